@@ -0,0 +1,64 @@
+#include "base_profiler.h"
+#include <iostream>
+#include <random>
+#include <thread>
+
+import stl;
+import index_base;
+import kmeans_partition;
+import search_top_k;
+
+using namespace infinity;
+
+// Train IVF centroids on random clustered vectors with each k-means option and report the time and the mean squared distance of the
+// vectors to their nearest centroid.
+
+void RunKMeans(const char *name, const Vector<f32> &data, u32 dim, u32 partition_num, const KMeansOption &option) {
+    u32 vector_n = data.size() / dim;
+    Vector<f32> centroids;
+    BaseProfiler profiler;
+    profiler.Begin();
+    u32 real_partition_num =
+        GetKMeansCentroids<f32, f32, f32>(MetricType::kMetricL2, dim, vector_n, data.data(), centroids, partition_num, 0, 32, 256, option);
+    profiler.End();
+
+    Vector<u32> labels(vector_n);
+    Vector<f32> distances(vector_n);
+    search_top_1_with_dis(dim, vector_n, data.data(), real_partition_num, centroids.data(), labels.data(), distances.data());
+    double total_distance = 0;
+    for (f32 distance : distances) {
+        total_distance += distance;
+    }
+    std::cout << name << " threads: " << option.thread_num_ << " cost: " << profiler.ElapsedToString()
+              << " mean distance: " << total_distance / vector_n << std::endl;
+}
+
+int main() {
+    const u32 dim = 128;
+    const u32 vector_n = 1000000;
+    const u32 partition_num = 1024;
+    const u32 thread_n = std::max(1u, std::thread::hardware_concurrency());
+
+    // vectors around random cluster centers
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<f32> center_dist(-1.0, 1.0);
+    std::normal_distribution<f32> noise_dist(0, 0.1);
+    Vector<f32> centers(partition_num * dim);
+    for (auto &x : centers) {
+        x = center_dist(rng);
+    }
+    Vector<f32> data(SizeT(vector_n) * dim);
+    std::uniform_int_distribution<u32> center_id_dist(0, partition_num - 1);
+    for (u32 i = 0; i < vector_n; ++i) {
+        u32 center_id = center_id_dist(rng);
+        for (u32 j = 0; j < dim; ++j) {
+            data[SizeT(i) * dim + j] = centers[center_id * dim + j] + noise_dist(rng);
+        }
+    }
+
+    RunKMeans("Random init", data, dim, partition_num, {.thread_num_ = 1});
+    RunKMeans("Random init", data, dim, partition_num, {.thread_num_ = thread_n});
+    RunKMeans("K-means++ init", data, dim, partition_num, {.thread_num_ = thread_n, .init_ = KMeansInit::kPlusPlus});
+    RunKMeans("Mini batch", data, dim, partition_num, {.thread_num_ = thread_n, .mini_batch_size_ = 16 * partition_num});
+    return 0;
+}
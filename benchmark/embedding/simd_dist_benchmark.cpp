@@ -0,0 +1,69 @@
+#include "base_profiler.h"
+#include <iostream>
+#include <random>
+
+import stl;
+import hnsw_simd_func;
+import simd_init;
+
+using namespace infinity;
+
+// Time the distance kernels of every instruction set the cpu supports on the same vectors.
+// The kernel picked by GetF32L2Func / GetI8IPFunc should be the fastest one.
+
+template <typename T, typename Func>
+void RunKernel(const char *name, Func func, const Vector<T> &base, const Vector<T> &query, SizeT dim, SizeT round_n) {
+    SizeT vector_n = base.size() / dim;
+    double checksum = 0;
+    BaseProfiler profiler;
+    profiler.Begin();
+    for (SizeT round = 0; round < round_n; ++round) {
+        for (SizeT i = 0; i < vector_n; ++i) {
+            checksum += func(base.data() + i * dim, query.data(), dim);
+        }
+    }
+    profiler.End();
+    std::cout << name << " dim: " << dim << " cost: " << profiler.ElapsedToString() << " checksum: " << checksum << std::endl;
+}
+
+int main() {
+    const SizeT vector_n = 100000;
+    const SizeT round_n = 10;
+    SIMDLevel level = GetSupportedSIMDLevel();
+    std::cout << "Supported SIMD level: " << SIMDLevelToString(level) << std::endl;
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> float_dist(-1.0, 1.0);
+    std::uniform_int_distribution<int> int_dist(-128, 127);
+
+    for (SizeT dim : {128, 200, 768}) {
+        Vector<float> base(vector_n * dim), query(dim);
+        Vector<int8_t> base_i8(vector_n * dim), query_i8(dim);
+        for (SizeT i = 0; i < base.size(); ++i) {
+            base[i] = float_dist(rng);
+            base_i8[i] = int_dist(rng);
+        }
+        for (SizeT i = 0; i < dim; ++i) {
+            query[i] = float_dist(rng);
+            query_i8[i] = int_dist(rng);
+        }
+
+        RunKernel("F32L2BF", F32L2BF, base, query, dim, round_n);
+        RunKernel("I8IPBF", I8IPBF, base_i8, query_i8, dim, round_n);
+        if (level >= SIMDLevel::kSSE) {
+            RunKernel("F32L2SSEResidual", F32L2SSEResidual, base, query, dim, round_n);
+            RunKernel("I8IPSSEResidual", I8IPSSEResidual, base_i8, query_i8, dim, round_n);
+        }
+        if (level >= SIMDLevel::kAVX2) {
+            RunKernel("F32L2AVXResidual", F32L2AVXResidual, base, query, dim, round_n);
+            RunKernel("I8IPAVXResidual", I8IPAVXResidual, base_i8, query_i8, dim, round_n);
+        }
+        if (level >= SIMDLevel::kAVX512) {
+            RunKernel("F32L2AVX512Residual", F32L2AVX512Residual, base, query, dim, round_n);
+            RunKernel("I8IPAVX512Residual", I8IPAVX512Residual, base_i8, query_i8, dim, round_n);
+        }
+        RunKernel("Selected F32L2", GetF32L2Func(dim), base, query, dim, round_n);
+        RunKernel("Selected I8IP", GetI8IPFunc(dim), base_i8, query_i8, dim, round_n);
+    }
+    return 0;
+}
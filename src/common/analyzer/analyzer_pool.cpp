@@ -38,20 +38,19 @@ constexpr u64 Str2Int(const char *str, u64 last_value = basis) {
     return (*str != '\0' && *str != '-') ? Str2Int(str + 1, (*str ^ last_value) * prime) : last_value;
 }
 
-UniquePtr<Analyzer> AnalyzerPool::Get(const std::string_view &name) {
+UniquePtr<Analyzer> AnalyzerPool::Create(const std::string_view &name) {
     switch (Str2Int(name.data())) {
         case Str2Int(CHINESE.data()): {
-            Analyzer *prototype = cache_[CHINESE].get();
-            if (prototype == nullptr) {
+            std::lock_guard<std::mutex> lock(prototype_mutex_);
+            if (chinese_prototype_.get() == nullptr) {
                 String path = InfinityContext::instance().config()->resource_dict_path();
                 UniquePtr<ChineseAnalyzer> analyzer = MakeUnique<ChineseAnalyzer>(std::move(path));
                 if (!analyzer->Load()) {
                     return nullptr;
                 }
-                prototype = analyzer.get();
-                cache_[CHINESE] = std::move(analyzer);
+                chinese_prototype_ = std::move(analyzer);
             }
-            return MakeUnique<ChineseAnalyzer>(*reinterpret_cast<ChineseAnalyzer *>(prototype));
+            return MakeUnique<ChineseAnalyzer>(*static_cast<ChineseAnalyzer *>(chinese_prototype_.get()));
         } break;
         case Str2Int(STANDARD.data()): {
             return MakeUnique<StandardAnalyzer>();
@@ -78,4 +77,50 @@ UniquePtr<Analyzer> AnalyzerPool::Get(const std::string_view &name) {
     }
 }
 
+namespace {
+
+// The idle analyzers of the current thread.
+struct ThreadAnalyzers {
+    ~ThreadAnalyzers();
+
+    HashMap<String, Vector<UniquePtr<Analyzer>>> idle_{};
+};
+
+// Analyzers released while the thread exits, after its free list is destroyed, are deleted.
+thread_local bool thread_analyzers_destroyed = false;
+thread_local ThreadAnalyzers thread_analyzers{};
+
+ThreadAnalyzers::~ThreadAnalyzers() { thread_analyzers_destroyed = true; }
+
+} // namespace
+
+void AnalyzerRecycler::operator()(Analyzer *analyzer) const { AnalyzerPool::instance().Recycle(name_, analyzer); }
+
+PooledAnalyzer AnalyzerPool::Get(const std::string_view &name) {
+    String key(name);
+    if (!thread_analyzers_destroyed) {
+        if (auto iter = thread_analyzers.idle_.find(key); iter != thread_analyzers.idle_.end() && !iter->second.empty()) {
+            Analyzer *analyzer = iter->second.back().release();
+            iter->second.pop_back();
+            return PooledAnalyzer(analyzer, AnalyzerRecycler{std::move(key)});
+        }
+    }
+    UniquePtr<Analyzer> analyzer = Create(name);
+    if (analyzer.get() == nullptr) {
+        return PooledAnalyzer(nullptr, AnalyzerRecycler{});
+    }
+    return PooledAnalyzer(analyzer.release(), AnalyzerRecycler{std::move(key)});
+}
+
+void AnalyzerPool::Recycle(const String &name, Analyzer *analyzer) {
+    UniquePtr<Analyzer> owned(analyzer);
+    if (thread_analyzers_destroyed) {
+        return;
+    }
+    Vector<UniquePtr<Analyzer>> &idle = thread_analyzers.idle_[name];
+    if (idle.size() < MAX_IDLE_PER_THREAD) {
+        idle.push_back(std::move(owned));
+    }
+}
+
 } // namespace infinity
\ No newline at end of file
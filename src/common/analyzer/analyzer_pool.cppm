@@ -14,6 +14,8 @@
 
 module;
 
+#include <memory>
+
 export module analyzer_pool;
 
 import stl;
@@ -23,16 +25,35 @@ import analyzer;
 
 namespace infinity {
 
+// Gives an analyzer back to the pool of the releasing thread instead of deleting it.
+export struct AnalyzerRecycler {
+    String name_{};
+
+    void operator()(Analyzer *analyzer) const;
+};
+
+export using PooledAnalyzer = std::unique_ptr<Analyzer, AnalyzerRecycler>;
+
+// Analyzers keep per call state, so an instance is used by one thread at a time. Released instances are kept in a per thread free list
+// keyed by the analyzer name and handed out again by Get, so neither the inverters nor the query analysis construct analyzers on the hot
+// path. The jieba dictionaries are loaded once into a prototype and shared read only by all the chinese analyzers.
 export class AnalyzerPool : public Singleton<AnalyzerPool> {
 public:
-    using CacheType = FlatHashMap<std::string_view, UniquePtr<Analyzer>>;
+    // Maximum idle analyzers of each name kept per thread.
+    static constexpr SizeT MAX_IDLE_PER_THREAD = 8;
 
-    UniquePtr<Analyzer> Get(const std::string_view &name);
-
-    void Set(const std::string_view &name);
+    // Return a null analyzer if the name is invalid or its dictionaries can't be loaded.
+    PooledAnalyzer Get(const std::string_view &name);
 
 private:
-    CacheType cache_{};
+    friend struct AnalyzerRecycler;
+
+    UniquePtr<Analyzer> Create(const std::string_view &name);
+
+    void Recycle(const String &name, Analyzer *analyzer);
+
+    std::mutex prototype_mutex_{};
+    UniquePtr<Analyzer> chinese_prototype_{};
 };
 
-} // namespace infinity
\ No newline at end of file
+} // namespace infinity
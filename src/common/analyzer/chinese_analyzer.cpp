@@ -47,14 +47,9 @@ namespace fs = std::filesystem;
 
 ChineseAnalyzer::ChineseAnalyzer(const String &path) : dict_path_(path) {}
 
-ChineseAnalyzer::ChineseAnalyzer(const ChineseAnalyzer &other) {
-    own_jieba_ = false;
-    jieba_ = other.jieba_;
-}
-ChineseAnalyzer::~ChineseAnalyzer() {
-    if (own_jieba_ && jieba_)
-        delete jieba_;
-}
+ChineseAnalyzer::ChineseAnalyzer(const ChineseAnalyzer &other) : jieba_(other.jieba_), dict_path_(other.dict_path_), stopwords_(other.stopwords_) {}
+
+ChineseAnalyzer::~ChineseAnalyzer() = default;
 
 bool ChineseAnalyzer::Load() {
     fs::path root(dict_path_);
@@ -86,11 +81,10 @@ bool ChineseAnalyzer::Load() {
     }
 
     try {
-        jieba_ = new cppjieba::Jieba(dict_path.string(), hmm_path.string(), userdict_path.string(), idf_path.string(), stopwords_path.string());
+        jieba_ = MakeShared<cppjieba::Jieba>(dict_path.string(), hmm_path.string(), userdict_path.string(), idf_path.string(), stopwords_path.string());
     } catch (const std::exception &e) {
         return false;
     }
-    own_jieba_ = true;
     LoadStopwordsDict(stopwords_path.string());
     return true;
 }
@@ -98,9 +92,11 @@ bool ChineseAnalyzer::Load() {
 void ChineseAnalyzer::LoadStopwordsDict(const String &stopwords_path) {
     std::ifstream ifs(stopwords_path);
     String line;
+    auto stopwords = MakeShared<FlatHashSet<String>>();
     while (getline(ifs, line)) {
-        stopwords_.insert(line);
+        stopwords->insert(line);
     }
+    stopwords_ = std::move(stopwords);
 }
 
 int ChineseAnalyzer::AnalyzeImpl(const Term &input, void *data, HookTypeForJieba func) {
@@ -110,7 +106,7 @@ int ChineseAnalyzer::AnalyzeImpl(const Term &input, void *data, HookTypeForJieba
             continue;
         func(data, cut_words_[i]);
     }
-    return cut_words_.back().offset + 1;
+    return cut_words_.empty() ? 0 : cut_words_.back().offset + 1;
 }
 
 } // namespace infinity
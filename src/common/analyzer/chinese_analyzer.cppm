@@ -28,6 +28,7 @@ export class ChineseAnalyzer : public Analyzer {
 public:
     ChineseAnalyzer(const String &path);
 
+    // Shares the loaded dictionaries of other, they are read only once loaded.
     ChineseAnalyzer(const ChineseAnalyzer &other);
 
     ~ChineseAnalyzer();
@@ -41,13 +42,12 @@ protected:
 
 private:
     void LoadStopwordsDict(const String &stopwords_path);
-    bool Accept_token(const String &term) { return !stopwords_.contains(term); }
+    bool Accept_token(const String &term) { return !stopwords_->contains(term); }
 
 private:
-    cppjieba::Jieba *jieba_{nullptr};
+    SharedPtr<const cppjieba::Jieba> jieba_{};
     String dict_path_;
-    bool own_jieba_{};
     Vector<cppjieba::Word> cut_words_;
-    FlatHashSet<String> stopwords_;
+    SharedPtr<const FlatHashSet<String>> stopwords_{};
 };
 } // namespace infinity
@@ -66,11 +66,25 @@ export {
     constexpr u64 SEGMENT_MASK_IN_DOCID = 0x7FFFFF;         // it should be adjusted together with DEFAULT_SEGMENT_CAPACITY
     constexpr u32 INVALID_SEGMENT_ID = std::numeric_limits<u32>::max();
 
+    // buffer read ahead related constants
+    constexpr SizeT DEFAULT_BUFFER_PREFETCH_THREAD_NUM = 4;
+    constexpr SizeT DEFAULT_READ_AHEAD_BLOCK_NUM = 4; // blocks read ahead of the one scanned
+
+    // buffer eviction related constants
+    constexpr double BUFFER_FLUSH_FREE_RATIO = 0.1; // memory kept free or evictable without writing, as a ratio of the limit
+    constexpr u64 BUFFER_FLUSH_INTERVAL_MS = 100;
+    constexpr u64 BUFFER_REQUEST_SPACE_TIMEOUT_SEC = 10; // wait for memory before the query fails with out of memory
+
     // queue related constants, TODO: double check the necessary
     constexpr SizeT BG_GROUND_TASK_QUEUE_SIZE = 65536;
     constexpr SizeT EXECUTOR_TASK_QUEUE_SIZE = 1024;
     constexpr SizeT DEFAULT_BLOCKING_QUEUE_SIZE = 1024;
 
+    // threads checking the conflicts and applying the commits of a wal batch
+    constexpr i32 WAL_COMMIT_THREAD_NUM = 4;
+    // threads inserting the committed appends into the realtime indexes
+    constexpr SizeT MEM_INDEX_APPEND_THREAD_NUM = 4;
+
     // transaction related constants
     constexpr u64 MAX_TXN_ID = std::numeric_limits<u64>::max();
     constexpr u64 MAX_TIMESTAMP = std::numeric_limits<u64>::max();
@@ -106,6 +120,16 @@ export {
     constexpr SizeT HNSW_M = 16;
     constexpr SizeT HNSW_EF_CONSTRUCTION = 200;
     constexpr SizeT HNSW_EF = 200;
+    // a filtered hnsw search expands the neighbors of filtered out vertices when fewer rows than this fraction pass the filter
+    constexpr double HNSW_FILTER_TWO_HOP_SELECTIVITY = 0.5;
+    // the candidates of a search on scalar or product quantized vectors re-ranked with the raw vectors, as a multiple of topk
+    constexpr SizeT HNSW_RERANK_FACTOR = 4;
+    // product quantization of hnsw vectors: the dimensions per subspace, the centroids per subspace and the vectors sampled to train them
+    constexpr SizeT HNSW_PQ_SUBSPACE_DIM = 4;
+    constexpr SizeT HNSW_PQ_CENTROID_NUM = 256;
+    constexpr SizeT HNSW_PQ_TRAIN_SAMPLE_NUM = 65536;
+    // the raw vectors an hnsw index keeps to train its quantizer again while they are added, until this many are added
+    constexpr SizeT HNSW_QUANTIZER_TRAIN_NUM = HNSW_PQ_CENTROID_NUM * 16;
 
     // default distance compute blas parameter
     constexpr SizeT DISTANCE_COMPUTE_BLAS_QUERY_BS = 4096;
@@ -115,6 +139,12 @@ export {
     constexpr SizeT DBT_COMPACTION_C = 4;
     constexpr SizeT DBT_COMPACTION_S = DEFAULT_BLOCK_CAPACITY;
 
+    // tiered merge of the full-text index chunks of a segment
+    constexpr SizeT FULLTEXT_MERGE_FACTOR = 8;
+    constexpr u32 FULLTEXT_MERGE_MIN_CHUNK_ROWS = DEFAULT_BLOCK_CAPACITY;
+    constexpr u32 FULLTEXT_MERGE_MAX_CHUNK_ROWS = DEFAULT_SEGMENT_CAPACITY;
+    constexpr SizeT FULLTEXT_MERGE_THREAD_NUM = 4;
+
     // default query option parameter
     constexpr u32 DEFAULT_FULL_TEXT_OPTION_TOP_N = 10;
 }
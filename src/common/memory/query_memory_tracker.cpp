@@ -0,0 +1,53 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+module query_memory_tracker;
+
+import stl;
+import status;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+namespace {
+
+thread_local SharedPtr<QueryMemoryTracker> current_tracker{};
+
+}
+
+void QueryMemoryTracker::Charge(SizeT bytes) {
+    u64 used = used_.fetch_add(bytes) + bytes;
+    if (used > limit_) {
+        used_.fetch_sub(bytes);
+        RecoverableError(Status::OutOfMemory(fmt::format("query needs {} more bytes, {} of query_memory_limit {} are in use", bytes, used - bytes, limit_)));
+    }
+    u64 peak = peak_.load();
+    while (used > peak && !peak_.compare_exchange_weak(peak, used)) {
+    }
+}
+
+void QueryMemoryTracker::Release(SizeT bytes) { used_.fetch_sub(bytes); }
+
+const SharedPtr<QueryMemoryTracker> &QueryMemoryTracker::Current() { return current_tracker; }
+
+QueryMemoryTracker::ScopedCurrent::ScopedCurrent(SharedPtr<QueryMemoryTracker> tracker) : prev_tracker_(std::move(current_tracker)) {
+    current_tracker = std::move(tracker);
+}
+
+QueryMemoryTracker::ScopedCurrent::~ScopedCurrent() { current_tracker = std::move(prev_tracker_); }
+
+} // namespace infinity
@@ -0,0 +1,112 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module query_memory_tracker;
+
+import stl;
+
+namespace infinity {
+
+// Memory charged to one query, bounded by query_memory_limit.
+// Charging beyond the limit fails the query with an out of memory error, the memory of the other queries and of the buffer manager is
+// left untouched.
+export class QueryMemoryTracker {
+public:
+    explicit QueryMemoryTracker(u64 limit) : limit_(limit) {}
+
+    // Throw a recoverable error if the query would exceed its limit.
+    void Charge(SizeT bytes);
+
+    void Release(SizeT bytes);
+
+    u64 limit() const { return limit_; }
+
+    u64 used() const { return used_.load(); }
+
+    u64 peak() const { return peak_.load(); }
+
+    // The tracker of the query executed by this thread, nullptr outside of query execution.
+    static const SharedPtr<QueryMemoryTracker> &Current();
+
+    // Make the tracker current on this thread for the lifetime of the guard.
+    class ScopedCurrent {
+    public:
+        explicit ScopedCurrent(SharedPtr<QueryMemoryTracker> tracker);
+
+        ~ScopedCurrent();
+
+    private:
+        SharedPtr<QueryMemoryTracker> prev_tracker_{};
+    };
+
+private:
+    const u64 limit_{};
+    Atomic<u64> used_{0};
+    Atomic<u64> peak_{0};
+};
+
+// Memory charged to a tracker and released when the reservation is destroyed.
+// The tracker is shared since the charged memory, e.g. the blocks of a query result, may outlive the query execution.
+export class MemoryReservation {
+public:
+    MemoryReservation() = default;
+
+    explicit MemoryReservation(SharedPtr<QueryMemoryTracker> tracker) : tracker_(std::move(tracker)) {}
+
+    MemoryReservation(const MemoryReservation &) = delete;
+    MemoryReservation &operator=(const MemoryReservation &) = delete;
+
+    MemoryReservation(MemoryReservation &&other) : tracker_(std::move(other.tracker_)), bytes_(std::exchange(other.bytes_, 0)) {}
+
+    MemoryReservation &operator=(MemoryReservation &&other) {
+        if (this != &other) {
+            Reset();
+            tracker_ = std::move(other.tracker_);
+            bytes_ = std::exchange(other.bytes_, 0);
+        }
+        return *this;
+    }
+
+    ~MemoryReservation() { Reset(); }
+
+    // Charge the difference to the tracker, nothing is charged without a tracker.
+    void Resize(SizeT bytes) {
+        if (tracker_.get() == nullptr) {
+            return;
+        }
+        if (bytes > bytes_) {
+            tracker_->Charge(bytes - bytes_);
+        } else {
+            tracker_->Release(bytes_ - bytes);
+        }
+        bytes_ = bytes;
+    }
+
+    void Reset() {
+        if (tracker_.get() != nullptr && bytes_ > 0) {
+            tracker_->Release(bytes_);
+        }
+        bytes_ = 0;
+    }
+
+    SizeT bytes() const { return bytes_; }
+
+private:
+    SharedPtr<QueryMemoryTracker> tracker_{};
+    SizeT bytes_{0};
+};
+
+} // namespace infinity
@@ -0,0 +1,58 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+module simd_init;
+
+import stl;
+
+namespace infinity {
+
+SIMDLevel DetectSIMDLevel() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SIMDLevel::kAVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SIMDLevel::kAVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return SIMDLevel::kSSE;
+    }
+#endif
+    return SIMDLevel::kNone;
+}
+
+SIMDLevel GetSupportedSIMDLevel() {
+    static const SIMDLevel level = DetectSIMDLevel();
+    return level;
+}
+
+String SIMDLevelToString(SIMDLevel level) {
+    switch (level) {
+        case SIMDLevel::kNone:
+            return "None";
+        case SIMDLevel::kSSE:
+            return "SSE4.2";
+        case SIMDLevel::kAVX2:
+            return "AVX2";
+        case SIMDLevel::kAVX512:
+            return "AVX512";
+    }
+    return "Invalid";
+}
+
+} // namespace infinity
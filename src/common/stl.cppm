@@ -196,6 +196,9 @@ export namespace std {
     using std::iota;
 
     using std::exception;
+    using std::exception_ptr;
+    using std::current_exception;
+    using std::rethrow_exception;
     using std::unordered_set;
 
     using std::back_inserter;
@@ -221,6 +224,7 @@ export namespace std {
 
     using std::is_same_v;
     using std::priority_queue;
+    using std::greater;
 } // namespace std
 
 namespace infinity {
@@ -370,6 +374,8 @@ namespace infinity {
     // Concurrency
     using ThreadPool = ctpl::thread_pool;
 
+    using std::future;
+
     using Thread = std::thread;
 
     // template< class Rep, class Period >
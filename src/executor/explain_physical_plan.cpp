@@ -812,6 +812,11 @@ void ExplainPhysicalPlan::Explain(const PhysicalKnnScan *knn_scan_node, SharedPt
     result->emplace_back(MakeShared<String>(query_embedding));
 
     // filter expression
+    if (BaseExpression *index_filter_expr = knn_scan_node->secondary_index_filter_qualified_.get(); index_filter_expr != nullptr) {
+        String filter_str = String(intent_size, ' ') + " - filter for secondary index: ";
+        ExplainLogicalPlan::Explain(index_filter_expr, filter_str);
+        result->emplace_back(MakeShared<String>(filter_str));
+    }
     BaseExpression *filter_expr = knn_scan_node->filter_expression_.get();
     if (filter_expr != nullptr) {
         String filter_str = String(intent_size, ' ') + " - filter: ";
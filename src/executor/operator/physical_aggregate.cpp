@@ -42,6 +42,8 @@ import status;
 import logical_type;
 import internal_types;
 import column_def;
+import physical_operator_type;
+import block_statistics_aggregate;
 
 namespace infinity {
 
@@ -61,10 +63,23 @@ bool PhysicalAggregate::Execute(QueryContext *query_context, OperatorState *oper
     if (group_count == 0) {
         // Aggregate without group by expression
         // e.g. SELECT count(a) FROM table;
+        BlockStatisticsAggregator *statistics_aggregator = nullptr;
+        if (prev_op_state->operator_type_ == PhysicalOperatorType::kTableScan) {
+            statistics_aggregator = static_cast<TableScanOperatorState *>(prev_op_state)->block_statistics_aggregator_.get();
+        }
+        if (statistics_aggregator != nullptr) {
+            for (const auto &input_block : prev_op_state->data_block_array_) {
+                statistics_aggregator->AddScannedRows(input_block->row_count());
+            }
+        }
         auto result = SimpleAggregateExecute(prev_op_state->data_block_array_,
                                              aggregate_operator_state->data_block_array_,
                                              aggregate_operator_state->states_,
                                              prev_op_state->Complete());
+        if (statistics_aggregator != nullptr && prev_op_state->Complete() && !aggregate_operator_state->data_block_array_.empty()) {
+            // blocks answered from their statistics were skipped by the scan
+            statistics_aggregator->MergeInto(*aggregate_operator_state->data_block_array_[0]);
+        }
         prev_op_state->data_block_array_.clear();
         if (prev_op_state->Complete()) {
             aggregate_operator_state->SetComplete();
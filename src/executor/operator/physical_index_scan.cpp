@@ -34,6 +34,7 @@ import table_index_entry;
 import segment_index_entry;
 import segment_entry;
 import fast_rough_filter;
+import secondary_index_in_mem;
 // TODO:use bitset
 import bitmask;
 import filter_value_type_classification;
@@ -228,21 +229,43 @@ struct FilterResult {
     template <typename ColumnValueType>
     inline void
     ExecuteSingleRangeT(const FilterIntervalRangeT<ColumnValueType> &interval_range, SegmentIndexEntry &index_entry, SegmentID segment_id) {
+        // the rows appended after the PGM index was built are in the memory index
+        auto [index_lock, memory_index] = index_entry.GetSecondaryIndexSnapshot();
+        const u32 memory_row_count = memory_index.get() == nullptr ? 0 : memory_index->GetRowCount();
+        ExecuteSingleRangePGM(interval_range, index_entry, memory_row_count);
+        if (memory_row_count == 0) {
+            return;
+        }
+        auto [begin_val, end_val] = interval_range.GetRange();
+        FilterResult memory_result(SegmentRowCount(), SegmentRowActualCount());
+        auto &memory_selected_rows = memory_result.selected_rows_.emplace<Vector<u32>>();
+        memory_index->RangeQuery(&begin_val, &end_val, SegmentRowCount(), memory_selected_rows);
+        MergeOr(memory_result);
+    }
+
+    template <typename ColumnValueType>
+    inline void
+    ExecuteSingleRangePGM(const FilterIntervalRangeT<ColumnValueType> &interval_range, SegmentIndexEntry &index_entry, u32 memory_row_count) {
         using T = FilterIntervalRangeT<ColumnValueType>::T;
         BufferHandle index_handle_head = index_entry.GetIndex();
         auto index = static_cast<const SecondaryIndexDataHead *>(index_handle_head.GetData());
         auto index_part_capacity = index->GetPartCapacity();
         auto index_part_num = index->GetPartNum();
         auto index_data_num = index->GetDataNum();
-        if (index_data_num != SegmentRowActualCount()) {
-            if (index_data_num < SegmentRowActualCount()) {
+        if (index_data_num + memory_row_count != SegmentRowActualCount()) {
+            if (index_data_num + memory_row_count < SegmentRowActualCount()) {
                 UnrecoverableError("FilterResult::ExecuteSingleRange(): index_data_num < SegmentRowActualCount(). index error.");
             } else {
-                LOG_INFO(fmt::format("FilterResult::ExecuteSingleRange(): index_data_num: {}, SegmentRowActualCount(): {}. Some rows are deleted.",
+                LOG_INFO(fmt::format("FilterResult::ExecuteSingleRange(): index_data_num: {}, memory_row_count: {}, SegmentRowActualCount(): {}. "
+                                     "Some rows are deleted.",
                                      index_data_num,
+                                     memory_row_count,
                                      SegmentRowActualCount()));
             }
         }
+        if (index_data_num == 0) {
+            return SetEmptyResult();
+        }
         auto [begin_val, end_val] = interval_range.GetRange();
         // 1. search PGM and get approximate search range
         // result:
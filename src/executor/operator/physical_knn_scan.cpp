@@ -66,26 +66,40 @@ import block_entry;
 import segment_index_entry;
 import segment_entry;
 import abstract_hnsw;
+import block_column_entry;
+import data_type;
+import logical_type;
+import internal_types;
+import physical_index_scan;
+import filter_value_type_classification;
 
 namespace infinity {
 
+// The output references the block memory, no column data is copied unless the column is updated in place.
 void ReadDataBlock(DataBlock *output,
                    BufferManager *buffer_mgr,
+                   TxnTimeStamp begin_ts,
                    const auto row_count,
                    const BlockEntry *current_block_entry,
                    const Vector<SizeT> &column_ids) {
     auto block_id = current_block_entry->block_id();
     auto segment_id = current_block_entry->segment_id();
-    for (SizeT output_column_id = 0; auto column_id : column_ids) {
+    Vector<SharedPtr<ColumnVector>> column_vectors;
+    column_vectors.reserve(column_ids.size());
+    for (auto column_id : column_ids) {
         if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
             u32 segment_offset = block_id * DEFAULT_BLOCK_CAPACITY;
-            output->column_vectors[output_column_id++]->AppendWith(RowID(segment_id, segment_offset), row_count);
+            auto row_id_column = ColumnVector::Make(MakeShared<DataType>(LogicalType::kRowID));
+            row_id_column->Initialize(ColumnVectorType::kFlat, DEFAULT_BLOCK_CAPACITY);
+            row_id_column->AppendWith(RowID(segment_id, segment_offset), row_count);
+            column_vectors.emplace_back(std::move(row_id_column));
         } else {
-            ColumnVector column_vector = current_block_entry->GetColumnBlockEntry(column_id)->GetColumnVector(buffer_mgr);
-            output->column_vectors[output_column_id++]->AppendWith(column_vector, 0, row_count);
+            ColumnVector column_vector = current_block_entry->GetColumnBlockEntry(column_id)->GetColumnVector(buffer_mgr, row_count, begin_ts);
+            column_vectors.emplace_back(MakeShared<ColumnVector>(std::move(column_vector)));
         }
     }
-    output->Finalize();
+    output->UnInit();
+    output->Init(column_vectors);
 }
 
 void MergeIntoBitmask(const VectorBuffer *input_bool_column_buffer,
@@ -139,6 +153,76 @@ void MergeIntoBitmask(const VectorBuffer *input_bool_column_buffer,
     }
 }
 
+// Clear the bits of the rows in [begin_offset, begin_offset + count) of the segment which the secondary index doesn't select.
+// bitmask[i] is the bit of row begin_offset + i.
+void MergeIndexFilterIntoBitmask(const std::variant<Vector<u32>, Bitmask> &index_filter_result,
+                                 SegmentOffset begin_offset,
+                                 SizeT count,
+                                 Bitmask &bitmask) {
+    std::visit(Overload{[&](const Vector<u32> &selected_rows) {
+                            // selected rows are in ascending order
+                            auto iter = std::lower_bound(selected_rows.begin(), selected_rows.end(), begin_offset);
+                            for (SizeT i = 0; i < count; ++i) {
+                                if (iter != selected_rows.end() && *iter == begin_offset + i) {
+                                    ++iter;
+                                } else {
+                                    bitmask.SetFalse(i);
+                                }
+                            }
+                        },
+                        [&](const Bitmask &selected_rows) {
+                            for (SizeT i = 0; i < count; ++i) {
+                                if (!selected_rows.IsTrue(begin_offset + i)) {
+                                    bitmask.SetFalse(i);
+                                }
+                            }
+                        }},
+               index_filter_result);
+}
+
+// Whether the secondary index selects any row in [begin_offset, begin_offset + count) of the segment.
+bool IndexFilterSelectsAny(const std::variant<Vector<u32>, Bitmask> &index_filter_result, SegmentOffset begin_offset, SizeT count) {
+    return std::visit(Overload{[&](const Vector<u32> &selected_rows) -> bool {
+                                   auto iter = std::lower_bound(selected_rows.begin(), selected_rows.end(), begin_offset);
+                                   return iter != selected_rows.end() && *iter < begin_offset + count;
+                               },
+                               [&](const Bitmask &selected_rows) -> bool {
+                                   for (SizeT i = 0; i < count; ++i) {
+                                       if (selected_rows.IsTrue(begin_offset + i)) {
+                                           return true;
+                                       }
+                                   }
+                                   return false;
+                               }},
+                      index_filter_result);
+}
+
+String FilteredHnswStrategyToString(FilteredHnswStrategy strategy) {
+    switch (strategy) {
+        case FilteredHnswStrategy::kGraph:
+            return "graph";
+        case FilteredHnswStrategy::kTwoHop:
+            return "two hop";
+        case FilteredHnswStrategy::kBruteForce:
+            return "brute force";
+    }
+    return "invalid";
+}
+
+FilteredHnswStrategy ChooseFilteredHnswStrategy(SizeT filtered_row_count, SizeT segment_row_count, SizeT ef, SizeT M) {
+    if (segment_row_count == 0) {
+        return FilteredHnswStrategy::kGraph;
+    }
+    double selectivity = double(filtered_row_count) / segment_row_count;
+    if (filtered_row_count == 0 || double(filtered_row_count) * selectivity <= double(ef) * 2 * M) {
+        return FilteredHnswStrategy::kBruteForce;
+    }
+    if (selectivity < HNSW_FILTER_TWO_HOP_SELECTIVITY) {
+        return FilteredHnswStrategy::kTwoHop;
+    }
+    return FilteredHnswStrategy::kGraph;
+}
+
 void PhysicalKnnScan::Init() {}
 
 bool PhysicalKnnScan::Execute(QueryContext *query_context, OperatorState *operator_state) {
@@ -221,14 +305,32 @@ void PhysicalKnnScan::PlanWithIndex(QueryContext *query_context) { // TODO: retu
         }
     }
 
+    // Solve the prefilter by secondary index once, the segments and blocks without any selected row are not scanned.
+    const bool use_index_filter = secondary_index_filter_qualified_.get() != nullptr && fast_rough_filter_evaluator_.get() != nullptr;
+    if (use_index_filter) {
+        index_filter_result_ = SolveSecondaryIndexFilter(fast_rough_filter_evaluator_.get(),
+                                                         filter_execute_command_,
+                                                         secondary_index_column_index_map_,
+                                                         base_table_ref_.get(),
+                                                         begin_ts);
+    }
+
     // Generate task set: index segment and no index block
     BlockIndex *block_index = base_table_ref_->block_index_.get();
     for (SegmentEntry *segment_entry : block_index->segments_) {
+        auto filter_iter = index_filter_result_.find(segment_entry->segment_id());
+        if (use_index_filter && filter_iter == index_filter_result_.end()) {
+            continue;
+        }
         if (auto iter = index_entry_map.find(segment_entry->segment_id()); iter != index_entry_map.end()) {
             index_entries_->emplace_back(iter->second.get());
         } else {
             BlockEntryIter block_entry_iter(segment_entry);
             for (auto *block_entry = block_entry_iter.Next(); block_entry != nullptr; block_entry = block_entry_iter.Next()) {
+                if (use_index_filter &&
+                    !IndexFilterSelectsAny(filter_iter->second, block_entry->block_id() * DEFAULT_BLOCK_CAPACITY, block_entry->row_count())) {
+                    continue;
+                }
                 BlockColumnEntry *block_column_entry = block_entry->GetColumnBlockEntry(knn_column_id);
                 block_column_entries_->emplace_back(block_column_entry);
             }
@@ -259,6 +361,17 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
         // brute force
         BlockColumnEntry *block_column_entry = knn_scan_shared_data->block_column_entries_->at(block_column_idx);
         const BlockEntry *block_entry = block_column_entry->block_entry();
+        {
+            // read the next block columns ahead while this one is computed, the tasks share the read ahead position
+            BufferManager *buffer_mgr = query_context->storage()->buffer_manager();
+            u64 read_ahead_end = std::min(u64(brute_task_n), block_column_idx + 1 + DEFAULT_READ_AHEAD_BLOCK_NUM);
+            u64 read_ahead_idx = knn_scan_shared_data->read_ahead_block_idx_.load();
+            while (read_ahead_idx < read_ahead_end && !knn_scan_shared_data->read_ahead_block_idx_.compare_exchange_weak(read_ahead_idx, read_ahead_end)) {
+            }
+            for (u64 i = std::max(read_ahead_idx, block_column_idx + 1); i < read_ahead_end; ++i) {
+                knn_scan_shared_data->block_column_entries_->at(i)->Prefetch(buffer_mgr);
+            }
+        }
         // check FastRoughFilter
         const auto &fast_rough_filter = *block_entry->GetFastRoughFilter();
         if (fast_rough_filter_evaluator_ and !fast_rough_filter_evaluator_->Evaluate(begin_ts, fast_rough_filter)) [[unlikely]] {
@@ -277,13 +390,15 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
 
             Bitmask bitmask;
             bitmask.Initialize(std::bit_ceil(row_count));
+            if (auto iter = index_filter_result_.find(block_entry->segment_id()); iter != index_filter_result_.end()) {
+                MergeIndexFilterIntoBitmask(iter->second, block_entry->block_id() * DEFAULT_BLOCK_CAPACITY, row_count, bitmask);
+            }
             if (filter_expression_) {
                 auto db_for_filter = knn_scan_function_data->db_for_filter_.get();
                 auto &filter_state_ = knn_scan_function_data->filter_state_;
                 auto &bool_column = knn_scan_function_data->bool_column_;
                 // filter and build bitmask, if filter_expression_ != nullptr
-                db_for_filter->Reset(row_count);
-                ReadDataBlock(db_for_filter, buffer_mgr, row_count, block_entry, base_table_ref_->column_ids_);
+                ReadDataBlock(db_for_filter, buffer_mgr, begin_ts, row_count, block_entry, base_table_ref_->column_ids_);
                 bool_column->Initialize(ColumnVectorType::kCompactBit, row_count);
                 ExpressionEvaluator expr_evaluator;
                 expr_evaluator.Init(db_for_filter);
@@ -295,7 +410,7 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
             }
             block_entry->SetDeleteBitmask(begin_ts, bitmask);
 
-            ColumnVector column_vector = block_column_entry->GetColumnVector(buffer_mgr);
+            ColumnVector column_vector = block_column_entry->GetColumnVector(buffer_mgr, row_count, begin_ts);
 
             auto data = reinterpret_cast<const DataType *>(column_vector.data());
             merge_heap->Search(query,
@@ -334,8 +449,14 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                                   index_task_n));
             auto segment_row_count = segment_entry->row_count();
             Bitmask bitmask;
-            if (filter_expression_) {
+            if (auto iter = index_filter_result_.find(segment_id); iter != index_filter_result_.end()) {
                 bitmask.Initialize(std::bit_ceil(segment_row_count));
+                MergeIndexFilterIntoBitmask(iter->second, 0, segment_row_count, bitmask);
+            }
+            if (filter_expression_) {
+                if (bitmask.count() == 0) {
+                    bitmask.Initialize(std::bit_ceil(segment_row_count));
+                }
                 SizeT segment_row_count_real = 0;
                 auto db_for_filter = knn_scan_function_data->db_for_filter_.get();
                 auto &filter_state_ = knn_scan_function_data->filter_state_;
@@ -345,8 +466,7 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                 auto block_entry_iter = BlockEntryIter(segment_entry);
                 for (auto *block_entry = block_entry_iter.Next(); block_entry != nullptr; block_entry = block_entry_iter.Next()) {
                     auto row_count = block_entry->row_count();
-                    db_for_filter->Reset(row_count);
-                    ReadDataBlock(db_for_filter, buffer_mgr, row_count, block_entry, base_table_ref_->column_ids_);
+                    ReadDataBlock(db_for_filter, buffer_mgr, begin_ts, row_count, block_entry, base_table_ref_->column_ids_);
                     bool_column->Initialize(ColumnVectorType::kCompactBit, row_count);
                     expr_evaluator.Init(db_for_filter);
                     expr_evaluator.Execute(filter_expression_, filter_state_, bool_column);
@@ -426,14 +546,107 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                 case IndexType::kHnsw: {
                     const auto *index_hnsw = static_cast<const IndexHnsw *>(segment_index_entry->table_index_entry()->index_base());
 
-                    auto hnsw_search = [&](BufferHandle index_handle, bool with_lock) {
-                        AbstractHnsw<f32, SegmentOffset> abstract_hnsw(index_handle.GetDataMut(), index_hnsw);
+                    u64 ef = 0;
+                    u64 rerank_factor = HNSW_RERANK_FACTOR;
+                    for (const auto &opt_param : knn_scan_shared_data->opt_params_) {
+                        if (opt_param.param_name_ == "ef") {
+                            ef = std::stoull(opt_param.param_value_);
+                        } else if (opt_param.param_name_ == "rerank_factor") {
+                            rerank_factor = std::max<u64>(1, std::stoull(opt_param.param_value_));
+                        }
+                    }
+                    const bool need_rerank = index_hnsw->NeedRerank();
+                    const SizeT search_k = need_rerank ? knn_scan_shared_data->topk_ * rerank_factor : knn_scan_shared_data->topk_;
 
-                        for (const auto &opt_param : knn_scan_shared_data->opt_params_) {
-                            if (opt_param.param_name_ == "ef") {
-                                u64 ef = std::stoull(opt_param.param_value_);
-                                abstract_hnsw.SetEf(ef);
+                    auto strategy = FilteredHnswStrategy::kGraph;
+                    if (use_bitmask) {
+                        // the bits past the segment rows are left true
+                        SizeT filtered_row_count = bitmask.CountTrue() - (bitmask.count() - segment_row_count);
+                        SizeT search_ef = ef != 0 ? ef : (index_hnsw->ef_ != 0 ? index_hnsw->ef_ : index_hnsw->ef_construction_);
+                        search_ef = std::max<SizeT>(search_ef, knn_scan_shared_data->topk_);
+                        strategy = ChooseFilteredHnswStrategy(filtered_row_count, segment_row_count, search_ef, index_hnsw->M_);
+                    }
+                    LOG_TRACE(fmt::format("KnnScan: {} index {}/{} filtered hnsw strategy: {}",
+                                          knn_scan_function_data->task_id_,
+                                          index_idx + 1,
+                                          index_task_n,
+                                          FilteredHnswStrategyToString(strategy)));
+
+                    // Compute the distances of the rows from `begin_offset` on, the rows passing the filter only.
+                    auto brute_force_search = [&](SegmentOffset begin_offset) {
+                        KnnExpression *knn_expr = knn_expression_.get();
+                        ColumnExpression *column_expr = static_cast<ColumnExpression *>(knn_expr->arguments()[0].get());
+                        SizeT knn_column_id = column_expr->binding().column_idx;
+
+                        auto block_entry_iter = BlockEntryIter(segment_entry);
+                        for (auto *block_entry = block_entry_iter.Next(); block_entry != nullptr; block_entry = block_entry_iter.Next()) {
+                            auto row_count = block_entry->row_count();
+                            SegmentOffset block_offset = block_entry->block_id() * DEFAULT_BLOCK_CAPACITY;
+                            if (block_offset + row_count <= begin_offset) {
+                                continue;
+                            }
+                            Bitmask block_bitmask;
+                            block_bitmask.Initialize(std::bit_ceil(row_count));
+                            for (SizeT i = 0; i < row_count; ++i) {
+                                if (block_offset + i < begin_offset || (use_bitmask && !bitmask.IsTrue(block_offset + i))) {
+                                    block_bitmask.SetFalse(i);
+                                }
                             }
+                            block_entry->SetDeleteBitmask(begin_ts, block_bitmask);
+
+                            ColumnVector column_vector =
+                                block_entry->GetColumnBlockEntry(knn_column_id)->GetColumnVector(buffer_mgr, row_count, begin_ts);
+                            auto data = reinterpret_cast<const DataType *>(column_vector.data());
+                            merge_heap->Search(query,
+                                               data,
+                                               knn_scan_shared_data->dimension_,
+                                               dist_func->dist_func_,
+                                               row_count,
+                                               segment_id,
+                                               block_entry->block_id(),
+                                               block_bitmask);
+                        }
+                    };
+
+                    if (strategy == FilteredHnswStrategy::kBruteForce) {
+                        // Few rows pass the filter, computing their distances is cheaper than searching the graph for them.
+                        brute_force_search(0);
+                        break;
+                    }
+                    const bool filter_two_hop = strategy == FilteredHnswStrategy::kTwoHop;
+
+                    // Replace the distances of the candidates by the ones of their raw vectors.
+                    HashMap<BlockID, ColumnVector> rerank_columns;
+                    auto rerank = [&](const DataType *query, DataType *d_ptr, const SegmentOffset *l_ptr, i64 result_n) {
+                        KnnExpression *knn_expr = knn_expression_.get();
+                        ColumnExpression *column_expr = static_cast<ColumnExpression *>(knn_expr->arguments()[0].get());
+                        SizeT knn_column_id = column_expr->binding().column_idx;
+                        SizeT dimension = knn_scan_shared_data->dimension_;
+
+                        for (i64 i = 0; i < result_n; ++i) {
+                            BlockID block_id = l_ptr[i] / DEFAULT_BLOCK_CAPACITY;
+                            BlockOffset block_offset = l_ptr[i] % DEFAULT_BLOCK_CAPACITY;
+                            auto iter = rerank_columns.find(block_id);
+                            if (iter == rerank_columns.end()) {
+                                SharedPtr<BlockEntry> block_entry = segment_entry->GetBlockEntryByID(block_id);
+                                if (block_entry.get() == nullptr) {
+                                    UnrecoverableError(fmt::format("Cannot find segment id: {}, block id: {}", segment_id, block_id));
+                                }
+                                ColumnVector column_vector = block_entry->GetColumnBlockEntry(knn_column_id)
+                                                                 ->GetColumnVector(buffer_mgr, block_entry->row_count(), begin_ts);
+                                iter = rerank_columns.emplace(block_id, std::move(column_vector)).first;
+                            }
+                            auto data = reinterpret_cast<const DataType *>(iter->second.data());
+                            d_ptr[i] = dist_func->dist_func_(query, data + block_offset * dimension, dimension);
+                        }
+                    };
+
+                    // The rows from `end_offset` on are searched by the tail scan.
+                    auto hnsw_search = [&](BufferHandle index_handle, bool with_lock, SegmentOffset end_offset) {
+                        AbstractHnsw<f32, SegmentOffset> abstract_hnsw(index_handle.GetDataMut(), index_hnsw);
+
+                        if (ef != 0) {
+                            abstract_hnsw.SetEf(ef);
                         }
 
                         i64 result_n = -1;
@@ -441,30 +654,35 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                             const DataType *query =
                                 static_cast<const DataType *>(knn_scan_shared_data->query_embedding_) + query_idx * knn_scan_shared_data->dimension_;
 
+                            auto knn_search = [&](const auto &filter) {
+                                if (end_offset == std::numeric_limits<SegmentOffset>::max()) {
+                                    return abstract_hnsw.KnnSearch(query, search_k, filter, with_lock, filter_two_hop);
+                                }
+                                PrefixFilter prefix_filter(filter, end_offset);
+                                return abstract_hnsw.KnnSearch(query, search_k, prefix_filter, with_lock, filter_two_hop);
+                            };
+
                             SizeT result_n1 = 0;
                             UniquePtr<DataType[]> d_ptr = nullptr;
                             UniquePtr<SegmentOffset[]> l_ptr = nullptr;
                             if (use_bitmask) {
                                 if (segment_entry->CheckAnyDelete(begin_ts)) {
                                     DeleteWithBitmaskFilter filter(bitmask, segment_entry, begin_ts);
-                                    std::tie(result_n1, d_ptr, l_ptr) =
-                                        abstract_hnsw.KnnSearch(query, knn_scan_shared_data->topk_, filter, with_lock);
+                                    std::tie(result_n1, d_ptr, l_ptr) = knn_search(filter);
                                 } else {
                                     BitmaskFilter<SegmentOffset> filter(bitmask);
-                                    std::tie(result_n1, d_ptr, l_ptr) =
-                                        abstract_hnsw.KnnSearch(query, knn_scan_shared_data->topk_, filter, with_lock);
+                                    std::tie(result_n1, d_ptr, l_ptr) = knn_search(filter);
                                 }
                             } else {
                                 if (segment_entry->CheckAnyDelete(begin_ts)) {
                                     DeleteFilter filter(segment_entry, begin_ts);
-                                    std::tie(result_n1, d_ptr, l_ptr) =
-                                        abstract_hnsw.KnnSearch(query, knn_scan_shared_data->topk_, filter, with_lock);
+                                    std::tie(result_n1, d_ptr, l_ptr) = knn_search(filter);
                                 } else {
                                     if (!with_lock) {
-                                        std::tie(result_n1, d_ptr, l_ptr) = abstract_hnsw.KnnSearch(query, knn_scan_shared_data->topk_, false);
+                                        std::tie(result_n1, d_ptr, l_ptr) = abstract_hnsw.KnnSearch(query, search_k, false);
                                     } else {
                                         AppendFilter filter(block_index->GetSegmentOffset(segment_id));
-                                        std::tie(result_n1, d_ptr, l_ptr) = abstract_hnsw.KnnSearch(query, knn_scan_shared_data->topk_, filter, true);
+                                        std::tie(result_n1, d_ptr, l_ptr) = knn_search(filter);
                                     }
                                 }
                             }
@@ -491,6 +709,9 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                                     break;
                                 }
                             }
+                            if (need_rerank) {
+                                rerank(query, d_ptr.get(), l_ptr.get(), result_n);
+                            }
 
                             auto row_ids = MakeUniqueForOverwrite<RowID[]>(result_n);
                             for (i64 i = 0; i < result_n; ++i) {
@@ -501,15 +722,30 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                     };
 
                     auto [chunk_index_entries, memory_index_entry] = segment_index_entry->GetHnswIndexSnapshot();
+                    SegmentOffset indexed_end = 0;
                     for (auto &chunk_index_entry : chunk_index_entries) {
                         if (chunk_index_entry->CheckVisible(begin_ts)) {
                             BufferHandle index_handle = chunk_index_entry->GetIndex();
-                            hnsw_search(index_handle, false);
+                            hnsw_search(index_handle, false, std::numeric_limits<SegmentOffset>::max());
+                            indexed_end =
+                                std::max<SegmentOffset>(indexed_end, chunk_index_entry->base_rowid_.segment_offset_ + chunk_index_entry->row_count_);
                         }
                     }
                     if (memory_index_entry.get() != nullptr) {
+                        // Rows may be inserted into the memory index during the search, they are left to the tail scan.
+                        SegmentOffset memory_end = memory_index_entry->base_rowid_.segment_offset_ + memory_index_entry->row_count_;
                         BufferHandle index_handle = memory_index_entry->GetIndex();
-                        hnsw_search(index_handle, true);
+                        hnsw_search(index_handle, true, memory_end);
+                        indexed_end = std::max(indexed_end, memory_end);
+                    }
+                    // The tail scan: the rows appended but not inserted into the realtime index yet.
+                    if (indexed_end < segment_row_count) {
+                        LOG_TRACE(fmt::format("KnnScan: {} index {}/{} tail scan of {} rows",
+                                              knn_scan_function_data->task_id_,
+                                              index_idx + 1,
+                                              index_task_n,
+                                              segment_row_count - indexed_end));
+                        brute_force_search(indexed_end);
                     }
 
                     break;
@@ -572,9 +808,11 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                 for (SizeT i = 0; i < column_n; ++i) {
                     SizeT column_id = base_table_ref_->column_ids_[i];
                     auto *block_column_entry = block_entry->GetColumnBlockEntry(column_id);
-                    ColumnVector &&column_vector = block_column_entry->GetColumnVector(query_context->storage()->buffer_manager());
-
-                    output_block_ptr->column_vectors[i]->AppendWith(column_vector, block_offset, 1);
+                    block_column_entry->AppendTo(query_context->storage()->buffer_manager(),
+                                                 begin_ts,
+                                                 block_offset,
+                                                 1,
+                                                 *output_block_ptr->column_vectors[i]);
                 }
                 output_block_ptr->AppendValueByPtr(column_n, (ptr_t)&result_dists[id]);
                 output_block_ptr->AppendValueByPtr(column_n + 1, (ptr_t)&row_ids[id]);
@@ -35,9 +35,26 @@ import infinity_exception;
 import internal_types;
 import data_type;
 import fast_rough_filter;
+import table_index_entry;
+import secondary_index_scan_execute_expression;
+import bitmask;
 
 namespace infinity {
 
+// How the hnsw index of a segment is searched with a prefilter.
+export enum class FilteredHnswStrategy {
+    kGraph,      // search the graph, the vertices rejected by the filter still lead the search
+    kTwoHop,     // search the graph, the neighbors of the rejected vertices are visited instead of the rejected vertices
+    kBruteForce, // compute the distance of every row passing the filter
+};
+
+export String FilteredHnswStrategyToString(FilteredHnswStrategy strategy);
+
+// Choose the strategy from the selectivity of the filter, i.e. filtered_row_count / segment_row_count.
+// The graph search visits about ef / selectivity vertices to collect ef results and computes up to 2 * M distances per visited vertex,
+// brute force computes filtered_row_count distances.
+export FilteredHnswStrategy ChooseFilteredHnswStrategy(SizeT filtered_row_count, SizeT segment_row_count, SizeT ef, SizeT M);
+
 export class PhysicalKnnScan final : public PhysicalOperator {
 public:
     explicit PhysicalKnnScan(u64 id,
@@ -45,14 +62,25 @@ public:
                              SharedPtr<KnnExpression> knn_expression,
                              SharedPtr<BaseExpression> filter_expression,
                              UniquePtr<FastRoughFilterEvaluator> &&fast_rough_filter_evaluator,
+                             SharedPtr<BaseExpression> filter_leftover,
+                             SharedPtr<BaseExpression> secondary_index_filter_qualified,
+                             HashMap<ColumnID, TableIndexEntry *> &&secondary_index_column_index_map,
+                             Vector<FilterExecuteElem> &&filter_execute_command,
                              SharedPtr<Vector<String>> output_names,
                              SharedPtr<Vector<SharedPtr<DataType>>> output_types,
                              u64 knn_table_index,
                              SharedPtr<Vector<LoadMeta>> load_metas)
         : PhysicalOperator(PhysicalOperatorType::kKnnScan, nullptr, nullptr, id, load_metas), base_table_ref_(std::move(base_table_ref)),
           knn_expression_(std::move(knn_expression)), filter_expression_(std::move(filter_expression)),
-          fast_rough_filter_evaluator_(std::move(fast_rough_filter_evaluator)), output_names_(std::move(output_names)),
-          output_types_(std::move(output_types)), knn_table_index_(knn_table_index) {}
+          fast_rough_filter_evaluator_(std::move(fast_rough_filter_evaluator)),
+          secondary_index_filter_qualified_(std::move(secondary_index_filter_qualified)),
+          secondary_index_column_index_map_(std::move(secondary_index_column_index_map)), filter_execute_command_(std::move(filter_execute_command)),
+          output_names_(std::move(output_names)), output_types_(std::move(output_types)), knn_table_index_(knn_table_index) {
+        if (secondary_index_filter_qualified_ && fast_rough_filter_evaluator_) {
+            // the row by row filter only evaluates the conjuncts which the secondary index can't solve
+            filter_expression_ = std::move(filter_leftover);
+        }
+    }
 
     ~PhysicalKnnScan() override = default;
 
@@ -93,6 +121,12 @@ public:
 
     UniquePtr<FastRoughFilterEvaluator> fast_rough_filter_evaluator_{};
 
+    SharedPtr<BaseExpression> secondary_index_filter_qualified_{};
+    HashMap<ColumnID, TableIndexEntry *> secondary_index_column_index_map_{};
+    Vector<FilterExecuteElem> filter_execute_command_{};
+    // rows of each segment selected by the secondary index, segments without any selected row are absent
+    Map<SegmentID, std::variant<Vector<u32>, Bitmask>> index_filter_result_{};
+
     SharedPtr<Vector<String>> output_names_{};
     SharedPtr<Vector<SharedPtr<DataType>>> output_types_{};
     u64 knn_table_index_{};
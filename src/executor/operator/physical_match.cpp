@@ -316,7 +316,7 @@ void ASSERT_FLOAT_EQ(float bar, u32 i, float a, float b) {
 }
 
 void AnalyzeFunc(const String &analyzer_name, String &&text, TermList &output_terms) {
-    UniquePtr<Analyzer> analyzer = AnalyzerPool::instance().Get(analyzer_name);
+    PooledAnalyzer analyzer = AnalyzerPool::instance().Get(analyzer_name);
     if (analyzer.get() == nullptr) {
         RecoverableError(Status::UnexpectedError(fmt::format("Invalid analyzer: {}", analyzer_name)));
     }
@@ -356,6 +356,20 @@ bool PhysicalMatch::ExecuteInnerHomebrewed(QueryContext *query_context, Operator
     // 1.3 build filter
     SearchDriver driver(column2analyzer, default_field);
     driver.analyze_func_ = reinterpret_cast<void (*)()>(&AnalyzeFunc);
+    if (auto iter_slop_option = search_ops.options_.find("slop"); iter_slop_option != search_ops.options_.end()) {
+        int slop_option = std::stoi(iter_slop_option->second);
+        if (slop_option < 0) {
+            RecoverableError(Status::SyntaxError("slop must be a non-negative integer"));
+        }
+        driver.phrase_slop_ = slop_option;
+    }
+    if (auto iter_expansions_option = search_ops.options_.find("max_expansions"); iter_expansions_option != search_ops.options_.end()) {
+        int expansions_option = std::stoi(iter_expansions_option->second);
+        if (expansions_option <= 0) {
+            RecoverableError(Status::SyntaxError("max_expansions must be a positive integer"));
+        }
+        driver.max_expansions_ = expansions_option;
+    }
     UniquePtr<QueryNode> query_tree = driver.ParseSingleWithFields(match_expr_->fields_, match_expr_->matching_text_);
     if (!query_tree) {
         RecoverableError(Status::ParseMatchExprFailed(match_expr_->fields_, match_expr_->matching_text_));
@@ -606,6 +620,7 @@ bool PhysicalMatch::ExecuteInnerHomebrewed(QueryContext *query_context, Operator
         SizeT column_n = column_ids.size();
         u32 block_capacity = DEFAULT_BLOCK_CAPACITY;
         u32 output_block_row_id = 0;
+        TxnTimeStamp begin_ts = query_context->GetTxn()->BeginTS();
         DataBlock *output_block_ptr = output_data_blocks.back().get();
         for (u32 output_id = 0; output_id < result_count; ++output_id) {
             if (output_block_row_id == block_capacity) {
@@ -624,8 +639,11 @@ bool PhysicalMatch::ExecuteInnerHomebrewed(QueryContext *query_context, Operator
             SizeT column_id = 0;
             for (; column_id < column_n; ++column_id) {
                 BlockColumnEntry *block_column_ptr = block_entry->GetColumnBlockEntry(column_ids[column_id]);
-                ColumnVector column_vector = block_column_ptr->GetColumnVector(query_context->storage()->buffer_manager());
-                output_block_ptr->column_vectors[column_id]->AppendWith(column_vector, block_offset, 1);
+                block_column_ptr->AppendTo(query_context->storage()->buffer_manager(),
+                                           begin_ts,
+                                           block_offset,
+                                           1,
+                                           *output_block_ptr->column_vectors[column_id]);
             }
             Value v = Value::MakeFloat(score_result[output_id]);
             output_block_ptr->column_vectors[column_id++]->AppendValue(v);
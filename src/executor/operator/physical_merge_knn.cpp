@@ -107,6 +107,7 @@ void PhysicalMergeKnn::ExecuteInner(QueryContext *query_context, MergeKnnOperato
     if (merge_knn_state->input_complete_) {
         merge_knn->End(); // reorder the heap
         BufferManager *buffer_mgr = query_context->storage()->buffer_manager();
+        TxnTimeStamp begin_ts = query_context->GetTxn()->BeginTS();
 
         BlockIndex *block_index = merge_knn_data.table_ref_->block_index_.get();
 
@@ -139,8 +140,7 @@ void PhysicalMergeKnn::ExecuteInner(QueryContext *query_context, MergeKnnOperato
                 SizeT column_n = table_ref_->column_ids_.size();
                 for (SizeT i = 0; i < column_n; ++i) {
                     SizeT column_id = table_ref_->column_ids_[i];
-                    ColumnVector &&column_vector = block_entry->GetColumnBlockEntry(column_id)->GetColumnVector(buffer_mgr);
-                    output_data_block->column_vectors[i]->AppendWith(column_vector, block_offset, 1);
+                    block_entry->GetColumnBlockEntry(column_id)->AppendTo(buffer_mgr, begin_ts, block_offset, 1, *output_data_block->column_vectors[i]);
                 }
                 output_data_block->AppendValueByPtr(column_n, (ptr_t)&result_dists[top_idx]);
                 output_data_block->AppendValueByPtr(column_n + 1, (ptr_t)&result_row_ids[top_idx]);
@@ -57,6 +57,12 @@ import create_index_info;
 import segment_index_entry;
 import segment_iter;
 import segment_entry;
+import simd_init;
+import storage;
+import catalog;
+import mem_index_appender;
+import background_process;
+import compaction_process;
 
 namespace infinity {
 
@@ -779,6 +785,38 @@ void PhysicalShow::ExecuteShowIndex(QueryContext *query_context, ShowOperatorSta
         }
     }
 
+    {
+        SizeT column_id = 0;
+        {
+            Value value = Value::MakeVarchar("chunk_index_count");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[column_id]);
+        }
+
+        ++column_id;
+        {
+            Value value = Value::MakeVarchar(std::to_string(table_index_info->chunk_index_count_));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[column_id]);
+        }
+    }
+
+    {
+        SizeT column_id = 0;
+        {
+            Value value = Value::MakeVarchar("merge_debt_rows");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[column_id]);
+        }
+
+        ++column_id;
+        {
+            Value value = Value::MakeVarchar(std::to_string(table_index_info->merge_debt_rows_));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[column_id]);
+        }
+    }
+
     output_block_ptr->Finalize();
     show_operator_state->output_.emplace_back(std::move(output_block_ptr));
 }
@@ -2512,6 +2550,97 @@ void PhysicalShow::ExecuteShowGlobalStatus(QueryContext *query_context, ShowOper
         }
     }
 
+    {
+        {
+            // option name
+            Value value = Value::MakeVarchar("buffer prefetch");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+        }
+        {
+            // option value
+            BufferManager *buffer_manager = query_context->storage()->buffer_manager();
+            Value value =
+                Value::MakeVarchar(fmt::format("pending: {}, done: {}", buffer_manager->prefetch_pending(), buffer_manager->prefetch_count()));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+        }
+    }
+
+    {
+        {
+            // option name
+            Value value = Value::MakeVarchar("buffer eviction");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+        }
+        {
+            // option value
+            BufferManager *buffer_manager = query_context->storage()->buffer_manager();
+            Value value = Value::MakeVarchar(fmt::format("evicted: {}, written back: {}, waits: {}",
+                                                         buffer_manager->evict_count(),
+                                                         buffer_manager->write_back_count(),
+                                                         buffer_manager->space_wait_count()));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+        }
+    }
+
+    MemIndexAppender *mem_index_appender = query_context->storage()->catalog()->mem_index_appender();
+    {
+        {
+            // option name
+            Value value = Value::MakeVarchar("realtime index pending rows");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+        }
+        {
+            // option value
+            Value value = Value::MakeVarchar(std::to_string(mem_index_appender->pending_rows()));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+        }
+    }
+
+    {
+        {
+            // option name
+            Value value = Value::MakeVarchar("realtime index lag");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+        }
+        {
+            // option value
+            Value value = Value::MakeVarchar(fmt::format("{}ms", mem_index_appender->lag_ms()));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+        }
+    }
+
+    Vector<BGTaskLaneInfo> lane_infos = query_context->storage()->bg_processor()->GetLaneInfos();
+    if (CompactionProcessor *compaction_processor = query_context->storage()->compaction_processor(); compaction_processor != nullptr) {
+        lane_infos.push_back(compaction_processor->GetLaneInfo());
+    }
+    for (const auto &lane_info : lane_infos) {
+        {
+            // option name
+            Value value = Value::MakeVarchar(fmt::format("background {} lane", lane_info.name_));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+        }
+        {
+            // option value
+            Value value = Value::MakeVarchar(fmt::format("threads: {}, queued: {}, done: {}, busy: {}ms, io: {}",
+                                                         lane_info.thread_num_,
+                                                         lane_info.queue_size_,
+                                                         lane_info.task_count_,
+                                                         lane_info.busy_time_ms_,
+                                                         Utility::FormatByteSize(lane_info.io_bytes_)));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+        }
+    }
+
     output_block_ptr->Finalize();
     show_operator_state->output_.emplace_back(std::move(output_block_ptr));
 }
@@ -2629,6 +2758,12 @@ void PhysicalShow::ExecuteShowVar(QueryContext *query_context, ShowOperatorState
             value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
             break;
         }
+        case SysVar::kSIMDLevel: {
+            Value value = Value::MakeVarchar(SIMDLevelToString(GetSupportedSIMDLevel()));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+            break;
+        }
         case SysVar::kLogFlushPolicy: {
             switch (query_context->global_config()->flush_at_commit()) {
                 case FlushOption::kFlushAtOnce: {
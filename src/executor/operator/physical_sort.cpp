@@ -37,6 +37,7 @@ import infinity_exception;
 import third_party;
 import status;
 import physical_top;
+import query_memory_tracker;
 
 namespace infinity {
 
@@ -170,6 +171,8 @@ bool PhysicalSort::Execute(QueryContext *, OperatorState *operator_state) {
     Vector<BlockRawIndex> block_indexes;
     auto pre_op_state = operator_state->prev_op_state_;
 
+    MemoryReservation index_reservation(QueryMemoryTracker::Current());
+    index_reservation.Resize(pre_op_state->data_block_array_.size() * DEFAULT_BLOCK_CAPACITY * sizeof(BlockRawIndex));
     block_indexes.reserve(pre_op_state->data_block_array_.size() * DEFAULT_BLOCK_CAPACITY);
     // filling block_indexes
     for (u32 block_id = 0; block_id < pre_op_state->data_block_array_.size(); block_id++) {
@@ -199,6 +202,8 @@ bool PhysicalSort::Execute(QueryContext *, OperatorState *operator_state) {
 
     merge_comparator.Init();
     indexes_group.reserve(unmerge_sorted_blocks.size());
+    // the indexes of all rows and the merged copy of them
+    index_reservation.Resize(2 * unmerge_sorted_blocks.size() * DEFAULT_BLOCK_CAPACITY * sizeof(BlockRawIndex));
 
     for (u32 block_id = 0; block_id < unmerge_sorted_blocks.size(); ++block_id) {
         Vector<BlockRawIndex> indexes;
@@ -42,6 +42,9 @@ import infinity_exception;
 import logical_type;
 
 import block_entry;
+import block_statistics_aggregate;
+import block_column_entry;
+import buffer_manager;
 
 namespace infinity {
 
@@ -139,16 +142,9 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
     }
 
     TxnTimeStamp begin_ts = query_context->GetTxn()->BeginTS();
+    BufferManager *buffer_mgr = query_context->storage()->buffer_manager();
     SizeT &read_offset = table_scan_function_data_ptr->current_read_offset_;
 
-    {
-        String out;
-        for (auto &global_block_id : *block_ids) {
-            out += fmt::format("({},{}) ", global_block_id.segment_id_, global_block_id.block_id_);
-        }
-        LOG_TRACE(fmt::format("TableScan: block_ids: {}", out));
-    }
-
     // Here we assume output is a fresh data block, we have never written anything into it.
     auto write_capacity = output_ptr->available_capacity();
     while (block_ids_idx < block_ids->size()) {
@@ -157,6 +153,15 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
 
         BlockEntry *current_block_entry = block_index->GetBlockEntry(segment_id, block_id);
         if (read_offset == 0) {
+            // new block, answer the aggregates above from its statistics
+            if (BlockStatisticsAggregator *aggregator = table_scan_operator_state->block_statistics_aggregator_.get();
+                aggregator != nullptr && aggregator->Accumulate(current_block_entry, begin_ts)) {
+                LOG_TRACE(fmt::format("TableScan: block_ids_idx: {}, block_ids.size(): {}, answered by block statistics",
+                                      block_ids_idx,
+                                      block_ids->size()));
+                ++block_ids_idx;
+                continue;
+            }
             // new block, check FastRoughFilter
             const auto &fast_rough_filter = *current_block_entry->GetFastRoughFilter();
             if (fast_rough_filter_evaluator_ and !fast_rough_filter_evaluator_->Evaluate(begin_ts, fast_rough_filter)) {
@@ -171,6 +176,21 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
                                       block_ids_idx,
                                       block_ids->size()));
             }
+            // new block, read the next blocks ahead while this one is scanned
+            u64 &read_ahead_idx = table_scan_function_data_ptr->read_ahead_block_ids_idx_;
+            u64 read_ahead_end = std::min(u64(block_ids->size()), block_ids_idx + 1 + DEFAULT_READ_AHEAD_BLOCK_NUM);
+            for (read_ahead_idx = std::max(read_ahead_idx, block_ids_idx + 1); read_ahead_idx < read_ahead_end; ++read_ahead_idx) {
+                const GlobalBlockID &read_ahead_block_id = block_ids->at(read_ahead_idx);
+                BlockEntry *read_ahead_block_entry = block_index->GetBlockEntry(read_ahead_block_id.segment_id_, read_ahead_block_id.block_id_);
+                if (fast_rough_filter_evaluator_ and !fast_rough_filter_evaluator_->Evaluate(begin_ts, *read_ahead_block_entry->GetFastRoughFilter())) {
+                    continue;
+                }
+                for (auto column_id : column_ids) {
+                    if (column_id != COLUMN_IDENTIFIER_ROW_ID) {
+                        read_ahead_block_entry->GetColumnBlockEntry(column_id)->Prefetch(buffer_mgr);
+                    }
+                }
+            }
         }
         auto [row_begin, row_end] = current_block_entry->GetVisibleRange(begin_ts, read_offset);
         if (row_begin == row_end) {
@@ -186,20 +206,28 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
         auto write_size = std::min(write_capacity, SizeT(row_end - row_begin));
 
         read_offset = row_begin;
+        // The visible range starts at the head of the block and the output is empty:
+        // hand out the block memory instead of copying it. Nothing can be appended after it.
+        bool zero_copy = read_offset == 0 && write_capacity == output_ptr->capacity();
         SizeT output_column_id{0};
         for (auto column_id : column_ids) {
             if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
                 u32 segment_offset = block_id * DEFAULT_BLOCK_CAPACITY + read_offset;
                 output_ptr->column_vectors[output_column_id++]->AppendWith(RowID(segment_id, segment_offset), write_size);
+            } else if (zero_copy) {
+                ColumnVector column_vector = current_block_entry->GetColumnBlockEntry(column_id)->GetColumnVector(buffer_mgr, write_size, begin_ts);
+                output_ptr->column_vectors[output_column_id++] = MakeShared<ColumnVector>(std::move(column_vector));
             } else {
-                ColumnVector column_vector =
-                    current_block_entry->GetColumnBlockEntry(column_id)->GetColumnVector(query_context->storage()->buffer_manager());
-                output_ptr->column_vectors[output_column_id++]->AppendWith(column_vector, read_offset, write_size);
+                current_block_entry->GetColumnBlockEntry(column_id)->AppendTo(buffer_mgr,
+                                                                              begin_ts,
+                                                                              read_offset,
+                                                                              write_size,
+                                                                              *output_ptr->column_vectors[output_column_id++]);
             }
         }
 
         // write_size = already read size = already write size
-        write_capacity -= write_size;
+        write_capacity = zero_copy ? 0 : write_capacity - write_size;
         read_offset += write_size;
     }
 
@@ -31,6 +31,7 @@ import load_meta;
 import internal_types;
 import data_type;
 import fast_rough_filter;
+import block_statistics_aggregate;
 
 namespace infinity {
 
@@ -40,9 +41,11 @@ public:
                                SharedPtr<BaseTableRef> base_table_ref,
                                UniquePtr<FastRoughFilterEvaluator> &&fast_rough_filter_evaluator,
                                SharedPtr<Vector<LoadMeta>> load_metas,
-                               bool add_row_id = false)
+                               bool add_row_id = false,
+                               SharedPtr<Vector<StatisticsAggregate>> statistics_aggregates = nullptr)
         : PhysicalOperator(PhysicalOperatorType::kTableScan, nullptr, nullptr, id, load_metas), base_table_ref_(std::move(base_table_ref)),
-          fast_rough_filter_evaluator_(std::move(fast_rough_filter_evaluator)), add_row_id_(add_row_id) {}
+          fast_rough_filter_evaluator_(std::move(fast_rough_filter_evaluator)), statistics_aggregates_(std::move(statistics_aggregates)),
+          add_row_id_(add_row_id) {}
 
     ~PhysicalTableScan() override = default;
 
@@ -70,6 +73,8 @@ public:
 
     Vector<SizeT> &ColumnIDs() const;
 
+    const SharedPtr<Vector<StatisticsAggregate>> &statistics_aggregates() const { return statistics_aggregates_; }
+
     bool ParallelExchange() const override { return true; }
 
     bool IsExchange() const override { return true; }
@@ -86,6 +91,8 @@ private:
 
     UniquePtr<FastRoughFilterEvaluator> fast_rough_filter_evaluator_{};
 
+    SharedPtr<Vector<StatisticsAggregate>> statistics_aggregates_{};
+
     bool add_row_id_;
     mutable Vector<SizeT> column_ids_;
 };
@@ -35,9 +35,43 @@ import expression_type;
 import base_expression;
 import logical_type;
 import internal_types;
+import txn;
+import table_entry;
+import table_index_meta;
+import table_index_entry;
+import column_def;
+import column_delta_store;
+import index_base;
 
 namespace infinity {
 
+// The updated columns are written to the delta store of the blocks instead of deleting and re-appending the rows,
+// if all of them are fixed width and no index has to be rebuilt for them.
+bool CanUpdateInPlace(TableEntry *table_entry, Txn *txn, const Vector<Pair<SizeT, SharedPtr<BaseExpression>>> &update_columns) {
+    const auto &column_defs = table_entry->column_defs();
+    for (const auto &[column_idx, expr] : update_columns) {
+        if (!ColumnDeltaStore::Supported(*column_defs[column_idx]->type())) {
+            return false;
+        }
+    }
+    auto map_guard = table_entry->IndexMetaMap();
+    for (auto &[index_name, table_index_meta] : *map_guard) {
+        auto [table_index_entry, status] = table_index_meta->GetEntryNolock(txn->TxnID(), txn->BeginTS());
+        if (!status.ok()) {
+            continue;
+        }
+        for (const String &column_name : table_index_entry->index_base()->column_names_) {
+            SizeT column_id = table_entry->GetColumnIdByName(column_name);
+            for (const auto &[column_idx, expr] : update_columns) {
+                if (column_idx == column_id) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 void PhysicalUpdate::Init() {}
 
 bool PhysicalUpdate::Execute(QueryContext *query_context, OperatorState *operator_state) {
@@ -62,6 +96,11 @@ bool PhysicalUpdate::Execute(QueryContext *query_context, OperatorState *operato
             }
         }
         if (!row_ids.empty()) {
+            // the delta store keeps no null bits: a row is updated in place only if its old and new values are not null
+            bool has_null = false;
+            for (const auto &[column_idx, expr] : update_columns_) {
+                has_null = has_null || !column_vectors[column_idx]->nulls_ptr_->IsAllTrue();
+            }
             ExpressionEvaluator evaluator;
             evaluator.Init(input_data_block_ptr);
             for (SizeT expr_idx = 0; expr_idx < update_columns_.size(); ++expr_idx) {
@@ -72,12 +111,29 @@ bool PhysicalUpdate::Execute(QueryContext *query_context, OperatorState *operato
                 output_column->Initialize(expr_state->OutputColumnVector()->vector_type());
                 evaluator.Execute(expr, expr_state, output_column);
                 column_vectors[column_idx] = output_column;
+                has_null = has_null || !output_column->nulls_ptr_->IsAllTrue();
             }
 
-            SharedPtr<DataBlock> output_data_block = DataBlock::Make();
-            output_data_block->Init(column_vectors);
-            txn->Append(db_name, *table_name, output_data_block);
-            txn->Delete(db_name, *table_name, row_ids);
+            if (!has_null && CanUpdateInPlace(table_entry_ptr_, txn, update_columns_)) {
+                Vector<ColumnID> column_ids;
+                Vector<SharedPtr<ColumnVector>> update_vectors;
+                for (const auto &[column_idx, expr] : update_columns_) {
+                    // the expression may output a constant vector, the delta store needs one value per row
+                    SharedPtr<ColumnVector> update_vector = ColumnVector::Make(column_vectors[column_idx]->data_type());
+                    update_vector->Initialize(ColumnVectorType::kFlat, input_data_block_ptr->capacity());
+                    update_vector->AppendWith(*column_vectors[column_idx], 0, row_ids.size());
+                    column_ids.push_back(column_idx);
+                    update_vectors.push_back(std::move(update_vector));
+                }
+                SharedPtr<DataBlock> update_data_block = DataBlock::Make();
+                update_data_block->Init(update_vectors);
+                txn->Update(db_name, *table_name, row_ids, column_ids, update_data_block);
+            } else {
+                SharedPtr<DataBlock> output_data_block = DataBlock::Make();
+                output_data_block->Init(column_vectors);
+                txn->Append(db_name, *table_name, output_data_block);
+                txn->Delete(db_name, *table_name, row_ids);
+            }
 
             UpdateOperatorState* update_operator_state = static_cast<UpdateOperatorState*>(operator_state);
             ++ update_operator_state->count_;
@@ -22,6 +22,7 @@ import physical_operator_type;
 import fragment_data;
 import data_block;
 import table_scan_function_data;
+import block_statistics_aggregate;
 import knn_scan_data;
 import table_def;
 
@@ -99,6 +100,9 @@ export struct TableScanOperatorState : public OperatorState {
     inline explicit TableScanOperatorState() : OperatorState(PhysicalOperatorType::kTableScan) {}
 
     UniquePtr<TableScanFunctionData> table_scan_function_data_{};
+
+    // blocks answered from their statistics are not scanned, see AggregatePushDown
+    UniquePtr<BlockStatisticsAggregator> block_statistics_aggregator_{};
 };
 
 // KnnScan
@@ -23,6 +23,7 @@ import default_values;
 import operator_state;
 import column_vector;
 import query_context;
+import txn;
 
 import base_table_ref;
 import third_party;
@@ -49,6 +50,7 @@ void PhysicalOperator::InputLoad(QueryContext *query_context, OperatorState *ope
         UnrecoverableError("TableRef not found!");
     }
 
+    TxnTimeStamp begin_ts = query_context->GetTxn()->BeginTS();
     for (SizeT i = 0; i < operator_state->prev_op_state_->data_block_array_.size(); ++i) {
         auto input_block = operator_state->prev_op_state_->data_block_array_[i].get();
         SizeT load_column_count = load_metas_->size();
@@ -81,8 +83,11 @@ void PhysicalOperator::InputLoad(QueryContext *query_context, OperatorState *ope
                 auto binding = load_metas[k].binding_;
                 BlockColumnEntry *block_column_ptr = block_entry->GetColumnBlockEntry(binding.column_idx);
 
-                ColumnVector column_vector = block_column_ptr->GetColumnVector(query_context->storage()->buffer_manager());
-                input_block->column_vectors[load_metas[k].index_]->AppendWith(column_vector, block_offset, 1);
+                block_column_ptr->AppendTo(query_context->storage()->buffer_manager(),
+                                           begin_ts,
+                                           block_offset,
+                                           1,
+                                           *input_block->column_vectors[load_metas[k].index_]);
             }
         }
     }
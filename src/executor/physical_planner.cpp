@@ -796,7 +796,8 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildTableScan(const SharedPtr<Logi
                                          logical_table_scan->base_table_ref_,
                                          std::move(logical_table_scan->fast_rough_filter_evaluator_),
                                          logical_operator->load_metas(),
-                                         logical_table_scan->add_row_id_);
+                                         logical_table_scan->add_row_id_,
+                                         logical_table_scan->statistics_aggregates_);
 }
 
 UniquePtr<PhysicalOperator> PhysicalPlanner::BuildIndexScan(const SharedPtr<LogicalNode> &logical_operator) const {
@@ -875,6 +876,10 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildKnn(const SharedPtr<LogicalNod
                                                                          logical_knn_scan->knn_expression_,
                                                                          logical_knn_scan->filter_expression_,
                                                                          std::move(logical_knn_scan->fast_rough_filter_evaluator_),
+                                                                         logical_knn_scan->filter_leftover_,
+                                                                         logical_knn_scan->secondary_index_filter_qualified_,
+                                                                         std::move(logical_knn_scan->secondary_index_column_index_map_),
+                                                                         std::move(logical_knn_scan->filter_execute_command_),
                                                                          logical_knn_scan->GetOutputNames(),
                                                                          logical_knn_scan->GetOutputTypes(),
                                                                          logical_knn_scan->knn_table_index_,
@@ -71,6 +71,11 @@ public:
         value_ += (input[idx] * count);
     }
 
+    inline void UpdateBatch(const TinyIntT *__restrict input, SizeT count) {
+        this->count_ += count;
+        value_ += BatchSum<i64>(input, count);
+    }
+
     [[nodiscard]] inline ptr_t Finalize() {
         result_ = value_ / count_;
         return (ptr_t)&result_;
@@ -105,6 +110,11 @@ public:
         value_ += (input[idx] * count);
     }
 
+    inline void UpdateBatch(const SmallIntT *__restrict input, SizeT count) {
+        this->count_ += count;
+        value_ += BatchSum<i64>(input, count);
+    }
+
     inline ptr_t Finalize() {
         result_ = value_ / count_;
         return (ptr_t)&result_;
@@ -139,6 +149,11 @@ public:
         value_ += (input[idx] * count);
     }
 
+    inline void UpdateBatch(const IntegerT *__restrict input, SizeT count) {
+        this->count_ += count;
+        value_ += BatchSum<i64>(input, count);
+    }
+
     inline ptr_t Finalize() {
         result_ = value_ / count_;
         return (ptr_t)&result_;
@@ -173,6 +188,11 @@ public:
         value_ += (input[idx] * count);
     }
 
+    inline void UpdateBatch(const BigIntT *__restrict input, SizeT count) {
+        this->count_ += count;
+        value_ += BatchSum<DoubleT>(input, count);
+    }
+
     inline ptr_t Finalize() {
         result_ = value_ / count_;
         return (ptr_t)&result_;
@@ -207,6 +227,11 @@ public:
         value_ += (input[idx] * count);
     }
 
+    inline void UpdateBatch(const FloatT *__restrict input, SizeT count) {
+        this->count_ += count;
+        value_ += BatchSum<DoubleT>(input, count);
+    }
+
     inline ptr_t Finalize() {
         result_ = value_ / count_;
         return (ptr_t)&result_;
@@ -241,6 +266,11 @@ public:
         value_ += (input[idx] * count);
     }
 
+    inline void UpdateBatch(const DoubleT *__restrict input, SizeT count) {
+        this->count_ += count;
+        value_ += BatchSum<DoubleT>(input, count);
+    }
+
     inline ptr_t Finalize() {
         result_ = value_ / count_;
         return (ptr_t)&result_;
@@ -73,6 +73,8 @@ public:
 
     inline void ConstantUpdate(const TinyIntT *__restrict input, SizeT idx, SizeT) { value_ = value_ < input[idx] ? input[idx] : value_; }
 
+    inline void UpdateBatch(const TinyIntT *__restrict input, SizeT count) { value_ = BatchMax(input, count, value_); }
+
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(TinyIntT); }
@@ -89,6 +91,8 @@ public:
 
     inline void ConstantUpdate(const SmallIntT *__restrict input, SizeT idx, SizeT) { value_ = value_ < input[idx] ? input[idx] : value_; }
 
+    inline void UpdateBatch(const SmallIntT *__restrict input, SizeT count) { value_ = BatchMax(input, count, value_); }
+
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(SmallIntT); }
@@ -105,6 +109,8 @@ public:
 
     inline void ConstantUpdate(const IntegerT *__restrict input, SizeT idx, SizeT) { value_ = value_ < input[idx] ? input[idx] : value_; }
 
+    inline void UpdateBatch(const IntegerT *__restrict input, SizeT count) { value_ = BatchMax(input, count, value_); }
+
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(IntegerT); }
@@ -121,6 +127,8 @@ public:
 
     inline void ConstantUpdate(const BigIntT *__restrict input, SizeT idx, SizeT) { value_ = value_ < input[idx] ? input[idx] : value_; }
 
+    inline void UpdateBatch(const BigIntT *__restrict input, SizeT count) { value_ = BatchMax(input, count, value_); }
+
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(BigIntT); }
@@ -156,6 +164,8 @@ public:
 
     inline void ConstantUpdate(const FloatT *__restrict input, SizeT idx, SizeT) { value_ = value_ < input[idx] ? input[idx] : value_; }
 
+    inline void UpdateBatch(const FloatT *__restrict input, SizeT count) { value_ = BatchMax(input, count, value_); }
+
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(FloatT); }
@@ -172,6 +182,8 @@ public:
 
     inline void ConstantUpdate(const DoubleT *__restrict input, SizeT idx, SizeT) { value_ = value_ < input[idx] ? input[idx] : value_; }
 
+    inline void UpdateBatch(const DoubleT *__restrict input, SizeT count) { value_ = BatchMax(input, count, value_); }
+
     inline ptr_t Finalize() { return (ptr_t)&value_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
@@ -55,6 +55,8 @@ public:
 
     inline void ConstantUpdate(const TinyIntT *__restrict input, SizeT idx, SizeT count) { sum_ += input[idx] * count; }
 
+    inline void UpdateBatch(const TinyIntT *__restrict input, SizeT count) { sum_ += BatchSum<i64>(input, count); }
+
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
@@ -71,6 +73,8 @@ public:
 
     inline void ConstantUpdate(const SmallIntT *__restrict input, SizeT idx, SizeT count) { sum_ += input[idx] * count; }
 
+    inline void UpdateBatch(const SmallIntT *__restrict input, SizeT count) { sum_ += BatchSum<i64>(input, count); }
+
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
@@ -87,6 +91,8 @@ public:
 
     inline void ConstantUpdate(const IntegerT *__restrict input, SizeT idx, SizeT count) { sum_ += input[idx] * count; }
 
+    inline void UpdateBatch(const IntegerT *__restrict input, SizeT count) { sum_ += BatchSum<i64>(input, count); }
+
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
@@ -103,6 +109,8 @@ public:
 
     inline void ConstantUpdate(const BigIntT *__restrict input, SizeT idx, SizeT count) { sum_ += input[idx] * count; }
 
+    inline void UpdateBatch(const BigIntT *__restrict input, SizeT count) { sum_ += BatchSum<i64>(input, count); }
+
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(i64); }
@@ -119,6 +127,8 @@ public:
 
     inline void ConstantUpdate(const FloatT *__restrict input, SizeT idx, SizeT count) { sum_ += input[idx] * count; }
 
+    inline void UpdateBatch(const FloatT *__restrict input, SizeT count) { sum_ += BatchSum<DoubleT>(input, count); }
+
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
@@ -135,6 +145,8 @@ public:
 
     inline void ConstantUpdate(const DoubleT *__restrict input, SizeT idx, SizeT count) { sum_ += input[idx] * count; }
 
+    inline void UpdateBatch(const DoubleT *__restrict input, SizeT count) { sum_ += BatchSum<DoubleT>(input, count); }
+
     inline ptr_t Finalize() { return (ptr_t)&sum_; }
 
     inline static SizeT Size(const DataType &) { return sizeof(DoubleT); }
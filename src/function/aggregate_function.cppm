@@ -23,6 +23,7 @@ import function;
 import function_data;
 import column_vector;
 import vector_buffer;
+import bitmask;
 import infinity_exception;
 import base_expression;
 import data_type;
@@ -35,6 +36,73 @@ using AggregateInitializeFuncType = std::function<void(ptr_t)>;
 using AggregateUpdateFuncType = std::function<void(ptr_t, const SharedPtr<ColumnVector> &)>;
 using AggregateFinalizeFuncType = std::function<ptr_t(ptr_t)>;
 
+// Reductions of a whole batch. The rows are spread over AGGREGATE_LANES independent accumulators so the compiler can vectorize the loop
+// with the SSE4.2 of the default build (wider with ENABLE_NATIVE_ARCH), floating point included since nothing has to be reordered.
+constexpr SizeT AGGREGATE_LANES = 8;
+
+export template <typename AccType, typename InputType>
+inline AccType BatchSum(const InputType *__restrict input, SizeT count) {
+    AccType lanes[AGGREGATE_LANES]{};
+    SizeT idx = 0;
+    for (; idx + AGGREGATE_LANES <= count; idx += AGGREGATE_LANES) {
+        for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+            lanes[lane] += input[idx + lane];
+        }
+    }
+    AccType sum{};
+    for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+        sum += lanes[lane];
+    }
+    for (; idx < count; ++idx) {
+        sum += input[idx];
+    }
+    return sum;
+}
+
+export template <typename InputType>
+inline InputType BatchMin(const InputType *__restrict input, SizeT count, InputType init) {
+    InputType lanes[AGGREGATE_LANES];
+    for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+        lanes[lane] = init;
+    }
+    SizeT idx = 0;
+    for (; idx + AGGREGATE_LANES <= count; idx += AGGREGATE_LANES) {
+        for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+            lanes[lane] = input[idx + lane] < lanes[lane] ? input[idx + lane] : lanes[lane];
+        }
+    }
+    InputType result = init;
+    for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+        result = lanes[lane] < result ? lanes[lane] : result;
+    }
+    for (; idx < count; ++idx) {
+        result = input[idx] < result ? input[idx] : result;
+    }
+    return result;
+}
+
+export template <typename InputType>
+inline InputType BatchMax(const InputType *__restrict input, SizeT count, InputType init) {
+    InputType lanes[AGGREGATE_LANES];
+    for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+        lanes[lane] = init;
+    }
+    SizeT idx = 0;
+    for (; idx + AGGREGATE_LANES <= count; idx += AGGREGATE_LANES) {
+        for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+            lanes[lane] = lanes[lane] < input[idx + lane] ? input[idx + lane] : lanes[lane];
+        }
+    }
+    InputType result = init;
+    for (SizeT lane = 0; lane < AGGREGATE_LANES; ++lane) {
+        result = result < lanes[lane] ? lanes[lane] : result;
+    }
+    for (; idx < count; ++idx) {
+        result = result < input[idx] ? input[idx] : result;
+    }
+    return result;
+}
+
 class AggregateOperation {
 public:
     template <typename AggregateState>
@@ -44,7 +112,7 @@ public:
 
     template <typename AggregateState, typename InputType>
     static inline void StateUpdate(const ptr_t state, const SharedPtr<ColumnVector> &input_column_vector) {
-        // Loop execute state update according to the input column vector
+        // Loop execute state update according to the input column vector, null rows are skipped.
 
         switch (input_column_vector->vector_type()) {
             case ColumnVectorType::kCompactBit: {
@@ -55,7 +123,12 @@ public:
                     SizeT row_count = input_column_vector->Size();
                     BooleanT value;
                     const VectorBuffer *buffer = input_column_vector->buffer_.get();
+                    const Bitmask *nulls = input_column_vector->nulls_ptr_.get();
+                    bool all_valid = nulls == nullptr || nulls->IsAllTrue();
                     for (SizeT idx = 0; idx < row_count; ++idx) {
+                        if (!all_valid && !nulls->IsTrue(idx)) {
+                            continue;
+                        }
                         value = buffer->GetCompactBit(idx);
                         ((AggregateState *)state)->Update(&value, 0);
                     }
@@ -63,14 +136,31 @@ public:
                 break;
             }
             case ColumnVectorType::kFlat: {
-                SizeT row_count = input_column_vector->Size();
                 auto *input_ptr = (InputType *)(input_column_vector->data());
-                for (SizeT idx = 0; idx < row_count; ++idx) {
-                    ((AggregateState *)state)->Update(input_ptr, idx);
+                const Bitmask *nulls = input_column_vector->nulls_ptr_.get();
+                bool all_valid = nulls == nullptr || nulls->IsAllTrue();
+                SizeT row_count = input_column_vector->Size();
+                if (!all_valid) {
+                    for (SizeT idx = 0; idx < row_count; ++idx) {
+                        if (nulls->IsTrue(idx)) {
+                            ((AggregateState *)state)->Update(input_ptr, idx);
+                        }
+                    }
+                    break;
+                }
+                if constexpr (requires(AggregateState *s, const InputType *input, SizeT count) { s->UpdateBatch(input, count); }) {
+                    ((AggregateState *)state)->UpdateBatch(input_ptr, row_count);
+                } else {
+                    for (SizeT idx = 0; idx < row_count; ++idx) {
+                        ((AggregateState *)state)->Update(input_ptr, idx);
+                    }
                 }
                 break;
             }
             case ColumnVectorType::kConstant: {
+                if (input_column_vector->nulls_ptr_.get() != nullptr && !input_column_vector->nulls_ptr_->IsTrue(0)) {
+                    break;
+                }
                 if (input_column_vector->data_type()->type() == LogicalType::kBoolean) {
                     if constexpr (!std::is_same_v<InputType, BooleanT>) {
                         UnrecoverableError("types do not match");
@@ -45,6 +45,19 @@ private:
     const SegmentOffset max_segment_offset_;
 };
 
+// Only the rows before `end_offset`, e.g. the rows of a memory index already inserted when the search starts.
+export template <typename Filter>
+class PrefixFilter final : public FilterBase<SegmentOffset> {
+public:
+    PrefixFilter(const Filter &filter, SegmentOffset end_offset) : filter_(filter), end_offset_(end_offset) {}
+
+    bool operator()(const SegmentOffset &segment_offset) const final { return segment_offset < end_offset_ && filter_(segment_offset); }
+
+private:
+    const Filter &filter_;
+    const SegmentOffset end_offset_;
+};
+
 export class DeleteFilter final : public FilterBase<SegmentOffset> {
 public:
     explicit DeleteFilter(const SegmentEntry *segment, TxnTimeStamp query_ts) : segment_(segment), query_ts_(query_ts) {}
@@ -102,8 +102,7 @@ void KnnScanFunctionData::Init() {
 
     if (knn_scan_shared_data_->filter_expression_) {
         filter_state_ = ExpressionState::CreateState(knn_scan_shared_data_->filter_expression_);
-        db_for_filter_ = MakeUnique<DataBlock>();
-        db_for_filter_->Init(*(knn_scan_shared_data_->table_ref_->column_types_));                // default capacity
+        db_for_filter_ = MakeUnique<DataBlock>(); // initialized with the block columns when reading each block
         bool_column_ = ColumnVector::Make(MakeShared<infinity::DataType>(LogicalType::kBoolean)); // default capacity
     }
 }
@@ -71,6 +71,8 @@ public:
 
     atomic_u64 current_block_idx_{0};
     atomic_u64 current_index_idx_{0};
+    // the block columns before it have been read ahead
+    atomic_u64 read_ahead_block_idx_{0};
 };
 
 //-------------------------------------------------------------------
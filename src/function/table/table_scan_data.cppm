@@ -35,6 +35,8 @@ public:
 
     u64 current_block_ids_idx_{0};
     SizeT current_read_offset_{0};
+    // the blocks before it have been read ahead
+    u64 read_ahead_block_ids_idx_{0};
 };
 
 } // namespace infinity
@@ -162,6 +162,12 @@ Status Config::Init(const SharedPtr<String> &config_path) {
     u64 default_cleanup_interval_sec = DEFAULT_CLEANUP_INTERVAL_SEC;
     u64 default_compact_interval_sec = DEFAULT_COMPACT_INTERVAL_SEC;
     u64 default_optimize_interval_sec = DEFAULT_OPTIMIZE_INTERVAL_SEC;
+    u64 default_index_build_thread_num = default_total_cpu_number;
+    u64 default_background_index_build_thread_num = 1;
+    u64 default_background_io_rate_limit = 0; // unlimited
+    i64 default_background_checkpoint_nice = 0;
+    i64 default_background_index_build_nice = 10;
+    i64 default_background_cleanup_nice = 10;
 
     // Default buffer config
     u64 default_buffer_pool_size = 4 * 1024lu * 1024lu * 1024lu; // 4Gib
@@ -241,6 +247,12 @@ Status Config::Init(const SharedPtr<String> &config_path) {
             system_option_.cleanup_interval_ = std::chrono::seconds(default_cleanup_interval_sec);
             system_option_.compact_interval_ = std::chrono::seconds(default_compact_interval_sec);
             system_option_.optimize_interval_ = std::chrono::seconds(default_optimize_interval_sec);
+            system_option_.index_build_thread_num_ = default_index_build_thread_num;
+            system_option_.background_index_build_thread_num_ = default_background_index_build_thread_num;
+            system_option_.background_io_rate_limit_ = default_background_io_rate_limit;
+            system_option_.background_checkpoint_nice_ = default_background_checkpoint_nice;
+            system_option_.background_index_build_nice_ = default_background_index_build_nice;
+            system_option_.background_cleanup_nice_ = default_background_cleanup_nice;
         }
 
         // Buffer
@@ -427,6 +439,28 @@ Status Config::Init(const SharedPtr<String> &config_path) {
             system_option_.cleanup_interval_ = std::chrono::seconds(storage_config["cleanup_interval"].value_or(default_cleanup_interval_sec));
             system_option_.compact_interval_ = std::chrono::seconds(storage_config["compact_interval"].value_or(default_compact_interval_sec));
             system_option_.optimize_interval_ = std::chrono::seconds(storage_config["optimize_interval"].value_or(default_optimize_interval_sec));
+            system_option_.index_build_thread_num_ = storage_config["index_build_thread_num"].value_or(default_index_build_thread_num);
+            if (system_option_.index_build_thread_num_ == 0) {
+                system_option_.index_build_thread_num_ = default_index_build_thread_num;
+            }
+            system_option_.background_index_build_thread_num_ =
+                storage_config["background_index_build_thread_num"].value_or(default_background_index_build_thread_num);
+            if (system_option_.background_index_build_thread_num_ == 0) {
+                system_option_.background_index_build_thread_num_ = default_background_index_build_thread_num;
+            }
+            String background_io_rate_limit_str = storage_config["background_io_rate_limit"].value_or("0");
+            if (background_io_rate_limit_str == "0") {
+                system_option_.background_io_rate_limit_ = default_background_io_rate_limit;
+            } else {
+                Status io_rate_status = ParseByteSize(background_io_rate_limit_str, system_option_.background_io_rate_limit_);
+                if (!io_rate_status.ok()) {
+                    return io_rate_status;
+                }
+            }
+            system_option_.background_checkpoint_nice_ = storage_config["background_checkpoint_nice"].value_or(default_background_checkpoint_nice);
+            system_option_.background_index_build_nice_ =
+                storage_config["background_index_build_nice"].value_or(default_background_index_build_nice);
+            system_option_.background_cleanup_nice_ = storage_config["background_cleanup_nice"].value_or(default_background_cleanup_nice);
         }
 
         // Buffer
@@ -517,6 +551,12 @@ void Config::PrintAll() const {
     fmt::print(" - cleanup_interval_sec: {}\n", system_option_.cleanup_interval_.count());
     fmt::print(" - compact_interval_sec: {}\n", system_option_.compact_interval_.count());
     fmt::print(" - optimize_interval_sec: {}\n", system_option_.optimize_interval_.count());
+    fmt::print(" - index_build_thread_num: {}\n", system_option_.index_build_thread_num_);
+    fmt::print(" - background_index_build_thread_num: {}\n", system_option_.background_index_build_thread_num_);
+    fmt::print(" - background_io_rate_limit: {}/s\n", Utility::FormatByteSize(system_option_.background_io_rate_limit_));
+    fmt::print(" - background_checkpoint_nice: {}\n", system_option_.background_checkpoint_nice_);
+    fmt::print(" - background_index_build_nice: {}\n", system_option_.background_index_build_nice_);
+    fmt::print(" - background_cleanup_nice: {}\n", system_option_.background_cleanup_nice_);
 
     // Buffer
     fmt::print(" - buffer_pool_size: {}\n", Utility::FormatByteSize(system_option_.buffer_pool_size));
@@ -566,6 +606,7 @@ void SystemVariables::InitVariablesMap() {
     map_["http_api_port"] = SysVar::kHttpAPIPort;
     map_["data_url"] = SysVar::kDataURL;
     map_["time_zone"] = SysVar::kTimezone;
+    map_["simd_level"] = SysVar::kSIMDLevel;
     map_["flush_at_commit"] = SysVar::kLogFlushPolicy;
 }
 
@@ -98,6 +98,18 @@ public:
 
     [[nodiscard]] inline std::chrono::seconds optimize_interval() const { return system_option_.optimize_interval_; }
 
+    [[nodiscard]] inline u64 index_build_thread_num() const { return system_option_.index_build_thread_num_; }
+
+    [[nodiscard]] inline u64 background_index_build_thread_num() const { return system_option_.background_index_build_thread_num_; }
+
+    [[nodiscard]] inline u64 background_io_rate_limit() const { return system_option_.background_io_rate_limit_; }
+
+    [[nodiscard]] inline i64 background_checkpoint_nice() const { return system_option_.background_checkpoint_nice_; }
+
+    [[nodiscard]] inline i64 background_index_build_nice() const { return system_option_.background_index_build_nice_; }
+
+    [[nodiscard]] inline i64 background_cleanup_nice() const { return system_option_.background_cleanup_nice_; }
+
     // Buffer
     [[nodiscard]] inline u64 buffer_pool_size() const { return system_option_.buffer_pool_size; }
 
@@ -150,6 +162,7 @@ export enum class SysVar {
     kHttpAPIPort,
     kDataURL,
     kTimezone,
+    kSIMDLevel,
     kLogFlushPolicy,
     kInvalid,
 };
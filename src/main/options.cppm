@@ -78,6 +78,12 @@ export struct SystemOptions {
     std::chrono::seconds cleanup_interval_{};
     std::chrono::seconds compact_interval_{};
     std::chrono::seconds optimize_interval_{};
+    u64 index_build_thread_num_{}; // threads to build an index of a whole segment, e.g. when compacting
+    u64 background_index_build_thread_num_{}; // threads of the index build lane of the background processor
+    u64 background_io_rate_limit_{};          // bytes per second read and written by each background lane but the checkpoint one, 0 means unlimited
+    i64 background_checkpoint_nice_{};        // nice values of the threads of the background lanes
+    i64 background_index_build_nice_{};
+    i64 background_cleanup_nice_{};
 
     // Buffer
     u64 buffer_pool_size{};
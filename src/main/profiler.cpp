@@ -259,6 +259,7 @@ String QueryProfiler::ToString() const {
             ExecuteRender(ss);
         }
     }
+    ss << "Peak memory: " << peak_memory_ << "B" << std::endl;
     return ss.str();
 }
 
@@ -322,6 +323,7 @@ nlohmann::json QueryProfiler::Serialize(const QueryProfiler *profiler) {
     }
     json["total"] = end - start;
     json["time_unit"] = "ns";
+    json["peak_memory"] = profiler->peak_memory_;
 
     return json;
 }
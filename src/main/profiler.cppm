@@ -199,6 +199,10 @@ public:
 
     OptimizerProfiler &optimizer() { return optimizer_; }
 
+    void set_peak_memory(u64 peak_memory) { peak_memory_ = peak_memory; }
+
+    u64 peak_memory() const { return peak_memory_; }
+
     [[nodiscard]] String ToString() const;
 
     static String QueryPhaseToString(QueryPhase phase);
@@ -213,6 +217,7 @@ private:
     Vector<BaseProfiler> profilers_{static_cast<magic_enum::underlying_type_t<QueryPhase>>(QueryPhase::kInvalid)};
     OptimizerProfiler optimizer_;
     QueryPhase current_phase_{QueryPhase::kInvalid};
+    u64 peak_memory_{0}; // peak memory charged to the query in bytes
 
     void ExecuteRender(std::stringstream &ss) const;
 };
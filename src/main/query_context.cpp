@@ -50,6 +50,7 @@ import session_manager;
 import base_statement;
 import parser_result;
 import parser_assert;
+import query_memory_tracker;
 
 namespace infinity {
 
@@ -106,6 +107,9 @@ QueryResult QueryContext::Query(const String &query) {
 
 QueryResult QueryContext::QueryStatement(const BaseStatement *statement) {
     QueryResult query_result;
+    memory_tracker_ = MakeShared<QueryMemoryTracker>(global_config_->query_memory_limit());
+    // Operator states are built on this thread, the tasks make the tracker current on the worker threads.
+    QueryMemoryTracker::ScopedCurrent memory_tracker_guard(memory_tracker_);
 //    ProfilerStart("Query");
 //    BaseProfiler profiler;
 //    profiler.Begin();
@@ -157,6 +161,9 @@ QueryResult QueryContext::QueryStatement(const BaseStatement *statement) {
         query_result.result_table_ = plan_fragment->GetResult();
         query_result.root_operator_type_ = logical_plan->operator_type();
         StopProfile(QueryPhase::kExecution);
+        if (query_profiler_) {
+            query_profiler_->set_peak_memory(memory_tracker_->peak());
+        }
 //        LOG_WARN(fmt::format("Before commit cost: {}", profiler.ElapsedToString()));
         StartProfile(QueryPhase::kCommit);
         this->CommitTxn();
@@ -29,6 +29,7 @@ import optimizer;
 import status;
 import query_result;
 import base_statement;
+import query_memory_tracker;
 
 export module query_context;
 
@@ -75,6 +76,9 @@ public:
 
     [[nodiscard]] inline u64 memory_size_limit() const { return memory_size_limit_; }
 
+    // Memory of the statement being executed, bounded by query_memory_limit.
+    [[nodiscard]] inline const SharedPtr<QueryMemoryTracker> &memory_tracker() const { return memory_tracker_; }
+
     [[nodiscard]] inline u64 query_id() const { return query_id_; }
 
     [[nodiscard]] inline u64 max_node_id() const { return current_max_node_id_; }
@@ -157,6 +161,8 @@ private:
 
     SharedPtr<QueryProfiler> query_profiler_{};
 
+    SharedPtr<QueryMemoryTracker> memory_tracker_{};
+
     Config *global_config_{};
     TaskScheduler *scheduler_{};
     Storage *storage_{};
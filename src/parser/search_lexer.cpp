@@ -393,8 +393,9 @@ int yyFlexLexer::yylex()
 /* %% [3.0] code to copy yytext_ptr to yytext[] goes here, if %array \ */\
 	(yy_c_buf_p) = yy_cp;
 /* %% [4.0] data tables for the DFA and the user's section 1 definitions go here */
-#define YY_NUM_RULES 26
-#define YY_END_OF_BUFFER 27
+#define YY_NUM_RULES 28
+#define YY_END_OF_BUFFER 29
+
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -402,14 +403,15 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static const flex_int16_t yy_accept[56] =
+
+static const flex_int16_t yy_accept[61] =
     {   0,
-        0,    0,   20,   20,   24,   24,   27,   26,    1,    8,
-       22,   26,   18,   10,   11,    4,    9,   26,   15,   12,
-       17,   17,   17,   17,   26,   26,   20,   21,   24,   25,
-        1,    3,    0,   15,   16,   15,   15,   17,   17,   17,
-        5,    0,   13,    6,   20,   19,   24,   23,   15,    2,
-        7,   14,   13,   13,    0
+        0,    0,   22,   22,   26,   26,   29,   28,    1,    8,
+       24,   28,   20,   10,   11,   18,    4,    9,   28,   15,
+       12,   17,   17,   17,   17,   28,   28,   19,   22,   23,
+       26,   27,    1,    3,   18,    0,   15,   16,   18,   15,
+       15,   17,   17,   17,    5,    0,   13,    6,   19,   22,
+       21,   26,   25,   15,    2,    7,   14,   13,   13,    0
     } ;
 
 static const YY_CHAR yy_ec[256] =
@@ -418,16 +420,16 @@ static const YY_CHAR yy_ec[256] =
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    2,    3,    4,    1,    1,    1,    5,    6,    7,
-        8,    1,    9,    1,   10,   11,    1,   12,   12,   12,
-       12,   12,   12,   12,   12,   12,   12,   13,    1,    1,
-        1,    1,    1,    1,   14,   15,   15,   16,   15,   15,
-       15,   15,   15,   15,   15,   15,   15,   17,   18,   15,
-       15,   19,   15,   20,   15,   15,   15,   15,   15,   15,
-        1,    1,    1,   21,   15,    1,   15,   15,   15,   15,
-
-       15,   15,   15,   15,   15,   15,   15,   15,   15,   15,
-       15,   15,   15,   15,   15,   15,   15,   15,   15,   15,
-       15,   15,    1,   22,    1,    1,    1,    1,    1,    1,
+        8,    9,   10,    1,   11,   12,    1,   13,   13,   13,
+       13,   13,   13,   13,   13,   13,   13,   14,    1,    1,
+        1,    1,    9,    1,   15,   16,   16,   17,   16,   16,
+       16,   16,   16,   16,   16,   16,   16,   18,   19,   16,
+       16,   20,   16,   21,   16,   16,   16,   16,   16,   16,
+        1,    1,    1,   22,   16,    1,   16,   16,   16,   16,
+
+       16,   16,   16,   16,   16,   16,   16,   16,   16,   16,
+       16,   16,   16,   16,   16,   16,   16,   16,   16,   16,
+       16,   16,    1,   23,    1,   24,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -444,70 +446,130 @@ static const YY_CHAR yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static const YY_CHAR yy_meta[23] =
+static const YY_CHAR yy_meta[25] =
     {   0,
-        1,    1,    1,    2,    1,    3,    1,    1,    1,    1,
-        4,    4,    1,    4,    4,    4,    4,    4,    4,    4,
-        1,    1
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1
     } ;
 
 static const flex_int16_t yy_base[61] =
     {   0,
-        0,    0,   78,   77,   78,   77,   80,   85,   77,   85,
-       85,   73,   85,   85,   85,   85,   12,   65,   14,   85,
-       16,   65,   17,   18,   19,   53,    0,   68,    0,   69,
-       70,   85,   59,   27,   58,   57,   29,   57,   31,   23,
-       56,   54,   33,   85,    0,   85,    0,   85,   53,   53,
-       50,   46,   34,   24,   85,   47,   51,   28,   55,   59
+        0,    0,   24,   24,   48,   48,    0,    0,   71,    0,
+        0,   69,    0,    0,    0,   66,    0,   64,   65,   79,
+        0,   92,  105,  118,  131,   77,   57,   80,  152,   96,
+      176,   99,  102,    0,  192,   93,  103,  104,  205,  106,
+      218,  231,  244,  257,  270,  115,  117,    0,  119,  291,
+        0,  315,    0,  128,  331,  344,  129,  130,  132,  366
     } ;
 
 static const flex_int16_t yy_def[61] =
     {   0,
-       55,    1,   56,   56,   57,   57,   55,   55,   55,   55,
-       55,   55,   55,   55,   55,   55,   55,   55,   58,   55,
-       58,   58,   58,   58,   55,   55,   59,   55,   60,   55,
-       55,   55,   55,   55,   55,   55,   58,   58,   58,   58,
-       58,   55,   55,   55,   59,   55,   60,   55,   55,   58,
-       58,   55,   55,   55,    0,   55,   55,   55,   55,   55
+       60,    1,   60,    3,   60,    5,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,    0
     } ;
 
-static const flex_int16_t yy_nxt[108] =
-    {   0,
+static const flex_int16_t yy_nxt[391] =
+    {   60,
         8,    9,   10,   11,   12,   13,   14,   15,   16,   17,
-       18,   19,   20,   21,   22,   22,   23,   24,   22,   22,
-       25,   26,   33,   34,   36,   37,   55,   55,   55,   42,
-       43,   38,   39,   55,   40,   54,   41,   36,   34,   36,
-       37,   55,   51,   53,   43,   54,   50,   27,   27,   27,
-       27,   29,   29,   29,   29,   45,   45,   52,   45,   47,
-       55,   47,   47,   55,   49,   52,   55,   55,   49,   35,
-       35,   31,   48,   46,   44,   55,   35,   32,   31,   55,
-       30,   30,   28,   28,    7,   55,   55,   55,   55,   55,
-       55,   55,   55,   55,   55,   55,   55,   55,   55,   55,
-
-       55,   55,   55,   55,   55,   55,   55
+       18,   19,   20,   21,   22,   23,   23,   24,   25,   23,
+       23,   26,   27,   28,   29,   29,   29,   29,   29,   30,
+       29,   29,   29,   29,   29,   29,   29,   29,   29,   29,
+       29,   29,   29,   29,   29,   29,   29,   29,   31,   31,
+       31,   32,   31,   31,   31,   31,   31,   31,   31,   31,
+       31,   31,   31,   31,   31,   31,   31,   31,   31,   31,
+       31,   31,   33,   34,   35,   36,   37,   38,   35,   48,
+       35,   35,   35,   35,   35,   35,   35,   39,   46,   47,
+       40,   41,   49,   42,   42,   42,   42,   42,   42,   42,
+
+       39,   51,   53,   33,   42,   38,   42,   42,   42,   43,
+       42,   42,   42,   39,   40,   37,   38,   42,   54,   42,
+       42,   42,   42,   42,   42,   42,   39,   57,   58,   47,
+       42,   49,   42,   42,   42,   42,   44,   42,   42,   39,
+       54,   57,   59,   42,   59,   42,   42,   42,   42,   42,
+       45,   42,   50,   50,   50,   50,   50,    0,   50,   50,
+       50,   50,   50,   50,   50,   50,   50,   50,   50,   50,
+       50,   50,   50,   50,   50,   50,   52,   52,   52,    0,
+       52,   52,   52,   52,   52,   52,   52,   52,   52,   52,
+       52,   52,   52,   52,   52,   52,   52,   52,   52,   52,
+
+       35,    0,    0,    0,   35,    0,   35,   35,   35,   35,
+       35,   35,   35,   35,    0,    0,    0,   35,    0,   35,
+       35,   35,   35,   35,   35,   35,   39,    0,    0,   40,
+       41,    0,   42,   42,   42,   42,   42,   42,   42,   39,
+        0,    0,    0,   42,    0,   42,   42,   42,   42,   42,
+       42,   42,   39,    0,    0,    0,   42,    0,   42,   42,
+       55,   42,   42,   42,   42,   39,    0,    0,    0,   42,
+        0,   42,   42,   42,   42,   42,   42,   56,   39,    0,
+        0,    0,   42,    0,   42,   42,   42,   42,   42,   42,
+       42,   50,   50,   50,   50,   50,    0,   50,   50,   50,
+
+       50,   50,   50,   50,   50,   50,   50,   50,   50,   50,
+       50,   50,   50,   50,   50,   52,   52,   52,    0,   52,
+       52,   52,   52,   52,   52,   52,   52,   52,   52,   52,
+       52,   52,   52,   52,   52,   52,   52,   52,   52,   39,
+        0,    0,    0,   42,    0,   42,   42,   42,   42,   42,
+       42,   42,   39,    0,    0,    0,   42,    0,   42,   42,
+       42,   42,   42,   42,   42,    7,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60
     } ;
 
-static const flex_int16_t yy_chk[108] =
-    {   0,
+static const flex_int16_t yy_chk[391] =
+    {   7,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,   17,   17,   19,   19,   21,   23,   24,   25,
-       25,   58,   21,   40,   23,   54,   24,   34,   34,   37,
-       37,   39,   40,   43,   43,   53,   39,   56,   56,   56,
-       56,   57,   57,   57,   57,   59,   59,   52,   59,   60,
-       51,   60,   60,   50,   49,   42,   41,   38,   36,   35,
-       33,   31,   30,   28,   26,   22,   18,   12,    9,    7,
-        6,    5,    4,    3,   55,   55,   55,   55,   55,   55,
-       55,   55,   55,   55,   55,   55,   55,   55,   55,   55,
-
-       55,   55,   55,   55,   55,   55,   55
+        1,    1,    1,    1,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    5,    5,
+        5,    5,    5,    5,    5,    5,    5,    5,    5,    5,
+        5,    5,    5,    5,    5,    5,    5,    5,    5,    5,
+        5,    5,    9,   12,   16,   18,   18,   19,   16,   27,
+       16,   16,   16,   16,   16,   16,   16,   20,   26,   26,
+       20,   20,   28,   20,   20,   20,   20,   20,   20,   20,
+
+       22,   30,   32,   33,   22,   36,   22,   22,   22,   22,
+       22,   22,   22,   23,   37,   37,   38,   23,   40,   23,
+       23,   23,   23,   23,   23,   23,   24,   46,   47,   47,
+       24,   49,   24,   24,   24,   24,   24,   24,   24,   25,
+       54,   57,   58,   25,   59,   25,   25,   25,   25,   25,
+       25,   25,   29,   29,   29,   29,   29,    0,   29,   29,
+       29,   29,   29,   29,   29,   29,   29,   29,   29,   29,
+       29,   29,   29,   29,   29,   29,   31,   31,   31,    0,
+       31,   31,   31,   31,   31,   31,   31,   31,   31,   31,
+       31,   31,   31,   31,   31,   31,   31,   31,   31,   31,
+
+       35,    0,    0,    0,   35,    0,   35,   35,   35,   35,
+       35,   35,   35,   39,    0,    0,    0,   39,    0,   39,
+       39,   39,   39,   39,   39,   39,   41,    0,    0,   41,
+       41,    0,   41,   41,   41,   41,   41,   41,   41,   42,
+        0,    0,    0,   42,    0,   42,   42,   42,   42,   42,
+       42,   42,   43,    0,    0,    0,   43,    0,   43,   43,
+       43,   43,   43,   43,   43,   44,    0,    0,    0,   44,
+        0,   44,   44,   44,   44,   44,   44,   44,   45,    0,
+        0,    0,   45,    0,   45,   45,   45,   45,   45,   45,
+       45,   50,   50,   50,   50,   50,    0,   50,   50,   50,
+
+       50,   50,   50,   50,   50,   50,   50,   50,   50,   50,
+       50,   50,   50,   50,   50,   52,   52,   52,    0,   52,
+       52,   52,   52,   52,   52,   52,   52,   52,   52,   52,
+       52,   52,   52,   52,   52,   52,   52,   52,   52,   55,
+        0,    0,    0,   55,    0,   55,   55,   55,   55,   55,
+       55,   55,   56,    0,    0,    0,   56,    0,   56,   56,
+       56,   56,   56,   56,   56,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60
     } ;
 
-static const flex_int16_t yy_rule_linenum[26] =
+static const flex_int16_t yy_rule_linenum[28] =
     {   0,
-       46,   48,   49,   50,   52,   53,   55,   56,   57,   59,
-       61,   63,   65,   66,   68,   69,   70,   72,   73,   74,
-       75,   78,   79,   80,   81
+       45,   47,   48,   49,   51,   52,   54,   55,   56,   58,
+       60,   62,   64,   65,   67,   68,   69,   71,   73,   75,
+       76,   77,   78,   81,   82,   83,   84
     } ;
 
 /* The intent behind this definition is that it'll catch
@@ -544,10 +606,10 @@ using token = infinity::SearchParser::token;
 /* for temporary storage of quoted string */
 static thread_local std::stringstream string_buffer;
 
-#line 548 "search_lexer.cpp"
+#line 610 "search_lexer.cpp"
 #define YY_NO_INPUT 1
 
-#line 551 "search_lexer.cpp"
+#line 613 "search_lexer.cpp"
 
 #define INITIAL 0
 #define SINGLE_QUOTED_STRING 1
@@ -750,7 +812,7 @@ YY_DECL
             /* Note: special characters in pattern shall be double-quoted or escaped with backslash: " <^.+|/()[]{}" */
 
 
-#line 754 "search_lexer.cpp"
+#line 816 "search_lexer.cpp"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -779,13 +841,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 56 )
+				if ( yy_current_state >= 61 )
 					yy_c = yy_meta[yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
 			++yy_cp;
 			}
-		while ( yy_current_state != 55 );
+		while ( yy_current_state != 60 );
 		yy_cp = (yy_last_accepting_cpos);
 		yy_current_state = (yy_last_accepting_state);
 
@@ -804,12 +866,12 @@ do_action:	/* This label is used only to access EOF actions. */
 			{
 			if ( yy_act == 0 )
 				std::cerr << "--scanner backing up\n";
-			else if ( yy_act < 26 )
+			else if ( yy_act < 28 )
 				std::cerr << "--accepting rule at line " << yy_rule_linenum[yy_act] <<
 				         "(\"" << yytext << "\")\n";
-			else if ( yy_act == 26 )
+			else if ( yy_act == 28 )
 				std::cerr << "--accepting default rule (\"" << yytext << "\")\n";
-			else if ( yy_act == 27 )
+			else if ( yy_act == 29 )
 				std::cerr << "--(end of buffer or a NUL)\n";
 			else
 				std::cerr << "--EOF (start condition " << YY_START << ")\n";
@@ -890,59 +952,69 @@ YY_RULE_SETUP
 case 18:
 YY_RULE_SETUP
 #line 72 "search_lexer.l"
-{ BEGIN SINGLE_QUOTED_STRING; string_buffer.clear(); string_buffer.str(""); }  // Clear strbuf manually, see #170
+{ yylval->build<std::string>(yytext); return token::WILDCARD_STRING; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 73 "search_lexer.l"
-{ string_buffer << '\''; }
+#line 74 "search_lexer.l"
+{ yylval->build<int>(yyleng > 1 ? std::atoi(yytext+1) : -1); return token::TILDE; }
 	YY_BREAK
 case 20:
-/* rule 20 can match eol */
 YY_RULE_SETUP
-#line 74 "search_lexer.l"
-{ string_buffer << yytext; }
+#line 76 "search_lexer.l"
+{ BEGIN SINGLE_QUOTED_STRING; string_buffer.clear(); string_buffer.str(""); }  // Clear strbuf manually, see #170
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 75 "search_lexer.l"
+#line 77 "search_lexer.l"
+{ string_buffer << '\''; }
+	YY_BREAK
+case 22:
+/* rule 22 can match eol */
+YY_RULE_SETUP
+#line 78 "search_lexer.l"
+{ string_buffer << yytext; }
+	YY_BREAK
+case 23:
+YY_RULE_SETUP
+#line 79 "search_lexer.l"
 { BEGIN INITIAL; yylval->build<std::string>(string_buffer.str()); return token::STRING; }
 	YY_BREAK
 case YY_STATE_EOF(SINGLE_QUOTED_STRING):
-#line 76 "search_lexer.l"
+#line 80 "search_lexer.l"
 { std::cerr << "[Lucene-Lexer-Error] Unterminated string" << std::endl; return 0; }
 	YY_BREAK
-case 22:
+case 24:
 YY_RULE_SETUP
-#line 78 "search_lexer.l"
+#line 82 "search_lexer.l"
 { BEGIN DOUBLE_QUOTED_STRING; string_buffer.clear(); string_buffer.str(""); }  // Clear strbuf manually, see #170
 	YY_BREAK
-case 23:
+case 25:
 YY_RULE_SETUP
-#line 79 "search_lexer.l"
+#line 83 "search_lexer.l"
 { string_buffer << '\"'; }
 	YY_BREAK
-case 24:
-/* rule 24 can match eol */
+case 26:
+/* rule 26 can match eol */
 YY_RULE_SETUP
-#line 80 "search_lexer.l"
+#line 84 "search_lexer.l"
 { string_buffer << yytext; }
 	YY_BREAK
-case 25:
+case 27:
 YY_RULE_SETUP
-#line 81 "search_lexer.l"
-{ BEGIN INITIAL; yylval->build<std::string>(string_buffer.str()); return token::STRING; }
+#line 85 "search_lexer.l"
+{ BEGIN INITIAL; yylval->build<std::string>(string_buffer.str()); return token::QUOTED_STRING; }
 	YY_BREAK
 case YY_STATE_EOF(DOUBLE_QUOTED_STRING):
-#line 82 "search_lexer.l"
+#line 86 "search_lexer.l"
 { std::cerr << "[Lucene-Lexer-Error] Unterminated string" << std::endl; return 0; }
 	YY_BREAK
-case 26:
+case 28:
 YY_RULE_SETUP
-#line 84 "search_lexer.l"
+#line 88 "search_lexer.l"
 ECHO;
 	YY_BREAK
-#line 946 "search_lexer.cpp"
+#line 1018 "search_lexer.cpp"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -1382,7 +1454,7 @@ int yyFlexLexer::yy_get_next_buffer()
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 56 )
+			if ( yy_current_state >= 61 )
 				yy_c = yy_meta[yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
@@ -1415,11 +1487,11 @@ int yyFlexLexer::yy_get_next_buffer()
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 56 )
+		if ( yy_current_state >= 61 )
 			yy_c = yy_meta[yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-	yy_is_jam = (yy_current_state == 55);
+	yy_is_jam = (yy_current_state == 60);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2061,6 +2133,6 @@ void yyfree (void * ptr )
 
 /* %ok-for-header */
 
-#line 84 "search_lexer.l"
+#line 88 "search_lexer.l"
 
 
@@ -193,7 +193,13 @@ namespace infinity {
         value.copy< float > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.copy< int > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.copy< std::string > (YY_MOVE (that.value));
         break;
 
@@ -241,7 +247,13 @@ namespace infinity {
         value.move< float > (YY_MOVE (s.value));
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.move< int > (YY_MOVE (s.value));
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.move< std::string > (YY_MOVE (s.value));
         break;
 
@@ -359,7 +371,13 @@ namespace infinity {
         value.YY_MOVE_OR_COPY< float > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.YY_MOVE_OR_COPY< int > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.YY_MOVE_OR_COPY< std::string > (YY_MOVE (that.value));
         break;
 
@@ -391,7 +409,13 @@ namespace infinity {
         value.move< float > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.move< int > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.move< std::string > (YY_MOVE (that.value));
         break;
 
@@ -423,7 +447,13 @@ namespace infinity {
         value.copy< float > (that.value);
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.copy< int > (that.value);
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.copy< std::string > (that.value);
         break;
 
@@ -454,7 +484,13 @@ namespace infinity {
         value.move< float > (that.value);
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.move< int > (that.value);
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.move< std::string > (that.value);
         break;
 
@@ -729,7 +765,13 @@ namespace infinity {
         yylhs.value.emplace< float > ();
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        yylhs.value.emplace< int > ();
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         yylhs.value.emplace< std::string > ();
         break;
 
@@ -763,108 +805,108 @@ namespace infinity {
           switch (yyn)
             {
   case 2: // topLevelQuery: query "end of file"
-#line 74 "search_parser.y"
+#line 77 "search_parser.y"
             {
     parse_result = std::move(yystack_[1].value.as < std::unique_ptr<QueryNode> > ());
 }
-#line 771 "search_parser.cpp"
+#line 813 "search_parser.cpp"
     break;
 
   case 3: // query: clause
-#line 79 "search_parser.y"
+#line 82 "search_parser.y"
          { yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ()); }
-#line 777 "search_parser.cpp"
+#line 819 "search_parser.cpp"
     break;
 
   case 4: // query: query clause
-#line 80 "search_parser.y"
+#line 83 "search_parser.y"
                {
     auto query = std::make_unique<OrQueryNode>();
     query->Add(std::move(yystack_[1].value.as < std::unique_ptr<QueryNode> > ()));
     query->Add(std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ()));
     yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(query);
 }
-#line 788 "search_parser.cpp"
+#line 830 "search_parser.cpp"
     break;
 
   case 5: // query: query OR clause
-#line 86 "search_parser.y"
+#line 89 "search_parser.y"
                   {
     auto query = std::make_unique<OrQueryNode>();
     query->Add(std::move(yystack_[2].value.as < std::unique_ptr<QueryNode> > ()));
     query->Add(std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ()));
     yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(query);
 }
-#line 799 "search_parser.cpp"
+#line 841 "search_parser.cpp"
     break;
 
   case 6: // clause: term
-#line 94 "search_parser.y"
+#line 97 "search_parser.y"
        { yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ()); }
-#line 805 "search_parser.cpp"
+#line 847 "search_parser.cpp"
     break;
 
   case 7: // clause: clause AND term
-#line 95 "search_parser.y"
+#line 98 "search_parser.y"
                   {
     auto query = std::make_unique<AndQueryNode>();
     query->Add(std::move(yystack_[2].value.as < std::unique_ptr<QueryNode> > ()));
     query->Add(std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ()));
     yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(query);
 }
-#line 816 "search_parser.cpp"
+#line 858 "search_parser.cpp"
     break;
 
   case 8: // term: basic_filter_boost
-#line 103 "search_parser.y"
+#line 106 "search_parser.y"
                      { yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ()); }
-#line 822 "search_parser.cpp"
+#line 864 "search_parser.cpp"
     break;
 
   case 9: // term: NOT term
-#line 104 "search_parser.y"
+#line 107 "search_parser.y"
            {
     auto query = std::make_unique<NotQueryNode>();
     query->Add(std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ()));
     yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(query);
 }
-#line 832 "search_parser.cpp"
+#line 874 "search_parser.cpp"
     break;
 
   case 10: // term: LPAREN query RPAREN
-#line 109 "search_parser.y"
+#line 112 "search_parser.y"
                       { yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(yystack_[1].value.as < std::unique_ptr<QueryNode> > ()); }
-#line 838 "search_parser.cpp"
+#line 880 "search_parser.cpp"
     break;
 
   case 11: // term: LPAREN query RPAREN CARAT
-#line 110 "search_parser.y"
+#line 113 "search_parser.y"
                             {
     yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(yystack_[2].value.as < std::unique_ptr<QueryNode> > ());
     yylhs.value.as < std::unique_ptr<QueryNode> > ()->MultiplyWeight(yystack_[0].value.as < float > ());
 }
-#line 847 "search_parser.cpp"
+#line 889 "search_parser.cpp"
     break;
 
   case 12: // basic_filter_boost: basic_filter
-#line 116 "search_parser.y"
+#line 119 "search_parser.y"
                {
     yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(yystack_[0].value.as < std::unique_ptr<QueryNode> > ());
 }
-#line 855 "search_parser.cpp"
+#line 897 "search_parser.cpp"
     break;
 
   case 13: // basic_filter_boost: basic_filter CARAT
-#line 119 "search_parser.y"
+#line 122 "search_parser.y"
                      {
     yylhs.value.as < std::unique_ptr<QueryNode> > () = std::move(yystack_[1].value.as < std::unique_ptr<QueryNode> > ());
     yylhs.value.as < std::unique_ptr<QueryNode> > ()->MultiplyWeight(yystack_[0].value.as < float > ());
 }
-#line 864 "search_parser.cpp"
+#line 906 "search_parser.cpp"
     break;
 
   case 14: // basic_filter: STRING
-#line 125 "search_parser.y"
+#line 128 "search_parser.y"
          {
     const std::string &field = default_field;
     if(field.empty()){
@@ -873,19 +915,103 @@ namespace infinity {
     }
     yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, std::move(yystack_[0].value.as < std::string > ()));
 }
-#line 877 "search_parser.cpp"
+#line 919 "search_parser.cpp"
     break;
 
   case 15: // basic_filter: STRING OP_COLON STRING
-#line 133 "search_parser.y"
+#line 136 "search_parser.y"
                          {
     yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(yystack_[2].value.as < std::string > (), std::move(yystack_[0].value.as < std::string > ()));
 }
-#line 885 "search_parser.cpp"
+#line 927 "search_parser.cpp"
+    break;
+
+  case 16: // basic_filter: QUOTED_STRING
+#line 139 "search_parser.y"
+                {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(yystack_[0].location, "default_field is empty");
+        YYERROR;
+    }
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, std::move(yystack_[0].value.as < std::string > ()), true);
+}
+#line 940 "search_parser.cpp"
     break;
 
+  case 17: // basic_filter: STRING OP_COLON QUOTED_STRING
+#line 147 "search_parser.y"
+                                {
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(yystack_[2].value.as < std::string > (), std::move(yystack_[0].value.as < std::string > ()), true);
+}
+#line 948 "search_parser.cpp"
+    break;
 
-#line 889 "search_parser.cpp"
+  case 18: // basic_filter: QUOTED_STRING TILDE
+#line 150 "search_parser.y"
+                      {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(yystack_[1].location, "default_field is empty");
+        YYERROR;
+    }
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(field, std::move(yystack_[1].value.as < std::string > ()), true, yystack_[0].value.as < int > ());
+}
+#line 961 "search_parser.cpp"
+    break;
+
+  case 19: // basic_filter: STRING OP_COLON QUOTED_STRING TILDE
+#line 158 "search_parser.y"
+                                      {
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(yystack_[3].value.as < std::string > (), std::move(yystack_[1].value.as < std::string > ()), true, yystack_[0].value.as < int > ());
+}
+#line 969 "search_parser.cpp"
+    break;
+
+  case 20: // basic_filter: WILDCARD_STRING
+#line 161 "search_parser.y"
+                  {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(yystack_[0].location, "default_field is empty");
+        YYERROR;
+    }
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildWildcardQueryNode(field, std::move(yystack_[0].value.as < std::string > ()));
+}
+#line 982 "search_parser.cpp"
+    break;
+
+  case 21: // basic_filter: STRING OP_COLON WILDCARD_STRING
+#line 169 "search_parser.y"
+                                  {
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildWildcardQueryNode(yystack_[2].value.as < std::string > (), std::move(yystack_[0].value.as < std::string > ()));
+}
+#line 990 "search_parser.cpp"
+    break;
+
+  case 22: // basic_filter: STRING TILDE
+#line 172 "search_parser.y"
+               {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(yystack_[1].location, "default_field is empty");
+        YYERROR;
+    }
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildFuzzyQueryNode(field, std::move(yystack_[1].value.as < std::string > ()), yystack_[0].value.as < int > ());
+}
+#line 1003 "search_parser.cpp"
+    break;
+
+  case 23: // basic_filter: STRING OP_COLON STRING TILDE
+#line 180 "search_parser.y"
+                               {
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildFuzzyQueryNode(yystack_[3].value.as < std::string > (), std::move(yystack_[1].value.as < std::string > ()), yystack_[0].value.as < int > ());
+}
+#line 1011 "search_parser.cpp"
+    break;
+
+
+#line 1015 "search_parser.cpp"
 
             default:
               break;
@@ -1237,74 +1363,81 @@ namespace infinity {
   }
 
 
-  const signed char SearchParser::yypact_ninf_ = -7;
+  const signed char SearchParser::yypact_ninf_ = -11;
 
   const signed char SearchParser::yytable_ninf_ = -1;
 
   const signed char
   SearchParser::yypact_[] =
   {
-       4,     4,     4,    -5,    15,     1,    10,    -7,    -7,    12,
-      -7,    13,    -6,    -7,    -7,     4,    10,     4,    -7,    16,
-      -7,    10,    -7,    -7
+      19,    19,    19,    -4,   -10,   -11,    10,     1,    29,   -11,
+     -11,    24,   -11,    11,    16,   -11,   -11,   -11,   -11,    19,
+      29,    19,   -11,    25,     6,    22,   -11,    29,   -11,   -11,
+     -11,   -11
   };
 
   const signed char
   SearchParser::yydefact_[] =
   {
-       0,     0,     0,    14,     0,     0,     3,     6,     8,    12,
-       9,     0,     0,     1,     2,     0,     4,     0,    13,    10,
-      15,     5,     7,    11
+       0,     0,     0,    14,    16,    20,     0,     0,     3,     6,
+       8,    12,     9,     0,     0,    22,    18,     1,     2,     0,
+       4,     0,    13,    10,    15,    17,    21,     5,     7,    11,
+      23,    19
   };
 
   const signed char
   SearchParser::yypgoto_[] =
   {
-      -7,    -7,    20,    -3,    -1,    -7,    -7
+     -11,   -11,    34,    -5,    -1,   -11,   -11
   };
 
   const signed char
   SearchParser::yydefgoto_[] =
   {
-       0,     4,     5,     6,     7,     8,     9
+       0,     6,     7,     8,     9,    10,    11
   };
 
   const signed char
   SearchParser::yytable_[] =
   {
-      10,    14,    16,    12,    20,    15,     1,     2,    16,     1,
-       2,     3,    21,    17,     3,    13,    22,    15,     1,     2,
-      19,    18,    11,     3,     0,    23
+      12,    18,    20,    16,    14,    19,     1,     2,    20,    15,
+      17,     3,     4,     5,    27,    19,     1,     2,    23,    30,
+      28,     3,     4,     5,     1,     2,    24,    25,    26,     3,
+       4,     5,    21,    22,    29,    31,    13
   };
 
   const signed char
   SearchParser::yycheck_[] =
   {
-       1,     0,     5,     8,    10,     4,     5,     6,    11,     5,
-       6,    10,    15,     3,    10,     0,    17,     4,     5,     6,
-       7,     9,     2,    10,    -1,     9
+       1,     0,     7,    13,     8,     4,     5,     6,    13,    13,
+       0,    10,    11,    12,    19,     4,     5,     6,     7,    13,
+      21,    10,    11,    12,     5,     6,    10,    11,    12,    10,
+      11,    12,     3,     9,     9,    13,     2
   };
 
   const signed char
   SearchParser::yystos_[] =
   {
-       0,     5,     6,    10,    12,    13,    14,    15,    16,    17,
-      15,    13,     8,     0,     0,     4,    14,     3,     9,     7,
-      10,    14,    15,     9
+       0,     5,     6,    10,    11,    12,    15,    16,    17,    18,
+      19,    20,    18,    16,     8,    13,    13,     0,     0,     4,
+      17,     3,     9,     7,    10,    11,    12,    17,    18,     9,
+      13,    13
   };
 
   const signed char
   SearchParser::yyr1_[] =
   {
-       0,    11,    12,    13,    13,    13,    14,    14,    15,    15,
-      15,    15,    16,    16,    17,    17
+       0,    14,    15,    16,    16,    16,    17,    17,    18,    18,
+      18,    18,    19,    19,    20,    20,    20,    20,    20,    20,
+      20,    20,    20,    20
   };
 
   const signed char
   SearchParser::yyr2_[] =
   {
        0,     2,     2,     1,     2,     3,     1,     3,     1,     2,
-       3,     4,     1,     2,     1,     3
+       3,     4,     1,     2,     1,     3,     1,     3,     2,     4,
+       1,     3,     2,     4
   };
 
 
@@ -1315,9 +1448,9 @@ namespace infinity {
   const SearchParser::yytname_[] =
   {
   "\"end of file\"", "error", "\"invalid token\"", "AND", "OR", "NOT",
-  "LPAREN", "RPAREN", "OP_COLON", "CARAT", "STRING", "$accept",
-  "topLevelQuery", "query", "clause", "term", "basic_filter_boost",
-  "basic_filter", YY_NULLPTR
+  "LPAREN", "RPAREN", "OP_COLON", "CARAT", "STRING", "QUOTED_STRING",
+  "WILDCARD_STRING", "TILDE", "$accept", "topLevelQuery", "query",
+  "clause", "term", "basic_filter_boost", "basic_filter", YY_NULLPTR
   };
 #endif
 
@@ -1326,8 +1459,9 @@ namespace infinity {
   const unsigned char
   SearchParser::yyrline_[] =
   {
-       0,    74,    74,    79,    80,    86,    94,    95,   103,   104,
-     109,   110,   116,   119,   125,   133
+       0,    77,    77,    82,    83,    89,    97,    98,   106,   107,
+     112,   113,   119,   122,   128,   136,   139,   147,   150,   158,
+     161,   169,   172,   180
   };
 
   void
@@ -1365,9 +1499,9 @@ namespace infinity {
 
 #line 9 "search_parser.y"
 } // infinity
-#line 1369 "search_parser.cpp"
+#line 1503 "search_parser.cpp"
 
-#line 137 "search_parser.y"
+#line 184 "search_parser.y"
 
 
 namespace infinity{
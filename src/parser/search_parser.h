@@ -420,8 +420,13 @@ namespace infinity {
       // CARAT
       char dummy1[sizeof (float)];
 
+      // TILDE
+      char dummy2[sizeof (int)];
+
       // STRING
-      char dummy2[sizeof (std::string)];
+      // QUOTED_STRING
+      // WILDCARD_STRING
+      char dummy3[sizeof (std::string)];
 
       // topLevelQuery
       // query
@@ -429,7 +434,7 @@ namespace infinity {
       // term
       // basic_filter_boost
       // basic_filter
-      char dummy3[sizeof (std::unique_ptr<QueryNode>)];
+      char dummy4[sizeof (std::unique_ptr<QueryNode>)];
     };
 
     /// The size of the largest semantic type.
@@ -489,7 +494,10 @@ namespace infinity {
     RPAREN = 7,                    // RPAREN
     OP_COLON = 8,                  // OP_COLON
     CARAT = 9,                     // CARAT
-    STRING = 10                    // STRING
+    STRING = 10,                   // STRING
+    QUOTED_STRING = 11,            // QUOTED_STRING
+    WILDCARD_STRING = 12,          // WILDCARD_STRING
+    TILDE = 13                     // TILDE
       };
       /// Backward compatibility alias (Bison 3.6).
       typedef token_kind_type yytokentype;
@@ -506,7 +514,7 @@ namespace infinity {
     {
       enum symbol_kind_type
       {
-        YYNTOKENS = 11, ///< Number of tokens.
+        YYNTOKENS = 14, ///< Number of tokens.
         S_YYEMPTY = -2,
         S_YYEOF = 0,                             // "end of file"
         S_YYerror = 1,                           // error
@@ -519,13 +527,16 @@ namespace infinity {
         S_OP_COLON = 8,                          // OP_COLON
         S_CARAT = 9,                             // CARAT
         S_STRING = 10,                           // STRING
-        S_YYACCEPT = 11,                         // $accept
-        S_topLevelQuery = 12,                    // topLevelQuery
-        S_query = 13,                            // query
-        S_clause = 14,                           // clause
-        S_term = 15,                             // term
-        S_basic_filter_boost = 16,               // basic_filter_boost
-        S_basic_filter = 17                      // basic_filter
+        S_QUOTED_STRING = 11,                    // QUOTED_STRING
+        S_WILDCARD_STRING = 12,                  // WILDCARD_STRING
+        S_TILDE = 13,                            // TILDE
+        S_YYACCEPT = 14,                         // $accept
+        S_topLevelQuery = 15,                    // topLevelQuery
+        S_query = 16,                            // query
+        S_clause = 17,                           // clause
+        S_term = 18,                             // term
+        S_basic_filter_boost = 19,               // basic_filter_boost
+        S_basic_filter = 20                      // basic_filter
       };
     };
 
@@ -566,7 +577,13 @@ namespace infinity {
         value.move< float > (std::move (that.value));
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.move< int > (std::move (that.value));
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.move< std::string > (std::move (that.value));
         break;
 
@@ -616,6 +633,20 @@ namespace infinity {
       {}
 #endif
 
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, int&& v, location_type&& l)
+        : Base (t)
+        , value (std::move (v))
+        , location (std::move (l))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const int& v, const location_type& l)
+        : Base (t)
+        , value (v)
+        , location (l)
+      {}
+#endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, std::string&& v, location_type&& l)
         : Base (t)
@@ -672,7 +703,13 @@ switch (yykind)
         value.template destroy< float > ();
         break;
 
+      case symbol_kind::S_TILDE: // TILDE
+        value.template destroy< int > ();
+        break;
+
       case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_QUOTED_STRING: // QUOTED_STRING
+      case symbol_kind::S_WILDCARD_STRING: // WILDCARD_STRING
         value.template destroy< std::string > ();
         break;
 
@@ -798,6 +835,18 @@ switch (yykind)
         YY_ASSERT (tok == token::CARAT);
 #endif
       }
+#if 201103L <= YY_CPLUSPLUS
+      symbol_type (int tok, int v, location_type l)
+        : super_type (token_kind_type (tok), std::move (v), std::move (l))
+#else
+      symbol_type (int tok, const int& v, const location_type& l)
+        : super_type (token_kind_type (tok), v, l)
+#endif
+      {
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::TILDE);
+#endif
+      }
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, std::string v, location_type l)
         : super_type (token_kind_type (tok), std::move (v), std::move (l))
@@ -807,7 +856,7 @@ switch (yykind)
 #endif
       {
 #if !defined _MSC_VER || defined __clang__
-        YY_ASSERT (tok == token::STRING);
+        YY_ASSERT ((token::STRING <= tok && tok <= token::WILDCARD_STRING));
 #endif
       }
     };
@@ -1023,6 +1072,51 @@ switch (yykind)
         return symbol_type (token::STRING, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_QUOTED_STRING (std::string v, location_type l)
+      {
+        return symbol_type (token::QUOTED_STRING, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_QUOTED_STRING (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::QUOTED_STRING, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_WILDCARD_STRING (std::string v, location_type l)
+      {
+        return symbol_type (token::WILDCARD_STRING, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_WILDCARD_STRING (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::WILDCARD_STRING, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_TILDE (int v, location_type l)
+      {
+        return symbol_type (token::TILDE, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_TILDE (const int& v, const location_type& l)
+      {
+        return symbol_type (token::TILDE, v, l);
+      }
+#endif
 
 
     class context
@@ -1353,9 +1447,9 @@ switch (yykind)
     /// Constants.
     enum
     {
-      yylast_ = 25,     ///< Last index in yytable_.
+      yylast_ = 36,     ///< Last index in yytable_.
       yynnts_ = 7,  ///< Number of nonterminal symbols.
-      yyfinal_ = 13 ///< Termination state number.
+      yyfinal_ = 17 ///< Termination state number.
     };
 
 
@@ -1370,7 +1464,7 @@ switch (yykind)
 
 #line 9 "search_parser.y"
 } // infinity
-#line 1374 "search_parser.h"
+#line 1468 "search_parser.h"
 
 
 
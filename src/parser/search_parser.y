@@ -58,6 +58,9 @@
 %token                 OP_COLON
 %token <float>         CARAT
 %token <std::string>   STRING
+%token <std::string>   QUOTED_STRING
+%token <std::string>   WILDCARD_STRING
+%token <int>           TILDE
 
 /* nonterminal symbol */
 %type <std::unique_ptr<QueryNode>>  topLevelQuery query clause term basic_filter_boost basic_filter
@@ -132,6 +135,50 @@ basic_filter
 }
 | STRING OP_COLON STRING {
     $$ = driver.AnalyzeAndBuildQueryNode($1, std::move($3));
+}
+| QUOTED_STRING {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(@1, "default_field is empty");
+        YYERROR;
+    }
+    $$ = driver.AnalyzeAndBuildQueryNode(field, std::move($1), true);
+}
+| STRING OP_COLON QUOTED_STRING {
+    $$ = driver.AnalyzeAndBuildQueryNode($1, std::move($3), true);
+}
+| QUOTED_STRING TILDE {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(@1, "default_field is empty");
+        YYERROR;
+    }
+    $$ = driver.AnalyzeAndBuildQueryNode(field, std::move($1), true, $2);
+}
+| STRING OP_COLON QUOTED_STRING TILDE {
+    $$ = driver.AnalyzeAndBuildQueryNode($1, std::move($3), true, $4);
+}
+| WILDCARD_STRING {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(@1, "default_field is empty");
+        YYERROR;
+    }
+    $$ = driver.BuildWildcardQueryNode(field, std::move($1));
+}
+| STRING OP_COLON WILDCARD_STRING {
+    $$ = driver.BuildWildcardQueryNode($1, std::move($3));
+}
+| STRING TILDE {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(@1, "default_field is empty");
+        YYERROR;
+    }
+    $$ = driver.BuildFuzzyQueryNode(field, std::move($1), $2);
+}
+| STRING OP_COLON STRING TILDE {
+    $$ = driver.BuildFuzzyQueryNode($1, std::move($3), $4);
 };
 
 %%
@@ -900,6 +900,22 @@ void ExplainLogicalPlan::Explain(const LogicalKnnScan *knn_scan_node, SharedPtr<
         filter_str += " - filter: ";
         Explain(knn_scan_node->filter_expression_.get(), filter_str);
         result->emplace_back(MakeShared<String>(filter_str));
+
+        if (knn_scan_node->secondary_index_filter_qualified_.get() != nullptr) {
+            String index_filter_str = String(intent_size, ' ');
+            index_filter_str += " - filter for secondary index: ";
+            Explain(knn_scan_node->secondary_index_filter_qualified_.get(), index_filter_str);
+            result->emplace_back(MakeShared<String>(index_filter_str));
+
+            String leftover_filter_str = String(intent_size, ' ');
+            leftover_filter_str += " - filter except secondary index: ";
+            if (knn_scan_node->filter_leftover_.get() != nullptr) {
+                Explain(knn_scan_node->filter_leftover_.get(), leftover_filter_str);
+            } else {
+                leftover_filter_str += "None";
+            }
+            result->emplace_back(MakeShared<String>(leftover_filter_str));
+        }
     }
 
     // Output columns
@@ -28,6 +28,8 @@ import table_entry;
 import internal_types;
 import data_type;
 import fast_rough_filter;
+import table_index_entry;
+import secondary_index_scan_execute_expression;
 
 namespace infinity {
 
@@ -59,6 +61,12 @@ public:
 
     UniquePtr<FastRoughFilterEvaluator> fast_rough_filter_evaluator_;
 
+    // filter members generated by optimizer, the qualified conjuncts are solved by secondary index as the prefilter
+    SharedPtr<BaseExpression> filter_leftover_;
+    SharedPtr<BaseExpression> secondary_index_filter_qualified_;
+    HashMap<ColumnID, TableIndexEntry *> secondary_index_column_index_map_;
+    Vector<FilterExecuteElem> filter_execute_command_;
+
     u64 knn_table_index_{};
 };
 
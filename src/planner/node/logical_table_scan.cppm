@@ -24,6 +24,7 @@ import table_entry;
 import internal_types;
 import data_type;
 import fast_rough_filter;
+import block_statistics_aggregate;
 
 export module logical_table_scan;
 
@@ -53,6 +54,9 @@ public:
 
     UniquePtr<FastRoughFilterEvaluator> fast_rough_filter_evaluator_;
 
+    // set by AggregatePushDown, answer the aggregates above from the block statistics where possible
+    SharedPtr<Vector<StatisticsAggregate>> statistics_aggregates_{};
+
     bool add_row_id_;
 };
 
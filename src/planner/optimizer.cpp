@@ -22,6 +22,7 @@ import column_pruner;
 import lazy_load;
 import secondary_index_scan_builder;
 import apply_fast_rough_filter;
+import aggregate_push_down;
 import explain_logical_plan;
 import optimizer_rule;
 import bound_delete_statement;
@@ -38,6 +39,7 @@ namespace infinity {
 Optimizer::Optimizer(QueryContext *query_context_ptr) : query_context_ptr_(query_context_ptr) {
     // TODO: need an equivalent expression optimizer
     AddRule(MakeUnique<ApplyFastRoughFilter>());      // put it before SecondaryIndexScanBuilder
+    AddRule(MakeUnique<AggregatePushDown>());         // put it after ApplyFastRoughFilter
     AddRule(MakeUnique<SecondaryIndexScanBuilder>()); // put it before ColumnPruner
     AddRule(MakeUnique<ColumnPruner>());
     AddRule(MakeUnique<LazyLoad>());
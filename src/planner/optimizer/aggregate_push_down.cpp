@@ -0,0 +1,107 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+module;
+
+module aggregate_push_down;
+
+import stl;
+import logical_node;
+import logical_node_type;
+import logical_aggregate;
+import logical_table_scan;
+import query_context;
+import base_expression;
+import expression_type;
+import aggregate_expression;
+import column_expression;
+import logical_type;
+import internal_types;
+import block_statistics_aggregate;
+
+namespace infinity {
+
+class AggregatePushDownMethod {
+public:
+    static void VisitNode(SharedPtr<LogicalNode> &op) {
+        if (!op) {
+            return;
+        }
+        if (op->operator_type() == LogicalNodeType::kAggregate && op->left_node().get() != nullptr &&
+            op->left_node()->operator_type() == LogicalNodeType::kTableScan) {
+            auto &aggregate = static_cast<LogicalAggregate &>(*op);
+            auto &table_scan = static_cast<LogicalTableScan &>(*(op->left_node()));
+            // with a filter the aggregate is above the filter, not the scan
+            if (aggregate.groups_.empty() && table_scan.fast_rough_filter_evaluator_.get() == nullptr) {
+                table_scan.statistics_aggregates_ = BuildStatisticsAggregates(aggregate.aggregates_, table_scan.TableIndex());
+            }
+        }
+        VisitNode(op->left_node());
+        VisitNode(op->right_node());
+    }
+
+private:
+    // nullptr unless every aggregate can be answered from the statistics
+    static SharedPtr<Vector<StatisticsAggregate>> BuildStatisticsAggregates(const Vector<SharedPtr<BaseExpression>> &aggregates, u64 table_index) {
+        auto result = MakeShared<Vector<StatisticsAggregate>>();
+        for (const auto &expr : aggregates) {
+            if (expr->type() != ExpressionType::kAggregate) {
+                return nullptr;
+            }
+            auto *aggregate_expr = static_cast<AggregateExpression *>(expr.get());
+            if (aggregate_expr->arguments().size() != 1 || aggregate_expr->arguments()[0]->type() != ExpressionType::kColumn) {
+                return nullptr;
+            }
+            auto *column_expr = static_cast<ColumnExpression *>(aggregate_expr->arguments()[0].get());
+            if (column_expr->binding().table_idx != table_index) {
+                return nullptr;
+            }
+            StatisticsAggregate statistics_aggregate;
+            statistics_aggregate.column_id_ = column_expr->binding().column_idx;
+            statistics_aggregate.value_type_ = column_expr->Type().type();
+            const String function_name = aggregate_expr->aggregate_function_.GetFuncName();
+            if (function_name == "COUNT") {
+                statistics_aggregate.type_ = StatisticsAggregateType::kCount;
+            } else if (function_name == "MIN" || function_name == "MAX") {
+                if (!SupportMinMax(statistics_aggregate.value_type_)) {
+                    return nullptr;
+                }
+                statistics_aggregate.type_ = function_name == "MIN" ? StatisticsAggregateType::kMin : StatisticsAggregateType::kMax;
+            } else {
+                return nullptr;
+            }
+            result->push_back(statistics_aggregate);
+        }
+        return result;
+    }
+
+    // the min max filter of varchar only keeps a prefix, the other types are exact
+    static bool SupportMinMax(LogicalType type) {
+        switch (type) {
+            case LogicalType::kTinyInt:
+            case LogicalType::kSmallInt:
+            case LogicalType::kInteger:
+            case LogicalType::kBigInt:
+            case LogicalType::kFloat:
+            case LogicalType::kDouble:
+                return true;
+            default:
+                return false;
+        }
+    }
+};
+
+void AggregatePushDown::ApplyToPlan(QueryContext *, SharedPtr<LogicalNode> &logical_plan) { AggregatePushDownMethod::VisitNode(logical_plan); }
+
+} // namespace infinity
@@ -0,0 +1,37 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+module;
+
+export module aggregate_push_down;
+
+import stl;
+import logical_node;
+import query_context;
+import optimizer_rule;
+
+namespace infinity {
+
+// Answer COUNT, MIN and MAX without group by over a plain table scan from the block statistics:
+// the row count of the block and its min max filter. Blocks whose statistics don't hold for the query are still scanned.
+export class AggregatePushDown final : public OptimizerRule {
+public:
+    ~AggregatePushDown() final = default;
+
+    void ApplyToPlan(QueryContext *, SharedPtr<LogicalNode> &logical_plan) final;
+
+    String name() const final { return "Aggregate Push Down"; }
+};
+
+} // namespace infinity
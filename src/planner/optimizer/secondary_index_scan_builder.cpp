@@ -23,6 +23,7 @@ import logical_filter;
 import logical_table_scan;
 import logical_index_scan;
 import logical_match;
+import logical_knn_scan;
 import query_context;
 import logical_node_visitor;
 import infinity_exception;
@@ -101,6 +102,17 @@ public:
                 match.secondary_index_column_index_map_ = std::move(column_index_map);
                 match.filter_execute_command_ = std::move(filter_execute_command);
             }
+        } else if (op->operator_type() == LogicalNodeType::kKnnScan) {
+            auto &knn_scan = static_cast<LogicalKnnScan &>(*op);
+            if (const auto &filter_expression = knn_scan.filter_expression_; filter_expression) {
+                auto &base_table_ref_ptr = knn_scan.base_table_ref_;
+                IndexScanFilterExpressionPushDownResult index_scan_solve_result =
+                    FilterExpressionPushDown::PushDownToIndexScan(query_context_, *base_table_ref_ptr, filter_expression);
+                knn_scan.filter_leftover_ = std::move(index_scan_solve_result.extra_leftover_filter_);
+                knn_scan.secondary_index_filter_qualified_ = std::move(index_scan_solve_result.index_filter_qualified_);
+                knn_scan.secondary_index_column_index_map_ = std::move(index_scan_solve_result.column_index_map_);
+                knn_scan.filter_execute_command_ = std::move(index_scan_solve_result.filter_execute_command_);
+            }
         }
         // visit children after handling current node
         VisitNode(op->left_node());
@@ -50,6 +50,7 @@ import physical_source;
 import physical_sink;
 import data_table;
 import data_block;
+import block_statistics_aggregate;
 import physical_merge_knn;
 import merge_knn_data;
 import create_index_data;
@@ -90,6 +91,9 @@ UniquePtr<OperatorState> MakeTableScanState(PhysicalTableScan *physical_table_sc
     table_scan_op_state_ptr->table_scan_function_data_ = MakeUnique<TableScanFunctionData>(physical_table_scan->GetBlockIndex(),
                                                                                            table_scan_source_state->global_ids_,
                                                                                            physical_table_scan->ColumnIDs());
+    if (physical_table_scan->statistics_aggregates().get() != nullptr) {
+        table_scan_op_state_ptr->block_statistics_aggregator_ = MakeUnique<BlockStatisticsAggregator>(physical_table_scan->statistics_aggregates());
+    }
     return operator_state;
 }
 
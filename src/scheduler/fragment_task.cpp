@@ -35,6 +35,7 @@ import defer_op;
 import fragment_context;
 import status;
 import parser_assert;
+import query_memory_tracker;
 
 namespace infinity {
 
@@ -76,6 +77,7 @@ void FragmentTask::OnExecute() {
         HashMap<SizeT, SharedPtr<BaseTableRef>> table_refs;
         profiler.Begin();
         try {
+            QueryMemoryTracker::ScopedCurrent memory_tracker_guard(query_context->memory_tracker());
             for (i64 op_idx = operator_count_ - 1; op_idx >= 0; --op_idx) {
                 profiler.StartOperator(operator_refs[op_idx]);
                 DeferFn defer_fn([&]() { profiler.StopOperator(operator_states_[op_idx].get()); });
@@ -14,7 +14,10 @@
 
 module;
 
+#include <sys/resource.h>
+#include <thread>
 #include <tuple>
+#include <unistd.h>
 
 module background_process;
 
@@ -22,6 +25,7 @@ import stl;
 import bg_task;
 import compact_segments_task;
 import update_segment_bloom_filter_task;
+import build_secondary_index_task;
 import logger;
 import blocking_queue;
 import infinity_exception;
@@ -29,84 +33,204 @@ import wal_manager;
 import catalog;
 import third_party;
 import buffer_manager;
+import io_rate_limiter;
 
 namespace infinity {
 
-BGTaskProcessor::BGTaskProcessor(WalManager *wal_manager, Catalog *catalog) : wal_manager_(wal_manager), catalog_(catalog) {}
+String BGTaskLaneToString(BGTaskLane lane) {
+    switch (lane) {
+        case BGTaskLane::kCheckpoint:
+            return "checkpoint";
+        case BGTaskLane::kIndexBuild:
+            return "index build";
+        case BGTaskLane::kCleanup:
+            return "cleanup";
+        default:
+            return "invalid";
+    }
+}
+
+void SetBGThreadNice(i32 nice) {
+#ifdef __linux__
+    // On linux the nice value is per thread.
+    if (setpriority(PRIO_PROCESS, gettid(), nice) != 0) {
+        LOG_WARN(fmt::format("Can't set the nice value of background thread to {}", nice));
+    }
+#endif
+}
+
+BGTaskProcessor::BGTaskProcessor(WalManager *wal_manager, Catalog *catalog, const BGTaskProcessorOptions &options)
+    : wal_manager_(wal_manager), catalog_(catalog) {
+    for (SizeT i = 0; i < lanes_.size(); ++i) {
+        auto lane = MakeUnique<Lane>();
+        lane->lane_ = BGTaskLane(i);
+        switch (lane->lane_) {
+            case BGTaskLane::kCheckpoint: {
+                // The wal can't be recycled before the checkpoint, it is neither deprioritized nor rate limited.
+                lane->thread_num_ = 1;
+                lane->nice_ = options.checkpoint_nice_;
+                lane->io_rate_limiter_ = MakeUnique<IoRateLimiter>(0);
+                break;
+            }
+            case BGTaskLane::kIndexBuild: {
+                lane->thread_num_ = std::max<SizeT>(options.index_build_thread_num_, 1);
+                lane->nice_ = options.index_build_nice_;
+                lane->io_rate_limiter_ = MakeUnique<IoRateLimiter>(options.io_rate_limit_);
+                break;
+            }
+            case BGTaskLane::kCleanup: {
+                lane->thread_num_ = 1;
+                lane->nice_ = options.cleanup_nice_;
+                lane->io_rate_limiter_ = MakeUnique<IoRateLimiter>(options.io_rate_limit_);
+                break;
+            }
+            default: {
+                UnrecoverableError("Invalid background task lane");
+            }
+        }
+        lanes_[i] = std::move(lane);
+    }
+}
 
 void BGTaskProcessor::Start() {
-    processor_thread_ = Thread([this] { Process(); });
+    for (auto &lane : lanes_) {
+        for (SizeT i = 0; i < lane->thread_num_; ++i) {
+            lane->threads_.emplace_back([this, lane = lane.get()] { Process(lane); });
+        }
+    }
     LOG_INFO("Background processor is started.");
 }
 
 void BGTaskProcessor::Stop() {
     LOG_INFO("Background processor is stopping.");
-    SharedPtr<StopProcessorTask> stop_task = MakeShared<StopProcessorTask>();
-    task_queue_.Enqueue(stop_task);
-    stop_task->Wait();
-    processor_thread_.join();
+    // The index lane is drained first, so that the checkpoints left in the queue save the index files its tasks wrote.
+    for (BGTaskLane lane_id : {BGTaskLane::kIndexBuild, BGTaskLane::kCheckpoint, BGTaskLane::kCleanup}) {
+        auto &lane = lanes_[SizeT(lane_id)];
+        // one stop task for each thread of the lane
+        for (SizeT i = 0; i < lane->threads_.size(); ++i) {
+            SharedPtr<StopProcessorTask> stop_task = MakeShared<StopProcessorTask>();
+            lane->task_queue_.Enqueue(stop_task);
+            stop_task->Wait();
+        }
+        for (auto &thread : lane->threads_) {
+            thread.join();
+        }
+        lane->threads_.clear();
+    }
     LOG_INFO("Background processor is stopped.");
 }
 
-void BGTaskProcessor::Submit(SharedPtr<BGTask> bg_task) { task_queue_.Enqueue(std::move(bg_task)); }
-
-void BGTaskProcessor::Process() {
-    bool running{true};
-    Deque<SharedPtr<BGTask>> tasks;
-    while (running) {
-        task_queue_.DequeueBulk(tasks);
-        for (const auto &bg_task : tasks) {
-            switch (bg_task->type_) {
-                case BGTaskType::kStopProcessor: {
-                    LOG_INFO("Stop the background processor");
-                    running = false;
-                    break;
-                }
-                case BGTaskType::kForceCheckpoint: {
-                    LOG_INFO("Force checkpoint in background");
-                    ForceCheckpointTask *force_ckp_task = static_cast<ForceCheckpointTask *>(bg_task.get());
-                    auto [max_commit_ts, wal_size] = catalog_->GetCheckpointState();
-                    wal_manager_->Checkpoint(force_ckp_task, max_commit_ts, wal_size);
-                    LOG_INFO("Force checkpoint in background done");
-                    break;
-                }
-                case BGTaskType::kAddDeltaEntry: {
-                    auto *task = static_cast<AddDeltaEntryTask *>(bg_task.get());
-                    catalog_->AddDeltaEntry(std::move(task->delta_entry_), task->wal_size_);
-                    break;
-                }
-                case BGTaskType::kCheckpoint: {
-                    LOG_INFO("Checkpoint in background");
-                    auto *task = static_cast<CheckpointTask *>(bg_task.get());
-                    bool is_full_checkpoint = task->is_full_checkpoint_;
-                    auto [max_commit_ts, wal_size] = catalog_->GetCheckpointState();
-                    wal_manager_->Checkpoint(is_full_checkpoint, max_commit_ts, wal_size);
-                    LOG_INFO("Checkpoint in background done");
-                    break;
-                }
-                case BGTaskType::kCleanup: {
-                    LOG_INFO("Cleanup in background");
-                    auto task = static_cast<CleanupTask *>(bg_task.get());
-                    task->Execute();
-                    LOG_INFO("Cleanup in background done");
-                    break;
-                }
-                case BGTaskType::kUpdateSegmentBloomFilterData: {
-                    LOG_INFO("Update segment bloom filter");
-                    auto *task = static_cast<UpdateSegmentBloomFilterTask *>(bg_task.get());
-                    task->Execute();
-                    LOG_INFO("Update segment bloom filter done");
-                    break;
-                }
-                default: {
-                    UnrecoverableError(fmt::format("Invalid background task: {}", (u8)bg_task->type_));
-                    break;
-                }
-            }
+void BGTaskProcessor::Submit(SharedPtr<BGTask> bg_task) {
+    BGTaskLane lane = GetLane(bg_task->type_);
+    lanes_[SizeT(lane)]->task_queue_.Enqueue(std::move(bg_task));
+}
 
+Vector<BGTaskLaneInfo> BGTaskProcessor::GetLaneInfos() const {
+    Vector<BGTaskLaneInfo> lane_infos;
+    for (const auto &lane : lanes_) {
+        lane_infos.push_back(BGTaskLaneInfo{BGTaskLaneToString(lane->lane_),
+                                            lane->thread_num_,
+                                            lane->task_queue_.Size(),
+                                            lane->task_count_.load(),
+                                            lane->busy_time_us_.load() / 1000,
+                                            lane->io_rate_limiter_->acquired_bytes()});
+    }
+    return lane_infos;
+}
+
+BGTaskLane BGTaskProcessor::GetLane(BGTaskType type) {
+    switch (type) {
+        case BGTaskType::kAddDeltaEntry:
+        case BGTaskType::kCheckpoint:
+        case BGTaskType::kForceCheckpoint: {
+            return BGTaskLane::kCheckpoint;
+        }
+        case BGTaskType::kUpdateSegmentBloomFilterData:
+        case BGTaskType::kBuildSecondaryIndex: {
+            return BGTaskLane::kIndexBuild;
+        }
+        case BGTaskType::kCleanup: {
+            return BGTaskLane::kCleanup;
+        }
+        default: {
+            UnrecoverableError(fmt::format("Invalid background task: {}", BGTaskTypeToString(type)));
+        }
+    }
+    return BGTaskLane::kInvalid;
+}
+
+void BGTaskProcessor::Process(Lane *lane) {
+    SetBGThreadNice(lane->nice_);
+    IoRateLimiter::SetCurrent(lane->io_rate_limiter_.get());
+    while (true) {
+        SharedPtr<BGTask> bg_task = lane->task_queue_.DequeueReturn();
+        if (bg_task->type_ == BGTaskType::kStopProcessor) {
+            LOG_INFO(fmt::format("Stop the {} lane thread of background processor", BGTaskLaneToString(lane->lane_)));
             bg_task->Complete();
+            break;
+        }
+        auto begin_time = std::chrono::steady_clock::now();
+        Execute(bg_task.get());
+        auto end_time = std::chrono::steady_clock::now();
+        lane->busy_time_us_ += std::chrono::duration_cast<std::chrono::microseconds>(end_time - begin_time).count();
+        ++lane->task_count_;
+        bg_task->Complete();
+    }
+    IoRateLimiter::SetCurrent(nullptr);
+}
+
+void BGTaskProcessor::Execute(BGTask *bg_task) {
+    switch (bg_task->type_) {
+        case BGTaskType::kForceCheckpoint: {
+            LOG_INFO("Force checkpoint in background");
+            std::unique_lock lock(checkpoint_cleanup_mutex_);
+            ForceCheckpointTask *force_ckp_task = static_cast<ForceCheckpointTask *>(bg_task);
+            auto [max_commit_ts, wal_size] = catalog_->GetCheckpointState();
+            wal_manager_->Checkpoint(force_ckp_task, max_commit_ts, wal_size);
+            LOG_INFO("Force checkpoint in background done");
+            break;
+        }
+        case BGTaskType::kAddDeltaEntry: {
+            auto *task = static_cast<AddDeltaEntryTask *>(bg_task);
+            catalog_->AddDeltaEntry(std::move(task->delta_entry_), task->wal_size_);
+            break;
+        }
+        case BGTaskType::kCheckpoint: {
+            LOG_INFO("Checkpoint in background");
+            std::unique_lock lock(checkpoint_cleanup_mutex_);
+            auto *task = static_cast<CheckpointTask *>(bg_task);
+            bool is_full_checkpoint = task->is_full_checkpoint_;
+            auto [max_commit_ts, wal_size] = catalog_->GetCheckpointState();
+            wal_manager_->Checkpoint(is_full_checkpoint, max_commit_ts, wal_size);
+            LOG_INFO("Checkpoint in background done");
+            break;
+        }
+        case BGTaskType::kCleanup: {
+            LOG_INFO("Cleanup in background");
+            std::unique_lock lock(checkpoint_cleanup_mutex_);
+            auto task = static_cast<CleanupTask *>(bg_task);
+            task->Execute();
+            LOG_INFO("Cleanup in background done");
+            break;
+        }
+        case BGTaskType::kUpdateSegmentBloomFilterData: {
+            LOG_INFO("Update segment bloom filter");
+            std::shared_lock lock(checkpoint_cleanup_mutex_);
+            auto *task = static_cast<UpdateSegmentBloomFilterTask *>(bg_task);
+            task->Execute();
+            LOG_INFO("Update segment bloom filter done");
+            break;
+        }
+        case BGTaskType::kBuildSecondaryIndex: {
+            std::shared_lock lock(checkpoint_cleanup_mutex_);
+            auto *task = static_cast<BuildSecondaryIndexTask *>(bg_task);
+            task->Execute();
+            break;
+        }
+        default: {
+            UnrecoverableError(fmt::format("Invalid background task: {}", (u8)bg_task->type_));
+            break;
         }
-        tasks.clear();
     }
 }
 
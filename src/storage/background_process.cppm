@@ -18,6 +18,7 @@ import wal_manager;
 import blocking_queue;
 import bg_task;
 import stl;
+import io_rate_limiter;
 
 export module background_process;
 
@@ -25,23 +26,74 @@ namespace infinity {
 
 class Catalog;
 
+// The lanes of the background processor, each with its own queue and threads: a long task of one lane doesn't delay the tasks of
+// another, e.g. an index build doesn't delay the checkpoints which recycle the wal.
+export enum class BGTaskLane {
+    kCheckpoint, // checkpoints and the delta entries they save, one thread to keep them in order
+    kIndexBuild, // the data built for sealed segments, e.g. bloom filters
+    kCleanup,
+    kInvalid,
+};
+
+export String BGTaskLaneToString(BGTaskLane lane);
+
+export struct BGTaskLaneInfo {
+    String name_{};
+    SizeT thread_num_{};
+    SizeT queue_size_{};
+    u64 task_count_{};
+    u64 busy_time_ms_{};
+    u64 io_bytes_{};
+};
+
+// Lower the priority of the calling thread by `nice`, so that background work yields the cpu to the queries.
+export void SetBGThreadNice(i32 nice);
+
+// The checkpoint and cleanup lanes have one thread each: the delta entries and checkpoints are applied in order, and a cleanup is serialized
+// with the checkpoints anyway.
+export struct BGTaskProcessorOptions {
+    SizeT index_build_thread_num_{1};
+    i32 checkpoint_nice_{0};
+    i32 index_build_nice_{10};
+    i32 cleanup_nice_{10};
+    u64 io_rate_limit_{0}; // bytes per second of each lane but the checkpoint one, 0 means unlimited
+};
+
 export class BGTaskProcessor {
 public:
-    explicit BGTaskProcessor(WalManager *wal_manager, Catalog *catalog);
+    explicit BGTaskProcessor(WalManager *wal_manager, Catalog *catalog, const BGTaskProcessorOptions &options = {});
     void Start();
     void Stop();
 
 public:
     void Submit(SharedPtr<BGTask> bg_task);
 
+    Vector<BGTaskLaneInfo> GetLaneInfos() const;
+
+    static BGTaskLane GetLane(BGTaskType type);
+
 private:
-    void Process();
-    void CompactProcess();
+    struct Lane {
+        BGTaskLane lane_{BGTaskLane::kInvalid};
+        SizeT thread_num_{};
+        i32 nice_{};
+        BlockingQueue<SharedPtr<BGTask>> task_queue_{};
+        Vector<Thread> threads_{};
+        UniquePtr<IoRateLimiter> io_rate_limiter_{};
+        Atomic<u64> task_count_{0};
+        Atomic<u64> busy_time_us_{0};
+    };
+
+    void Process(Lane *lane);
+
+    void Execute(BGTask *bg_task);
 
 private:
-    BlockingQueue<SharedPtr<BGTask>> task_queue_;
+    Array<UniquePtr<Lane>, SizeT(BGTaskLane::kInvalid)> lanes_{};
 
-    Thread processor_thread_{};
+    // A cleanup deletes the files of the entries it removes, while a checkpoint may be flushing or saving them. The index lane tasks
+    // write the files of sealed segments: they take it shared, the checkpoints and cleanups exclusively.
+    std::shared_mutex checkpoint_cleanup_mutex_{};
 
     WalManager *wal_manager_{};
     Catalog *catalog_{};
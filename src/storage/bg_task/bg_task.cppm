@@ -34,6 +34,7 @@ export enum class BGTaskType {
     kNotifyOptimize,
     kCleanup,
     kUpdateSegmentBloomFilterData, // Not used
+    kBuildSecondaryIndex,
     kInvalid
 };
 
@@ -55,6 +56,8 @@ export String BGTaskTypeToString(BGTaskType type) {
             return "Cleanup";
         case BGTaskType::kUpdateSegmentBloomFilterData:
             return "UpdateSegmentBloomFilterData";
+        case BGTaskType::kBuildSecondaryIndex:
+            return "BuildSecondaryIndex";
         default:
             return "Invalid";
     }
@@ -47,6 +47,7 @@ import compaction_alg;
 import status;
 import build_fast_rough_filter_task;
 import catalog_delta_entry;
+import data_block;
 
 namespace infinity {
 
@@ -283,6 +284,18 @@ void CompactSegmentsTask::ApplyDeletes(CompactSegmentsTaskState &state) {
         }
     }
     txn_->Delete(*db_name_, *table_name_, row_ids, false);
+
+    for (const auto &update_info : to_updates_) {
+        Vector<RowID> update_row_ids;
+        SharedPtr<DataBlock> values = DataBlock::Make();
+        values->Init(update_info.values_->types(), update_info.update_rows_.size());
+        for (const auto &[offset, value_idx] : update_info.update_rows_) {
+            update_row_ids.push_back(remapper.GetNewRowID(RowID(update_info.segment_id_, offset)));
+            values->AppendWith(update_info.values_.get(), value_idx, 1);
+        }
+        values->Finalize();
+        txn_->Update(*db_name_, *table_name_, update_row_ids, update_info.column_ids_, values, false);
+    }
 }
 
 void CompactSegmentsTask::AddToDelete(SegmentID segment_id, Vector<SegmentOffset> &&delete_offsets) {
@@ -290,6 +303,14 @@ void CompactSegmentsTask::AddToDelete(SegmentID segment_id, Vector<SegmentOffset
     to_deletes_.emplace_back(ToDeleteInfo{segment_id, std::move(delete_offsets)});
 }
 
+void CompactSegmentsTask::AddToUpdate(SegmentID segment_id,
+                                      Vector<Pair<SegmentOffset, u32>> &&update_rows,
+                                      const Vector<ColumnID> &column_ids,
+                                      const SharedPtr<DataBlock> &values) {
+    std::unique_lock lock(mutex_);
+    to_updates_.emplace_back(ToUpdateInfo{segment_id, std::move(update_rows), column_ids, values});
+}
+
 SharedPtr<SegmentEntry> CompactSegmentsTask::CompactSegmentsToOne(CompactSegmentsTaskState &state, const Vector<SegmentEntry *> &segments) {
     auto *table_entry = state.table_entry_;
     auto &remapper = state.remapper_;
@@ -306,7 +327,8 @@ SharedPtr<SegmentEntry> CompactSegmentsTask::CompactSegmentsToOne(CompactSegment
             Vector<ColumnVector> input_column_vectors;
             for (ColumnID column_id = 0; column_id < column_count; ++column_id) {
                 auto *column_block_entry = old_block->GetColumnBlockEntry(column_id);
-                input_column_vectors.emplace_back(column_block_entry->GetColumnVector(buffer_mgr));
+                // merge the in place updates visible at begin_ts, later ones must in to_update
+                input_column_vectors.emplace_back(column_block_entry->GetColumnVector(buffer_mgr, old_block->row_count(), begin_ts));
             }
             SizeT read_offset = 0;
             while (true) {
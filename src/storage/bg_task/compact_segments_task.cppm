@@ -29,6 +29,7 @@ namespace infinity {
 
 class TableEntry;
 class SegmentEntry;
+class DataBlock;
 
 class RowIDRemapper {
 private:
@@ -64,6 +65,16 @@ struct ToDeleteInfo {
     const Vector<SegmentOffset> delete_offsets_;
 };
 
+struct ToUpdateInfo {
+    const SegmentID segment_id_;
+
+    const Vector<Pair<SegmentOffset, u32>> update_rows_; // (segment offset, row of the new value in values_)
+
+    const Vector<ColumnID> column_ids_;
+
+    const SharedPtr<DataBlock> values_;
+};
+
 export struct CompactSegmentsTaskState {
     // default copy construct of table ref
     CompactSegmentsTaskState(TableEntry *table_entry) : table_entry_(table_entry) {}
@@ -110,6 +121,12 @@ public:
     // TODO: remove lock
     void AddToDelete(SegmentID segment_id, Vector<SegmentOffset> &&delete_offsets);
 
+    // Called by `SegmentEntry::UpdateData`, same as `AddToDelete`.
+    void AddToUpdate(SegmentID segment_id,
+                     Vector<Pair<SegmentOffset, u32>> &&update_rows,
+                     const Vector<ColumnID> &column_ids,
+                     const SharedPtr<DataBlock> &values);
+
     // these functions are called by unit test. Do not use them directly.
 public:
     void CompactSegments(CompactSegmentsTaskState &state);
@@ -119,7 +136,7 @@ public:
     // Save new segment, set no_delete_ts, add compact wal cmd
     void SaveSegmentsData(CompactSegmentsTaskState &state);
 
-    // Apply the delete op commit in process of compacting
+    // Apply the delete and update op commit in process of compacting
     void ApplyDeletes(CompactSegmentsTaskState &state);
 
 public:
@@ -140,5 +157,6 @@ private:
 
     std::mutex mutex_;
     Vector<ToDeleteInfo> to_deletes_;
+    Vector<ToUpdateInfo> to_updates_;
 };
 } // namespace infinity
\ No newline at end of file
@@ -0,0 +1,59 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+module;
+
+module build_secondary_index_task;
+
+import stl;
+import bg_task;
+import background_process;
+import txn_manager;
+import segment_entry;
+import segment_index_entry;
+import buffer_manager;
+import logger;
+import third_party;
+
+namespace infinity {
+
+void BuildSecondaryIndexTask::CreateAndSubmitTask(SharedPtr<SegmentIndexEntry> segment_index_entry,
+                                                  SharedPtr<SegmentEntry> segment_entry,
+                                                  BufferManager *buffer_mgr,
+                                                  TxnTimeStamp begin_ts,
+                                                  TxnManager *txn_mgr) {
+    LOG_TRACE(fmt::format("BuildSecondaryIndexTask: create task for segment: {}", segment_entry->segment_id()));
+    auto build_task = MakeShared<BuildSecondaryIndexTask>(std::move(segment_index_entry), std::move(segment_entry), buffer_mgr, begin_ts);
+    if (txn_mgr == nullptr) {
+        // Replaying the wal, there is no background processor yet.
+        build_task->Execute();
+        return;
+    }
+    txn_mgr->bg_task_processor()->Submit(std::move(build_task));
+}
+
+void BuildSecondaryIndexTask::Execute() {
+    // The background processor holds the checkpoint and cleanup lock: the files of a segment not deprecated yet are not cleaned up
+    // before the task ends.
+    if (segment_entry_->status() == SegmentStatus::kDeprecated) {
+        LOG_TRACE(fmt::format("BuildSecondaryIndexTask: segment {} is deprecated, skip task", segment_entry_->segment_id()));
+        return;
+    }
+    // All the rows of a sealed segment are committed.
+    segment_index_entry_->BuildSecondaryIndex(segment_entry_.get(), buffer_mgr_, begin_ts_, false);
+    // The rebuilt files are saved here, the commit saves the files of a segment index created by its txn only.
+    segment_index_entry_->SaveIndexFile();
+}
+
+} // namespace infinity
@@ -0,0 +1,56 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+module;
+
+export module build_secondary_index_task;
+
+import stl;
+import bg_task;
+import segment_entry;
+import segment_index_entry;
+import buffer_manager;
+import txn_manager;
+
+namespace infinity {
+
+// Rebuilds the PGM index of a sealed segment with all its rows and saves it. Until then the rows appended after the previous build
+// are searched in the memory secondary index.
+export class BuildSecondaryIndexTask final : public BGTask {
+public:
+    static void CreateAndSubmitTask(SharedPtr<SegmentIndexEntry> segment_index_entry,
+                                    SharedPtr<SegmentEntry> segment_entry,
+                                    BufferManager *buffer_mgr,
+                                    TxnTimeStamp begin_ts,
+                                    TxnManager *txn_mgr);
+
+    BuildSecondaryIndexTask(SharedPtr<SegmentIndexEntry> segment_index_entry,
+                            SharedPtr<SegmentEntry> segment_entry,
+                            BufferManager *buffer_mgr,
+                            TxnTimeStamp begin_ts)
+        : BGTask(BGTaskType::kBuildSecondaryIndex, true), segment_index_entry_(std::move(segment_index_entry)),
+          segment_entry_(std::move(segment_entry)), buffer_mgr_(buffer_mgr), begin_ts_(begin_ts) {}
+
+    String ToString() const override { return "BuildSecondaryIndexTask"; }
+
+    void Execute();
+
+private:
+    SharedPtr<SegmentIndexEntry> segment_index_entry_{};
+    SharedPtr<SegmentEntry> segment_entry_{};
+    BufferManager *buffer_mgr_{};
+    TxnTimeStamp begin_ts_{};
+};
+
+} // namespace infinity
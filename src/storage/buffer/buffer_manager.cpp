@@ -26,16 +26,31 @@ import logger;
 import specific_concurrent_queue;
 import infinity_exception;
 import buffer_obj;
+import async_io_pool;
+import default_values;
+import status;
 
 namespace infinity {
-BufferManager::BufferManager(u64 memory_limit, SharedPtr<String> data_dir, SharedPtr<String> temp_dir)
-    : data_dir_(std::move(data_dir)), temp_dir_(std::move(temp_dir)), memory_limit_(memory_limit), current_memory_size_(0) {
+BufferManager::BufferManager(u64 memory_limit, SharedPtr<String> data_dir, SharedPtr<String> temp_dir, SizeT prefetch_thread_num)
+    : data_dir_(std::move(data_dir)), temp_dir_(std::move(temp_dir)), memory_limit_(memory_limit), current_memory_size_(0),
+      async_io_pool_(MakeUnique<AsyncIoPool>(prefetch_thread_num)) {
     LocalFileSystem fs;
     if (!fs.Exists(*data_dir_)) {
         fs.CreateDirectory(*data_dir_);
     }
 
     fs.CleanupDirectory(*temp_dir_);
+
+    flush_thread_ = Thread([this] { Flush(); });
+}
+
+BufferManager::~BufferManager() {
+    {
+        std::unique_lock lock(flush_locker_);
+        stop_flush_ = true;
+    }
+    flush_cv_.notify_one();
+    flush_thread_.join();
 }
 
 BufferObj *BufferManager::Allocate(UniquePtr<FileWorker> file_worker) {
@@ -70,6 +85,9 @@ BufferObj *BufferManager::Get(UniquePtr<FileWorker> file_worker) {
 }
 
 void BufferManager::RemoveClean() {
+    // no prefetch may still refer to a removed buffer object
+    async_io_pool_->Drain();
+
     Vector<BufferObj *> clean_list;
     {
         std::unique_lock lock(clean_locker_);
@@ -88,6 +106,8 @@ void BufferManager::RemoveClean() {
                 gc_map_.erase(iter);
             }
         }
+        // a buffer object taken out of gc_list_ before may still be freed or written back
+        space_cv_.wait(lock, [this] { return evicting_n_ == 0; });
     }
     {
         std::unique_lock lock(w_locker_);
@@ -101,24 +121,117 @@ void BufferManager::RemoveClean() {
     }
 }
 
+void BufferManager::Prefetch(BufferObj *buffer_obj) {
+    async_io_pool_->Submit([this, buffer_obj] {
+        if (buffer_obj->Prefetch()) {
+            ++prefetch_count_;
+        }
+    });
+}
+
 void BufferManager::RequestSpace(SizeT need_size) {
-    std::unique_lock lock(gc_locker_);
-    while (current_memory_size_ + need_size > memory_limit_ && !gc_list_.empty()) {
-        auto *buffer_obj = gc_list_.front();
+    if (!RequestSpaceInner(need_size, true)) {
+        RecoverableError(Status::OutOfMemory(fmt::format("Buffer manager can't get {} bytes in {}s, memory usage: {}/{}",
+                                                         need_size,
+                                                         BUFFER_REQUEST_SPACE_TIMEOUT_SEC,
+                                                         memory_usage(),
+                                                         memory_limit_)));
+    }
+}
+
+bool BufferManager::TryRequestSpace(SizeT need_size) { return RequestSpaceInner(need_size, false); }
 
-        // Free return false when the buffer is freed by cleanup
-        // will not dead lock because caller is in kNew or kFree state, and `buffer_obj` is in kUnloaded or kClean state
-        if (buffer_obj->Free()) {
-            current_memory_size_ -= buffer_obj->GetBufferSize();
+bool BufferManager::RequestSpaceInner(SizeT need_size, bool wait) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(BUFFER_REQUEST_SPACE_TIMEOUT_SEC);
+    bool waited = false;
+    std::unique_lock lock(gc_locker_);
+    while (true) {
+        if (current_memory_size_ + need_size <= memory_limit_) {
+            current_memory_size_ += need_size;
+            return true;
         }
+        if (!gc_list_.empty() && current_memory_size_ + need_size > memory_limit_ + evicting_size_) {
+            // Take the least recently used buffers covering the missing memory, the buffers being evicted by other threads included.
+            Vector<BufferObj *> victims;
+            SizeT victim_size = 0;
+            while (!gc_list_.empty() && current_memory_size_ + need_size > memory_limit_ + evicting_size_ + victim_size) {
+                BufferObj *buffer_obj = gc_list_.front();
+                gc_list_.pop_front();
+                gc_map_.erase(buffer_obj);
+                victims.push_back(buffer_obj);
+                victim_size += buffer_obj->GetBufferSize();
+            }
+            evicting_size_ += victim_size;
+            ++evicting_n_;
+            lock.unlock();
+
+            // Free a dirty buffer writes it to disk, other threads may request space meanwhile.
+            // Free return false when the buffer is loaded again or freed by cleanup after it was taken out of gc_list_.
+            SizeT freed_size = 0;
+            for (auto *buffer_obj : victims) {
+                if (buffer_obj->Free()) {
+                    freed_size += buffer_obj->GetBufferSize();
+                    ++evict_count_;
+                }
+            }
 
-        gc_list_.pop_front();
-        gc_map_.erase(buffer_obj);
+            lock.lock();
+            current_memory_size_ -= freed_size;
+            evicting_size_ -= victim_size;
+            --evicting_n_;
+            space_cv_.notify_all();
+            continue;
+        }
+        if ((!wait && evicting_n_ == 0) || std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        // Back pressure: wait for the evictions of other threads or for buffers to be unloaded.
+        if (!waited) {
+            waited = true;
+            ++space_wait_count_;
+        }
+        space_cv_.wait_until(lock, deadline);
     }
-    if (current_memory_size_ + need_size > memory_limit_) {
-        UnrecoverableError("Out of memory.");
+}
+
+void BufferManager::Flush() {
+    while (true) {
+        {
+            std::unique_lock lock(flush_locker_);
+            flush_cv_.wait_for(lock, std::chrono::milliseconds(BUFFER_FLUSH_INTERVAL_MS), [this] { return stop_flush_; });
+            if (stop_flush_) {
+                break;
+            }
+        }
+        Vector<BufferObj *> dirty_buffers;
+        {
+            std::unique_lock lock(gc_locker_);
+            SizeT watermark = memory_limit_ * BUFFER_FLUSH_FREE_RATIO;
+            SizeT clean_size = current_memory_size_ < memory_limit_ ? memory_limit_ - current_memory_size_ : 0;
+            for (auto iter = gc_list_.begin(); iter != gc_list_.end() && clean_size < watermark; ++iter) {
+                BufferObj *buffer_obj = *iter;
+                clean_size += buffer_obj->GetBufferSize();
+                // the type is only a hint here, WriteBack checks it again
+                if (buffer_obj->type() == BufferType::kEphemeral && !buffer_obj->spilled()) {
+                    dirty_buffers.push_back(buffer_obj);
+                }
+            }
+            if (dirty_buffers.empty()) {
+                continue;
+            }
+            ++evicting_n_;
+        }
+        for (auto *buffer_obj : dirty_buffers) {
+            if (buffer_obj->WriteBack()) {
+                ++write_back_count_;
+            }
+        }
+        {
+            std::unique_lock lock(gc_locker_);
+            --evicting_n_;
+            space_cv_.notify_all();
+        }
     }
-    current_memory_size_ += need_size;
 }
 
 void BufferManager::PushGCQueue(BufferObj *buffer_obj) {
@@ -129,6 +242,7 @@ void BufferManager::PushGCQueue(BufferObj *buffer_obj) {
     }
     gc_list_.push_back(buffer_obj);
     gc_map_[buffer_obj] = --gc_list_.end();
+    space_cv_.notify_all();
 }
 
 bool BufferManager::RemoveFromGCQueue(BufferObj *buffer_obj) {
@@ -147,9 +261,14 @@ void BufferManager::AddToCleanList(BufferObj *buffer_obj, bool free) {
         clean_list_.push_back(buffer_obj);
     }
     if (free) {
-        std::unique_lock lock(w_locker_);
-        current_memory_size_ -= buffer_obj->GetBufferSize();
+        ReleaseSpace(buffer_obj->GetBufferSize());
     }
 }
 
+void BufferManager::ReleaseSpace(SizeT size) {
+    std::unique_lock lock(gc_locker_);
+    current_memory_size_ -= size;
+    space_cv_.notify_all();
+}
+
 } // namespace infinity
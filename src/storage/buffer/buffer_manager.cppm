@@ -16,6 +16,8 @@ module;
 
 import stl;
 import file_worker;
+import default_values;
+import async_io_pool;
 // import specific_concurrent_queue;
 
 export module buffer_manager;
@@ -26,7 +28,12 @@ class BufferObj;
 
 export class BufferManager {
 public:
-    explicit BufferManager(u64 memory_limit, SharedPtr<String> data_dir, SharedPtr<String> temp_dir);
+    explicit BufferManager(u64 memory_limit,
+                           SharedPtr<String> data_dir,
+                           SharedPtr<String> temp_dir,
+                           SizeT prefetch_thread_num = DEFAULT_BUFFER_PREFETCH_THREAD_NUM);
+
+    ~BufferManager();
 
 public:
     // Create a new BufferHandle, or in replay process. (read data block from wal)
@@ -51,12 +58,42 @@ public:
 
     void RemoveClean();
 
+    // Read the buffer in the background, the scan loading it later doesn't wait on the disk.
+    // Nothing is read if the buffer is in memory already or the memory is exhausted.
+    void Prefetch(BufferObj *buffer_obj);
+
+    // Number of the prefetch reads queued or running.
+    SizeT prefetch_pending() const { return async_io_pool_->pending(); }
+
+    u64 prefetch_count() const { return prefetch_count_.load(); }
+
+    // Number of the dirty buffers written back by the flusher ahead of their eviction.
+    u64 write_back_count() const { return write_back_count_.load(); }
+
+    u64 evict_count() const { return evict_count_.load(); }
+
+    // Number of the requests which waited for memory to be unloaded.
+    u64 space_wait_count() const { return space_wait_count_.load(); }
+
 private:
     friend class BufferObj;
 
     // BufferHandle calls it, before allocate memory. It will start GC if necessary.
+    // Wait for memory to be unloaded by other threads if nothing can be evicted, fail the query if it isn't in time.
     void RequestSpace(SizeT need_size);
 
+    // Same as RequestSpace, but return false instead of waiting when nothing can be evicted.
+    bool TryRequestSpace(SizeT need_size);
+
+    bool RequestSpaceInner(SizeT need_size, bool wait);
+
+    // Give back the space of a buffer freed or never loaded, and wake up the requests waiting for it.
+    void ReleaseSpace(SizeT size);
+
+    // The flusher thread. Write back the dirty least recently used buffers so the free memory plus the memory evictable without
+    // writing stays above the watermark, the eviction on demand then only releases memory.
+    void Flush();
+
     // BufferHandle calls it, after unload.
     void PushGCQueue(BufferObj *buffer_obj);
 
@@ -77,9 +114,25 @@ private:
     std::mutex gc_locker_{};
     HashMap<BufferObj *, GCListIter> gc_map_{};
     List<BufferObj *> gc_list_{};
+    // The buffers taken out of gc_list_ are freed without holding gc_locker_.
+    SizeT evicting_size_{0};
+    SizeT evicting_n_{0};
+    std::condition_variable space_cv_{};
 
     std::mutex clean_locker_{};
     Vector<BufferObj *> clean_list_{};
+
+    Atomic<u64> prefetch_count_{0};
+    Atomic<u64> write_back_count_{0};
+    Atomic<u64> evict_count_{0};
+    Atomic<u64> space_wait_count_{0};
+
+    std::mutex flush_locker_{};
+    std::condition_variable flush_cv_{};
+    bool stop_flush_{false};
+    Thread flush_thread_{};
+    // declared last to stop the io threads before the buffer objects are destroyed
+    UniquePtr<AsyncIoPool> async_io_pool_{};
 };
 
 } // namespace infinity
\ No newline at end of file
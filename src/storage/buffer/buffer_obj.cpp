@@ -46,14 +46,14 @@ BufferObj::~BufferObj() = default;
 
 BufferHandle BufferObj::Load() {
     std::unique_lock<std::shared_mutex> w_locker(rw_locker_);
+    spilled_ = false;
     switch (status_) {
         case BufferStatus::kLoaded: {
             break;
         }
         case BufferStatus::kUnloaded: {
-            if (!buffer_mgr_->RemoveFromGCQueue(this)) {
-                UnrecoverableError(fmt::format("attempt to buffer: {} status is UNLOADED, but not in GC queue", GetFilename()));
-            }
+            // not in the GC queue if it's being evicted, the eviction finds it loaded and leaves it
+            buffer_mgr_->RemoveFromGCQueue(this);
             break;
         }
         case BufferStatus::kFreed: {
@@ -81,14 +81,35 @@ BufferHandle BufferObj::Load() {
     return BufferHandle(this, data);
 }
 
-bool BufferObj::Free() {
+bool BufferObj::Prefetch() {
     std::unique_lock<std::shared_mutex> w_locker(rw_locker_);
-    // no lock is needed because already in gc_queue
-    if (status_ == BufferStatus::kClean) {
+    if (status_ != BufferStatus::kFreed || type_ != BufferType::kPersistent) {
         return false;
     }
+    // a read ahead doesn't fail the query when the memory is exhausted
+    if (!buffer_mgr_->TryRequestSpace(GetBufferSize())) {
+        return false;
+    }
+    try {
+        file_worker_->ReadFromFile(false);
+    } catch (...) {
+        // the buffer stays freed, the reader loads it itself
+        if (file_worker_->GetData() != nullptr) {
+            file_worker_->FreeInMemory();
+        }
+        buffer_mgr_->ReleaseSpace(GetBufferSize());
+        throw;
+    }
+    status_ = BufferStatus::kUnloaded;
+    buffer_mgr_->PushGCQueue(this);
+    return true;
+}
+
+bool BufferObj::Free() {
+    std::unique_lock<std::shared_mutex> w_locker(rw_locker_);
+    // The buffer was taken out of the gc queue without its lock, it may be loaded again, freed by another eviction or cleaned since.
     if (status_ != BufferStatus::kUnloaded) {
-        UnrecoverableError(fmt::format("attempt to free {} buffer object", BufferStatusToString(status_)));
+        return false;
     }
     switch (type_) {
         case BufferType::kTemp:
@@ -97,7 +118,9 @@ bool BufferObj::Free() {
             break;
         }
         case BufferType::kEphemeral: {
-            file_worker_->WriteToFile(true);
+            if (!spilled_) {
+                file_worker_->WriteToFile(true);
+            }
             break;
         }
     }
@@ -106,6 +129,17 @@ bool BufferObj::Free() {
     return true;
 }
 
+bool BufferObj::WriteBack() {
+    std::unique_lock<std::shared_mutex> w_locker(rw_locker_);
+    if (status_ != BufferStatus::kUnloaded || type_ != BufferType::kEphemeral || spilled_) {
+        return false;
+    }
+    file_worker_->WriteToFile(true);
+    // the spill file holds the data now, Free only releases the memory unless the buffer is loaded again
+    spilled_ = true;
+    return true;
+}
+
 bool BufferObj::Save() {
     bool write = false;
     std::unique_lock<std::shared_mutex> w_locker(rw_locker_);
@@ -130,6 +164,7 @@ bool BufferObj::Save() {
             }
         }
         type_ = BufferType::kPersistent;
+        spilled_ = false;
     }
     return write;
 }
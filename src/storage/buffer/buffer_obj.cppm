@@ -67,10 +67,20 @@ public:
     // called by ObjectHandle when load first time for that ObjectHandle
     BufferHandle Load();
 
+    // called by BufferMgr::Prefetch in an io thread.
+    // Read a freed persistent buffer into memory and leave it unloaded, so a following Load doesn't wait on the disk.
+    // return false if nothing is read.
+    bool Prefetch();
+
     // called by BufferMgr in GC process.
     // return true if is freed.
     bool Free();
 
+    // called by the BufferMgr flusher.
+    // Write an unloaded dirty buffer to the spill file, so its eviction doesn't write unless it's loaded again.
+    // return true if is written.
+    bool WriteBack();
+
     // called when checkpoint. or in "IMPORT" operator.
     bool Save();
 
@@ -82,6 +92,8 @@ public:
 
     String GetFilename() const { return file_worker_->GetFilePath(); }
 
+    FileWorker *file_worker() const { return file_worker_.get(); }
+
 private:
     // Friend to encapsulate `Unload` interface and to increase `rc_`.
     friend class BufferHandle;
@@ -101,6 +113,7 @@ public:
         return status_;
     }
     BufferType type() const { return type_; }
+    bool spilled() const { return spilled_; }
     u64 rc() const { return rc_; }
 
     // check the invalid state, only used in tests.
@@ -113,6 +126,8 @@ protected:
 
     BufferStatus status_{BufferStatus::kNew};
     BufferType type_{BufferType::kTemp};
+    // an ephemeral buffer whose spill file holds its data, cleared by Load because the data may change through the handle
+    bool spilled_{false};
     u64 rc_{0};
     const UniquePtr<FileWorker> file_worker_;
 };
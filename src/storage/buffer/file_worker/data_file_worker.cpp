@@ -21,11 +21,20 @@ import infinity_exception;
 import local_file_system;
 import third_party;
 import status;
+import block_codec;
+import crc;
 
 namespace infinity {
 
-DataFileWorker::DataFileWorker(SharedPtr<String> file_dir, SharedPtr<String> file_name, SizeT buffer_size)
-    : FileWorker(std::move(file_dir), std::move(file_name)), buffer_size_(buffer_size) {}
+namespace {
+constexpr u64 kPlainMagicNumber = 0x00dd3344;
+constexpr u64 kEncodedMagicNumber = 0x00dd3345;
+
+u64 Checksum(const void *data, SizeT size) { return CRC32IEEE::makeCRC(static_cast<const unsigned char *>(data), size); }
+} // namespace
+
+DataFileWorker::DataFileWorker(SharedPtr<String> file_dir, SharedPtr<String> file_name, SizeT buffer_size, SizeT codec_elem_size)
+    : FileWorker(std::move(file_dir), std::move(file_name)), buffer_size_(buffer_size), codec_elem_size_(codec_elem_size) {}
 
 DataFileWorker::~DataFileWorker() {
     if (data_ != nullptr) {
@@ -53,14 +62,28 @@ void DataFileWorker::FreeInMemory() {
 }
 
 void DataFileWorker::WriteToFileImpl(bool &prepare_success) {
+    if (codec_elem_size_ != 0 && sealed_) {
+        SizeT row_count = buffer_size_ / codec_elem_size_;
+        if (!encoding_.has_value()) {
+            encoding_ = BlockCodec::ChooseEncoding(data_, row_count, codec_elem_size_);
+        }
+        if (*encoding_ != BlockEncodingType::kPlain) {
+            Vector<u8> encoded_data;
+            BlockCodec::Encode(*encoding_, data_, row_count, codec_elem_size_, encoded_data);
+            WriteEncoded(encoded_data);
+            prepare_success = true;
+            return;
+        }
+    }
+
     LocalFileSystem fs;
     // File structure:
     // - header: magic number
     // - header: buffer size
     // - data buffer
-    // - footer: checksum
+    // - footer: checksum of the data buffer
 
-    u64 magic_number = 0x00dd3344;
+    u64 magic_number = kPlainMagicNumber;
     u64 nbytes = fs.Write(*file_handler_, &magic_number, sizeof(magic_number));
     if (nbytes != sizeof(magic_number)) {
         RecoverableError(Status::DataIOError(fmt::format("Write magic number which length is {}.", nbytes)));
@@ -76,7 +99,7 @@ void DataFileWorker::WriteToFileImpl(bool &prepare_success) {
         RecoverableError(Status::DataIOError(fmt::format("Expect to write buffer with size: {}, but {} bytes is written", buffer_size_, nbytes)));
     }
 
-    u64 checksum{};
+    u64 checksum = Checksum(data_, buffer_size_);
     nbytes = fs.Write(*file_handler_, &checksum, sizeof(checksum));
     if (nbytes != sizeof(checksum)) {
         RecoverableError(Status::DataIOError(fmt::format("Write buffer length field which length is {}.", nbytes)));
@@ -98,7 +121,7 @@ void DataFileWorker::ReadFromFileImpl() {
     if (nbytes != sizeof(magic_number)) {
         RecoverableError(Status::DataIOError(fmt::format("Read magic number which length isn't {}.", nbytes)));
     }
-    if (magic_number != 0x00dd3344) {
+    if (magic_number != kPlainMagicNumber && magic_number != kEncodedMagicNumber) {
         RecoverableError(Status::DataIOError(fmt::format("Incorrect file header magic number: {}.", magic_number)));
     }
 
@@ -107,6 +130,10 @@ void DataFileWorker::ReadFromFileImpl() {
     if (nbytes != sizeof(buffer_size_)) {
         RecoverableError(Status::DataIOError(fmt::format("Unmatched buffer length: {} / {}", nbytes, buffer_size_)));
     }
+    if (magic_number == kEncodedMagicNumber) {
+        ReadEncoded(file_size, buffer_size_);
+        return;
+    }
     if (file_size != buffer_size_ + 3 * sizeof(u64)) {
         RecoverableError(Status::DataIOError(fmt::format("File size: {} isn't matched with {}.", file_size, buffer_size_ + 3 * sizeof(u64))));
     }
@@ -124,6 +151,79 @@ void DataFileWorker::ReadFromFileImpl() {
     if (nbytes != sizeof(checksum)) {
         RecoverableError(Status::DataIOError(fmt::format("Incorrect file checksum length: {}.", nbytes)));
     }
+    if (checksum != Checksum(data_, buffer_size_)) {
+        RecoverableError(Status::DataIOError(fmt::format("Checksum mismatch of file {}.", GetFilePath())));
+    }
+}
+
+void DataFileWorker::WriteEncoded(const Vector<u8> &encoded_data) {
+    LocalFileSystem fs;
+    // File structure:
+    // - header: magic number
+    // - header: buffer size
+    // - header: encoded data size
+    // - encoded data buffer
+    // - footer: checksum of the encoded data buffer
+
+    u64 magic_number = kEncodedMagicNumber;
+    u64 nbytes = fs.Write(*file_handler_, &magic_number, sizeof(magic_number));
+    if (nbytes != sizeof(magic_number)) {
+        RecoverableError(Status::DataIOError(fmt::format("Write magic number which length is {}.", nbytes)));
+    }
+
+    u64 buffer_size = buffer_size_;
+    nbytes = fs.Write(*file_handler_, &buffer_size, sizeof(buffer_size));
+    if (nbytes != sizeof(buffer_size)) {
+        RecoverableError(Status::DataIOError(fmt::format("Write buffer length field which length is {}.", nbytes)));
+    }
+
+    u64 encoded_size = encoded_data.size();
+    nbytes = fs.Write(*file_handler_, &encoded_size, sizeof(encoded_size));
+    if (nbytes != sizeof(encoded_size)) {
+        RecoverableError(Status::DataIOError(fmt::format("Write encoded length field which length is {}.", nbytes)));
+    }
+
+    nbytes = fs.Write(*file_handler_, encoded_data.data(), encoded_size);
+    if (nbytes != encoded_size) {
+        RecoverableError(Status::DataIOError(fmt::format("Expect to write encoded buffer with size: {}, but {} bytes is written", encoded_size, nbytes)));
+    }
+
+    u64 checksum = Checksum(encoded_data.data(), encoded_size);
+    nbytes = fs.Write(*file_handler_, &checksum, sizeof(checksum));
+    if (nbytes != sizeof(checksum)) {
+        RecoverableError(Status::DataIOError(fmt::format("Write buffer length field which length is {}.", nbytes)));
+    }
+}
+
+void DataFileWorker::ReadEncoded(SizeT file_size, SizeT buffer_size) {
+    LocalFileSystem fs;
+
+    u64 encoded_size{};
+    u64 nbytes = fs.Read(*file_handler_, &encoded_size, sizeof(encoded_size));
+    if (nbytes != sizeof(encoded_size)) {
+        RecoverableError(Status::DataIOError(fmt::format("Unmatched encoded length: {} / {}", nbytes, encoded_size)));
+    }
+    if (file_size != encoded_size + 4 * sizeof(u64)) {
+        RecoverableError(Status::DataIOError(fmt::format("File size: {} isn't matched with {}.", file_size, encoded_size + 4 * sizeof(u64))));
+    }
+
+    Vector<u8> encoded_data(encoded_size);
+    nbytes = fs.Read(*file_handler_, encoded_data.data(), encoded_size);
+    if (nbytes != encoded_size) {
+        RecoverableError(Status::DataIOError(fmt::format("Expect to read encoded buffer with size: {}, but {} bytes is read", encoded_size, nbytes)));
+    }
+
+    u64 checksum{0};
+    nbytes = fs.Read(*file_handler_, &checksum, sizeof(checksum));
+    if (nbytes != sizeof(checksum)) {
+        RecoverableError(Status::DataIOError(fmt::format("Incorrect file checksum length: {}.", nbytes)));
+    }
+    if (checksum != Checksum(encoded_data.data(), encoded_size)) {
+        RecoverableError(Status::DataIOError(fmt::format("Checksum mismatch of file {}.", GetFilePath())));
+    }
+
+    data_ = static_cast<void *>(new char[buffer_size]{});
+    BlockCodec::Decode(encoded_data.data(), encoded_size, data_, buffer_size);
 }
 
-} // namespace infinity
\ No newline at end of file
+} // namespace infinity
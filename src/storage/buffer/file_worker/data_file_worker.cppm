@@ -18,12 +18,14 @@ export module data_file_worker;
 
 import stl;
 import file_worker;
+import block_codec;
 
 namespace infinity {
 
 export class DataFileWorker : public FileWorker {
 public:
-    explicit DataFileWorker(SharedPtr<String> file_dir, SharedPtr<String> file_name, SizeT buffer_size);
+    // codec_elem_size: element width of an integer column that may be written with a lightweight encoding, 0 to always write plain.
+    explicit DataFileWorker(SharedPtr<String> file_dir, SharedPtr<String> file_name, SizeT buffer_size, SizeT codec_elem_size = 0);
 
     virtual ~DataFileWorker() override;
 
@@ -34,12 +36,24 @@ public:
 
     SizeT GetMemoryCost() const override { return buffer_size_; }
 
+    // Called when the segment of the block is sealed: its data doesn't change anymore, so the encoding is chosen at the next write
+    // and kept for the following ones. The writes before are plain.
+    void Seal() { sealed_ = true; }
+
 protected:
     void WriteToFileImpl(bool &prepare_success) override;
 
     void ReadFromFileImpl() override;
 
+private:
+    void WriteEncoded(const Vector<u8> &encoded_data);
+
+    void ReadEncoded(SizeT file_size, SizeT buffer_size);
+
 private:
     const SizeT buffer_size_;
+    const SizeT codec_elem_size_;
+    Atomic<bool> sealed_{false};
+    Optional<BlockEncodingType> encoding_{};
 };
 } // namespace infinity
\ No newline at end of file
@@ -1528,7 +1528,13 @@ void ColumnVector::Reset() {
     }
 
     //    buffer_.reset();
-    if (buffer_.get() != nullptr) {
+    if (buffer_.get() != nullptr && buffer_->HoldsBufferHandle()) {
+        // The vector references block memory (e.g. output of table scan). Drop it, so that the following Initialize
+        // allocates private memory instead of writing into the block.
+        buffer_.reset();
+        nulls_ptr_.reset();
+        data_ptr_ = nullptr;
+    } else if (buffer_.get() != nullptr) {
         buffer_->fix_heap_mgr_ = nullptr;
     }
     //    data_ptr_ = nullptr;
@@ -21,6 +21,7 @@ import buffer_manager;
 import buffer_handle;
 import infinity_exception;
 import block_column_entry;
+import query_memory_tracker;
 
 module vector_buffer;
 
@@ -68,6 +69,8 @@ void VectorBuffer::InitializeCompactBit(SizeT capacity) {
     }
     SizeT data_size = (capacity + 7) / 8;
     if (data_size > 0) {
+        reservation_ = MemoryReservation(QueryMemoryTracker::Current());
+        reservation_.Resize(data_size);
         ptr_ = MakeUniqueForOverwrite<char[]>(data_size);
     }
     initialized_ = true;
@@ -81,6 +84,8 @@ void VectorBuffer::Initialize(SizeT type_size, SizeT capacity) {
     }
     SizeT data_size = type_size * capacity;
     if (data_size > 0) {
+        reservation_ = MemoryReservation(QueryMemoryTracker::Current());
+        reservation_.Resize(data_size);
         ptr_ = MakeUniqueForOverwrite<char[]>(data_size);
     }
     if (buffer_type_ == VectorBufferType::kHeap) {
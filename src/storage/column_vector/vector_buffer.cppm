@@ -21,6 +21,7 @@ import global_resource_usage;
 import heap_chunk;
 import fix_heap;
 import buffer_handle;
+import query_memory_tracker;
 
 namespace infinity {
 
@@ -77,6 +78,9 @@ public:
         }
     }
 
+    // True if the data is the memory of a block column held by buffer manager, not owned by this vector buffer.
+    [[nodiscard]] bool HoldsBufferHandle() const { return std::holds_alternative<BufferHandle>(ptr_); }
+
     [[nodiscard]] bool GetCompactBit(SizeT idx) const;
 
     void SetCompactBit(SizeT idx, bool val);
@@ -97,6 +101,9 @@ private:
     SizeT data_size_{0};
     SizeT capacity_{0};
 
+    // Owned data is charged to the query allocating it.
+    MemoryReservation reservation_{};
+
 public:
     VectorBufferType buffer_type_{VectorBufferType::kInvalid};
 
@@ -0,0 +1,424 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <bit>
+
+module block_codec;
+
+import stl;
+import logical_type;
+import fastpfor;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+namespace {
+
+constexpr SizeT kMaxDictionarySize = 1 << 16;
+
+u32 BitWidth(u64 value) { return value == 0 ? 0 : 64 - std::countl_zero(value); }
+
+SizeT PackedSize(SizeT count, u32 bit_width) { return (count * bit_width + 7) / 8 + sizeof(u32) * (count / 2048 + 2); }
+
+u64 ZigZag(i64 value) { return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63); }
+
+i64 UnZigZag(u64 value) { return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1); }
+
+i64 ReadValue(const char *src, SizeT idx, SizeT elem_size) {
+    switch (elem_size) {
+        case 1:
+            return reinterpret_cast<const i8 *>(src)[idx];
+        case 2:
+            return reinterpret_cast<const i16 *>(src)[idx];
+        case 4:
+            return reinterpret_cast<const i32 *>(src)[idx];
+        case 8:
+            return reinterpret_cast<const i64 *>(src)[idx];
+        default: {
+            UnrecoverableError(fmt::format("Unsupported element size {} in block codec.", elem_size));
+        }
+    }
+    return 0;
+}
+
+void WriteValue(char *dest, SizeT idx, SizeT elem_size, i64 value) {
+    switch (elem_size) {
+        case 1: {
+            reinterpret_cast<i8 *>(dest)[idx] = static_cast<i8>(value);
+            break;
+        }
+        case 2: {
+            reinterpret_cast<i16 *>(dest)[idx] = static_cast<i16>(value);
+            break;
+        }
+        case 4: {
+            reinterpret_cast<i32 *>(dest)[idx] = static_cast<i32>(value);
+            break;
+        }
+        case 8: {
+            reinterpret_cast<i64 *>(dest)[idx] = value;
+            break;
+        }
+        default: {
+            UnrecoverableError(fmt::format("Unsupported element size {} in block codec.", elem_size));
+        }
+    }
+}
+
+template <typename T>
+void Put(Vector<u8> &dest, const T &value) {
+    SizeT offset = dest.size();
+    dest.resize(offset + sizeof(T));
+    std::memcpy(dest.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T Get(const u8 *&ptr, const u8 *end) {
+    if (ptr + sizeof(T) > end) {
+        UnrecoverableError("Encoded block is truncated.");
+    }
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return value;
+}
+
+// Packed codes: u32 word count, then the SIMDBitPacking words.
+void PackCodes(const Vector<u32> &codes, Vector<u8> &dest) {
+    SIMDBitPacking codec;
+    Vector<u32> words(codes.size() + 1024);
+    SizeT word_count = words.size();
+    codec.Compress(codes.data(), codes.size(), words.data(), word_count);
+    Put(dest, static_cast<u32>(word_count));
+    SizeT offset = dest.size();
+    dest.resize(offset + word_count * sizeof(u32));
+    std::memcpy(dest.data() + offset, words.data(), word_count * sizeof(u32));
+}
+
+void UnpackCodes(const u8 *&ptr, const u8 *end, SizeT count, Vector<u32> &codes) {
+    u32 word_count = Get<u32>(ptr, end);
+    if (ptr + word_count * sizeof(u32) > end) {
+        UnrecoverableError("Encoded block is truncated.");
+    }
+    // copy to keep the words aligned for the SIMD unpacker
+    Vector<u32> words(word_count);
+    std::memcpy(words.data(), ptr, word_count * sizeof(u32));
+    ptr += word_count * sizeof(u32);
+
+    SIMDBitPacking codec;
+    codes.resize(count + 128);
+    SizeT decoded = codes.size();
+    codec.Decompress(words.data(), word_count, codes.data(), decoded);
+    if (decoded != count) {
+        UnrecoverableError(fmt::format("Unpacked {} codes, expect {}.", decoded, count));
+    }
+    codes.resize(count);
+}
+
+struct BlockStats {
+    i64 min_{std::numeric_limits<i64>::max()};
+    i64 max_{std::numeric_limits<i64>::min()};
+    SizeT run_count_{};
+    u64 max_zigzag_delta_{};
+};
+
+BlockStats CollectStats(const Vector<i64> &values) {
+    BlockStats stats;
+    for (SizeT i = 0; i < values.size(); ++i) {
+        stats.min_ = std::min(stats.min_, values[i]);
+        stats.max_ = std::max(stats.max_, values[i]);
+        if (i == 0 || values[i] != values[i - 1]) {
+            ++stats.run_count_;
+        }
+        if (i > 0) {
+            u64 zigzag = ZigZag(static_cast<i64>(static_cast<u64>(values[i]) - static_cast<u64>(values[i - 1])));
+            stats.max_zigzag_delta_ = std::max(stats.max_zigzag_delta_, zigzag);
+        }
+    }
+    return stats;
+}
+
+Vector<i64> LoadValues(const void *src, SizeT row_count, SizeT elem_size) {
+    Vector<i64> values(row_count);
+    for (SizeT i = 0; i < row_count; ++i) {
+        values[i] = ReadValue(static_cast<const char *>(src), i, elem_size);
+    }
+    return values;
+}
+
+Vector<i64> SortedDistinct(const Vector<i64> &values) {
+    Vector<i64> dictionary = values;
+    std::sort(dictionary.begin(), dictionary.end());
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+    return dictionary;
+}
+
+u64 Range(const BlockStats &stats) { return static_cast<u64>(stats.max_) - static_cast<u64>(stats.min_); }
+
+} // namespace
+
+String BlockEncodingTypeToString(BlockEncodingType type) {
+    switch (type) {
+        case BlockEncodingType::kPlain:
+            return "Plain";
+        case BlockEncodingType::kFrameOfReference:
+            return "FrameOfReference";
+        case BlockEncodingType::kDictionary:
+            return "Dictionary";
+        case BlockEncodingType::kRunLength:
+            return "RunLength";
+        case BlockEncodingType::kDelta:
+            return "Delta";
+    }
+    return "Invalid";
+}
+
+SizeT BlockCodec::EncodableElemSize(LogicalType logical_type) {
+    switch (logical_type) {
+        case LogicalType::kTinyInt:
+            return sizeof(i8);
+        case LogicalType::kSmallInt:
+            return sizeof(i16);
+        case LogicalType::kInteger:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+            return sizeof(i32);
+        case LogicalType::kBigInt:
+            return sizeof(i64);
+        default:
+            return 0;
+    }
+}
+
+BlockEncodingType BlockCodec::ChooseEncoding(const void *src, SizeT row_count, SizeT elem_size) {
+    if (row_count == 0 || row_count > std::numeric_limits<u16>::max() + 1) {
+        return BlockEncodingType::kPlain;
+    }
+    Vector<i64> values = LoadValues(src, row_count, elem_size);
+    BlockStats stats = CollectStats(values);
+
+    BlockEncodingType best = BlockEncodingType::kPlain;
+    SizeT best_size = row_count * elem_size;
+    auto consider = [&](BlockEncodingType encoding, SizeT size) {
+        if (size < best_size) {
+            best = encoding;
+            best_size = size;
+        }
+    };
+
+    u64 range = Range(stats);
+    if (range <= std::numeric_limits<u32>::max()) {
+        consider(BlockEncodingType::kFrameOfReference, PackedSize(row_count, BitWidth(range)));
+    }
+    consider(BlockEncodingType::kRunLength, stats.run_count_ * (sizeof(i64) + sizeof(u32)) + sizeof(u32));
+    if (stats.max_zigzag_delta_ <= std::numeric_limits<u32>::max()) {
+        consider(BlockEncodingType::kDelta, sizeof(i64) + PackedSize(row_count - 1, BitWidth(stats.max_zigzag_delta_)));
+    }
+    // Dictionary only pays off when there are few distinct values and the range is wide.
+    if (stats.run_count_ > 1 && BitWidth(range) > 8) {
+        Vector<i64> dictionary = SortedDistinct(values);
+        if (dictionary.size() <= kMaxDictionarySize) {
+            consider(BlockEncodingType::kDictionary,
+                     sizeof(u32) + dictionary.size() * sizeof(i64) + PackedSize(row_count, BitWidth(dictionary.size() - 1)));
+        }
+    }
+    return best;
+}
+
+void BlockCodec::Encode(BlockEncodingType encoding, const void *src, SizeT row_count, SizeT elem_size, Vector<u8> &dest) {
+    if (row_count > std::numeric_limits<u16>::max() + 1) {
+        UnrecoverableError(fmt::format("Too many rows {} in one encoded block.", row_count));
+    }
+    Vector<i64> values = LoadValues(src, row_count, elem_size);
+    BlockStats stats = CollectStats(values);
+
+    BlockCodecHeader header;
+    header.encoding_ = static_cast<u8>(encoding);
+    header.elem_size_ = static_cast<u8>(elem_size);
+    header.row_count_ = static_cast<u32>(row_count);
+    header.min_ = row_count == 0 ? 0 : stats.min_;
+    header.max_ = row_count == 0 ? 0 : stats.max_;
+    dest.clear();
+    Put(dest, header);
+
+    switch (encoding) {
+        case BlockEncodingType::kPlain: {
+            SizeT offset = dest.size();
+            dest.resize(offset + row_count * elem_size);
+            std::memcpy(dest.data() + offset, src, row_count * elem_size);
+            break;
+        }
+        case BlockEncodingType::kFrameOfReference: {
+            if (Range(stats) > std::numeric_limits<u32>::max()) {
+                UnrecoverableError("Value range of the block exceeds frame of reference encoding.");
+            }
+            Vector<u32> codes(row_count);
+            for (SizeT i = 0; i < row_count; ++i) {
+                codes[i] = static_cast<u32>(static_cast<u64>(values[i]) - static_cast<u64>(header.min_));
+            }
+            PackCodes(codes, dest);
+            break;
+        }
+        case BlockEncodingType::kDictionary: {
+            Vector<i64> dictionary = SortedDistinct(values);
+            if (dictionary.size() > kMaxDictionarySize) {
+                UnrecoverableError(fmt::format("Too many distinct values {} for dictionary encoding.", dictionary.size()));
+            }
+            Put(dest, static_cast<u32>(dictionary.size()));
+            for (i64 value : dictionary) {
+                Put(dest, value);
+            }
+            Vector<u32> codes(row_count);
+            for (SizeT i = 0; i < row_count; ++i) {
+                codes[i] = std::lower_bound(dictionary.begin(), dictionary.end(), values[i]) - dictionary.begin();
+            }
+            PackCodes(codes, dest);
+            break;
+        }
+        case BlockEncodingType::kRunLength: {
+            Vector<i64> run_values;
+            Vector<u32> run_ends;
+            for (SizeT i = 0; i < row_count; ++i) {
+                if (i == 0 || values[i] != values[i - 1]) {
+                    run_values.push_back(values[i]);
+                    run_ends.push_back(i + 1);
+                } else {
+                    run_ends.back() = i + 1;
+                }
+            }
+            Put(dest, static_cast<u32>(run_values.size()));
+            for (i64 value : run_values) {
+                Put(dest, value);
+            }
+            for (u32 run_end : run_ends) {
+                Put(dest, run_end);
+            }
+            break;
+        }
+        case BlockEncodingType::kDelta: {
+            if (stats.max_zigzag_delta_ > std::numeric_limits<u32>::max()) {
+                UnrecoverableError("Delta of the block exceeds delta encoding.");
+            }
+            Put(dest, row_count == 0 ? i64(0) : values[0]);
+            Vector<u32> codes(row_count == 0 ? 0 : row_count - 1);
+            for (SizeT i = 1; i < row_count; ++i) {
+                codes[i - 1] = static_cast<u32>(ZigZag(static_cast<i64>(static_cast<u64>(values[i]) - static_cast<u64>(values[i - 1]))));
+            }
+            PackCodes(codes, dest);
+            break;
+        }
+        default: {
+            UnrecoverableError(fmt::format("Unknown block encoding {}.", static_cast<u8>(encoding)));
+        }
+    }
+}
+
+BlockCodecHeader BlockCodec::ReadHeader(const u8 *src, SizeT src_size) {
+    const u8 *ptr = src;
+    BlockCodecHeader header = Get<BlockCodecHeader>(ptr, src + src_size);
+    if (header.encoding_ > static_cast<u8>(BlockEncodingType::kDelta)) {
+        UnrecoverableError(fmt::format("Unknown block encoding {}.", header.encoding_));
+    }
+    return header;
+}
+
+void BlockCodec::Decode(const u8 *src, SizeT src_size, void *dest, SizeT dest_size) {
+    BlockCodecHeader header = ReadHeader(src, src_size);
+    const u8 *ptr = src + sizeof(BlockCodecHeader);
+    const u8 *end = src + src_size;
+    SizeT row_count = header.row_count_;
+    SizeT elem_size = header.elem_size_;
+    if (row_count * elem_size > dest_size) {
+        UnrecoverableError(fmt::format("Decode buffer size {} is less than {} * {}.", dest_size, row_count, elem_size));
+    }
+    char *out = static_cast<char *>(dest);
+
+    switch (static_cast<BlockEncodingType>(header.encoding_)) {
+        case BlockEncodingType::kPlain: {
+            if (ptr + row_count * elem_size > end) {
+                UnrecoverableError("Encoded block is truncated.");
+            }
+            std::memcpy(out, ptr, row_count * elem_size);
+            break;
+        }
+        case BlockEncodingType::kFrameOfReference: {
+            Vector<u32> codes;
+            UnpackCodes(ptr, end, row_count, codes);
+            for (SizeT i = 0; i < row_count; ++i) {
+                WriteValue(out, i, elem_size, static_cast<i64>(static_cast<u64>(header.min_) + codes[i]));
+            }
+            break;
+        }
+        case BlockEncodingType::kDictionary: {
+            u32 dictionary_size = Get<u32>(ptr, end);
+            Vector<i64> dictionary(dictionary_size);
+            for (u32 i = 0; i < dictionary_size; ++i) {
+                dictionary[i] = Get<i64>(ptr, end);
+            }
+            Vector<u32> codes;
+            UnpackCodes(ptr, end, row_count, codes);
+            for (SizeT i = 0; i < row_count; ++i) {
+                if (codes[i] >= dictionary_size) {
+                    UnrecoverableError(fmt::format("Dictionary code {} exceeds dictionary size {}.", codes[i], dictionary_size));
+                }
+                WriteValue(out, i, elem_size, dictionary[codes[i]]);
+            }
+            break;
+        }
+        case BlockEncodingType::kRunLength: {
+            u32 run_count = Get<u32>(ptr, end);
+            Vector<i64> run_values(run_count);
+            for (u32 i = 0; i < run_count; ++i) {
+                run_values[i] = Get<i64>(ptr, end);
+            }
+            SizeT row_idx = 0;
+            for (u32 i = 0; i < run_count; ++i) {
+                u32 run_end = Get<u32>(ptr, end);
+                if (run_end > row_count) {
+                    UnrecoverableError(fmt::format("Run end {} exceeds row count {}.", run_end, row_count));
+                }
+                for (; row_idx < run_end; ++row_idx) {
+                    WriteValue(out, row_idx, elem_size, run_values[i]);
+                }
+            }
+            if (row_idx != row_count) {
+                UnrecoverableError(fmt::format("Runs cover {} rows of {}.", row_idx, row_count));
+            }
+            break;
+        }
+        case BlockEncodingType::kDelta: {
+            i64 value = Get<i64>(ptr, end);
+            if (row_count == 0) {
+                break;
+            }
+            Vector<u32> codes;
+            UnpackCodes(ptr, end, row_count - 1, codes);
+            WriteValue(out, 0, elem_size, value);
+            for (SizeT i = 1; i < row_count; ++i) {
+                value = static_cast<i64>(static_cast<u64>(value) + static_cast<u64>(UnZigZag(codes[i - 1])));
+                WriteValue(out, i, elem_size, value);
+            }
+            break;
+        }
+        default: {
+            UnrecoverableError(fmt::format("Unknown block encoding {}.", header.encoding_));
+        }
+    }
+}
+
+} // namespace infinity
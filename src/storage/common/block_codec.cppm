@@ -0,0 +1,63 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module block_codec;
+
+import stl;
+import logical_type;
+
+namespace infinity {
+
+// Lightweight encodings of a column block of fixed width integers.
+export enum class BlockEncodingType : u8 {
+    kPlain = 0,
+    kFrameOfReference = 1, // value - min, bit-packed
+    kDictionary = 2,       // index into the sorted distinct values, bit-packed
+    kRunLength = 3,        // (value, run end) pairs
+    kDelta = 4,            // zigzag of value[i] - value[i - 1], bit-packed
+};
+
+export String BlockEncodingTypeToString(BlockEncodingType type);
+
+// Encoded block layout:
+// - header: encoding type, element size, row count, min value, max value
+// - payload: depends on the encoding type
+export struct BlockCodecHeader {
+    u8 encoding_{};
+    u8 elem_size_{};
+    u16 reserved_{};
+    u32 row_count_{};
+    i64 min_{};
+    i64 max_{};
+};
+
+export class BlockCodec {
+public:
+    // Width of the element if the column type can be encoded by BlockCodec, otherwise 0.
+    static SizeT EncodableElemSize(LogicalType logical_type);
+
+    // Pick the encoding with the smallest estimated size, kPlain if none of them is smaller than the raw data.
+    static BlockEncodingType ChooseEncoding(const void *src, SizeT row_count, SizeT elem_size);
+
+    static void Encode(BlockEncodingType encoding, const void *src, SizeT row_count, SizeT elem_size, Vector<u8> &dest);
+
+    // dest_size is the size of the raw buffer in bytes, must be no less than row_count * elem_size.
+    static void Decode(const u8 *src, SizeT src_size, void *dest, SizeT dest_size);
+
+    static BlockCodecHeader ReadHeader(const u8 *src, SizeT src_size);
+};
+
+} // namespace infinity
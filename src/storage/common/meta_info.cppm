@@ -39,6 +39,8 @@ export struct TableIndexInfo {
     SharedPtr<String> index_name_{};
     SharedPtr<String> index_entry_dir_{};
     i64 segment_index_count_{};
+    i64 chunk_index_count_{};
+    i64 merge_debt_rows_{};
     SharedPtr<String> index_type_{};
     SharedPtr<String> index_other_params_{};
     SharedPtr<String> index_column_ids_{};
@@ -29,10 +29,13 @@ import logger;
 import infinity_exception;
 import third_party;
 import blocking_queue;
+import background_process;
+import io_rate_limiter;
 
 namespace infinity {
 
-CompactionProcessor::CompactionProcessor(Catalog *catalog, TxnManager *txn_mgr) : catalog_(catalog), txn_mgr_(txn_mgr) {}
+CompactionProcessor::CompactionProcessor(Catalog *catalog, TxnManager *txn_mgr, u64 io_rate_limit)
+    : catalog_(catalog), txn_mgr_(txn_mgr), io_rate_limiter_(io_rate_limit) {}
 
 void CompactionProcessor::Start() {
     LOG_INFO("Compaction processor is started.");
@@ -50,6 +53,10 @@ void CompactionProcessor::Stop() {
 
 void CompactionProcessor::Submit(SharedPtr<BGTask> bg_task) { task_queue_.Enqueue(std::move(bg_task)); }
 
+BGTaskLaneInfo CompactionProcessor::GetLaneInfo() const {
+    return BGTaskLaneInfo{"compaction", 1, task_queue_.Size(), task_count_.load(), busy_time_us_.load() / 1000, io_rate_limiter_.acquired_bytes()};
+}
+
 Vector<UniquePtr<CompactSegmentsTask>> CompactionProcessor::ScanForCompact() {
     auto generate_txn = [this]() { return txn_mgr_->BeginTxn(); };
 
@@ -96,11 +103,14 @@ void CompactionProcessor::ScanAndOptimize() {
 }
 
 void CompactionProcessor::Process() {
+    SetBGThreadNice(10);
+    IoRateLimiter::SetCurrent(&io_rate_limiter_);
     bool running = true;
     while (running) {
         Deque<SharedPtr<BGTask>> tasks;
         task_queue_.DequeueBulk(tasks);
         for (const auto &bg_task : tasks) {
+            auto begin_time = std::chrono::steady_clock::now();
             switch (bg_task->type_) {
                 case BGTaskType::kStopProcessor: {
                     running = false;
@@ -128,9 +138,13 @@ void CompactionProcessor::Process() {
                     break;
                 }
             }
+            auto end_time = std::chrono::steady_clock::now();
+            busy_time_us_ += std::chrono::duration_cast<std::chrono::microseconds>(end_time - begin_time).count();
+            ++task_count_;
             bg_task->Complete();
         }
     }
+    IoRateLimiter::SetCurrent(nullptr);
 }
 
 } // namespace infinity
\ No newline at end of file
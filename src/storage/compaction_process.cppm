@@ -21,6 +21,8 @@ import compact_segments_task;
 import txn;
 import bg_task;
 import blocking_queue;
+import background_process;
+import io_rate_limiter;
 
 namespace infinity {
 
@@ -29,7 +31,7 @@ class TxnManager;
 
 export class CompactionProcessor {
 public:
-    CompactionProcessor(Catalog *catalog, TxnManager *txn_mgr);
+    CompactionProcessor(Catalog *catalog, TxnManager *txn_mgr, u64 io_rate_limit = 0);
 
     void Start();
 
@@ -37,6 +39,9 @@ public:
 
     void Submit(SharedPtr<BGTask> bg_task);
 
+    // The compaction lane of the background work.
+    BGTaskLaneInfo GetLaneInfo() const;
+
 private:
     Vector<UniquePtr<CompactSegmentsTask>> ScanForCompact();
 
@@ -52,6 +57,10 @@ private:
     Catalog *catalog_{};
     TxnManager *txn_mgr_{};
 
+    IoRateLimiter io_rate_limiter_;
+    Atomic<u64> task_count_{0};
+    Atomic<u64> busy_time_us_{0};
+
     // atomic_bool stop_{false};
     // std::chrono::seconds interval_{};
 };
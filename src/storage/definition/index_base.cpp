@@ -193,7 +193,9 @@ SharedPtr<IndexBase> IndexBase::Deserialize(const nlohmann::json &index_def_json
         }
         case IndexType::kFullText: {
             String analyzer = index_def_json["analyzer"];
-            auto ptr = MakeShared<IndexFullText>(index_name, file_name, std::move(column_names), analyzer);
+            // catalogs written before the flag was serialized were built without term impacts
+            optionflag_t flag = index_def_json.contains("flag") ? optionflag_t(index_def_json["flag"]) : optionflag_t(OPTION_FLAG_ALL & ~of_term_impact);
+            auto ptr = MakeShared<IndexFullText>(index_name, file_name, std::move(column_names), analyzer, flag);
             res = std::static_pointer_cast<IndexBase>(ptr);
             break;
         }
@@ -38,6 +38,12 @@ HnswEncodeType StringToHnswEncodeType(const String &str) {
         return HnswEncodeType::kPlain;
     } else if (str == "lvq") {
         return HnswEncodeType::kLVQ;
+    } else if (str == "sq8") {
+        return HnswEncodeType::kSQ8;
+    } else if (str == "sq4") {
+        return HnswEncodeType::kSQ4;
+    } else if (str == "pq") {
+        return HnswEncodeType::kPQ;
     } else {
         return HnswEncodeType::kInvalid;
     }
@@ -49,6 +55,12 @@ String HnswEncodeTypeToString(HnswEncodeType encode_type) {
             return "plain";
         case HnswEncodeType::kLVQ:
             return "lvq";
+        case HnswEncodeType::kSQ8:
+            return "sq8";
+        case HnswEncodeType::kSQ4:
+            return "sq4";
+        case HnswEncodeType::kPQ:
+            return "pq";
         default:
             return "invalid";
     }
@@ -30,6 +30,9 @@ namespace infinity {
 export enum class HnswEncodeType {
     kPlain,
     kLVQ,
+    kSQ8,
+    kSQ4,
+    kPQ,
     kInvalid,
 };
 
@@ -73,6 +76,11 @@ public:
 public:
     static void ValidateColumnDataType(const SharedPtr<BaseTableRef> &base_table_ref, const String &column_name);
 
+    // The distances of the scalar and product quantized vectors are approximate, the results of a search are re-ranked with the raw vectors.
+    bool NeedRerank() const {
+        return encode_type_ == HnswEncodeType::kSQ8 || encode_type_ == HnswEncodeType::kSQ4 || encode_type_ == HnswEncodeType::kPQ;
+    }
+
 public:
     const MetricType metric_type_{MetricType::kInvalid};
     const HnswEncodeType encode_type_{HnswEncodeType::kInvalid};
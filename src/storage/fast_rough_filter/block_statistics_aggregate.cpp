@@ -0,0 +1,140 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+module;
+
+module block_statistics_aggregate;
+
+import stl;
+import internal_types;
+import logical_type;
+import value;
+import block_entry;
+import data_block;
+import fast_rough_filter;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+namespace {
+
+template <typename T>
+Value MakeNumberValue(T value) {
+    if constexpr (std::is_same_v<T, TinyIntT>) {
+        return Value::MakeTinyInt(value);
+    } else if constexpr (std::is_same_v<T, SmallIntT>) {
+        return Value::MakeSmallInt(value);
+    } else if constexpr (std::is_same_v<T, IntegerT>) {
+        return Value::MakeInt(value);
+    } else if constexpr (std::is_same_v<T, BigIntT>) {
+        return Value::MakeBigInt(value);
+    } else if constexpr (std::is_same_v<T, FloatT>) {
+        return Value::MakeFloat(value);
+    } else {
+        static_assert(std::is_same_v<T, DoubleT>, "Unexpected number type");
+        return Value::MakeDouble(value);
+    }
+}
+
+template <typename T>
+Value CombineMinMaxT(const Value &lhs, const Value &rhs, bool take_min) {
+    T lhs_value = lhs.GetValue<T>();
+    T rhs_value = rhs.GetValue<T>();
+    return MakeNumberValue<T>(take_min == (rhs_value < lhs_value) ? rhs_value : lhs_value);
+}
+
+Value CombineMinMax(const Value &lhs, const Value &rhs, bool take_min) {
+    switch (lhs.type_.type()) {
+        case LogicalType::kTinyInt:
+            return CombineMinMaxT<TinyIntT>(lhs, rhs, take_min);
+        case LogicalType::kSmallInt:
+            return CombineMinMaxT<SmallIntT>(lhs, rhs, take_min);
+        case LogicalType::kInteger:
+            return CombineMinMaxT<IntegerT>(lhs, rhs, take_min);
+        case LogicalType::kBigInt:
+            return CombineMinMaxT<BigIntT>(lhs, rhs, take_min);
+        case LogicalType::kFloat:
+            return CombineMinMaxT<FloatT>(lhs, rhs, take_min);
+        case LogicalType::kDouble:
+            return CombineMinMaxT<DoubleT>(lhs, rhs, take_min);
+        default: {
+            UnrecoverableError(fmt::format("Min max statistics of type {} is not supported", lhs.type_.ToString()));
+            return lhs;
+        }
+    }
+}
+
+} // namespace
+
+BlockStatisticsAggregator::BlockStatisticsAggregator(SharedPtr<Vector<StatisticsAggregate>> aggregates) : aggregates_(std::move(aggregates)) {
+    results_.reserve(aggregates_->size());
+    for (const auto &aggregate : *aggregates_) {
+        results_.push_back(aggregate.type_ == StatisticsAggregateType::kCount ? Value::MakeBigInt(0) : Value::MakeNull());
+    }
+}
+
+bool BlockStatisticsAggregator::Accumulate(const BlockEntry *block_entry, TxnTimeStamp begin_ts) {
+    if (block_entry->CheckAnyDelete(begin_ts) || block_entry->CheckAnyUpdate(begin_ts)) {
+        return false;
+    }
+    auto [row_begin, row_end] = block_entry->GetVisibleRange(begin_ts);
+    const BigIntT row_count = row_end - row_begin;
+    // collect every min and max first, the block is either answered completely or scanned
+    Vector<Value> min_max;
+    if (row_count > 0) {
+        const FastRoughFilter *filter = block_entry->GetFastRoughFilter();
+        for (const auto &aggregate : *aggregates_) {
+            if (aggregate.type_ == StatisticsAggregateType::kCount) {
+                continue;
+            }
+            Value min = Value::MakeNull();
+            Value max = Value::MakeNull();
+            if (!filter->GetMinMax(begin_ts, aggregate.column_id_, min, max)) {
+                return false;
+            }
+            min_max.push_back(aggregate.type_ == StatisticsAggregateType::kMin ? std::move(min) : std::move(max));
+        }
+    }
+    for (SizeT i = 0, min_max_idx = 0; i < aggregates_->size(); ++i) {
+        const StatisticsAggregateType type = (*aggregates_)[i].type_;
+        if (type == StatisticsAggregateType::kCount) {
+            results_[i] = Value::MakeBigInt(results_[i].GetValue<BigIntT>() + row_count);
+        } else if (row_count > 0) {
+            Value &value = min_max[min_max_idx++];
+            results_[i] = results_[i].type_.type() == LogicalType::kNull ? std::move(value)
+                                                                          : CombineMinMax(results_[i], value, type == StatisticsAggregateType::kMin);
+        }
+    }
+    ++block_count_;
+    return true;
+}
+
+void BlockStatisticsAggregator::MergeInto(DataBlock &output) const {
+    if (block_count_ == 0) {
+        return;
+    }
+    for (SizeT i = 0; i < aggregates_->size(); ++i) {
+        const Value &result = results_[i];
+        const StatisticsAggregateType type = (*aggregates_)[i].type_;
+        if (type == StatisticsAggregateType::kCount) {
+            output.SetValue(i, 0, Value::MakeBigInt(output.GetValue(i, 0).GetValue<BigIntT>() + result.GetValue<BigIntT>()));
+        } else if (result.type_.type() != LogicalType::kNull) {
+            // without scanned rows the output holds the initial state of the aggregate
+            output.SetValue(i, 0, scanned_row_count_ == 0 ? result : CombineMinMax(output.GetValue(i, 0), result, type == StatisticsAggregateType::kMin));
+        }
+    }
+}
+
+} // namespace infinity
@@ -0,0 +1,67 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+module;
+
+export module block_statistics_aggregate;
+
+import stl;
+import internal_types;
+import logical_type;
+import value;
+
+namespace infinity {
+
+struct BlockEntry;
+class DataBlock;
+
+// An aggregate without group by which can be answered from the statistics of a block instead of its column data:
+// count from the visible row count, min and max from the min max filter.
+export enum class StatisticsAggregateType : u8 {
+    kCount,
+    kMin,
+    kMax,
+};
+
+export struct StatisticsAggregate {
+    StatisticsAggregateType type_{};
+    ColumnID column_id_{};
+    LogicalType value_type_{}; // type of the column for min and max
+};
+
+// Per task: folds in the blocks whose statistics are exact for the query, the other blocks are scanned.
+// When the task finishes, the results are combined with the aggregates over the scanned rows.
+export class BlockStatisticsAggregator {
+public:
+    explicit BlockStatisticsAggregator(SharedPtr<Vector<StatisticsAggregate>> aggregates);
+
+    // Return false, leaving the results untouched, if the block has to be scanned:
+    // rows of the block are deleted or updated, or it has no exact min max filter, e.g. it is not sealed yet.
+    bool Accumulate(const BlockEntry *block_entry, TxnTimeStamp begin_ts);
+
+    void AddScannedRows(SizeT row_count) { scanned_row_count_ += row_count; }
+
+    // Combine with the aggregates over the scanned rows, which are in the first row of output.
+    void MergeInto(DataBlock &output) const;
+
+    SizeT block_count() const { return block_count_; }
+
+private:
+    SharedPtr<Vector<StatisticsAggregate>> aggregates_{};
+    Vector<Value> results_{};
+    SizeT block_count_{0};
+    SizeT scanned_row_count_{0};
+};
+
+} // namespace infinity
@@ -49,6 +49,10 @@ private:
 
     UniquePtr<ProbabilisticDataFilter> probabilistic_data_filter_;
 
+    // commit ts of the first in place update of column values, see ColumnDeltaStore
+    // the filters are built from the column data and don't hold for the queries which see the update
+    Atomic<TxnTimeStamp> first_update_ts_{UNCOMMIT_TS};
+
 public:
     // bloom filter test
     inline bool MayContain(TxnTimeStamp query_ts, ColumnID column_id, const Value &value) const {
@@ -60,6 +64,22 @@ public:
         return min_max_data_filter_->MayInRange(column_id, value, compare_type);
     }
 
+    // exact min and max of the column over the rows of the block or segment, used to answer aggregates without scanning
+    // false if the filter doesn't hold for the query, or the column has no filter or only bounds of its values
+    inline bool GetMinMax(TxnTimeStamp query_ts, ColumnID column_id, Value &min, Value &max) const {
+        if (!HaveMinMaxFilter() || query_ts < GetMinMaxBuildTime() || query_ts >= first_update_ts_.load()) {
+            return false;
+        }
+        return min_max_data_filter_->GetMinMax(column_id, min, max);
+    }
+
+    // column values are updated in place at commit_ts
+    void MarkUpdated(TxnTimeStamp commit_ts) {
+        TxnTimeStamp first_update_ts = first_update_ts_.load();
+        while (commit_ts < first_update_ts && !first_update_ts_.compare_exchange_weak(first_update_ts, commit_ts)) {
+        }
+    }
+
     String SerializeToString() const;
 
     void DeserializeFromString(const String &str);
@@ -119,6 +139,10 @@ public:
             LOG_TRACE("FastRoughFilterEvaluator: query timestamp earlier than filter build timestamp, cannot apply, return true.");
             return true;
         }
+        if (query_ts >= filter.first_update_ts_.load()) {
+            LOG_TRACE("FastRoughFilterEvaluator: column values are updated after filter build, cannot apply, return true.");
+            return true;
+        }
         return EvaluateInner(query_ts, filter);
     }
 
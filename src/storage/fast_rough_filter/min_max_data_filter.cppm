@@ -96,7 +96,46 @@ public:
         is.read(reinterpret_cast<char *>(&max_), sizeof(max_));
     }
 
+    // false if min and max only bound the values, i.e. the truncated varchar
+    bool GetMinMax(Value &min, Value &max) const {
+        if constexpr (IsVarchar<OriginalValueType>) {
+            return false;
+        } else {
+            min = MakeMinMaxValue(min_);
+            max = MakeMinMaxValue(max_);
+            return true;
+        }
+    }
+
 private:
+    template <typename T>
+    static Value MakeMinMaxValue(const T &value) {
+        if constexpr (std::is_same_v<T, TinyIntT>) {
+            return Value::MakeTinyInt(value);
+        } else if constexpr (std::is_same_v<T, SmallIntT>) {
+            return Value::MakeSmallInt(value);
+        } else if constexpr (std::is_same_v<T, IntegerT>) {
+            return Value::MakeInt(value);
+        } else if constexpr (std::is_same_v<T, BigIntT>) {
+            return Value::MakeBigInt(value);
+        } else if constexpr (std::is_same_v<T, HugeIntT>) {
+            return Value::MakeHugeInt(value);
+        } else if constexpr (std::is_same_v<T, FloatT>) {
+            return Value::MakeFloat(value);
+        } else if constexpr (std::is_same_v<T, DoubleT>) {
+            return Value::MakeDouble(value);
+        } else if constexpr (std::is_same_v<T, DateT>) {
+            return Value::MakeDate(value);
+        } else if constexpr (std::is_same_v<T, TimeT>) {
+            return Value::MakeTime(value);
+        } else if constexpr (std::is_same_v<T, DateTimeT>) {
+            return Value::MakeDateTime(value);
+        } else {
+            static_assert(std::is_same_v<T, TimestampT>, "Unexpected min max filter type");
+            return Value::MakeTimestamp(value);
+        }
+    }
+
     template <IsMinMaxInnerValUnchanged T = OriginalValueType>
     [[nodiscard]] inline bool MayInRangeT(const Value &value, FilterCompareType compare_type) const {
         static_assert(std::is_same<InnerValueType, OriginalValueType>::value, "Type mismatch");
@@ -180,6 +219,13 @@ public:
                           min_max_filters_[column_id]);
     }
 
+    // exact min and max of the column, false if there is no filter for the column or it only bounds the values
+    [[nodiscard]] inline bool GetMinMax(ColumnID column_id, Value &min, Value &max) const {
+        return std::visit(Overload{[](const std::monostate &) -> bool { return false; },
+                                   [&min, &max]<typename T>(const InnerMinMaxDataFilterT<T> &filter) -> bool { return filter.GetMinMax(min, max); }},
+                          min_max_filters_[column_id]);
+    }
+
     // used in build_fast_rough_filter_task
     template <typename OriginalValueType, typename MinMaxInnerValT>
     void Build(ColumnID column_id, MinMaxInnerValT &&min, MinMaxInnerValT &&max) {
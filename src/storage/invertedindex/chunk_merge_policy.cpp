@@ -0,0 +1,96 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+module chunk_merge_policy;
+
+import stl;
+import infinity_exception;
+
+namespace infinity {
+
+TieredChunkMergePolicy::TieredChunkMergePolicy(SizeT merge_factor, u32 min_chunk_rows, u32 max_chunk_rows)
+    : merge_factor_(merge_factor), min_chunk_rows_(min_chunk_rows), max_chunk_rows_(max_chunk_rows) {
+    if (merge_factor < 2 || min_chunk_rows == 0 || max_chunk_rows < min_chunk_rows) {
+        UnrecoverableError("Invalid full-text chunk merge parameters");
+    }
+}
+
+u32 TieredChunkMergePolicy::Tier(u32 row_count) const {
+    u32 tier = 0;
+    for (u64 bound = min_chunk_rows_; row_count >= bound; bound *= merge_factor_) {
+        ++tier;
+    }
+    return tier;
+}
+
+Vector<Pair<SizeT, SizeT>> TieredChunkMergePolicy::PickMerges(const Vector<u32> &chunk_row_counts) const {
+    Vector<Pair<SizeT, SizeT>> merges;
+    SizeT chunk_n = chunk_row_counts.size();
+    SizeT run_begin = 0;
+    while (run_begin < chunk_n) {
+        // the run of adjacent chunks of the same tier
+        u32 tier = Tier(chunk_row_counts[run_begin]);
+        SizeT run_end = run_begin + 1;
+        while (run_end < chunk_n && Tier(chunk_row_counts[run_end]) == tier) {
+            ++run_end;
+        }
+        SizeT begin = run_begin;
+        while (run_end - begin >= merge_factor_) {
+            SizeT end = begin;
+            u64 row_count = 0;
+            while (end < begin + merge_factor_ && row_count + chunk_row_counts[end] <= max_chunk_rows_) {
+                row_count += chunk_row_counts[end];
+                ++end;
+            }
+            if (end - begin < 2) {
+                // the chunk at begin can not be merged with the next one without exceeding max_chunk_rows
+                ++begin;
+                continue;
+            }
+            merges.emplace_back(begin, end);
+            begin = end;
+        }
+        run_begin = run_end;
+    }
+    return merges;
+}
+
+u64 TieredChunkMergePolicy::MergeDebt(Vector<u32> chunk_row_counts) const {
+    u64 debt = 0;
+    while (true) {
+        Vector<Pair<SizeT, SizeT>> merges = PickMerges(chunk_row_counts);
+        if (merges.empty()) {
+            break;
+        }
+        Vector<u32> merged_row_counts;
+        SizeT next = 0;
+        for (const auto &[begin, end] : merges) {
+            merged_row_counts.insert(merged_row_counts.end(), chunk_row_counts.begin() + next, chunk_row_counts.begin() + begin);
+            u32 row_count = 0;
+            for (SizeT i = begin; i < end; ++i) {
+                row_count += chunk_row_counts[i];
+            }
+            merged_row_counts.push_back(row_count);
+            debt += row_count;
+            next = end;
+        }
+        merged_row_counts.insert(merged_row_counts.end(), chunk_row_counts.begin() + next, chunk_row_counts.end());
+        chunk_row_counts = std::move(merged_row_counts);
+    }
+    return debt;
+}
+
+} // namespace infinity
@@ -0,0 +1,50 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module chunk_merge_policy;
+
+import stl;
+import default_values;
+
+namespace infinity {
+
+// Size-tiered merge policy of the full-text index chunks of a segment.
+// Tier 0 holds the chunks below min_chunk_rows, every following tier holds chunks merge_factor times larger. A merge takes
+// merge_factor adjacent chunks of the same tier, so a row is rewritten once per tier instead of on every optimize.
+// Chunks of at least max_chunk_rows are never merged and a merge never produces a chunk larger than max_chunk_rows.
+// Only adjacent chunks may be merged since a chunk covers a contiguous range of row ids.
+export class TieredChunkMergePolicy {
+public:
+    explicit TieredChunkMergePolicy(SizeT merge_factor = FULLTEXT_MERGE_FACTOR,
+                                    u32 min_chunk_rows = FULLTEXT_MERGE_MIN_CHUNK_ROWS,
+                                    u32 max_chunk_rows = FULLTEXT_MERGE_MAX_CHUNK_ROWS);
+
+    u32 Tier(u32 row_count) const;
+
+    // The disjoint merges of one pass over the chunks, as [begin, end) ranges of the chunk row counts in row id order.
+    // Merged chunks may make a higher tier full, that merge is picked by the next pass.
+    Vector<Pair<SizeT, SizeT>> PickMerges(const Vector<u32> &chunk_row_counts) const;
+
+    // The rows rewritten by the merges still to run until no merge is picked anymore.
+    u64 MergeDebt(Vector<u32> chunk_row_counts) const;
+
+private:
+    const SizeT merge_factor_;
+    const u32 min_chunk_rows_;
+    const u32 max_chunk_rows_;
+};
+
+} // namespace infinity
@@ -40,6 +40,7 @@ import index_full_text;
 import third_party;
 import blockmax_term_doc_iterator;
 import default_values;
+import fst;
 
 namespace infinity {
 void ColumnIndexReader::Open(optionflag_t flag, String &&index_dir, Map<SegmentID, SharedPtr<SegmentIndexEntry>> &&index_by_segment) {
@@ -106,6 +107,20 @@ UniquePtr<BlockMaxTermDocIterator> ColumnIndexReader::LookupBlockMax(const Strin
     return result;
 }
 
+Vector<String> ColumnIndexReader::ExpandTerms(Automaton &automaton, SizeT max_expansions) {
+    // each segment gives its first max_expansions terms, the first ones of the union are the first ones of all segments
+    Vector<String> terms;
+    for (const auto &segment_reader : segment_readers_) {
+        segment_reader->MatchTerms(automaton, max_expansions, terms);
+    }
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    if (terms.size() > max_expansions) {
+        terms.resize(max_expansions);
+    }
+    return terms;
+}
+
 float ColumnIndexReader::GetAvgColumnLength() const {
     u64 column_len_sum = 0;
     u32 column_len_cnt = 0;
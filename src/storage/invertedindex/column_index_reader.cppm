@@ -25,6 +25,7 @@ import memory_indexer;
 import internal_types;
 import segment_index_entry;
 import chunk_index_entry;
+import fst;
 
 export module column_index_reader;
 
@@ -40,6 +41,9 @@ public:
 
     UniquePtr<BlockMaxTermDocIterator> LookupBlockMax(const String &term, MemoryPool *session_pool, float weight, bool fetch_position = true);
 
+    // The terms of all segments matched by the automaton, the first max_expansions ones in lexicographical order.
+    Vector<String> ExpandTerms(Automaton &automaton, SizeT max_expansions);
+
     float GetAvgColumnLength() const;
 
     optionflag_t GetOptionFlag() const { return flag_; }
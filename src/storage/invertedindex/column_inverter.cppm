@@ -20,6 +20,7 @@ export module column_inverter;
 
 import stl;
 import analyzer;
+import analyzer_pool;
 
 import column_vector;
 import term;
@@ -110,7 +111,7 @@ private:
 
     void MergePrepare();
 
-    UniquePtr<Analyzer> analyzer_{nullptr};
+    PooledAnalyzer analyzer_{};
     u32 begin_doc_id_{0};
     u32 doc_count_{0};
     u32 merged_{1};
@@ -73,6 +73,17 @@ public:
         }
     }
 
+    // Call func on the key-value pairs in key order until it returns false.
+    template <typename Func>
+    void Scan(Func &&func) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto &[key, value] : map_) {
+            if (!func(key, value)) {
+                break;
+            }
+        }
+    }
+
     // WARN: Caller shall ensure there's no concurrent write access
     Map<KeyType, ValueType>::iterator UnsafeBegin() { return map_.begin(); }
 
@@ -0,0 +1,67 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <bit>
+
+export module norm_quantizer;
+
+import stl;
+
+namespace infinity {
+
+// Column lengths quantized to 1 byte for BM25 length normalization.
+// Lengths below NORM_EXACT_LIMIT are exact, larger ones are a float with 3 mantissa bits, so the error is at most 1/8.
+// Lengths are rounded up: the decoded length is never smaller than the real one, so tf / decoded length <= 1.
+constexpr u32 NORM_EXACT_LIMIT = 32;
+constexpr u32 NORM_EXACT_BITS = 5; // log2(NORM_EXACT_LIMIT)
+constexpr u32 NORM_MANTISSA_BITS = 3;
+
+constexpr u32 DecodeNormImpl(u8 norm) {
+    if (norm < NORM_EXACT_LIMIT) {
+        return norm;
+    }
+    const u32 exponent = NORM_EXACT_BITS + (norm - NORM_EXACT_LIMIT) / (1u << NORM_MANTISSA_BITS);
+    const u64 mantissa = (1u << NORM_MANTISSA_BITS) + (norm - NORM_EXACT_LIMIT) % (1u << NORM_MANTISSA_BITS);
+    const u64 column_len = mantissa << (exponent - NORM_MANTISSA_BITS);
+    return column_len > std::numeric_limits<u32>::max() ? std::numeric_limits<u32>::max() : u32(column_len);
+}
+
+constexpr Array<u32, 256> NORM_DECODE_TABLE = [] {
+    Array<u32, 256> table{};
+    for (u32 i = 0; i < 256; ++i) {
+        table[i] = DecodeNormImpl(u8(i));
+    }
+    return table;
+}();
+
+export inline u8 EncodeNorm(u32 column_len) {
+    if (column_len < NORM_EXACT_LIMIT) {
+        return u8(column_len);
+    }
+    u32 exponent = std::bit_width(column_len) - 1;
+    const u32 shift = exponent - NORM_MANTISSA_BITS;
+    // round the mantissa up
+    u32 mantissa = (column_len >> shift) + ((column_len & ((1u << shift) - 1)) != 0);
+    if (mantissa == (2u << NORM_MANTISSA_BITS)) {
+        mantissa >>= 1;
+        ++exponent;
+    }
+    return u8(NORM_EXACT_LIMIT + (exponent - NORM_EXACT_BITS) * (1u << NORM_MANTISSA_BITS) + mantissa - (1u << NORM_MANTISSA_BITS));
+}
+
+export inline u32 DecodeNorm(u8 norm) { return NORM_DECODE_TABLE[norm]; }
+
+} // namespace infinity
@@ -81,4 +81,13 @@ bool DictionaryReader::Next(String &term, TermMeta &term_meta) {
     return true;
 }
 
+void DictionaryReader::MatchTerms(Automaton &automaton, SizeT limit, Vector<String> &terms) {
+    FstAutomatonStream s(*fst_, automaton);
+    Vector<u8> key;
+    u64 val;
+    for (SizeT matched = 0; matched < limit && s.Next(key, val); matched++) {
+        terms.emplace_back((char *)key.data(), key.size());
+    }
+}
+
 } // namespace infinity
\ No newline at end of file
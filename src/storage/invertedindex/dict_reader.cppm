@@ -43,5 +43,8 @@ public:
     void InitIterator(const String &prefix);
 
     bool Next(String &term, TermMeta &term_meta);
+
+    // Append the terms matched by the automaton in lexicographical order, at most limit terms.
+    void MatchTerms(Automaton &automaton, SizeT limit, Vector<String> &terms);
 };
 } // namespace infinity
@@ -29,6 +29,7 @@ import posting_list_format;
 import internal_types;
 import third_party;
 import byte_slice_reader;
+import fst;
 
 namespace infinity {
 
@@ -135,5 +136,11 @@ bool DiskIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPostin
     return true;
 }
 
+void DiskIndexSegmentReader::MatchTerms(Automaton &automaton, SizeT limit, Vector<String> &terms) const {
+    if (!dict_reader_.get()) {
+        return;
+    }
+    dict_reader_->MatchTerms(automaton, limit, terms);
+}
 
 } // namespace infinity
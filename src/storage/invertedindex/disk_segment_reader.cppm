@@ -25,6 +25,7 @@ import file_reader;
 import posting_list_format;
 import local_file_system;
 import internal_types;
+import fst;
 
 namespace infinity {
 export class DiskIndexSegmentReader : public IndexSegmentReader {
@@ -33,6 +34,8 @@ public:
     virtual ~DiskIndexSegmentReader();
 
     bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, MemoryPool *session_pool, bool fetch_position = true) const override;
+    void MatchTerms(Automaton &automaton, SizeT limit, Vector<String> &terms) const override;
+
     bool GetSegmentPostingBack(const String &term, SegmentPosting &seg_posting, MemoryPool *session_pool, bool fetch_position = true) const;
 private:
     RowID base_row_id_{INVALID_ROWID};
@@ -15,6 +15,7 @@ import index_defines;
 import skiplist_reader;
 import vbyte_compressor;
 import logger;
+import norm_quantizer;
 
 namespace infinity {
 
@@ -72,7 +73,10 @@ void DocListEncoder::AddDocument(docid_t doc_id, docpayload_t doc_payload, tf_t
     last_doc_payload_ = doc_payload;
     block_max_tf_ = std::max(block_max_tf_, tf);
     assert((tf > 0 and tf <= doc_len));
-    block_max_percentage_ = std::max(block_max_percentage_, static_cast<float>(tf) / doc_len);
+    // docs are scored with the quantized column length, which is not less than doc_len
+    block_max_percentage_ = std::max(block_max_percentage_, static_cast<float>(tf) / DecodeNorm(EncodeNorm(doc_len)));
+    max_tf_ = std::max(max_tf_, block_max_tf_);
+    max_percentage_ = std::max(max_percentage_, block_max_percentage_);
     if (doc_list_buffer_.NeedFlush()) {
         FlushDocListBuffer();
     }
@@ -89,6 +93,8 @@ void DocListEncoder::Dump(const SharedPtr<FileWriter> &file, bool spill) {
         assert((sizeof(i32) == sizeof(float)));
         i32 block_max_percentage = std::bit_cast<i32>(block_max_percentage_);
         file->WriteInt(block_max_percentage);
+        file->WriteVInt(max_tf_);
+        file->WriteInt(std::bit_cast<i32>(max_percentage_));
     } else {
         Flush();
         u32 doc_skiplist_size = 0;
@@ -118,6 +124,8 @@ void DocListEncoder::Load(const SharedPtr<FileReader> &file) {
     block_max_tf_ = file->ReadVInt();
     i32 block_max_percentage = file->ReadInt();
     block_max_percentage_ = std::bit_cast<float>(block_max_percentage);
+    max_tf_ = file->ReadVInt();
+    max_percentage_ = std::bit_cast<float>(file->ReadInt());
 
     doc_skiplist_writer_->Load(file);
     doc_list_buffer_.Load(file);
@@ -154,9 +162,7 @@ void DocListEncoder::AddSkipListItem(u32 item_size) {
     const DocSkipListFormat *skiplist_format = doc_list_format_->GetDocSkipListFormat();
     if (skiplist_format->HasBlockMax()) {
         assert((block_max_percentage_ > 0 and block_max_percentage_ <= 1.0f));
-        u32 max_percentage_field = static_cast<u32>(std::ceil(block_max_percentage_ * std::numeric_limits<u16>::max()));
-        assert((max_percentage_field <= std::numeric_limits<u16>::max()));
-        doc_skiplist_writer_->AddItem(last_doc_id_, total_tf_, block_max_tf_, static_cast<u16>(max_percentage_field), item_size);
+        doc_skiplist_writer_->AddItem(last_doc_id_, total_tf_, block_max_tf_, QuantizePercentage(block_max_percentage_), item_size);
     } else if (skiplist_format->HasTfList()) {
         doc_skiplist_writer_->AddItem(last_doc_id_, total_tf_, item_size);
     } else {
@@ -164,6 +170,12 @@ void DocListEncoder::AddSkipListItem(u32 item_size) {
     }
 }
 
+u16 DocListEncoder::QuantizePercentage(float percentage) {
+    u32 percentage_field = static_cast<u32>(std::ceil(percentage * std::numeric_limits<u16>::max()));
+    assert((percentage_field <= std::numeric_limits<u16>::max()));
+    return static_cast<u16>(percentage_field);
+}
+
 InMemDocListDecoder *DocListEncoder::GetInMemDocListDecoder(MemoryPool *session_pool) const {
     df_t df = df_;
     SkipListReaderPostingByteSlice *skiplist_reader = nullptr;
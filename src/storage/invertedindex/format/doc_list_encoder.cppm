@@ -33,6 +33,9 @@ public:
 
     u16 GetLastDocPayload() const { return last_doc_payload_; }
 
+    // max tf and max (tf / doc length) quantized to u16 over all the docs, i.e. the max of the block max info
+    Pair<u32, u16> GetMaxInfo() const { return {max_tf_, QuantizePercentage(max_percentage_)}; }
+
     void SetCurrentTF(tf_t tf) {
         current_tf_ = tf;
         total_tf_ += tf;
@@ -63,6 +66,8 @@ private:
 
     void AddSkipListItem(u32 item_size);
 
+    static u16 QuantizePercentage(float percentage);
+
 private:
     PostingByteSlice doc_list_buffer_;
     bool own_doc_list_format_;
@@ -77,6 +82,9 @@ private:
     // for skip list block
     tf_t block_max_tf_ = 0;
     float block_max_percentage_ = 0.0f;
+    // for term meta
+    tf_t max_tf_ = 0;
+    float max_percentage_ = 0.0f;
 
     UniquePtr<SkipListWriter> doc_skiplist_writer_;
     MemoryPool *byte_slice_pool_{nullptr};
@@ -13,7 +13,8 @@ namespace infinity {
 export class PostingFormatOption {
 public:
     inline PostingFormatOption(optionflag_t flag)
-        : has_term_payload_(flag & of_term_payload), doc_list_format_option_(flag), pos_list_format_option_(flag) {}
+        : has_term_payload_(flag & of_term_payload), has_term_impact_((flag & of_term_impact) && (flag & of_block_max)), doc_list_format_option_(flag),
+          pos_list_format_option_(flag) {}
 
     bool HasTfList() const { return doc_list_format_option_.HasTfList(); }
 
@@ -25,6 +26,9 @@ public:
 
     bool HasTermPayload() const { return has_term_payload_; }
 
+    // the term meta keeps the max block impact of the term
+    bool HasTermImpact() const { return has_term_impact_; }
+
     bool IsShortListVbyteCompress() const { return doc_list_format_option_.IsShortListVbyteCompress(); }
 
     void SetShortListVbyteCompress(bool flag) { doc_list_format_option_.SetShortListVbyteCompress(flag); }
@@ -39,6 +43,7 @@ public:
 
 private:
     bool has_term_payload_;
+    bool has_term_impact_;
     DocListFormatOption doc_list_format_option_;
     PositionListFormatOption pos_list_format_option_;
 };
@@ -28,6 +28,10 @@ void TermMetaLoader::Load(ByteSliceReader *byte_slice_reader, TermMeta &term_met
     } else {
         term_meta.SetPayload(0);
     }
+    if (option_.HasTermImpact()) {
+        term_meta.max_tf_ = byte_slice_reader->ReadVUInt32();
+        byte_slice_reader->Read((void *)(&term_meta.max_percentage_), sizeof(term_meta.max_percentage_));
+    }
     term_meta.doc_start_ = byte_slice_reader->ReadVUInt64();
     term_meta.pos_start_ = byte_slice_reader->ReadVUInt64();
     term_meta.pos_end_ = byte_slice_reader->ReadVUInt64();
@@ -48,6 +52,10 @@ void TermMetaLoader::Load(const SharedPtr<FileReader> &reader, TermMeta &term_me
     } else {
         term_meta.SetPayload(0);
     }
+    if (option_.HasTermImpact()) {
+        term_meta.max_tf_ = reader->ReadVInt();
+        reader->Read((char *)(&term_meta.max_percentage_), sizeof(term_meta.max_percentage_));
+    }
     term_meta.doc_start_ = reader->ReadVLong();
     term_meta.pos_start_ = reader->ReadVLong();
     term_meta.pos_end_ = reader->ReadVLong();
@@ -71,6 +79,12 @@ void TermMetaLoader::Load(u8 *&data_cursor, SizeT &left_size, TermMeta &term_met
     } else {
         term_meta.SetPayload(0);
     }
+    if (option_.HasTermImpact()) {
+        term_meta.max_tf_ = VByteCompressor::DecodeVInt32(data_cursor, (u32 &)left_size);
+        term_meta.max_percentage_ = *(u16 *)data_cursor;
+        data_cursor += sizeof(u16);
+        left_size -= sizeof(u16);
+    }
     term_meta.doc_start_ = VByteCompressor::DecodeVInt64(data_cursor, (u32 &)left_size);
     term_meta.pos_start_ = VByteCompressor::DecodeVInt64(data_cursor, (u32 &)left_size);
     term_meta.pos_end_ = VByteCompressor::DecodeVInt64(data_cursor, (u32 &)left_size);
@@ -84,6 +98,10 @@ u32 TermMetaDumper::CalculateStoreSize(const TermMeta &term_meta) const {
     if (option_.HasTermPayload()) {
         len += sizeof(termpayload_t);
     }
+    if (option_.HasTermImpact()) {
+        len += VByteCompressor::GetVInt32Length(term_meta.max_tf_);
+        len += sizeof(term_meta.max_percentage_);
+    }
     len += VByteCompressor::GetVInt64Length(term_meta.doc_start_);
     len += VByteCompressor::GetVInt64Length(term_meta.pos_start_);
     len += VByteCompressor::GetVInt64Length(term_meta.pos_end_);
@@ -99,6 +117,10 @@ void TermMetaDumper::Dump(const SharedPtr<FileWriter> &file, const TermMeta &ter
         termpayload_t payload = term_meta.GetPayload();
         file->Write((char *)(&payload), sizeof(payload));
     }
+    if (option_.HasTermImpact()) {
+        file->WriteVInt(term_meta.max_tf_);
+        file->Write((char *)(&term_meta.max_percentage_), sizeof(term_meta.max_percentage_));
+    }
     file->WriteVLong(term_meta.doc_start_);
     file->WriteVLong(term_meta.pos_start_);
     file->WriteVLong(term_meta.pos_end_);
@@ -15,7 +15,9 @@ export struct TermMeta {
 
     TermMeta(df_t df, tf_t total_tf, termpayload_t payload = 0) : doc_freq_(df), total_tf_(total_tf), payload_(payload) {}
 
-    TermMeta(const TermMeta &term_meta) : doc_freq_(term_meta.doc_freq_), total_tf_(term_meta.total_tf_), payload_(term_meta.payload_) {}
+    TermMeta(const TermMeta &term_meta)
+        : doc_freq_(term_meta.doc_freq_), total_tf_(term_meta.total_tf_), payload_(term_meta.payload_), max_tf_(term_meta.max_tf_),
+          max_percentage_(term_meta.max_percentage_) {}
 
     df_t GetDocFreq() const { return doc_freq_; }
     tf_t GetTotalTermFreq() const { return total_tf_; }
@@ -29,23 +31,32 @@ export struct TermMeta {
         doc_freq_ = term_meta.doc_freq_;
         total_tf_ = term_meta.total_tf_;
         payload_ = term_meta.payload_;
+        max_tf_ = term_meta.max_tf_;
+        max_percentage_ = term_meta.max_percentage_;
         return (*this);
     }
 
     bool operator==(const TermMeta &term_meta) const {
-        return (doc_freq_ == term_meta.doc_freq_) && (total_tf_ == term_meta.total_tf_) && (payload_ == term_meta.payload_);
+        return (doc_freq_ == term_meta.doc_freq_) && (total_tf_ == term_meta.total_tf_) && (payload_ == term_meta.payload_) &&
+               (max_tf_ == term_meta.max_tf_) && (max_percentage_ == term_meta.max_percentage_);
     }
 
     void Reset() {
         doc_freq_ = 0;
         total_tf_ = 0;
         payload_ = 0;
+        max_tf_ = 0;
+        max_percentage_ = 0;
         doc_start_ = pos_start_ = 0;
     }
 
     df_t doc_freq_;
     tf_t total_tf_;
     termpayload_t payload_;
+    // max impact over the blocks of the term, same as the block max info of the skiplist
+    // max_tf_ is 0 if unknown, i.e. the index was built without of_term_impact
+    tf_t max_tf_ = 0;
+    u16 max_percentage_ = 0;
     u64 doc_start_ = 0;
     u64 pos_start_ = 0;
     u64 pos_end_ = 0;
@@ -70,8 +81,8 @@ public:
     u32 CalculateStoreSize(const TermMeta &term_meta) const;
     void Dump(const SharedPtr<FileWriter> &file, const TermMeta &term_meta) const;
 
-    // ReadVUInt32 + ReadVUInt32 + sizeof(payload)
-    static SizeT MaxStoreSize() { return sizeof(u32) + 1 + sizeof(u32) + 1 + sizeof(termpayload_t); }
+    // ReadVUInt32 + ReadVUInt32 + sizeof(payload) + ReadVUInt32 + sizeof(u16)
+    static SizeT MaxStoreSize() { return sizeof(u32) + 1 + sizeof(u32) + 1 + sizeof(termpayload_t) + sizeof(u32) + 1 + sizeof(u16); }
 
 private:
     PostingFormatOption option_;
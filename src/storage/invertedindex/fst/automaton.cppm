@@ -0,0 +1,214 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+export module fst:automaton;
+import stl;
+
+namespace infinity {
+
+/// A deterministic automaton over the bytes of a key.
+///
+/// An fst is searched with an automaton by walking both in lockstep, see
+/// `FstAutomatonStream`. Once the automaton is in `DEAD_STATE` no key with
+/// the current prefix can match, so the whole subtree of the fst is skipped.
+export class Automaton {
+public:
+    static constexpr i64 DEAD_STATE = -1;
+
+    virtual ~Automaton() = default;
+
+    virtual i64 Start() = 0;
+
+    virtual bool IsMatch(i64 state) = 0;
+
+    virtual i64 Accept(i64 state, u8 byte) = 0;
+
+    /// Returns true if and only if the automaton matches the whole key.
+    bool Matches(const u8 *key_ptr, SizeT key_len) {
+        i64 state = Start();
+        for (SizeT i = 0; i < key_len && state != DEAD_STATE; i++) {
+            state = Accept(state, key_ptr[i]);
+        }
+        return state != DEAD_STATE && IsMatch(state);
+    }
+};
+
+/// Matches the keys starting with a prefix.
+///
+/// The state is the length of the prefix matched so far.
+export class PrefixAutomaton : public Automaton {
+public:
+    explicit PrefixAutomaton(String prefix) : prefix_(std::move(prefix)) {}
+
+    i64 Start() override { return 0; }
+
+    bool IsMatch(i64 state) override { return state == i64(prefix_.size()); }
+
+    i64 Accept(i64 state, u8 byte) override {
+        if (state == DEAD_STATE || state == i64(prefix_.size())) {
+            return state;
+        }
+        return u8(prefix_[state]) == byte ? state + 1 : DEAD_STATE;
+    }
+
+private:
+    const String prefix_;
+};
+
+/// An automaton whose states are vectors of u32, i.e. the state set of a
+/// nondeterministic automaton or a row of edit distances.
+///
+/// States and transitions are built lazily, only the ones reached by the
+/// keys walked are ever computed.
+export class LazyAutomaton : public Automaton {
+public:
+    i64 Start() override {
+        if (states_.empty()) {
+            Vector<u32> start;
+            StartState(start);
+            Intern(std::move(start));
+        }
+        return 0;
+    }
+
+    bool IsMatch(i64 state) override { return state != DEAD_STATE && matches_[state]; }
+
+    i64 Accept(i64 state, u8 byte) override {
+        if (state == DEAD_STATE) {
+            return DEAD_STATE;
+        }
+        u64 transition = (u64(state) << 8) | byte;
+        if (auto iter = transitions_.find(transition); iter != transitions_.end()) {
+            return iter->second;
+        }
+        Vector<u32> next;
+        Step(states_[state], byte, next);
+        i64 next_state = next.empty() ? DEAD_STATE : Intern(std::move(next));
+        transitions_.emplace(transition, next_state);
+        return next_state;
+    }
+
+protected:
+    virtual void StartState(Vector<u32> &start) const = 0;
+
+    /// `next` is left empty if no key can match after `byte`.
+    virtual void Step(const Vector<u32> &state, u8 byte, Vector<u32> &next) const = 0;
+
+    virtual bool IsMatchState(const Vector<u32> &state) const = 0;
+
+private:
+    i64 Intern(Vector<u32> &&state) {
+        auto [iter, inserted] = state_ids_.emplace(std::move(state), i64(states_.size()));
+        if (inserted) {
+            states_.push_back(iter->first);
+            matches_.push_back(IsMatchState(iter->first));
+        }
+        return iter->second;
+    }
+
+    Vector<Vector<u32>> states_;
+    Vector<bool> matches_;
+    Map<Vector<u32>, i64> state_ids_;
+    HashMap<u64, i64> transitions_;
+};
+
+/// Matches the keys against a pattern where `*` matches any sequence of
+/// bytes and `?` matches exactly one byte.
+///
+/// The state is the sorted set of the pattern positions reached.
+export class WildcardAutomaton : public LazyAutomaton {
+public:
+    explicit WildcardAutomaton(String pattern) : pattern_(std::move(pattern)) {}
+
+protected:
+    void StartState(Vector<u32> &start) const override {
+        start.push_back(0);
+        Close(start);
+    }
+
+    void Step(const Vector<u32> &state, u8 byte, Vector<u32> &next) const override {
+        for (u32 pos : state) {
+            if (pos == pattern_.size()) {
+                continue;
+            }
+            char c = pattern_[pos];
+            if (c == '*') {
+                next.push_back(pos);
+            } else if (c == '?' || u8(c) == byte) {
+                next.push_back(pos + 1);
+            }
+        }
+        Close(next);
+    }
+
+    bool IsMatchState(const Vector<u32> &state) const override { return state.back() == pattern_.size(); }
+
+private:
+    // A `*` may match the empty sequence, so the position after it is reached as well.
+    void Close(Vector<u32> &state) const {
+        for (SizeT i = 0; i < state.size(); i++) {
+            u32 pos = state[i];
+            if (pos < pattern_.size() && pattern_[pos] == '*') {
+                state.push_back(pos + 1);
+            }
+        }
+        std::sort(state.begin(), state.end());
+        state.erase(std::unique(state.begin(), state.end()), state.end());
+    }
+
+    const String pattern_;
+};
+
+/// Matches the keys within `max_edits` insertions, deletions or
+/// substitutions of a term.
+///
+/// The state is the row of the edit distances between the key read so far
+/// and every prefix of the term, capped at `max_edits + 1`. Edits are counted
+/// in bytes.
+export class LevenshteinAutomaton : public LazyAutomaton {
+public:
+    LevenshteinAutomaton(String term, u32 max_edits) : term_(std::move(term)), max_edits_(max_edits) {}
+
+protected:
+    void StartState(Vector<u32> &start) const override {
+        start.resize(term_.size() + 1);
+        for (u32 i = 0; i < start.size(); i++) {
+            start[i] = std::min(i, max_edits_ + 1);
+        }
+    }
+
+    void Step(const Vector<u32> &state, u8 byte, Vector<u32> &next) const override {
+        next.resize(state.size());
+        next[0] = std::min(state[0] + 1, max_edits_ + 1);
+        u32 min_distance = next[0];
+        for (SizeT i = 1; i < state.size(); i++) {
+            u32 substitute = state[i - 1] + (u8(term_[i - 1]) == byte ? 0 : 1);
+            u32 distance = std::min({substitute, state[i] + 1, next[i - 1] + 1});
+            next[i] = std::min(distance, max_edits_ + 1);
+            min_distance = std::min(min_distance, next[i]);
+        }
+        if (min_distance > max_edits_) {
+            next.clear();
+        }
+    }
+
+    bool IsMatchState(const Vector<u32> &state) const override { return state.back() <= max_edits_; }
+
+private:
+    const String term_;
+    const u32 max_edits_;
+};
+
+} // namespace infinity
@@ -19,6 +19,7 @@ import crc;
 import :error;
 import :bytes;
 import :node;
+import :automaton;
 
 /// An acyclic deterministic finite state transducer.
 ///
@@ -47,6 +48,7 @@ private:
     SizeT data_len_;
 
     friend class FstStream;
+    friend class FstAutomatonStream;
 
 public:
     /// Creates a transducer from its representation as a raw byte sequence.
@@ -366,4 +368,63 @@ private:
     }
 };
 
+struct AutomatonStreamState {
+    Node node_;
+    SizeT trans_;
+    Output out_;
+    i64 aut_state_;
+    AutomatonStreamState(const Node &node, SizeT trans, Output out, i64 aut_state) : node_(node), trans_(trans), out_(out), aut_state_(aut_state) {}
+};
+
+/// A lexicographically ordered stream of the key-value pairs of an fst whose
+/// keys are matched by an automaton.
+///
+/// The fst and the automaton are walked in lockstep, a transition leading the
+/// automaton to its dead state is never followed.
+export class FstAutomatonStream {
+private:
+    Fst &fst_;
+    Automaton &automaton_;
+    Vector<u8> inp_;
+    Vector<AutomatonStreamState> stack_;
+
+public:
+    FstAutomatonStream(Fst &fst, Automaton &automaton) : fst_(fst), automaton_(automaton) {
+        stack_.emplace_back(fst_.Root(), 0, Output(), automaton_.Start());
+    }
+
+    /// @brief Get next matched key-value pair per lexicographical order
+    /// @param key Stores the key of the pair when found
+    /// @param val Stores the value of the pair when found
+    /// @return true if found next pair, false if not
+    bool Next(Vector<u8> &key, u64 &val) {
+        while (!stack_.empty()) {
+            AutomatonStreamState &state = stack_.back();
+            if (state.trans_ >= state.node_.Len()) {
+                stack_.pop_back();
+                if (!inp_.empty()) {
+                    inp_.pop_back();
+                }
+                continue;
+            }
+            Transition trans = state.node_.TransAt(state.trans_);
+            state.trans_++;
+            i64 next_aut_state = automaton_.Accept(state.aut_state_, trans.inp_);
+            if (next_aut_state == Automaton::DEAD_STATE) {
+                continue;
+            }
+            Output out = state.out_.Cat(trans.out_);
+            Node next_node = fst_.NodeAt(trans.addr_);
+            inp_.push_back(trans.inp_);
+            stack_.emplace_back(next_node, 0, out, next_aut_state);
+            if (next_node.IsFinal() && automaton_.IsMatch(next_aut_state)) {
+                key = inp_;
+                val = out.Cat(next_node.FinalOutput()).Value();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 } // namespace infinity
\ No newline at end of file
@@ -20,6 +20,7 @@ export {
         of_position_list = 4,  // 1 << 2
         of_term_frequency = 8, // 1 << 3
         of_block_max = 16,     // 1 << 4
+        of_term_impact = 32,   // 1 << 5
     };
 
     typedef u16 docpayload_t;
@@ -31,7 +32,7 @@ export {
     typedef u32 tf_t;
     typedef i64 ttf_t;
 
-    constexpr optionflag_t OPTION_FLAG_ALL = of_term_payload | of_doc_payload | of_position_list | of_term_frequency | of_block_max;
+    constexpr optionflag_t OPTION_FLAG_ALL = of_term_payload | of_doc_payload | of_position_list | of_term_frequency | of_block_max | of_term_impact;
     constexpr optionflag_t NO_BLOCK_MAX = of_term_payload | of_doc_payload | of_position_list | of_term_frequency;
     constexpr optionflag_t NO_TERM_FREQUENCY = of_term_payload | of_doc_payload;
     constexpr optionflag_t OPTION_FLAG_NONE = of_none;
@@ -18,6 +18,7 @@ import stl;
 import memory_pool;
 import segment_posting;
 import index_defines;
+import fst;
 export module index_segment_reader;
 
 namespace infinity {
@@ -28,6 +29,9 @@ public:
 
     // fetch_position is only valid in DiskIndexSegmentReader
     virtual bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, MemoryPool *session_pool, bool fetch_position = true) const = 0;
+
+    // append the terms of the segment matched by the automaton in lexicographical order, at most limit terms
+    virtual void MatchTerms(Automaton &automaton, SizeT limit, Vector<String> &terms) const = 0;
 };
 
 } // namespace infinity
\ No newline at end of file
@@ -24,6 +24,7 @@ import index_defines;
 import posting_writer;
 import memory_indexer;
 import third_party;
+import fst;
 
 namespace infinity {
 InMemIndexSegmentReader::InMemIndexSegmentReader(MemoryIndexer *memory_indexer)
@@ -39,4 +40,16 @@ bool InMemIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPosti
     return false;
 }
 
+void InMemIndexSegmentReader::MatchTerms(Automaton &automaton, SizeT limit, Vector<String> &terms) const {
+    // the in-memory terms are not in an fst, every term is checked but the automaton caches its transitions
+    SizeT matched = 0;
+    posting_table_->store_.Scan([&](const String &term, const SharedPtr<PostingWriter> &) {
+        if (automaton.Matches(reinterpret_cast<const u8 *>(term.data()), term.size())) {
+            terms.push_back(term);
+            ++matched;
+        }
+        return matched < limit;
+    });
+}
+
 } // namespace infinity
\ No newline at end of file
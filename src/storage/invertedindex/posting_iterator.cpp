@@ -40,8 +40,16 @@ PostingIterator::~PostingIterator() {
 
 bool PostingIterator::Init(SharedPtr<Vector<SegmentPosting>> seg_postings, const u32) {
     segment_postings_ = std::move(seg_postings);
+    bool term_max_info_known = true;
     for (auto &seg_posting : *segment_postings_) {
-        doc_freq_ += seg_posting.GetTermMeta().GetDocFreq();
+        const TermMeta &term_meta = seg_posting.GetTermMeta();
+        doc_freq_ += term_meta.GetDocFreq();
+        term_max_info_known = term_max_info_known && term_meta.max_tf_ > 0;
+        term_max_info_.first = std::max(term_max_info_.first, term_meta.max_tf_);
+        term_max_info_.second = std::max(term_max_info_.second, term_meta.max_percentage_);
+    }
+    if (!term_max_info_known) {
+        term_max_info_ = {0, 0};
     }
     Reset();
     return true;
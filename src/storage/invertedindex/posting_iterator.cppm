@@ -40,6 +40,10 @@ public:
     // u16: block max (ceil(tf / doc length) * numeric_limits<u16>::max())
     Pair<u32, u16> GetBlockMaxInfo() const;
 
+    // same as GetBlockMaxInfo, the max over all the blocks of all the segments
+    // u32 is 0 if unknown for some segment
+    Pair<u32, u16> GetTermMaxInfo() const { return term_max_info_; }
+
     RowID SeekDoc(RowID docId);
 
     Pair<bool, RowID> PeekInBlockRange(RowID doc_id, RowID doc_id_no_beyond);
@@ -116,6 +120,7 @@ private:
     PostingFormatOption posting_option_;
     MemoryPool *session_pool_ = nullptr;
     u32 doc_freq_ = 0;
+    Pair<u32, u16> term_max_info_{0, 0};
 
     // info for skiplist, block max
     RowID last_doc_id_in_prev_block_ = INVALID_ROWID;
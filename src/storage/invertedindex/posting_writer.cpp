@@ -55,12 +55,17 @@ u32 PostingWriter::GetDF() const { return doc_list_encoder_->GetDF(); }
 
 u32 PostingWriter::GetTotalTF() const { return doc_list_encoder_->GetTotalTF(); }
 
+Pair<u32, u16> PostingWriter::GetMaxInfo() const { return doc_list_encoder_->GetMaxInfo(); }
+
 tf_t PostingWriter::GetCurrentTF() const { return doc_list_encoder_->GetCurrentTF(); }
 
 void PostingWriter::SetCurrentTF(tf_t tf) { doc_list_encoder_->SetCurrentTF(tf); }
 
 void PostingWriter::Dump(const SharedPtr<FileWriter> &file_writer, TermMeta &term_meta, bool spill) {
     term_meta.doc_start_ = file_writer->TotalWrittenBytes();
+    auto [max_tf, max_percentage] = doc_list_encoder_->GetMaxInfo();
+    term_meta.max_tf_ = max_tf;
+    term_meta.max_percentage_ = max_percentage;
     doc_list_encoder_->Dump(file_writer, spill);
     if (position_list_encoder_) {
         term_meta.pos_start_ = file_writer->TotalWrittenBytes();
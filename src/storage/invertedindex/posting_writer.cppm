@@ -29,6 +29,9 @@ public:
 
     u32 GetDF() const;
 
+    // max tf and max quantized (tf / doc length) of the term, see DocListEncoder::GetMaxInfo
+    Pair<u32, u16> GetMaxInfo() const;
+
     docpayload_t GetLastDocPayload() const { return 0; };
 
     void SetCurrentTF(tf_t tf);
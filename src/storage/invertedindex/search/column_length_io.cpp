@@ -32,6 +32,7 @@ import chunk_index_entry;
 import memory_indexer;
 import buffer_obj;
 import buffer_handle;
+import norm_quantizer;
 
 namespace infinity {
 
@@ -41,9 +42,8 @@ FullTextColumnLengthReader::FullTextColumnLengthReader(UniquePtr<FileSystem> fil
                                                        SharedPtr<MemoryIndexer> memory_indexer)
     : file_system_(std::move(file_system)), index_dir_(index_dir), chunk_index_entries_(chunk_index_entries), memory_indexer_(memory_indexer) {}
 
-u32 FullTextColumnLengthReader::SeekFile(RowID row_id) {
+u8 FullTextColumnLengthReader::SeekChunk(RowID row_id) {
     // determine the ChunkIndexEntry which contains row_id
-    current_chunk_buffer_handle_.~BufferHandle();
     SizeT left = 0;
     SizeT right = chunk_index_entries_.size();
     SizeT current_chunk = std::numeric_limits<SizeT>::max();
@@ -62,12 +62,11 @@ u32 FullTextColumnLengthReader::SeekFile(RowID row_id) {
         return 0;
     }
 
-    // Load the column-length file of the ChunkIndexEntry
-    current_chunk_buffer_handle_ = chunk_index_entries_[current_chunk]->GetBufferObj()->Load();
-    column_lengths_ = (const u32 *)current_chunk_buffer_handle_.GetData();
+    // the norms of the chunk stay in memory, switching chunks reads no file
+    norms_ = chunk_index_entries_[current_chunk]->GetNorms();
     current_chunk_base_rowid_ = chunk_index_entries_[current_chunk]->base_rowid_;
     current_chunk_row_count_ = chunk_index_entries_[current_chunk]->row_count_;
-    return column_lengths_[row_id - current_chunk_base_rowid_];
+    return norms_[row_id - current_chunk_base_rowid_];
 }
 
 void ColumnLengthReader::AppendColumnLength(IndexReader *index_reader, const Vector<u64> &column_ids, Vector<float> &avg_column_length) {
@@ -25,6 +25,7 @@ import chunk_index_entry;
 import memory_indexer;
 import buffer_obj;
 import buffer_handle;
+import norm_quantizer;
 
 namespace infinity {
 class SegmentIndexEntry;
@@ -39,31 +40,33 @@ public:
                                const Vector<SharedPtr<ChunkIndexEntry>> &chunk_index_entries,
                                SharedPtr<MemoryIndexer> memory_indexer);
 
-    inline u32 GetColumnLength(RowID row_id) {
+    // the quantized column length, see norm_quantizer
+    inline u8 GetNorm(RowID row_id) {
         if (row_id >= current_chunk_base_rowid_ && row_id < current_chunk_base_rowid_ + current_chunk_row_count_) [[likely]] {
-            assert(column_lengths_ != nullptr);
-            return column_lengths_[row_id - current_chunk_base_rowid_];
+            assert(norms_ != nullptr);
+            return norms_[row_id - current_chunk_base_rowid_];
         }
         if (memory_indexer_.get() != nullptr) {
             RowID base_rowid = memory_indexer_->GetBaseRowId();
             u32 doc_count = memory_indexer_->GetDocCount();
             if (row_id >= base_rowid && row_id < base_rowid + doc_count) {
-                return memory_indexer_->GetColumnLength(row_id - base_rowid);
+                return EncodeNorm(memory_indexer_->GetColumnLength(row_id - base_rowid));
             }
         }
-        return SeekFile(row_id);
+        return SeekChunk(row_id);
     }
 
+    inline u32 GetColumnLength(RowID row_id) { return DecodeNorm(GetNorm(row_id)); }
+
 private:
-    u32 SeekFile(RowID row_id);
+    u8 SeekChunk(RowID row_id);
     UniquePtr<FileSystem> file_system_;
     const String &index_dir_;
     const Vector<SharedPtr<ChunkIndexEntry>> &chunk_index_entries_; // must in ascending order
     SharedPtr<MemoryIndexer> memory_indexer_;
-    const u32 *column_lengths_{nullptr};
+    const u8 *norms_{nullptr};
     RowID current_chunk_base_rowid_{(u64)0};
     u32 current_chunk_row_count_{0};
-    BufferHandle current_chunk_buffer_handle_{};
 };
 
 export class ColumnLengthReader {
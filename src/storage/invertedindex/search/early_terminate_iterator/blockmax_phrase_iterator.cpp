@@ -0,0 +1,100 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <iostream>
+module blockmax_phrase_iterator;
+import stl;
+import index_defines;
+import early_terminate_iterator;
+import blockmax_term_doc_iterator;
+import blockmax_and_iterator;
+import phrase_doc_iterator;
+import internal_types;
+
+namespace infinity {
+
+BlockMaxPhraseIterator::BlockMaxPhraseIterator(Vector<UniquePtr<BlockMaxTermDocIterator>> iterators, Vector<u32> offsets, u32 slop)
+    : matcher_(std::move(offsets), slop) {
+    phrase_iterators_.reserve(iterators.size());
+    Vector<UniquePtr<EarlyTerminateIterator>> and_children;
+    and_children.reserve(iterators.size());
+    for (auto &iter : iterators) {
+        phrase_iterators_.push_back(iter.get());
+        and_children.emplace_back(std::move(iter));
+    }
+    and_iterator_ = MakeUnique<BlockMaxAndIterator>(std::move(and_children));
+    doc_freq_ = and_iterator_->DocFreq();
+    bm25_score_upper_bound_ = and_iterator_->BM25ScoreUpperBound();
+}
+
+bool BlockMaxPhraseIterator::MatchPhrase(RowID doc_id) {
+    if (doc_id != checked_doc_id_) {
+        checked_doc_id_ = doc_id;
+        checked_doc_match_ = matcher_.Match(phrase_iterators_);
+    }
+    return checked_doc_match_;
+}
+
+Tuple<bool, float, RowID> BlockMaxPhraseIterator::SeekInBlockRange(RowID doc_id, RowID doc_id_no_beyond, float threshold) {
+    const RowID block_end = std::min(doc_id_no_beyond, BlockLastDocID());
+    while (doc_id <= block_end) {
+        auto [success, score, id] = and_iterator_->SeekInBlockRange(doc_id, block_end, threshold);
+        if (!success) {
+            return {false, 0.0F, INVALID_ROWID};
+        }
+        if (MatchPhrase(id)) {
+            doc_id_ = id;
+            return {true, score, id};
+        }
+        // all the terms occur in the doc, but not as the phrase
+        doc_id = id + 1;
+    }
+    return {false, 0.0F, INVALID_ROWID};
+}
+
+bool BlockMaxPhraseIterator::NotPartCheckExist(RowID doc_id) {
+    if (doc_id_ != INVALID_ROWID) {
+        if (doc_id_ > doc_id) {
+            return false;
+        }
+        if (doc_id_ == doc_id) {
+            return true;
+        }
+    }
+    if (!and_iterator_->NotPartCheckExist(doc_id) || !MatchPhrase(doc_id)) {
+        return false;
+    }
+    doc_id_ = doc_id;
+    return true;
+}
+
+void BlockMaxPhraseIterator::PrintTree(std::ostream &os, const String &prefix, bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << "BlockMaxPhraseIterator";
+    os << " (column: " << *column_name_ptr_ << ")";
+    os << " (slop: " << matcher_.slop() << ")";
+    os << " (doc_freq: " << DocFreq() << ")";
+    os << " (bm25_score_upper_bound: " << BM25ScoreUpperBound() << ")";
+    os << '\n';
+    const String next_prefix = prefix + (is_final ? "    " : "│   ");
+    for (u32 i = 0; i < phrase_iterators_.size(); ++i) {
+        phrase_iterators_[i]->PrintTree(os, next_prefix, i + 1 == phrase_iterators_.size());
+    }
+}
+
+} // namespace infinity
@@ -0,0 +1,75 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+export module blockmax_phrase_iterator;
+import stl;
+import index_defines;
+import early_terminate_iterator;
+import blockmax_term_doc_iterator;
+import blockmax_and_iterator;
+import phrase_doc_iterator;
+import internal_types;
+
+namespace infinity {
+
+// Block max iterator of a phrase.
+// The docs containing all the terms and their block max scores come from a BlockMaxAndIterator over the terms, the positions of the
+// candidate docs are checked before they are returned. The score of a doc is the sum of the BM25 scores of the terms.
+export class BlockMaxPhraseIterator final : public EarlyTerminateIterator {
+public:
+    BlockMaxPhraseIterator(Vector<UniquePtr<BlockMaxTermDocIterator>> iterators, Vector<u32> offsets, u32 slop);
+
+    void UpdateScoreThreshold(float threshold) override { and_iterator_->UpdateScoreThreshold(threshold); }
+
+    bool BlockSkipTo(RowID doc_id, float threshold) override { return and_iterator_->BlockSkipTo(doc_id, threshold); }
+
+    // following functions are available only after BlockSkipTo() is called
+
+    RowID BlockMinPossibleDocID() const override { return and_iterator_->BlockMinPossibleDocID(); }
+
+    RowID BlockLastDocID() const override { return and_iterator_->BlockLastDocID(); }
+
+    float BlockMaxBM25Score() override { return and_iterator_->BlockMaxBM25Score(); }
+
+    Tuple<bool, float, RowID> SeekInBlockRange(RowID doc_id, RowID doc_id_no_beyond, float threshold) override;
+
+    // The positions are not checked, the doc may contain all the terms but not the phrase.
+    // It is only a lower bound of the next matching doc, which is what the callers use it for.
+    Pair<bool, RowID> PeekInBlockRange(RowID doc_id, RowID doc_id_no_beyond) override {
+        return and_iterator_->PeekInBlockRange(doc_id, doc_id_no_beyond);
+    }
+
+    bool NotPartCheckExist(RowID doc_id) override;
+
+    void PrintTree(std::ostream &os, const String &prefix, bool is_final) const override;
+
+    // debug info
+    const String *column_name_ptr_ = nullptr;
+
+private:
+    // the term iterators are at doc_id
+    bool MatchPhrase(RowID doc_id);
+
+    Vector<BlockMaxTermDocIterator *> phrase_iterators_; // in phrase order, owned by and_iterator_
+    UniquePtr<BlockMaxAndIterator> and_iterator_;
+    PhraseMatcher matcher_;
+    // the positions can be checked only once per doc
+    RowID checked_doc_id_ = INVALID_ROWID;
+    bool checked_doc_match_ = false;
+};
+
+} // namespace infinity
@@ -28,6 +28,7 @@ import segment_posting;
 import posting_iterator;
 import column_length_io;
 import infinity_exception;
+import norm_quantizer;
 
 namespace infinity {
 BlockMaxTermDocIterator::BlockMaxTermDocIterator(optionflag_t flag, MemoryPool *session_pool) : iter_(flag, session_pool) {}
@@ -67,6 +68,16 @@ void BlockMaxTermDocIterator::InitBM25Info(u64 total_df, float avg_column_len, F
     float smooth_idf = std::log(1.0F + (total_df - doc_freq_ + 0.5F) / (doc_freq_ + 0.5F));
     bm25_common_score_ = weight_ * smooth_idf * (k1 + 1.0F);
     bm25_score_upper_bound_ = bm25_common_score_ / (1.0F + k1 * b / avg_column_len_);
+    // the term level impact gives the same bound as the block level one, over all the blocks
+    if (auto [term_max_tf, term_max_percentage_u16] = iter_.GetTermMaxInfo(); term_max_tf > 0 && term_max_percentage_u16 > 0) {
+        const float term_upper_bound =
+            bm25_common_score_ /
+            (1.0F + k1 * ((1.0F - b) / term_max_tf + b * std::numeric_limits<u16>::max() / (term_max_percentage_u16 * avg_column_len_)));
+        bm25_score_upper_bound_ = std::min(bm25_score_upper_bound_, term_upper_bound);
+    }
+    for (u32 norm = 0; norm < bm25_norm_factors_.size(); ++norm) {
+        bm25_norm_factors_[norm] = k1 * (1.0F - b + b * DecodeNorm(u8(norm)) / avg_column_len_);
+    }
 }
 
 // weight included
@@ -86,9 +97,9 @@ float BlockMaxTermDocIterator::BlockMaxBM25Score() {
 // weight included
 float BlockMaxTermDocIterator::BM25Score() {
     // bm25_common_score_ * tf / (tf + k1 * (1.0F - b + b * column_len / avg_column_len));
-    auto tf = iter_.GetCurrentTF();
-    auto doc_len = column_length_reader_->GetColumnLength(doc_id_);
-    return bm25_common_score_ * tf / (tf + k1 * (1.0F - b + b * doc_len / avg_column_len_));
+    const float tf = iter_.GetCurrentTF();
+    const u8 norm = column_length_reader_->GetNorm(doc_id_);
+    return bm25_common_score_ * tf / (tf + bm25_norm_factors_[norm]);
 }
 
 Tuple<bool, float, RowID> BlockMaxTermDocIterator::SeekInBlockRange(RowID doc_id, RowID doc_id_no_beyond, float threshold) {
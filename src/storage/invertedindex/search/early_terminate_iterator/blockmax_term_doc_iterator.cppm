@@ -62,6 +62,9 @@ public:
     // weight included
     float BM25Score();
 
+    // the first position not less than pos in the current doc, positions are visited in ascending order
+    void SeekPosition(pos_t pos, pos_t &result) { iter_.SeekPosition(pos, result); }
+
     void PrintTree(std::ostream &os, const String &prefix, bool is_final) const override;
 
     // debug info
@@ -76,6 +79,7 @@ private:
     float avg_column_len_ = 0;
     FullTextColumnLengthReader *column_length_reader_ = nullptr;
     float bm25_common_score_ = 0; // include: weight * smooth_idf * (k1 + 1.0F)
+    Array<float, 256> bm25_norm_factors_{}; // k1 * (1.0F - b + b * column_len / avg_column_len) of every quantized column length
     float block_max_bm25_score_cache_ = 0;
     RowID block_max_bm25_score_cache_end_id_ = INVALID_ROWID;
     // cache for PeekInBlockRange
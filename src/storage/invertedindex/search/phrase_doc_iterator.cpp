@@ -0,0 +1,81 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <iostream>
+module phrase_doc_iterator;
+
+import stl;
+import index_defines;
+import doc_iterator;
+import term_doc_iterator;
+import internal_types;
+
+namespace infinity {
+
+PhraseDocIterator::PhraseDocIterator(Vector<UniquePtr<TermDocIterator>> &&iterators, Vector<u32> offsets, u32 slop)
+    : iterators_(std::move(iterators)), matcher_(std::move(offsets), slop) {
+    phrase_iterators_.reserve(iterators_.size());
+    phrase_df_ = std::numeric_limits<u32>::max();
+    for (const auto &iter : iterators_) {
+        iter->DoSeek(0);
+        phrase_iterators_.push_back(iter.get());
+        phrase_df_ = std::min(phrase_df_, iter->GetDF());
+    }
+    sorted_iterators_ = phrase_iterators_;
+    std::sort(sorted_iterators_.begin(), sorted_iterators_.end(), [](const auto lhs, const auto rhs) { return lhs->GetDF() < rhs->GetDF(); });
+    // initialize doc_id_ to first doc
+    DoSeek(0);
+}
+
+void PhraseDocIterator::DoSeek(RowID doc_id) {
+    while (true) {
+        auto ib = sorted_iterators_.begin();
+        const auto ie = sorted_iterators_.end();
+        while (ib != ie) {
+            (*ib)->Seek(doc_id);
+            if (RowID doc = (*ib)->Doc(); doc != doc_id) {
+                // not match, restart from the first iterator, since first iterator has fewer docs
+                doc_id = doc;
+                ib = sorted_iterators_.begin();
+            } else {
+                ++ib;
+            }
+        }
+        if (doc_id == INVALID_ROWID || matcher_.Match(phrase_iterators_)) {
+            break;
+        }
+        // all the terms occur in the doc, but not as the phrase
+        ++doc_id;
+    }
+    doc_id_ = doc_id;
+}
+
+void PhraseDocIterator::PrintTree(std::ostream &os, const String &prefix, bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << "PhraseDocIterator";
+    os << " (column: " << *column_name_ptr_ << ")";
+    os << " (slop: " << matcher_.slop() << ")";
+    os << " (doc_freq: " << GetDF() << ")";
+    os << '\n';
+    const String next_prefix = prefix + (is_final ? "    " : "│   ");
+    for (u32 i = 0; i < phrase_iterators_.size(); ++i) {
+        phrase_iterators_[i]->PrintTree(os, next_prefix, i + 1 == phrase_iterators_.size());
+    }
+}
+
+} // namespace infinity
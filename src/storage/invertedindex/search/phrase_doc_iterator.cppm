@@ -0,0 +1,107 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+export module phrase_doc_iterator;
+
+import stl;
+import index_defines;
+import doc_iterator;
+import term_doc_iterator;
+import internal_types;
+
+namespace infinity {
+
+// Check the positions of the terms of a phrase in the current doc of their iterators.
+// Term i has to occur offsets[i] positions after term 0, the positions may be shifted forward by at most slop in total.
+export class PhraseMatcher {
+public:
+    PhraseMatcher(Vector<u32> offsets, u32 slop) : offsets_(std::move(offsets)), slop_(slop), positions_(offsets_.size()) {}
+
+    template <typename TermIterator>
+    bool Match(const Vector<TermIterator *> &terms) {
+        // The iterators can only seek positions forward, the last position found of every term is kept.
+        // For a larger position of term 0 the earliest valid positions of the other terms can't be smaller, so one pass is enough.
+        std::fill(positions_.begin(), positions_.end(), NOT_SEEKED);
+        auto seek = [&](SizeT i, i64 pos) -> i64 {
+            if (positions_[i] < pos) {
+                pos_t result = INVALID_POSITION;
+                terms[i]->SeekPosition(pos, result);
+                positions_[i] = result;
+            }
+            return positions_[i];
+        };
+        i64 start = 0;
+        while (true) {
+            const i64 first = seek(0, start);
+            if (first == INVALID_POSITION) {
+                return false;
+            }
+            i64 prev = first;
+            SizeT i = 1;
+            for (; i < terms.size(); ++i) {
+                const i64 pos = seek(i, prev + offsets_[i] - offsets_[i - 1]);
+                if (pos == INVALID_POSITION) {
+                    return false;
+                }
+                if (pos - first - offsets_[i] > slop_) {
+                    // term 0 has to move forward so that term i is within the slop
+                    start = std::max(first + 1, pos - offsets_[i] - slop_);
+                    break;
+                }
+                prev = pos;
+            }
+            if (i == terms.size()) {
+                return true;
+            }
+        }
+    }
+
+    u32 slop() const { return slop_; }
+
+private:
+    static constexpr i64 NOT_SEEKED = -1;
+
+    const Vector<u32> offsets_;
+    const i64 slop_;
+    Vector<i64> positions_;
+};
+
+// Docs containing all the terms of a phrase at the right positions.
+// The docs containing all the terms are found the same way as AndIterator does, then their positions are checked.
+export class PhraseDocIterator final : public DocIterator {
+public:
+    PhraseDocIterator(Vector<UniquePtr<TermDocIterator>> &&iterators, Vector<u32> offsets, u32 slop);
+
+    void DoSeek(RowID doc_id) override;
+
+    // estimated by the least df of the terms
+    u32 GetDF() const override { return phrase_df_; }
+
+    void PrintTree(std::ostream &os, const String &prefix, bool is_final) const override;
+
+    // debug info
+    const String *column_name_ptr_ = nullptr;
+
+private:
+    Vector<UniquePtr<TermDocIterator>> iterators_; // in phrase order
+    Vector<TermDocIterator *> phrase_iterators_;   // in phrase order
+    Vector<TermDocIterator *> sorted_iterators_;   // sort by df, in ascending order
+    PhraseMatcher matcher_;
+    u32 phrase_df_{};
+};
+
+} // namespace infinity
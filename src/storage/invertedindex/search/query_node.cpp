@@ -19,12 +19,16 @@ import blockmax_term_doc_iterator;
 import blockmax_and_iterator;
 import blockmax_and_not_iterator;
 import blockmax_maxscore_iterator;
+import phrase_doc_iterator;
+import blockmax_phrase_iterator;
 import index_defines;
+import fst;
 import third_party;
 
 namespace infinity {
 
 // optimize: from leaf to root, replace tree node in place
+// "phrase" and the multi-term nodes (prefix, wildcard, fuzzy) are leaves, they are optimized as a term
 
 // expected property of optimized node:
 // 1. children of "not" can only be term, "and" or "and_not", because "not" is not allowed, and "or" will be flattened to not list
@@ -45,7 +49,11 @@ std::unique_ptr<QueryNode> QueryNode::GetOptimizedQueryTree(std::unique_ptr<Quer
     root->PushDownWeight();
     // optimize the query tree
     switch (root->GetType()) {
-        case QueryNodeType::TERM: {
+        case QueryNodeType::TERM:
+        case QueryNodeType::PHRASE:
+        case QueryNodeType::PREFIX_TERM:
+        case QueryNodeType::WILDCARD_TERM:
+        case QueryNodeType::FUZZY_TERM: {
             // no need to optimize
             optimized_root = std::move(root);
             break;
@@ -93,6 +101,10 @@ std::unique_ptr<QueryNode> MultiQueryNode::GetNewOptimizedQueryTree() {
     for (auto &child : children_) {
         switch (child->GetType()) {
             case QueryNodeType::TERM:
+            case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
                 // no need to optimize
                 break;
             case QueryNodeType::AND_NOT: {
@@ -142,6 +154,10 @@ std::unique_ptr<QueryNode> NotQueryNode::InnerGetNewOptimizedQueryTree() {
                 break;
             }
             case QueryNodeType::TERM:
+            case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 new_not_list.emplace_back(std::move(child));
@@ -193,6 +209,10 @@ std::unique_ptr<QueryNode> AndQueryNode::InnerGetNewOptimizedQueryTree() {
                 break;
             }
             case QueryNodeType::TERM:
+            case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::OR: {
                 and_list.emplace_back(std::move(child));
                 break;
@@ -281,6 +301,10 @@ std::unique_ptr<QueryNode> OrQueryNode::InnerGetNewOptimizedQueryTree() {
                 break;
             }
             case QueryNodeType::TERM:
+            case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 or_list.emplace_back(std::move(child));
@@ -393,6 +417,167 @@ TermQueryNode::CreateEarlyTerminateSearch(const TableEntry *table_entry, IndexRe
     return search;
 }
 
+std::unique_ptr<DocIterator> PhraseQueryNode::CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const {
+    ColumnID column_id = table_entry->GetColumnIdByName(column_);
+    ColumnIndexReader *column_index_reader = index_reader.GetColumnIndexReader(column_id);
+    if (!column_index_reader) {
+        return nullptr;
+    }
+    if (!(column_index_reader->GetOptionFlag() & OptionFlag::of_position_list)) {
+        RecoverableError(Status::NotSupport(fmt::format("Phrase query on column {} requires positions in the full-text index", column_)));
+    }
+    Vector<UniquePtr<TermDocIterator>> term_iters;
+    term_iters.reserve(terms_.size());
+    for (const auto &term : terms_) {
+        auto posting_iterator = column_index_reader->Lookup(term, index_reader.session_pool_.get(), true);
+        if (!posting_iterator) {
+            // no doc contains the phrase
+            return nullptr;
+        }
+        auto term_iter = MakeUnique<TermDocIterator>(std::move(posting_iterator), column_id, GetWeight());
+        term_iter->term_ptr_ = &term;
+        term_iter->column_name_ptr_ = &column_;
+        term_iters.emplace_back(std::move(term_iter));
+    }
+    if (scorer) {
+        // a doc containing the phrase is scored by its terms
+        for (const auto &term_iter : term_iters) {
+            scorer->AddDocIterator(term_iter.get(), column_id);
+        }
+    }
+    auto search = MakeUnique<PhraseDocIterator>(std::move(term_iters), offsets_, slop_);
+    search->column_name_ptr_ = &column_;
+    return search;
+}
+
+std::unique_ptr<EarlyTerminateIterator>
+PhraseQueryNode::CreateEarlyTerminateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const {
+    ColumnID column_id = table_entry->GetColumnIdByName(column_);
+    ColumnIndexReader *column_index_reader = index_reader.GetColumnIndexReader(column_id);
+    if (!column_index_reader) {
+        return nullptr;
+    }
+    if (!(column_index_reader->GetOptionFlag() & OptionFlag::of_position_list)) {
+        RecoverableError(Status::NotSupport(fmt::format("Phrase query on column {} requires positions in the full-text index", column_)));
+    }
+    Vector<UniquePtr<BlockMaxTermDocIterator>> term_iters;
+    term_iters.reserve(terms_.size());
+    for (const auto &term : terms_) {
+        auto term_iter = column_index_reader->LookupBlockMax(term, index_reader.session_pool_.get(), GetWeight(), true);
+        if (!term_iter) {
+            // no doc contains the phrase
+            return nullptr;
+        }
+        term_iter->term_ptr_ = &term;
+        term_iter->column_name_ptr_ = &column_;
+        term_iters.emplace_back(std::move(term_iter));
+    }
+    if (scorer) {
+        // the bm25 info of the terms is needed to build the score upper bounds of the phrase
+        for (const auto &term_iter : term_iters) {
+            scorer->AddBlockMaxDocIterator(term_iter.get(), column_id);
+        }
+    }
+    auto search = MakeUnique<BlockMaxPhraseIterator>(std::move(term_iters), offsets_, slop_);
+    search->column_name_ptr_ = &column_;
+    return search;
+}
+
+namespace {
+
+UniquePtr<Automaton> MakeMultiTermAutomaton(const MultiTermQueryNode &node) {
+    switch (node.GetType()) {
+        case QueryNodeType::PREFIX_TERM:
+            return MakeUnique<PrefixAutomaton>(node.pattern_);
+        case QueryNodeType::WILDCARD_TERM:
+            return MakeUnique<WildcardAutomaton>(node.pattern_);
+        case QueryNodeType::FUZZY_TERM:
+            return MakeUnique<LevenshteinAutomaton>(node.pattern_, node.max_edits_);
+        default: {
+            UnrecoverableError("MakeMultiTermAutomaton: Unexpected query node type!");
+            return nullptr;
+        }
+    }
+}
+
+} // namespace
+
+std::unique_ptr<DocIterator> MultiTermQueryNode::CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const {
+    ColumnID column_id = table_entry->GetColumnIdByName(column_);
+    ColumnIndexReader *column_index_reader = index_reader.GetColumnIndexReader(column_id);
+    if (!column_index_reader) {
+        return nullptr;
+    }
+    bool fetch_position = false;
+    auto option_flag = column_index_reader->GetOptionFlag();
+    if (option_flag & OptionFlag::of_position_list) {
+        fetch_position = true;
+    }
+    auto automaton = MakeMultiTermAutomaton(*this);
+    Vector<String> terms = column_index_reader->ExpandTerms(*automaton, max_expansions_);
+    Vector<std::unique_ptr<DocIterator>> sub_doc_iters;
+    sub_doc_iters.reserve(terms.size());
+    for (auto &term : terms) {
+        auto posting_iterator = column_index_reader->Lookup(term, index_reader.session_pool_.get(), fetch_position);
+        if (!posting_iterator) {
+            continue;
+        }
+        auto search = MakeUnique<TermDocIterator>(std::move(posting_iterator), column_id, GetWeight());
+        search->term_ptr_ = &expanded_terms_.emplace_back(std::move(term));
+        search->column_name_ptr_ = &column_;
+        if (scorer) {
+            // nodes under "not" will not be added to scorer
+            scorer->AddDocIterator(search.get(), column_id);
+        }
+        sub_doc_iters.emplace_back(std::move(search));
+    }
+    if (sub_doc_iters.empty()) {
+        return nullptr;
+    } else if (sub_doc_iters.size() == 1) {
+        return std::move(sub_doc_iters[0]);
+    } else {
+        return MakeUnique<OrIterator>(std::move(sub_doc_iters));
+    }
+}
+
+std::unique_ptr<EarlyTerminateIterator>
+MultiTermQueryNode::CreateEarlyTerminateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const {
+    ColumnID column_id = table_entry->GetColumnIdByName(column_);
+    ColumnIndexReader *column_index_reader = index_reader.GetColumnIndexReader(column_id);
+    if (!column_index_reader) {
+        return nullptr;
+    }
+    bool fetch_position = false;
+    auto option_flag = column_index_reader->GetOptionFlag();
+    if (option_flag & OptionFlag::of_position_list) {
+        fetch_position = true;
+    }
+    auto automaton = MakeMultiTermAutomaton(*this);
+    Vector<String> terms = column_index_reader->ExpandTerms(*automaton, max_expansions_);
+    Vector<std::unique_ptr<EarlyTerminateIterator>> sub_doc_iters;
+    sub_doc_iters.reserve(terms.size());
+    for (auto &term : terms) {
+        auto search = column_index_reader->LookupBlockMax(term, index_reader.session_pool_.get(), GetWeight(), fetch_position);
+        if (!search) {
+            continue;
+        }
+        search->term_ptr_ = &expanded_terms_.emplace_back(std::move(term));
+        search->column_name_ptr_ = &column_;
+        if (scorer) {
+            // nodes under "not" will not be added to scorer
+            scorer->AddBlockMaxDocIterator(search.get(), column_id);
+        }
+        sub_doc_iters.emplace_back(std::move(search));
+    }
+    if (sub_doc_iters.empty()) {
+        return nullptr;
+    } else if (sub_doc_iters.size() == 1) {
+        return std::move(sub_doc_iters[0]);
+    } else {
+        return MakeUnique<BlockMaxMaxscoreIterator>(std::move(sub_doc_iters));
+    }
+}
+
 std::unique_ptr<DocIterator> AndQueryNode::CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const {
     Vector<std::unique_ptr<DocIterator>> sub_doc_iters;
     sub_doc_iters.reserve(children_.size());
@@ -549,10 +734,10 @@ std::string QueryNodeTypeToString(QueryNodeType type) {
             return "PHRASE";
         case QueryNodeType::PREFIX_TERM:
             return "PREFIX_TERM";
-        case QueryNodeType::SUFFIX_TERM:
-            return "SUFFIX_TERM";
-        case QueryNodeType::SUBSTRING_TERM:
-            return "SUBSTRING_TERM";
+        case QueryNodeType::WILDCARD_TERM:
+            return "WILDCARD_TERM";
+        case QueryNodeType::FUZZY_TERM:
+            return "FUZZY_TERM";
     }
 }
 
@@ -566,6 +751,35 @@ void TermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool
     os << '\n';
 }
 
+void PhraseQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << QueryNodeTypeToString(type_);
+    os << " (weight: " << weight_ << ")";
+    os << " (column: " << column_ << ")";
+    os << " (terms:";
+    for (SizeT i = 0; i < terms_.size(); ++i) {
+        os << ' ' << terms_[i] << '@' << offsets_[i];
+    }
+    os << ")";
+    os << " (slop: " << slop_ << ")";
+    os << '\n';
+}
+
+void MultiTermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << QueryNodeTypeToString(type_);
+    os << " (weight: " << weight_ << ")";
+    os << " (column: " << column_ << ")";
+    os << " (pattern: " << pattern_ << ")";
+    if (type_ == QueryNodeType::FUZZY_TERM) {
+        os << " (max edits: " << max_edits_ << ")";
+    }
+    os << " (max expansions: " << max_expansions_ << ")";
+    os << '\n';
+}
+
 void MultiQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const {
     os << prefix;
     os << (is_final ? "└──" : "├──");
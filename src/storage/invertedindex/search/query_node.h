@@ -15,6 +15,8 @@
 #ifndef QUERY_NODE_H
 #define QUERY_NODE_H
 
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -34,12 +36,12 @@ enum class QueryNodeType : char {
     AND,
     AND_NOT,
     OR,
-    // unimplemented:
-    WAND,
     PHRASE,
     PREFIX_TERM,
-    SUFFIX_TERM,
-    SUBSTRING_TERM,
+    WILDCARD_TERM,
+    FUZZY_TERM,
+    // unimplemented:
+    WAND,
 };
 
 std::string QueryNodeTypeToString(QueryNodeType type);
@@ -118,6 +120,43 @@ struct MultiQueryNode : public QueryNode {
     void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const final;
 };
 
+// The terms of a quoted text, matching the rows where they occur in order.
+// offsets_ holds the position of each term relative to the first one, slop_ is the number of extra positions allowed between them.
+struct PhraseQueryNode final : public QueryNode {
+    std::vector<std::string> terms_;
+    std::vector<uint32_t> offsets_;
+    std::string column_;
+    uint32_t slop_{0};
+
+    PhraseQueryNode() : QueryNode(QueryNodeType::PHRASE) {}
+
+    void PushDownWeight(float factor) override { MultiplyWeight(factor); }
+    std::unique_ptr<DocIterator> CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const override;
+    std::unique_ptr<EarlyTerminateIterator>
+    CreateEarlyTerminateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const override;
+    void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const override;
+};
+
+// A term pattern matching the indexed terms: a prefix (PREFIX_TERM), a pattern with `*` and `?` (WILDCARD_TERM)
+// or a term within max_edits_ edits (FUZZY_TERM). The pattern is not analyzed.
+// It is searched as an "or" of the matched terms, at most max_expansions_ of them, the first ones in lexicographical order.
+struct MultiTermQueryNode final : public QueryNode {
+    std::string pattern_;
+    std::string column_;
+    uint32_t max_edits_{0};
+    uint32_t max_expansions_{0};
+    // the matched terms, referred to by the term iterators
+    mutable std::deque<std::string> expanded_terms_;
+
+    explicit MultiTermQueryNode(QueryNodeType type) : QueryNode(type) {}
+
+    void PushDownWeight(float factor) override { MultiplyWeight(factor); }
+    std::unique_ptr<DocIterator> CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const override;
+    std::unique_ptr<EarlyTerminateIterator>
+    CreateEarlyTerminateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const override;
+    void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const override;
+};
+
 // "NotQueryNode" will be generated by parser
 // need to be optimized to AndNotQueryNode
 // otherwise, query statement is invalid
@@ -152,10 +191,6 @@ struct OrQueryNode final : public MultiQueryNode {
 
 // unimplemented
 struct WandQueryNode;
-struct PhraseQueryNode;
-struct PrefixTermQueryNode;
-struct SuffixTermQueryNode;
-struct SubstringTermQueryNode;
 
 } // namespace infinity
 
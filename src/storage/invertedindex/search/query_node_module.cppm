@@ -25,6 +25,8 @@ export using infinity::QueryNodeTypeToString;
 
 export using infinity::QueryNode;
 export using infinity::TermQueryNode;
+export using infinity::PhraseQueryNode;
+export using infinity::MultiTermQueryNode;
 export using infinity::MultiQueryNode;
 export using infinity::AndQueryNode;
 export using infinity::AndNotQueryNode;
@@ -33,9 +35,5 @@ export using infinity::NotQueryNode;
 
 // unimplemented
 // export using infinity::WandQueryNode;
-// export using infinity::PhraseQueryNode;
-// export using infinity::PrefixTermQueryNode;
-// export using infinity::SuffixTermQueryNode;
-// export using infinity::SubstringTermQueryNode;
 
 } // namespace infinity
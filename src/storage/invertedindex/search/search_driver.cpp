@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <sstream>
@@ -129,7 +130,36 @@ std::unique_ptr<QueryNode> SearchDriver::ParseSingle(const std::string &query, c
     return result;
 }
 
-std::unique_ptr<QueryNode> SearchDriver::AnalyzeAndBuildQueryNode(const std::string &field, std::string &&text) const {
+std::unique_ptr<QueryNode> SearchDriver::BuildWildcardQueryNode(const std::string &field, std::string &&pattern) const {
+    std::unique_ptr<MultiTermQueryNode> result;
+    if (size_t wildcard_idx = pattern.find_first_of("*?"); wildcard_idx > 0 && wildcard_idx + 1 == pattern.size() && pattern.back() == '*') {
+        result = std::make_unique<MultiTermQueryNode>(QueryNodeType::PREFIX_TERM);
+        pattern.pop_back();
+    } else {
+        result = std::make_unique<MultiTermQueryNode>(QueryNodeType::WILDCARD_TERM);
+    }
+    result->pattern_ = std::move(pattern);
+    result->column_ = field;
+    result->max_expansions_ = max_expansions_;
+    return result;
+}
+
+std::unique_ptr<QueryNode> SearchDriver::BuildFuzzyQueryNode(const std::string &field, std::string &&text, int max_edits) const {
+    if (max_edits < 0) {
+        max_edits = 2;
+    } else if (max_edits > 2) {
+        RecoverableError(Status::SyntaxError("Fuzzy term allows at most 2 edits"));
+        return nullptr;
+    }
+    auto result = std::make_unique<MultiTermQueryNode>(QueryNodeType::FUZZY_TERM);
+    result->pattern_ = std::move(text);
+    result->column_ = field;
+    result->max_edits_ = max_edits;
+    result->max_expansions_ = max_expansions_;
+    return result;
+}
+
+std::unique_ptr<QueryNode> SearchDriver::AnalyzeAndBuildQueryNode(const std::string &field, std::string &&text, bool phrase, int slop) const {
     if (text.empty()) {
         RecoverableError(Status::SyntaxError("Empty query text"));
         return nullptr;
@@ -160,6 +190,16 @@ std::unique_ptr<QueryNode> SearchDriver::AnalyzeAndBuildQueryNode(const std::str
         result->term_ = std::move(terms.front().text_);
         result->column_ = field;
         return result;
+    } else if (phrase) {
+        auto result = std::make_unique<PhraseQueryNode>();
+        const u32 first_offset = terms.front().word_offset_;
+        for (auto &term : terms) {
+            result->offsets_.push_back(std::max(term.word_offset_, first_offset) - first_offset);
+            result->terms_.emplace_back(std::move(term.text_));
+        }
+        result->column_ = field;
+        result->slop_ = slop < 0 ? phrase_slop_ : slop;
+        return result;
     } else {
         auto result = std::make_unique<OrQueryNode>();
         for (auto &term : terms) {
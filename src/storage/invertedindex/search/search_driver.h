@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -38,10 +39,24 @@ public:
     [[nodiscard]] std::unique_ptr<QueryNode> ParseSingle(const std::string &query, const std::string *default_field_ptr = nullptr) const;
 
     // used in SearchParser in ParseSingle
-    [[nodiscard]] std::unique_ptr<QueryNode> AnalyzeAndBuildQueryNode(const std::string &field, std::string &&text) const;
+    // a quoted text is a phrase, its terms have to occur in order within slop extra positions ("a b"~2), -1 means phrase_slop_
+    [[nodiscard]] std::unique_ptr<QueryNode>
+    AnalyzeAndBuildQueryNode(const std::string &field, std::string &&text, bool phrase = false, int slop = -1) const;
+
+    // used in SearchParser in ParseSingle
+    // abc* is a prefix, a pattern with other '*' or '?' is a wildcard, matched against the indexed terms as is
+    [[nodiscard]] std::unique_ptr<QueryNode> BuildWildcardQueryNode(const std::string &field, std::string &&pattern) const;
+
+    // used in SearchParser in ParseSingle
+    // abc~ / abc~1 matches the indexed terms within max_edits (-1 means 2) edits
+    [[nodiscard]] std::unique_ptr<QueryNode> BuildFuzzyQueryNode(const std::string &field, std::string &&text, int max_edits) const;
 
     // will be set in PhysicalMatch
     void (*analyze_func_)() = nullptr;
+    // number of extra positions allowed between the terms of a phrase
+    uint32_t phrase_slop_ = 0;
+    // max number of indexed terms a prefix, wildcard or fuzzy term is expanded to
+    uint32_t max_expansions_ = 64;
 
     /**
      * parsing options
@@ -46,6 +46,9 @@ public:
 
     float GetWeight() const { return weight_; }
 
+    // the first position not less than pos in the current doc, positions are visited in ascending order
+    void SeekPosition(pos_t pos, pos_t &result) { iter_->SeekPosition(pos, result); }
+
     void PrintTree(std::ostream &os, const String &prefix, bool is_final) const override;
 
     // debug info
@@ -62,6 +62,9 @@ public:
         tf_t ttf = posting_writer_->GetTotalTF();
         tm.SetDocFreq(df);
         tm.SetTotalTermFreq(ttf);
+        auto [max_tf, max_percentage] = posting_writer_->GetMaxInfo();
+        tm.max_tf_ = max_tf;
+        tm.max_percentage_ = max_percentage;
     }
 
     const TermMeta &GetTermMeta() const { return term_meta_; }
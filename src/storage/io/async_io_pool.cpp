@@ -0,0 +1,91 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+module async_io_pool;
+
+import stl;
+import logger;
+import third_party;
+
+namespace infinity {
+
+AsyncIoPool::AsyncIoPool(SizeT thread_num) {
+    for (SizeT i = 0; i < thread_num; ++i) {
+        threads_.emplace_back([this] { Process(); });
+    }
+}
+
+AsyncIoPool::~AsyncIoPool() {
+    {
+        std::unique_lock lock(mutex_);
+        stop_ = true;
+    }
+    task_cv_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+void AsyncIoPool::Submit(std::function<void()> io_task) {
+    {
+        std::unique_lock lock(mutex_);
+        tasks_.push_back(std::move(io_task));
+    }
+    task_cv_.notify_one();
+}
+
+void AsyncIoPool::Drain() {
+    std::unique_lock lock(mutex_);
+    idle_cv_.wait(lock, [this] { return tasks_.empty() && running_n_ == 0; });
+}
+
+SizeT AsyncIoPool::pending() const {
+    std::unique_lock lock(mutex_);
+    return tasks_.size() + running_n_;
+}
+
+void AsyncIoPool::Process() {
+    while (true) {
+        std::function<void()> io_task;
+        {
+            std::unique_lock lock(mutex_);
+            task_cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                // stopped, the remaining tasks are run before
+                break;
+            }
+            io_task = std::move(tasks_.front());
+            tasks_.pop_front();
+            ++running_n_;
+        }
+        try {
+            io_task();
+        } catch (const std::exception &e) {
+            // a failed read ahead is retried by the reader itself
+            LOG_WARN(fmt::format("Async io task failed: {}", e.what()));
+        }
+        ++done_count_;
+        {
+            std::unique_lock lock(mutex_);
+            --running_n_;
+            if (tasks_.empty() && running_n_ == 0) {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace infinity
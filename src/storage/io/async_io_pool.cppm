@@ -0,0 +1,54 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module async_io_pool;
+
+import stl;
+
+namespace infinity {
+
+// Runs reads off the calling thread so a scan can keep computing while the next blocks are read from disk.
+// The tasks are run by a pool of threads blocking on the reads, several reads are in flight at once.
+export class AsyncIoPool {
+public:
+    explicit AsyncIoPool(SizeT thread_num);
+
+    ~AsyncIoPool();
+
+    void Submit(std::function<void()> io_task);
+
+    // Wait until every submitted task is done.
+    void Drain();
+
+    SizeT pending() const;
+
+    u64 done_count() const { return done_count_.load(); }
+
+private:
+    void Process();
+
+    mutable std::mutex mutex_{};
+    std::condition_variable task_cv_{};
+    std::condition_variable idle_cv_{};
+    Deque<std::function<void()>> tasks_{};
+    SizeT running_n_{0};
+    bool stop_{false};
+    Atomic<u64> done_count_{0};
+
+    Vector<Thread> threads_{};
+};
+
+} // namespace infinity
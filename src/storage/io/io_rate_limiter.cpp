@@ -0,0 +1,58 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <thread>
+
+module io_rate_limiter;
+
+import stl;
+
+namespace infinity {
+
+namespace {
+thread_local IoRateLimiter *current_limiter = nullptr;
+}
+
+IoRateLimiter::IoRateLimiter(u64 bytes_per_sec)
+    : bytes_per_sec_(bytes_per_sec), tokens_(double(bytes_per_sec)), refill_time_(std::chrono::steady_clock::now()) {}
+
+void IoRateLimiter::Acquire(SizeT bytes) {
+    acquired_bytes_ += bytes;
+    if (bytes_per_sec_ == 0) {
+        return;
+    }
+    double debt = 0;
+    {
+        std::lock_guard lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        double elapsed_sec = std::chrono::duration<double>(now - refill_time_).count();
+        refill_time_ = now;
+        tokens_ = std::min(tokens_ + elapsed_sec * bytes_per_sec_, double(bytes_per_sec_));
+        tokens_ -= double(bytes);
+        if (tokens_ < 0) {
+            debt = -tokens_;
+        }
+    }
+    if (debt > 0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(debt / bytes_per_sec_));
+    }
+}
+
+IoRateLimiter *IoRateLimiter::Current() { return current_limiter; }
+
+void IoRateLimiter::SetCurrent(IoRateLimiter *limiter) { current_limiter = limiter; }
+
+} // namespace infinity
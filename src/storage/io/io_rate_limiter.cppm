@@ -0,0 +1,51 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module io_rate_limiter;
+
+import stl;
+
+namespace infinity {
+
+// Token bucket bounding the bytes per second read and written by the threads it is current on, e.g. the threads of a background lane.
+// A burst of one second of tokens is allowed, a larger read or write borrows the tokens and the next one waits for the refill.
+export class IoRateLimiter {
+public:
+    // 0 means unlimited.
+    explicit IoRateLimiter(u64 bytes_per_sec);
+
+    // Take the tokens of `bytes`, sleep until the bucket isn't in debt.
+    void Acquire(SizeT bytes);
+
+    u64 bytes_per_sec() const { return bytes_per_sec_; }
+
+    u64 acquired_bytes() const { return acquired_bytes_.load(); }
+
+    // The limiter of the I/O of this thread, nullptr (unlimited) for the foreground threads.
+    static IoRateLimiter *Current();
+
+    static void SetCurrent(IoRateLimiter *limiter);
+
+private:
+    const u64 bytes_per_sec_{};
+    Atomic<u64> acquired_bytes_{0};
+
+    std::mutex mutex_{};
+    double tokens_{};
+    std::chrono::steady_clock::time_point refill_time_{};
+};
+
+} // namespace infinity
@@ -29,6 +29,7 @@ import infinity_exception;
 import third_party;
 import logger;
 import status;
+import io_rate_limiter;
 
 module local_file_system;
 
@@ -123,6 +124,9 @@ void LocalFileSystem::Rename(const String &old_path, const String &new_path) {
 
 i64 LocalFileSystem::Read(FileHandler &file_handler, void *data, u64 nbytes) {
     i32 fd = ((LocalFileHandler &)file_handler).fd_;
+    if (IoRateLimiter *limiter = IoRateLimiter::Current(); limiter != nullptr) {
+        limiter->Acquire(nbytes);
+    }
     i64 read_count = read(fd, data, nbytes);
     if (read_count == -1) {
         UnrecoverableError(fmt::format("Can't read file: {}: {}", file_handler.path_.string(), strerror(errno)));
@@ -132,6 +136,9 @@ i64 LocalFileSystem::Read(FileHandler &file_handler, void *data, u64 nbytes) {
 
 i64 LocalFileSystem::Write(FileHandler &file_handler, const void *data, u64 nbytes) {
     i32 fd = ((LocalFileHandler &)file_handler).fd_;
+    if (IoRateLimiter *limiter = IoRateLimiter::Current(); limiter != nullptr) {
+        limiter->Acquire(nbytes);
+    }
     i64 write_count = write(fd, data, nbytes);
     if (write_count == -1) {
         UnrecoverableError(fmt::format("Can't write file: {}: {}. fd: {}", file_handler.path_.string(), strerror(errno), fd));
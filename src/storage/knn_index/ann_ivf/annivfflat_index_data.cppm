@@ -53,7 +53,8 @@ struct AnnIVFFlatIndexData {
                     const u32 vector_count,
                     const VectorDataType *vectors_ptr,
                     const u32 min_points_per_centroid = 32,
-                    const u32 max_points_per_centroid = 256) {
+                    const u32 max_points_per_centroid = 256,
+                    const KMeansOption &kmeans_option = {}) {
         if (loaded_) {
             UnrecoverableError("AnnIVFFlatIndexData::BuildIndex(): Index data already exists.");
         }
@@ -75,7 +76,7 @@ struct AnnIVFFlatIndexData {
         }
 
         // step 1. train centroids
-        TrainCentroids(train_count, train_ptr, min_points_per_centroid, max_points_per_centroid);
+        TrainCentroids(train_count, train_ptr, min_points_per_centroid, max_points_per_centroid, kmeans_option);
 
         // step 2. insert data to partitions
         struct {
@@ -92,7 +93,8 @@ struct AnnIVFFlatIndexData {
                     const u32 dimension,
                     const u32 full_row_count,
                     const u32 min_points_per_centroid = 32,
-                    const u32 max_points_per_centroid = 256) {
+                    const u32 max_points_per_centroid = 256,
+                    const KMeansOption &kmeans_option = {}) {
         if (loaded_) {
             UnrecoverableError("AnnIVFFlatIndexData::BuildIndex(): Index data already exists.");
         }
@@ -144,7 +146,7 @@ struct AnnIVFFlatIndexData {
         }
 
         // step 2. train centroids
-        TrainCentroids(cnt, segment_column_data.data(), min_points_per_centroid, max_points_per_centroid);
+        TrainCentroids(cnt, segment_column_data.data(), min_points_per_centroid, max_points_per_centroid, kmeans_option);
 
         // step 3. insert data to partitions, will update data_num_
         InsertData(cnt, segment_column_data.data(), segment_offset.data());
@@ -155,7 +157,8 @@ struct AnnIVFFlatIndexData {
     inline void TrainCentroids(const u32 vector_count,
                                const VectorDataType *vector_data_ptr,
                                const u32 min_points_per_centroid,
-                               const u32 max_points_per_centroid) {
+                               const u32 max_points_per_centroid,
+                               const KMeansOption &kmeans_option) {
         u32 iteration_max = 0;
         if (partition_num_ != 0 and partition_num_ > vector_count) {
             LOG_TRACE(fmt::format("AnnIVFFlatIndexData::TrainCentroids(): non-zero partition_num_ = {}, more than vector_count = {}",
@@ -172,7 +175,8 @@ struct AnnIVFFlatIndexData {
                                                                 partition_num_,
                                                                 iteration_max,
                                                                 min_points_per_centroid,
-                                                                max_points_per_centroid);
+                                                                max_points_per_centroid,
+                                                                kmeans_option);
         if (real_partition_num != partition_num_) {
             LOG_TRACE(fmt::format("AnnIVFFlatIndexData::BuildIndex(): After K-means partition, real_partition_num = %u, partition_num_ = %u",
                                   real_partition_num,
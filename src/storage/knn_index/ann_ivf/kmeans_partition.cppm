@@ -27,12 +27,27 @@ import logger;
 
 namespace infinity {
 
-inline Vector<u32> RandomPermutatePartially(u32 vector_count, u32 random_num = 0) {
+export enum class KMeansInit {
+    kRandom,   // random training vectors
+    kPlusPlus, // k-means++: each centroid is a training vector picked with probability proportional to its squared distance to the nearest
+               // centroid picked before
+};
+
+export struct KMeansOption {
+    // threads of the initialization, the assignment and the update steps
+    u32 thread_num_ = 1;
+    KMeansInit init_ = KMeansInit::kRandom;
+    // if not 0, an iteration trains on a random batch of this many vectors instead of all the training vectors and moves the centroids
+    // with per-centroid learning rates
+    u32 mini_batch_size_ = 0;
+    // seed of the training data sampling, the initialization and the batches: the same input gives the same centroids
+    u32 seed_ = 0;
+};
+
+inline Vector<u32> RandomPermutatePartially(std::mt19937 &gen, u32 vector_count, u32 random_num = 0) {
     if (random_num == 0 || random_num > vector_count) {
         random_num = vector_count;
     }
-    std::random_device rd;
-    std::mt19937 gen(rd());
     Vector<u32> permutation(vector_count);
     std::iota(permutation.begin(), permutation.end(), 0);
     for (u32 i = 0; i < random_num; ++i) {
@@ -47,6 +62,23 @@ inline Vector<u32> RandomPermutatePartially(u32 vector_count, u32 random_num = 0
     return permutation;
 }
 
+// Split [0, n) into thread_num contiguous ranges and call func(begin, end) for each range on its own thread.
+template <typename Func>
+void ParallelForRange(u32 thread_num, u32 n, Func &&func) {
+    thread_num = std::max(1u, std::min(thread_num, n));
+    u32 step = (n + thread_num - 1) / thread_num;
+    Vector<Thread> threads;
+    for (u32 t = 1; t < thread_num; ++t) {
+        u32 begin = std::min(n, t * step);
+        u32 end = std::min(n, begin + step);
+        threads.emplace_back([&func, begin, end] { func(begin, end); });
+    }
+    func(0, std::min(n, step));
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
 // normalize centroids
 template <typename CentroidType>
 inline void NormalizeCentroids(u32 dimension, u32 partition_num, CentroidType *centroids) {
@@ -62,9 +94,92 @@ inline void NormalizeCentroids(u32 dimension, u32 partition_num, CentroidType *c
     }
 }
 
+// For every vacant partition, in the order of the partition ids, split the partition with the most vectors, the one with the smallest id
+// among equals.
+template <typename CentroidType>
+inline void SplitEmptyPartitions(u32 dimension, u32 partition_num, CentroidType *centroids, Vector<u32> &partition_element_count) {
+    for (u32 i = 0; i < partition_num; ++i) {
+        if (partition_element_count[i] == 0) {
+            // find the partition with the most vectors
+            u32 max_partition_id = 0;
+            u32 max_partition_element_count = 0;
+            for (u32 j = 0; j < partition_num; ++j) {
+                if (partition_element_count[j] > max_partition_element_count) {
+                    max_partition_id = j;
+                    max_partition_element_count = partition_element_count[j];
+                }
+            }
+            // split the partition
+            partition_element_count[i] = max_partition_element_count / 2;
+            partition_element_count[max_partition_id] -= partition_element_count[i];
+            // copy the centroid vector
+            memcpy(centroids + i * dimension, centroids + max_partition_id * dimension, dimension * sizeof(CentroidType));
+            // slightly change che i and max_partition_id centroid vector
+            constexpr f32 epsilon = 1 / 1024.0;
+            constexpr f32 plus_epsilon = 1 + epsilon;
+            constexpr f32 minus_epsilon = 1 - epsilon;
+            for (u32 j = 0; j < dimension; ++j) {
+                centroids[i * dimension + j] *= ((j & 1) ? plus_epsilon : minus_epsilon);
+                centroids[max_partition_id * dimension + j] *= ((j & 1) ? minus_epsilon : plus_epsilon);
+            }
+        }
+    }
+}
+
+// k-means++ initialization, the distances to the nearest centroid are updated on option.thread_num_ threads.
+template <typename CentroidsType, typename ElemType>
+void InitCentroidsPlusPlus(u32 dimension,
+                           u32 training_data_num,
+                           const ElemType *training_data,
+                           u32 partition_num,
+                           CentroidsType *centroids,
+                           std::mt19937 &gen,
+                           u32 thread_num) {
+    auto copy_centroid = [&](u32 centroid_id, u32 vector_id) {
+        for (u32 j = 0; j < dimension; ++j) {
+            centroids[SizeT(centroid_id) * dimension + j] = training_data[SizeT(vector_id) * dimension + j];
+        }
+    };
+    Vector<f32> min_distance(training_data_num, std::numeric_limits<f32>::max());
+    u32 vector_id = std::uniform_int_distribution<u32>(0, training_data_num - 1)(gen);
+    for (u32 centroid_id = 0; centroid_id < partition_num; ++centroid_id) {
+        copy_centroid(centroid_id, vector_id);
+        if (centroid_id + 1 == partition_num) {
+            break;
+        }
+        const CentroidsType *centroid = centroids + SizeT(centroid_id) * dimension;
+        ParallelForRange(thread_num, training_data_num, [&](u32 begin, u32 end) {
+            for (u32 i = begin; i < end; ++i) {
+                f32 distance = L2Distance<f32>(training_data + SizeT(i) * dimension, centroid, dimension);
+                min_distance[i] = std::min(min_distance[i], distance);
+            }
+        });
+        f64 total_distance = 0;
+        for (f32 distance : min_distance) {
+            total_distance += distance;
+        }
+        if (total_distance <= 0) {
+            // every vector is a centroid already
+            vector_id = std::uniform_int_distribution<u32>(0, training_data_num - 1)(gen);
+            continue;
+        }
+        f64 target = std::uniform_real_distribution<f64>(0, total_distance)(gen);
+        vector_id = training_data_num - 1;
+        for (u32 i = 0; i < training_data_num; ++i) {
+            target -= min_distance[i];
+            if (target < 0) {
+                vector_id = i;
+                break;
+            }
+        }
+    }
+}
+
 // CentroidsType: the type to calculate centroids
 // partition_num: the number of partitions, default to sqrt(vector_count)
-// iteration_max: the max iteration count, default to 10
+// iteration_max: the max iteration count, default to 10, in mini batch mode the batches of 2 passes over the training data
+// The assignment step searches the nearest centroids with sgemm on option.thread_num_ threads, each thread a range of the vectors.
+// The update step gives each thread a range of the centroids, so the sums are the same whatever the thread count.
 export template <typename CentroidsType, typename ElemType, typename CentroidsOutputType>
 [[nodiscard]] u32 GetKMeansCentroids(const MetricType metric,
                                      const u32 dimension,
@@ -74,7 +189,8 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
                                      u32 partition_num = 0,
                                      u32 iteration_max = 0,
                                      u32 min_points_per_centroid = 32,
-                                     u32 max_points_per_centroid = 256) {
+                                     u32 max_points_per_centroid = 256,
+                                     const KMeansOption &option = {}) {
     constexpr int default_iteration_max = 10;
     if (metric != MetricType::kMetricL2 && metric != MetricType::kMetricInnerProduct) {
         UnrecoverableError("metric type not implemented");
@@ -91,9 +207,7 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
     if (partition_num <= 0) {
         partition_num = (int)sqrt(vector_count);
     }
-    if (iteration_max <= 0) {
-        iteration_max = default_iteration_max;
-    }
+    std::mt19937 gen(option.seed_);
     centroids_output_vector.resize(dimension * partition_num);
     CentroidsOutputType *centroids_output = centroids_output_vector.data();
     CentroidsType *centroids = nullptr;
@@ -122,7 +236,7 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
             training_data_num = max_num;
             // generate random training data
             {
-                Vector<u32> random_ids = RandomPermutatePartially(vector_count, training_data_num);
+                Vector<u32> random_ids = RandomPermutatePartially(gen, vector_count, training_data_num);
                 random_training_data_destructor = MakeUnique<ElemType[]>(dimension * training_data_num);
                 training_data = random_training_data_destructor.get();
                 for (u32 i = 0; i < training_data_num; ++i) {
@@ -134,8 +248,16 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
         }
     }
 
+    const bool mini_batch = option.mini_batch_size_ > 0 && option.mini_batch_size_ < training_data_num;
+    const u32 batch_size = mini_batch ? option.mini_batch_size_ : training_data_num;
+    if (iteration_max <= 0) {
+        iteration_max = mini_batch ? 2 * ((training_data_num + batch_size - 1) / batch_size) : default_iteration_max;
+    }
+
     // Initializing centroids
-    {
+    if (option.init_ == KMeansInit::kPlusPlus) {
+        InitCentroidsPlusPlus(dimension, training_data_num, training_data, partition_num, centroids, gen, option.thread_num_);
+    } else {
         // If training vectors are randomly chosen, centroids can be copied from training data.
         // Otherwise, centroids need to be randomly generated.
         if (random_training_data_destructor) {
@@ -147,7 +269,7 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
                 }
             }
         } else {
-            Vector<u32> random_ids = RandomPermutatePartially(training_data_num, partition_num);
+            Vector<u32> random_ids = RandomPermutatePartially(gen, training_data_num, partition_num);
             if constexpr (std::is_same_v<ElemType, CentroidsType>) {
                 for (u32 i = 0; i < partition_num; ++i) {
                     memcpy(centroids + i * dimension, training_data + random_ids[i] * dimension, sizeof(ElemType) * dimension);
@@ -160,60 +282,98 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
                 }
             }
         }
-        // normalize centroids if inner product metric is used
-        if (metric == MetricType::kMetricInnerProduct) {
-            NormalizeCentroids(dimension, partition_num, centroids);
-        }
+    }
+    // normalize centroids if inner product metric is used
+    if (metric == MetricType::kMetricInnerProduct) {
+        NormalizeCentroids(dimension, partition_num, centroids);
     }
 
     // Record some information
     f32 previous_total_distance = std::numeric_limits<f32>::max();
+    // The vectors of an iteration, all the training vectors or a batch
+    const ElemType *iteration_data = training_data;
+    UniquePtr<ElemType[]> batch_data;
+    if (mini_batch) {
+        batch_data = MakeUniqueForOverwrite<ElemType[]>(SizeT(batch_size) * dimension);
+        iteration_data = batch_data.get();
+    }
     // Assign each vector to a partition
-    Vector<u32> training_data_partition_id(training_data_num);
+    Vector<u32> training_data_partition_id(batch_size);
     // Distance
-    Vector<f32> partition_element_distance(training_data_num);
-    // Record the number of vectors in each partition
+    Vector<f32> partition_element_distance(batch_size);
+    // Record the number of vectors in each partition, in mini batch mode the vectors of all the batches so far
     Vector<u32> partition_element_count(partition_num);
 
     // Iteration
     for (u32 iter = 1; iter <= iteration_max; ++iter) {
+        if (mini_batch) {
+            std::uniform_int_distribution<u32> dis(0, training_data_num - 1);
+            for (u32 i = 0; i < batch_size; ++i) {
+                u32 vector_id = dis(gen);
+                memcpy(batch_data.get() + SizeT(i) * dimension, training_data + SizeT(vector_id) * dimension, sizeof(ElemType) * dimension);
+            }
+        }
         // info
         f32 this_iter_distance = 0;
-        // First : assign each training vector to a partition
+        // First : assign each vector to a partition
         {
             // search top 1
-            search_top_1_with_dis(dimension,
-                                  training_data_num,
-                                  training_data,
-                                  partition_num,
-                                  centroids,
-                                  training_data_partition_id.data(),
-                                  partition_element_distance.data());
-            // Clear partition_element_count
-            memset(partition_element_count.data(), 0, sizeof(u32) * partition_num);
-            // calculate partition_element_count
-            for (auto i : training_data_partition_id)
-                ++partition_element_count[i];
-
+            ParallelForRange(option.thread_num_, batch_size, [&](u32 begin, u32 end) {
+                search_top_1_with_dis(dimension,
+                                      end - begin,
+                                      iteration_data + SizeT(begin) * dimension,
+                                      partition_num,
+                                      centroids,
+                                      training_data_partition_id.data() + begin,
+                                      partition_element_distance.data() + begin);
+            });
             // add distance to this_iter_distance
             this_iter_distance += std::reduce(partition_element_distance.begin(), partition_element_distance.end());
         }
         // Second : update centroids
-        {
+        if (mini_batch) {
+            // Move each centroid toward its vectors, in the order of the batch, with learning rate 1 / (number of its vectors so far).
+            ParallelForRange(option.thread_num_, partition_num, [&](u32 partition_begin, u32 partition_end) {
+                for (u32 i = 0; i < batch_size; ++i) {
+                    u32 partition_id = training_data_partition_id[i];
+                    if (partition_id < partition_begin || partition_id >= partition_end) {
+                        continue;
+                    }
+                    f32 rate = 1.0f / (f32)(++partition_element_count[partition_id]);
+                    auto vector_pos_i = iteration_data + SizeT(i) * dimension;
+                    auto centroid_pos_i = centroids + SizeT(partition_id) * dimension;
+                    for (u32 j = 0; j < dimension; ++j) {
+                        centroid_pos_i[j] += (vector_pos_i[j] - centroid_pos_i[j]) * rate;
+                    }
+                }
+            });
+            if (metric == MetricType::kMetricInnerProduct) {
+                NormalizeCentroids(dimension, partition_num, centroids);
+            }
+            // The vacant partitions are split once the batches are done.
+            continue;
+        }
+        ParallelForRange(option.thread_num_, partition_num, [&](u32 partition_begin, u32 partition_end) {
             // Clear old centroids data
-            memset(centroids, 0, sizeof(CentroidsType) * partition_num * dimension);
+            memset(centroids + SizeT(partition_begin) * dimension, 0, sizeof(CentroidsType) * (partition_end - partition_begin) * dimension);
+            std::fill(partition_element_count.begin() + partition_begin, partition_element_count.begin() + partition_end, 0);
             // Sum
             for (u32 i = 0; i < training_data_num; ++i) {
-                auto vector_pos_i = training_data + i * dimension;
-                auto centroid_pos_i = centroids + training_data_partition_id[i] * dimension;
+                u32 partition_id = training_data_partition_id[i];
+                if (partition_id < partition_begin || partition_id >= partition_end) {
+                    continue;
+                }
+                ++partition_element_count[partition_id];
+                auto vector_pos_i = training_data + SizeT(i) * dimension;
+                auto centroid_pos_i = centroids + SizeT(partition_id) * dimension;
                 for (u32 j = 0; j < dimension; ++j) {
                     centroid_pos_i[j] += vector_pos_i[j];
                 }
             }
-            // For L2 metric, divide the count. If there is no vector in a partition, the centroid of this partition will not be updated.
+            // For L2 metric, divide the count.
             // For IP metric, normalize centroids.
             if (metric == MetricType::kMetricL2) {
-                for (u32 i = 0; i < partition_num; ++i) {
+                for (u32 i = partition_begin; i < partition_end; ++i) {
                     if (auto cnt = partition_element_count[i]; cnt > 0) {
                         f32 inv = 1.0f / (f32)cnt;
                         for (u32 j = 0; j < dimension; ++j) {
@@ -222,42 +382,12 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
                     }
                 }
             } else if (metric == MetricType::kMetricInnerProduct) {
-                NormalizeCentroids(dimension, partition_num, centroids);
+                NormalizeCentroids(dimension, partition_end - partition_begin, centroids + SizeT(partition_begin) * dimension);
             }
-        }
+        });
 
         // Third: split partitions when needed
-        // TODO: When to split? How?
-        //  Now sort the centroids by the number of vectors in each partition.
-        //  For every vacant partition, split the partition with the most vectors.
-        {
-            for (u32 i = 0; i < partition_num; ++i) {
-                if (partition_element_count[i] == 0) {
-                    // find the partition with the most vectors
-                    u32 max_partition_id = 0;
-                    u32 max_partition_element_count = 0;
-                    for (u32 j = 0; j < partition_num; ++j) {
-                        if (partition_element_count[j] > max_partition_element_count) {
-                            max_partition_id = j;
-                            max_partition_element_count = partition_element_count[j];
-                        }
-                    }
-                    // split the partition
-                    partition_element_count[i] = max_partition_element_count / 2;
-                    partition_element_count[max_partition_id] -= partition_element_count[i];
-                    // copy the centroid vector
-                    memcpy(centroids + i * dimension, centroids + max_partition_id * dimension, dimension * sizeof(CentroidsType));
-                    // slightly change che i and max_partition_id centroid vector
-                    constexpr f32 epsilon = 1 / 1024.0;
-                    constexpr f32 plus_epsilon = 1 + epsilon;
-                    constexpr f32 minus_epsilon = 1 - epsilon;
-                    for (u32 j = 0; j < dimension; ++j) {
-                        centroids[i * dimension + j] *= ((j & 1) ? plus_epsilon : minus_epsilon);
-                        centroids[max_partition_id * dimension + j] *= ((j & 1) ? minus_epsilon : plus_epsilon);
-                    }
-                }
-            }
-        }
+        SplitEmptyPartitions(dimension, partition_num, centroids, partition_element_count);
 
         // TODO:stop condition?
         if (metric == MetricType::kMetricL2 && this_iter_distance >= previous_total_distance)
@@ -266,6 +396,9 @@ export template <typename CentroidsType, typename ElemType, typename CentroidsOu
 
         // In the next loop, training data will be re-assigned to partitions.
     }
+    if (mini_batch) {
+        SplitEmptyPartitions(dimension, partition_num, centroids, partition_element_count);
+    }
 
     // Output results if typeof(centroids_output) != typeof(centroids)
     if constexpr (!std::is_same_v<CentroidsOutputType, CentroidsType>) {
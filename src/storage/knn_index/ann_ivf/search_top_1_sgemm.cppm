@@ -215,17 +215,17 @@ void search_top_1_with_sgemm(u32 dimension,
                     __m128 ip_0 = _mm_loadu_ps(ip_line);
                     __m128 ip_1 = _mm_loadu_ps(ip_line + 4);
                     
-                    __m128 distances_0 = _mm_fmadd_ps(ip_0, mul_minus2, y_norm_0);
-                    __m128 distances_1 = _mm_fmadd_ps(ip_1, mul_minus2, y_norm_1);
+                    __m128 distances_0 = _mm_add_ps(_mm_mul_ps(ip_0, mul_minus2), y_norm_0);
+                    __m128 distances_1 = _mm_add_ps(_mm_mul_ps(ip_1, mul_minus2), y_norm_1);
 
-                    const __m128 comparison_0 = _mm_cmp_ps(min_distances, distances_0, _CMP_LE_OS);
+                    const __m128 comparison_0 = _mm_cmple_ps(min_distances, distances_0);
 
                     min_distances = _mm_blendv_ps(distances_0, min_distances, comparison_0);
                     min_indices = 
                         _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(current_indices), _mm_castsi128_ps(min_indices), comparison_0));
                     current_indices = _mm_add_epi32(current_indices, indices_delta);
 
-                    const __m128 comparison_1 = _mm_cmp_ps(min_distances, distances_1, _CMP_LE_OS);
+                    const __m128 comparison_1 = _mm_cmple_ps(min_distances, distances_1);
 
                     min_distances = _mm_blendv_ps(distances_1, min_distances, comparison_1);
                     min_indices = 
@@ -197,8 +197,8 @@ void search_top_k_with_sgemm(u32 k,
                     const __m128 ip_0 = _mm_loadu_ps(ip_line + 0);
                     const __m128 ip_1 = _mm_loadu_ps(ip_line + 4);
 
-                    __m128 distances_0 = _mm_fmadd_ps(ip_0, mul_minus2, y_norm_0);
-                    __m128 distances_1 = _mm_fmadd_ps(ip_1, mul_minus2, y_norm_1);
+                    __m128 distances_0 = _mm_add_ps(_mm_mul_ps(ip_0, mul_minus2), y_norm_0);
+                    __m128 distances_1 = _mm_add_ps(_mm_mul_ps(ip_1, mul_minus2), y_norm_1);
 
                     f32 distances_scalar_0[4];
                     f32 distances_scalar_1[4];
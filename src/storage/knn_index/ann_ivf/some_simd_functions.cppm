@@ -20,13 +20,16 @@ export module some_simd_functions;
 
 import stl;
 import hnsw_simd_func;
+import simd_init;
 
 namespace infinity {
 
-#if defined(__AVX2__)
+#if defined(__x86_64__) || defined(__i386__)
+
+#define AVX2_TARGET __attribute__((target("avx2")))
 
 // x = ( x7, x6, x5, x4, x3, x2, x1, x0 )
-float calc_256_sum_8(__m256 x) {
+AVX2_TARGET float calc_256_sum_8(__m256 x) {
    // high_quad = ( x7, x6, x5, x4 )
    const __m128 high_quad = _mm256_extractf128_ps(x, 1);
    // low_quad = ( x3, x2, x1, x0 )
@@ -48,12 +51,8 @@ float calc_256_sum_8(__m256 x) {
    return _mm_cvtss_f32(sum);
 }
 
-#endif
-
-#if defined(__AVX2__)
-
-export f32 L2Distance_simd(const f32 *vector1, const f32 *vector2, u32 dimension) {
-   u32 i = 0;
+AVX2_TARGET f32 L2DistanceAVX2(const f32 *vector1, const f32 *vector2, SizeT dimension) {
+   SizeT i = 0;
    __m256 sum_1 = _mm256_setzero_ps();
    __m256 sum_2 = _mm256_setzero_ps();
    _mm_prefetch(vector1, _MM_HINT_NTA);
@@ -83,18 +82,8 @@ export f32 L2Distance_simd(const f32 *vector1, const f32 *vector2, u32 dimension
    return distance;
 }
 
-#elif defined(__SSE__) 
-
-export f32 L2Distance_simd(const f32 *vector1, const f32 *vector2, u32 dimension) {
-    return F32L2SSEResidual(vector1, vector2, dimension);
-}
-
-#endif
-
-#if defined(__AVX2__)
-
-export f32 IPDistance_simd(const f32 *vector1, const f32 *vector2, u32 dimension) {
-   u32 i = 0;
+AVX2_TARGET f32 IPDistanceAVX2(const f32 *vector1, const f32 *vector2, SizeT dimension) {
+   SizeT i = 0;
    __m256 sum_1 = _mm256_setzero_ps();
    __m256 sum_2 = _mm256_setzero_ps();
    _mm_prefetch(vector1, _MM_HINT_NTA);
@@ -120,12 +109,40 @@ export f32 IPDistance_simd(const f32 *vector1, const f32 *vector2, u32 dimension
    return distance;
 }
 
-#elif defined(__SSE__) 
+#undef AVX2_TARGET
+
+#endif
 
-export f32 IPDistance_simd(const f32 *vector1, const f32 *vector2, u32 dimension) {
-    return F32IPSSEResidual(vector1, vector2, dimension);
+F32DistanceFunc SelectL2Distance() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (GetSupportedSIMDLevel() >= SIMDLevel::kAVX2) {
+        return L2DistanceAVX2;
+    }
+    if (GetSupportedSIMDLevel() >= SIMDLevel::kSSE) {
+        return F32L2SSEResidual;
+    }
+#endif
+    return F32L2BF;
 }
 
+F32DistanceFunc SelectIPDistance() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (GetSupportedSIMDLevel() >= SIMDLevel::kAVX2) {
+        return IPDistanceAVX2;
+    }
+    if (GetSupportedSIMDLevel() >= SIMDLevel::kSSE) {
+        return F32IPSSEResidual;
+    }
 #endif
+    return F32IPBF;
+}
+
+// Resolved once at startup, the callers run in the innermost loops of kmeans and ivf search.
+const F32DistanceFunc L2DistanceImpl = SelectL2Distance();
+const F32DistanceFunc IPDistanceImpl = SelectIPDistance();
+
+export f32 L2Distance_simd(const f32 *vector1, const f32 *vector2, u32 dimension) { return L2DistanceImpl(vector1, vector2, dimension); }
+
+export f32 IPDistance_simd(const f32 *vector1, const f32 *vector2, u32 dimension) { return IPDistanceImpl(vector1, vector2, dimension); }
 
 } // namespace infinity
\ No newline at end of file
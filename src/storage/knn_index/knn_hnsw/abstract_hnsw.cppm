@@ -39,6 +39,12 @@ class AbstractHnsw {
     using Hnsw2 = KnnHnsw<PlainL2VecStoreType<DataType>, LabelType>;
     using Hnsw3 = KnnHnsw<LVQIPVecStoreType<DataType, i8>, LabelType>;
     using Hnsw4 = KnnHnsw<LVQL2VecStoreType<DataType, i8>, LabelType>;
+    using Hnsw5 = KnnHnsw<SQIPVecStoreType<DataType, 8>, LabelType>;
+    using Hnsw6 = KnnHnsw<SQL2VecStoreType<DataType, 8>, LabelType>;
+    using Hnsw7 = KnnHnsw<SQIPVecStoreType<DataType, 4>, LabelType>;
+    using Hnsw8 = KnnHnsw<SQL2VecStoreType<DataType, 4>, LabelType>;
+    using Hnsw9 = KnnHnsw<PQIPVecStoreType<DataType>, LabelType>;
+    using Hnsw10 = KnnHnsw<PQL2VecStoreType<DataType>, LabelType>;
 
 public:
     AbstractHnsw(void *ptr, const IndexHnsw *index_hnsw) {
@@ -75,6 +81,54 @@ public:
                 }
                 break;
             }
+            case HnswEncodeType::kSQ8: {
+                switch (index_hnsw->metric_type_) {
+                    case MetricType::kMetricInnerProduct: {
+                        knn_hnsw_ptr_ = reinterpret_cast<Hnsw5 *>(ptr);
+                        break;
+                    }
+                    case MetricType::kMetricL2: {
+                        knn_hnsw_ptr_ = reinterpret_cast<Hnsw6 *>(ptr);
+                        break;
+                    }
+                    default: {
+                        UnrecoverableError("HNSW supports inner product and L2 distance.");
+                    }
+                }
+                break;
+            }
+            case HnswEncodeType::kSQ4: {
+                switch (index_hnsw->metric_type_) {
+                    case MetricType::kMetricInnerProduct: {
+                        knn_hnsw_ptr_ = reinterpret_cast<Hnsw7 *>(ptr);
+                        break;
+                    }
+                    case MetricType::kMetricL2: {
+                        knn_hnsw_ptr_ = reinterpret_cast<Hnsw8 *>(ptr);
+                        break;
+                    }
+                    default: {
+                        UnrecoverableError("HNSW supports inner product and L2 distance.");
+                    }
+                }
+                break;
+            }
+            case HnswEncodeType::kPQ: {
+                switch (index_hnsw->metric_type_) {
+                    case MetricType::kMetricInnerProduct: {
+                        knn_hnsw_ptr_ = reinterpret_cast<Hnsw9 *>(ptr);
+                        break;
+                    }
+                    case MetricType::kMetricL2: {
+                        knn_hnsw_ptr_ = reinterpret_cast<Hnsw10 *>(ptr);
+                        break;
+                    }
+                    default: {
+                        UnrecoverableError("HNSW supports inner product and L2 distance.");
+                    }
+                }
+                break;
+            }
             default: {
                 UnrecoverableError("Invalid metric type");
             }
@@ -100,6 +154,16 @@ public:
             knn_hnsw_ptr_);
     }
 
+    // Replace the graph with a copy of the one of src, which has the same type. The object stays in place.
+    void CopyInPlace(const AbstractHnsw &src) {
+        std::visit(
+            [&](auto &&arg) {
+                using T = std::decay_t<decltype(*arg)>;
+                *arg = T::Clone(*std::get<T *>(src.knn_hnsw_ptr_));
+            },
+            knn_hnsw_ptr_);
+    }
+
     void Save(FileHandler &file_handler) {
         std::visit([&file_handler](auto &&arg) { arg->Save(file_handler); }, knn_hnsw_ptr_);
     }
@@ -116,6 +180,11 @@ public:
         std::visit([idx](auto &&arg) { arg->Build(idx); }, knn_hnsw_ptr_);
     }
 
+    template <typename Progress>
+    void ParallelBuild(SizeT start_i, SizeT end_i, SizeT thread_n, SizeT report_interval, Progress &&progress) {
+        std::visit([&](auto &&arg) { arg->ParallelBuild(start_i, end_i, thread_n, report_interval, progress); }, knn_hnsw_ptr_);
+    }
+
     void *RawPtr() const {
         return std::visit([](auto &&arg) { return reinterpret_cast<void *>(arg); }, knn_hnsw_ptr_);
     }
@@ -140,13 +209,13 @@ public:
 
     template <FilterConcept<LabelType> Filter>
     Tuple<SizeT, UniquePtr<DataType[]>, UniquePtr<LabelType[]>>
-    KnnSearch(const DataType *q, SizeT k, const Filter &filter, bool with_lock = true) const {
+    KnnSearch(const DataType *q, SizeT k, const Filter &filter, bool with_lock = true, bool filter_two_hop = false) const {
         return std::visit(
-            [q, k, &filter, with_lock](auto &&arg) {
+            [q, k, &filter, with_lock, filter_two_hop](auto &&arg) {
                 if (with_lock) {
-                    return arg->template KnnSearch<Filter, true>(q, k, filter);
+                    return arg->template KnnSearch<Filter, true>(q, k, filter, filter_two_hop);
                 } else {
-                    return arg->template KnnSearch<Filter, false>(q, k, filter);
+                    return arg->template KnnSearch<Filter, false>(q, k, filter, filter_two_hop);
                 }
             },
             knn_hnsw_ptr_);
@@ -165,7 +234,7 @@ public:
     }
 
 private:
-    std::variant<Hnsw1 *, Hnsw2 *, Hnsw3 *, Hnsw4 *> knn_hnsw_ptr_;
+    std::variant<Hnsw1 *, Hnsw2 *, Hnsw3 *, Hnsw4 *, Hnsw5 *, Hnsw6 *, Hnsw7 *, Hnsw8 *, Hnsw9 *, Hnsw10 *> knn_hnsw_ptr_;
 };
 
 } // namespace infinity
\ No newline at end of file
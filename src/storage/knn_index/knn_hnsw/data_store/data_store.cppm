@@ -24,6 +24,7 @@ import hnsw_common;
 import file_system;
 import vec_store_type;
 import graph_store;
+import default_values;
 
 namespace infinity {
 
@@ -58,7 +59,8 @@ public:
         : chunk_size_(std::exchange(other.chunk_size_, 0)), max_chunk_n_(std::exchange(other.max_chunk_n_, 0)),
           chunk_shift_(std::exchange(other.chunk_shift_, 0)), cur_vec_num_(other.cur_vec_num_.exchange(0)),
           vec_store_meta_(std::move(other.vec_store_meta_)), graph_store_meta_(std::move(other.graph_store_meta_)),
-          inners_(std::exchange(other.inners_, nullptr)) {}
+          inners_(std::exchange(other.inners_, nullptr)), keep_raw_(std::exchange(other.keep_raw_, false)),
+          trained_num_(std::exchange(other.trained_num_, 0)), raw_vecs_(std::move(other.raw_vecs_)) {}
     DataStore &operator=(This &&other) {
         if (this != &other) {
             chunk_size_ = std::exchange(other.chunk_size_, 0);
@@ -68,6 +70,9 @@ public:
             vec_store_meta_ = std::move(other.vec_store_meta_);
             graph_store_meta_ = std::move(other.graph_store_meta_);
             inners_ = std::exchange(other.inners_, nullptr);
+            keep_raw_ = std::exchange(other.keep_raw_, false);
+            trained_num_ = std::exchange(other.trained_num_, 0);
+            raw_vecs_ = std::move(other.raw_vecs_);
         }
         return *this;
     }
@@ -89,6 +94,7 @@ public:
         This ret(chunk_size, max_chunk_n, std::move(vec_store_meta), std::move(graph_store_meta));
         ret.cur_vec_num_ = 0;
         ret.inners_[0] = Inner::Make(chunk_size, ret.vec_store_meta_, ret.graph_store_meta_);
+        ret.keep_raw_ = This::IsQuantized();
         return ret;
     }
 
@@ -134,39 +140,64 @@ public:
         return ret;
     }
 
+    // A deep copy with the layout of Load, the caller makes sure that no vector is added to other meanwhile.
+    static This Clone(const This &other, SizeT max_chunk_n = 0) {
+        if (max_chunk_n == 0) {
+            max_chunk_n = other.max_chunk_n_;
+        }
+        assert(max_chunk_n >= other.max_chunk_n_);
+
+        SizeT cur_vec_num = other.cur_vec_num();
+        VecStoreMeta vec_store_meta = VecStoreMeta::Clone(other.vec_store_meta_);
+        GraphStoreMeta graph_store_meta = GraphStoreMeta::Clone(other.graph_store_meta_);
+
+        This ret = This(other.chunk_size_, max_chunk_n, std::move(vec_store_meta), std::move(graph_store_meta));
+        ret.cur_vec_num_ = cur_vec_num;
+
+        auto [chunk_num, last_chunk_size] = ret.ChunkInfo(cur_vec_num);
+        for (SizeT i = 0; i < chunk_num; ++i) {
+            SizeT cur_chunk_size = (i < chunk_num - 1) ? other.chunk_size_ : last_chunk_size;
+            ret.inners_[i] = Inner::Clone(other.inners_[i], cur_chunk_size, other.chunk_size_, ret.vec_store_meta_, ret.graph_store_meta_);
+        }
+        ret.keep_raw_ = other.keep_raw_;
+        ret.trained_num_ = other.trained_num_;
+        ret.raw_vecs_ = other.raw_vecs_;
+        return ret;
+    }
+
     // vec store
     Pair<SizeT, SizeT> AddVec(const DataType *vec, SizeT vec_num) { return AddVec(DenseVectorIter<DataType, LabelType>(vec, dim(), vec_num)); }
 
     template <DataIteratorConcept<const DataType *, LabelType> Iterator>
     Pair<SizeT, SizeT> AddVec(Iterator &&query_iter) {
-        SizeT cur_vec_num = this->cur_vec_num();
-        SizeT start_idx = cur_vec_num;
-        auto [chunk_num, last_chunk_size] = ChunkInfo(cur_vec_num);
-        while (true) {
-            SizeT remain_size = chunk_size_ - last_chunk_size;
-            auto [insert_n, used_up] = inners_[chunk_num - 1].AddVec(std::move(query_iter), last_chunk_size, remain_size, vec_store_meta_);
-            cur_vec_num += insert_n;
-            last_chunk_size += insert_n;
-            if (cur_vec_num == max_chunk_n_ * chunk_size_) {
-                break;
-            }
-            if (last_chunk_size == chunk_size_) {
-                inners_[chunk_num++] = Inner::Make(chunk_size_, vec_store_meta_, graph_store_meta_);
-                last_chunk_size = 0;
-            }
-            if (used_up) {
-                break;
+        if constexpr (This::IsQuantized()) {
+            if (keep_raw_) {
+                Iterator raw_iter = query_iter;
+                auto [start_i, end_i] = AddVecInner(std::move(query_iter));
+                AddRawVec(std::move(raw_iter), start_i, end_i);
+                return {start_i, end_i};
             }
         }
-        cur_vec_num_.store(cur_vec_num);
-        return {start_idx, cur_vec_num};
+        return AddVecInner(std::move(query_iter));
     }
 
     Pair<SizeT, SizeT> OptAddVec(const DataType *vec, SizeT vec_num) { return OptAddVec(DenseVectorIter<DataType, LabelType>(vec, dim(), vec_num)); }
 
     template <DataIteratorConcept<const DataType *, LabelType> Iterator>
     Pair<SizeT, SizeT> OptAddVec(Iterator &&query_iter) {
-        if constexpr (!This::IsPlain()) {
+        if constexpr (This::IsQuantized()) {
+            // All the vectors are at hand: the quantizer of an empty store is trained on them at once.
+            if (cur_vec_num() == 0) {
+                Iterator train_iter = query_iter;
+                VecStoreMeta new_meta = VecStoreMeta::Make(dim());
+                new_meta.template Train<LabelType, Iterator>(std::move(train_iter));
+                if (new_meta.trained()) {
+                    std::unique_lock lock(quantizer_mutex_);
+                    vec_store_meta_ = std::move(new_meta);
+                    keep_raw_ = false;
+                }
+            }
+        } else if constexpr (!This::IsPlain()) {
             SizeT cur_vec_num = this->cur_vec_num();
             auto [chunk_num, last_chunk_size] = ChunkInfo(cur_vec_num);
             if (chunk_num > 0) {
@@ -185,9 +216,14 @@ public:
     void Optimize() {
         if constexpr (This::IsPlain()) {
             return;
+        } else if constexpr (This::IsQuantized()) {
+            if (keep_raw_ && raw_vecs_.size() / dim() > trained_num_) {
+                TrainOnRawVec();
+            }
+        } else {
+            DenseVectorIter<DataType, LabelType> empty_iter(nullptr, dim(), 0);
+            AddVec(std::move(empty_iter));
         }
-        DenseVectorIter<DataType, LabelType> empty_iter(nullptr, dim(), 0);
-        AddVec(std::move(empty_iter));
     }
 
     typename VecStoreT::StoreType GetVec(SizeT vec_i) const {
@@ -246,11 +282,95 @@ public:
 
     SizeT cur_vec_num() const { return cur_vec_num_.load(); }
 
+    // Held by a search while it uses the quantizer and the codes, the inserting thread may train the quantizer again, see TrainOnRawVec.
+    std::shared_lock<std::shared_mutex> SharedQuantizerLock() const {
+        if constexpr (This::IsQuantized()) {
+            return std::shared_lock(quantizer_mutex_);
+        }
+        return {};
+    }
+
 private:
     constexpr static bool IsPlain() {
         return std::is_same_v<VecStoreT, PlainL2VecStoreType<DataType>> || std::is_same_v<VecStoreT, PlainIPVecStoreType<DataType>>;
     }
 
+    constexpr static bool IsQuantized() {
+        return requires(const VecStoreMeta &meta) { meta.trained(); };
+    }
+
+    template <DataIteratorConcept<const DataType *, LabelType> Iterator>
+    Pair<SizeT, SizeT> AddVecInner(Iterator &&query_iter) {
+        SizeT cur_vec_num = this->cur_vec_num();
+        SizeT start_idx = cur_vec_num;
+        auto [chunk_num, last_chunk_size] = ChunkInfo(cur_vec_num);
+        while (true) {
+            SizeT remain_size = chunk_size_ - last_chunk_size;
+            auto [insert_n, used_up] = inners_[chunk_num - 1].AddVec(std::move(query_iter), last_chunk_size, remain_size, vec_store_meta_);
+            cur_vec_num += insert_n;
+            last_chunk_size += insert_n;
+            if (cur_vec_num == max_chunk_n_ * chunk_size_) {
+                break;
+            }
+            if (last_chunk_size == chunk_size_) {
+                inners_[chunk_num++] = Inner::Make(chunk_size_, vec_store_meta_, graph_store_meta_);
+                last_chunk_size = 0;
+            }
+            if (used_up) {
+                break;
+            }
+        }
+        cur_vec_num_.store(cur_vec_num);
+        return {start_idx, cur_vec_num};
+    }
+
+    // Keep the raw vectors [start_i, end_i) of the iterator, the first HNSW_QUANTIZER_TRAIN_NUM vectors added are kept. The quantizer
+    // is trained again on the kept vectors whenever their number doubles, a quantizer trained on the first few vectors only would
+    // encode the later ones badly. The vectors that are not kept are encoded again from the iterator.
+    template <DataIteratorConcept<const DataType *, LabelType> Iterator>
+    void AddRawVec(Iterator &&raw_iter, SizeT start_i, SizeT end_i) {
+        SizeT dim = this->dim();
+        SizeT keep_end = std::min(end_i, std::max(start_i, HNSW_QUANTIZER_TRAIN_NUM));
+        SizeT i = start_i;
+        for (; i < keep_end; ++i) {
+            const DataType *vec = raw_iter.Next()->first;
+            raw_vecs_.insert(raw_vecs_.end(), vec, vec + dim);
+        }
+        SizeT raw_num = raw_vecs_.size() / dim;
+        if (raw_num < 2 * trained_num_ && raw_num < HNSW_QUANTIZER_TRAIN_NUM) {
+            return;
+        }
+        auto lock = TrainOnRawVec();
+        for (; i < end_i; ++i) {
+            auto [inner, idx] = GetInner(i);
+            inner.vec_store_inner()->SetVec(idx, raw_iter.Next()->first, vec_store_meta_);
+        }
+        if (raw_num >= HNSW_QUANTIZER_TRAIN_NUM) {
+            keep_raw_ = false;
+            Vector<DataType>().swap(raw_vecs_);
+        }
+    }
+
+    // Train a new quantizer on the kept raw vectors, then swap it in and encode the vectors again under the returned lock. The
+    // training runs on the side, the searches wait for the swap and the encoding only.
+    std::unique_lock<std::shared_mutex> TrainOnRawVec() {
+        SizeT dim = this->dim();
+        SizeT raw_num = raw_vecs_.size() / dim;
+        VecStoreMeta new_meta = VecStoreMeta::Make(dim);
+        new_meta.template Train<LabelType>(DenseVectorIter<DataType, LabelType>(raw_vecs_.data(), dim, raw_num));
+        std::unique_lock lock(quantizer_mutex_);
+        if (!new_meta.trained()) {
+            return lock;
+        }
+        vec_store_meta_ = std::move(new_meta);
+        for (SizeT i = 0; i < raw_num; ++i) {
+            auto [inner, idx] = GetInner(i);
+            inner.vec_store_inner()->SetVec(idx, raw_vecs_.data() + i * dim, vec_store_meta_);
+        }
+        trained_num_ = raw_num;
+        return lock;
+    }
+
     Pair<Inner &, SizeT> GetInner(SizeT vec_i) { return {inners_[vec_i >> chunk_shift_], vec_i & (chunk_size_ - 1)}; }
 
     Pair<const Inner &, SizeT> GetInner(SizeT vec_i) const { return {inners_[vec_i >> chunk_shift_], vec_i & (chunk_size_ - 1)}; }
@@ -274,6 +394,13 @@ private:
 
     UniquePtr<Inner[]> inners_;
 
+    // The raw vectors a quantized store keeps to train its quantizer, see AddRawVec. A loaded store keeps none.
+    bool keep_raw_ = false;
+    SizeT trained_num_ = 0;
+    Vector<DataType> raw_vecs_;
+    // not moved with the store, a store is moved before it is searched
+    mutable std::shared_mutex quantizer_mutex_;
+
 public:
     void Check() const {
         i32 max_l = -1;
@@ -354,6 +481,15 @@ public:
         return ret;
     }
 
+    static This
+    Clone(const This &other, SizeT cur_vec_num, SizeT chunk_size, const VecStoreMeta &vec_store_meta, const GraphStoreMeta &graph_store_meta) {
+        auto vec_store_inner = VecStoreInner::Clone(other.vec_store_inner_, cur_vec_num, chunk_size, vec_store_meta);
+        auto graph_store_inner = GraphStoreInner::Clone(other.graph_store_inner_, cur_vec_num, chunk_size, graph_store_meta);
+        This ret(chunk_size, std::move(vec_store_inner), std::move(graph_store_inner));
+        std::memcpy(ret.labels_.get(), other.labels_.get(), sizeof(LabelType) * cur_vec_num);
+        return ret;
+    }
+
     // vec store
     template <DataIteratorConcept<const DataType *, LabelType> Iterator>
     Pair<SizeT, bool> AddVec(Iterator &&query_iter, VertexType start_idx, SizeT remain_num, const VecStoreMeta &meta) {
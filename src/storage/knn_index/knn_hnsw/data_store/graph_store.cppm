@@ -91,6 +91,14 @@ public:
         return meta;
     }
 
+    static GraphStoreMeta Clone(const GraphStoreMeta &other) {
+        GraphStoreMeta meta(other.Mmax0_, other.Mmax_);
+        auto [max_layer, enterpoint] = other.GetEnterPoint();
+        meta.max_layer_ = max_layer;
+        meta.enterpoint_ = enterpoint;
+        return meta;
+    }
+
     SizeT Mmax0() const { return Mmax0_; }
     SizeT Mmax() const { return Mmax_; }
     SizeT level0_size() const { return level0_size_; }
@@ -200,6 +208,34 @@ public:
         return graph_store;
     }
 
+    // Same layout as Load, the upper layers of all the vertices are copied to one buffer.
+    static GraphStoreInner Clone(const GraphStoreInner &other, SizeT cur_vertex_n, SizeT max_vertex, const GraphStoreMeta &meta) {
+        assert(cur_vertex_n <= max_vertex);
+
+        SizeT layer_sum = 0;
+        for (VertexType vertex_i = 0; vertex_i < (VertexType)cur_vertex_n; ++vertex_i) {
+            layer_sum += other.GetLevel0(vertex_i, meta)->layer_n_;
+        }
+
+        GraphStoreInner graph_store(max_vertex, meta, cur_vertex_n);
+        std::memcpy(graph_store.graph_.get(), other.graph_.get(), cur_vertex_n * meta.level0_size());
+
+        auto loaded_layers = MakeUnique<char[]>(meta.levelx_size() * layer_sum);
+        char *loaded_layers_p = loaded_layers.get();
+        for (VertexType vertex_i = 0; vertex_i < (VertexType)cur_vertex_n; ++vertex_i) {
+            VertexL0 *v = graph_store.GetLevel0(vertex_i, meta);
+            if (v->layer_n_) {
+                std::memcpy(loaded_layers_p, v->layers_p_, meta.levelx_size() * v->layer_n_);
+                v->layers_p_ = loaded_layers_p;
+                loaded_layers_p += meta.levelx_size() * v->layer_n_;
+            } else {
+                v->layers_p_ = nullptr;
+            }
+        }
+        graph_store.loaded_layers_ = std::move(loaded_layers);
+        return graph_store;
+    }
+
     void AddVertex(VertexType vertex_i, i32 layer_n, const GraphStoreMeta &meta) {
         VertexL0 *v = GetLevel0(vertex_i, meta);
         v->neighbor_n_ = 0;
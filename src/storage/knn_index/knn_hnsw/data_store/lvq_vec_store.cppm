@@ -100,6 +100,13 @@ public:
         return meta;
     }
 
+    static This Clone(const This &other) {
+        This meta(other.dim_);
+        std::memcpy(meta.mean_.get(), other.mean_.get(), sizeof(MeanType) * other.dim_);
+        meta.global_cache_ = other.global_cache_;
+        return meta;
+    }
+
     LVQQuery MakeQuery(const DataType *vec) const {
         LVQQuery query(compress_data_size_);
         CompressTo(vec, query.inner_.get());
@@ -239,6 +246,13 @@ public:
         return ret;
     }
 
+    static This Clone(const This &other, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        std::memcpy(ret.ptr_.get(), other.ptr_.get(), cur_vec_num * meta.compress_data_size());
+        return ret;
+    }
+
     void SetVec(SizeT idx, const DataType *vec, const Meta &meta) { meta.CompressTo(vec, GetVecMut(idx, meta)); }
 
     const LVQData *GetVec(SizeT idx, const Meta &meta) const {
@@ -57,6 +57,8 @@ public:
         return This(dim);
     }
 
+    static This Clone(const This &other) { return This(other.dim_); }
+
     QueryType MakeQuery(const DataType *vec) const { return vec; }
 
     SizeT dim() const { return dim_; }
@@ -93,6 +95,13 @@ public:
         return ret;
     }
 
+    static This Clone(const This &other, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        std::memcpy(ret.ptr_.get(), other.ptr_.get(), sizeof(DataType) * cur_vec_num * meta.dim());
+        return ret;
+    }
+
     void SetVec(SizeT idx, const DataType *vec, const Meta &meta) { Copy(vec, vec + meta.dim(), GetVecMut(idx, meta)); }
 
     const DataType *GetVec(SizeT idx, const Meta &meta) const { return ptr_.get() + idx * meta.dim(); }
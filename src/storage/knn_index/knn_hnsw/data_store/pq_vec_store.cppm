@@ -0,0 +1,323 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <cassert>
+#include <ostream>
+#include <random>
+#include <xmmintrin.h>
+
+export module pq_vec_store;
+
+import stl;
+import file_system;
+import hnsw_common;
+import kmeans_partition;
+import index_base;
+import default_values;
+
+namespace infinity {
+
+// A vector of the store is its codes, a query is its lookup table: the distances between the query and every centroid of every
+// subspace, so the distance to a vector is the sum of one table entry per subspace.
+export template <typename DataType>
+struct PQStore {
+    const u8 *codes_;
+    const DataType *lut_;
+};
+
+export template <typename DataType, typename PQTable>
+class PQVecStoreInner;
+
+// Product quantization: the dimensions are split into subspaces of HNSW_PQ_SUBSPACE_DIM, the last one may be shorter, and each
+// subspace of a vector is encoded to its nearest centroid. The centroids are trained with k-means on raw vectors, see Train.
+// PQTable gives the distance between the subspaces of two vectors.
+export template <typename DataType, typename PQTable>
+class PQVecStoreMeta {
+public:
+    constexpr static SizeT max_centroid_num_ = HNSW_PQ_CENTROID_NUM;
+    static_assert(max_centroid_num_ <= 256);
+
+    using This = PQVecStoreMeta<DataType, PQTable>;
+    using Inner = PQVecStoreInner<DataType, PQTable>;
+    using StoreType = PQStore<DataType>;
+    struct PQQuery {
+        UniquePtr<DataType[]> lut_;
+        operator StoreType() const { return {nullptr, lut_.get()}; }
+    };
+    using QueryType = PQQuery;
+
+private:
+    PQVecStoreMeta(SizeT dim) : dim_(dim), subspace_num_((dim + HNSW_PQ_SUBSPACE_DIM - 1) / HNSW_PQ_SUBSPACE_DIM) {
+        centroids_ = MakeUnique<DataType[]>(max_centroid_num_ * dim);
+        std::fill(centroids_.get(), centroids_.get() + max_centroid_num_ * dim, 0);
+    }
+
+public:
+    PQVecStoreMeta() : dim_(0), subspace_num_(0) {}
+    PQVecStoreMeta(This &&other)
+        : dim_(std::exchange(other.dim_, 0)), subspace_num_(std::exchange(other.subspace_num_, 0)),
+          centroid_num_(std::exchange(other.centroid_num_, 0)), centroids_(std::move(other.centroids_)) {}
+    This &operator=(This &&other) {
+        if (this != &other) {
+            dim_ = std::exchange(other.dim_, 0);
+            subspace_num_ = std::exchange(other.subspace_num_, 0);
+            centroid_num_ = std::exchange(other.centroid_num_, 0);
+            centroids_ = std::move(other.centroids_);
+        }
+        return *this;
+    }
+    ~PQVecStoreMeta() = default;
+
+    static This Make(SizeT dim) { return This(dim); }
+
+    void Save(FileHandler &file_handler) const {
+        file_handler.Write(&dim_, sizeof(dim_));
+        file_handler.Write(&centroid_num_, sizeof(centroid_num_));
+        file_handler.Write(centroids_.get(), sizeof(DataType) * centroid_num_ * dim_);
+    }
+
+    static This Load(FileHandler &file_handler) {
+        SizeT dim;
+        file_handler.Read(&dim, sizeof(dim));
+        This meta(dim);
+        file_handler.Read(&meta.centroid_num_, sizeof(meta.centroid_num_));
+        file_handler.Read(meta.centroids_.get(), sizeof(DataType) * meta.centroid_num_ * dim);
+        return meta;
+    }
+
+    static This Clone(const This &other) {
+        This meta(other.dim_);
+        meta.centroid_num_ = other.centroid_num_;
+        std::memcpy(meta.centroids_.get(), other.centroids_.get(), sizeof(DataType) * other.centroid_num_ * other.dim_);
+        return meta;
+    }
+
+    QueryType MakeQuery(const DataType *vec) const {
+        QueryType query{MakeUniqueForOverwrite<DataType[]>(subspace_num_ * max_centroid_num_)};
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            auto [offset, sub_dim] = Subspace(m);
+            DataType *lut = query.lut_.get() + m * max_centroid_num_;
+            for (SizeT c = 0; c < centroid_num_; ++c) {
+                lut[c] = PQTable::SubDist(vec + offset, Centroid(centroids_.get(), c, m), sub_dim);
+            }
+        }
+        return query;
+    }
+
+    // The distance of the query with a vector, the lookup table is the one of MakeQuery.
+    DataType QueryDist(const DataType *lut, const u8 *codes) const {
+        DataType dist = 0;
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            dist += lut[m * max_centroid_num_ + codes[m]];
+        }
+        return dist;
+    }
+
+    // The distance of two vectors of the store, used when building the graph.
+    DataType CodesDist(const u8 *codes1, const u8 *codes2) const {
+        DataType dist = 0;
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            auto [offset, sub_dim] = Subspace(m);
+            dist += PQTable::SubDist(Centroid(centroids_.get(), codes1[m], m), Centroid(centroids_.get(), codes2[m], m), sub_dim);
+        }
+        return dist;
+    }
+
+    void CompressTo(const DataType *src, u8 *dest) const { Encode(src, centroids_.get(), centroid_num_, dest); }
+
+    void DecompressTo(const u8 *src, DataType *dest) const {
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            auto [offset, sub_dim] = Subspace(m);
+            const DataType *centroid = Centroid(centroids_.get(), src[m], m);
+            Copy(centroid, centroid + sub_dim, dest + offset);
+        }
+    }
+
+    // Train the centroids on a sample of the raw vectors of the iterator. The centroids are written in place, the caller encodes
+    // the vectors in the store again.
+    template <typename LabelType, DataIteratorConcept<const DataType *, LabelType> Iterator>
+    void Train(Iterator &&query_iter) {
+        // Reservoir sampling, the sample is at most HNSW_PQ_TRAIN_SAMPLE_NUM vectors.
+        Vector<DataType> sample;
+        SizeT cur_vec_num = 0;
+        std::mt19937 rng(0);
+        auto add_sample = [&](const DataType *vec) {
+            if (cur_vec_num < HNSW_PQ_TRAIN_SAMPLE_NUM) {
+                sample.insert(sample.end(), vec, vec + dim_);
+            } else if (SizeT i = std::uniform_int_distribution<SizeT>(0, cur_vec_num)(rng); i < HNSW_PQ_TRAIN_SAMPLE_NUM) {
+                Copy(vec, vec + dim_, sample.data() + i * dim_);
+            }
+            ++cur_vec_num;
+        };
+        while (true) {
+            if (auto ret = query_iter.Next(); ret) {
+                add_sample(ret->first);
+            } else {
+                break;
+            }
+        }
+        SizeT sample_num = sample.size() / dim_;
+        if (sample_num == 0) {
+            return;
+        }
+
+        SizeT new_centroid_num = std::min(max_centroid_num_, sample_num);
+        auto new_centroids = MakeUnique<DataType[]>(max_centroid_num_ * dim_);
+        Vector<DataType> sub_sample(sample_num * HNSW_PQ_SUBSPACE_DIM);
+        Vector<DataType> sub_centroids;
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            auto [offset, sub_dim] = Subspace(m);
+            for (SizeT i = 0; i < sample_num; ++i) {
+                Copy(sample.data() + i * dim_ + offset, sample.data() + i * dim_ + offset + sub_dim, sub_sample.data() + i * sub_dim);
+            }
+            // the sample may have fewer vectors than centroids times min_points_per_centroid while a store is filled, see DataStore
+            u32 partition_num = GetKMeansCentroids<f32, DataType, DataType>(MetricType::kMetricL2,
+                                                                            u32(sub_dim),
+                                                                            u32(sample_num),
+                                                                            sub_sample.data(),
+                                                                            sub_centroids,
+                                                                            u32(new_centroid_num),
+                                                                            0 /*iteration_max*/,
+                                                                            1 /*min_points_per_centroid*/);
+            assert(partition_num == new_centroid_num);
+            for (SizeT c = 0; c < partition_num; ++c) {
+                Copy(sub_centroids.data() + c * sub_dim, sub_centroids.data() + (c + 1) * sub_dim, Centroid(new_centroids.get(), c, m));
+            }
+        }
+
+        Copy(new_centroids.get(), new_centroids.get() + new_centroid_num * dim_, centroids_.get());
+        centroid_num_ = new_centroid_num;
+    }
+
+    SizeT dim() const { return dim_; }
+    SizeT code_size() const { return subspace_num_; }
+    bool trained() const { return centroid_num_ > 0; }
+
+private:
+    // The offset and the dimension of subspace m.
+    Pair<SizeT, SizeT> Subspace(SizeT m) const {
+        SizeT offset = m * HNSW_PQ_SUBSPACE_DIM;
+        return {offset, std::min(HNSW_PQ_SUBSPACE_DIM, dim_ - offset)};
+    }
+
+    // The centroids of one index of all subspaces make up a vector.
+    DataType *Centroid(DataType *centroids, SizeT c, SizeT m) const { return centroids + c * dim_ + m * HNSW_PQ_SUBSPACE_DIM; }
+    const DataType *Centroid(const DataType *centroids, SizeT c, SizeT m) const { return centroids + c * dim_ + m * HNSW_PQ_SUBSPACE_DIM; }
+
+    // The nearest centroid of every subspace in L2 distance, whatever the metric of the index.
+    void Encode(const DataType *src, const DataType *centroids, SizeT centroid_num, u8 *dest) const {
+        for (SizeT m = 0; m < subspace_num_; ++m) {
+            auto [offset, sub_dim] = Subspace(m);
+            DataType min_dist = std::numeric_limits<DataType>::max();
+            u8 code = 0;
+            for (SizeT c = 0; c < centroid_num; ++c) {
+                const DataType *centroid = Centroid(centroids, c, m);
+                DataType dist = 0;
+                for (SizeT j = 0; j < sub_dim; ++j) {
+                    DataType diff = src[offset + j] - centroid[j];
+                    dist += diff * diff;
+                }
+                if (dist < min_dist) {
+                    min_dist = dist;
+                    code = c;
+                }
+            }
+            dest[m] = code;
+        }
+    }
+
+private:
+    SizeT dim_;
+    SizeT subspace_num_;
+    SizeT centroid_num_ = 0;
+
+    UniquePtr<DataType[]> centroids_;
+
+public:
+    void Dump(std::ostream &os) const {
+        os << "[CONST] dim: " << dim_ << ", subspace_num: " << subspace_num_ << ", centroid_num: " << centroid_num_ << std::endl;
+        for (SizeT c = 0; c < centroid_num_; ++c) {
+            os << "centroid " << c << ": ";
+            for (SizeT j = 0; j < dim_; ++j) {
+                os << centroids_[c * dim_ + j] << " ";
+            }
+            os << std::endl;
+        }
+    }
+};
+
+export template <typename DataType, typename PQTable>
+class PQVecStoreInner {
+public:
+    using This = PQVecStoreInner<DataType, PQTable>;
+    using Meta = PQVecStoreMeta<DataType, PQTable>;
+    using StoreType = typename Meta::StoreType;
+
+private:
+    PQVecStoreInner(SizeT max_vec_num, const Meta &meta) : ptr_(MakeUnique<u8[]>(max_vec_num * meta.code_size())) {}
+
+public:
+    PQVecStoreInner() = default;
+
+    static This Make(SizeT max_vec_num, const Meta &meta) { return This(max_vec_num, meta); }
+
+    void Save(FileHandler &file_handler, SizeT cur_vec_num, const Meta &meta) const {
+        file_handler.Write(ptr_.get(), cur_vec_num * meta.code_size());
+    }
+
+    static This Load(FileHandler &file_handler, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        file_handler.Read(ret.ptr_.get(), cur_vec_num * meta.code_size());
+        return ret;
+    }
+
+    static This Clone(const This &other, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        std::memcpy(ret.ptr_.get(), other.ptr_.get(), cur_vec_num * meta.code_size());
+        return ret;
+    }
+
+    void SetVec(SizeT idx, const DataType *vec, const Meta &meta) { meta.CompressTo(vec, GetCodesMut(idx, meta)); }
+
+    StoreType GetVec(SizeT idx, const Meta &meta) const { return {GetCodes(idx, meta), nullptr}; }
+
+    const u8 *GetCodes(SizeT idx, const Meta &meta) const { return ptr_.get() + idx * meta.code_size(); }
+
+    void Prefetch(VertexType vec_i, const Meta &meta) const { _mm_prefetch(reinterpret_cast<const char *>(GetCodes(vec_i, meta)), _MM_HINT_T0); }
+
+private:
+    u8 *GetCodesMut(SizeT idx, const Meta &meta) { return ptr_.get() + idx * meta.code_size(); }
+
+private:
+    UniquePtr<u8[]> ptr_;
+
+public:
+    void Dump(std::ostream &os, SizeT offset, SizeT chunk_size, const Meta &meta) const {
+        for (int i = 0; i < (int)chunk_size; ++i) {
+            os << "vec " << i << "(" << offset + i << "): ";
+            const u8 *codes = GetCodes(i, meta);
+            for (SizeT m = 0; m < meta.code_size(); ++m) {
+                os << static_cast<int>(codes[m]) << " ";
+            }
+            os << std::endl;
+        }
+    }
+};
+
+} // namespace infinity
@@ -0,0 +1,261 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <cassert>
+#include <ostream>
+#include <xmmintrin.h>
+
+export module sq_vec_store;
+
+import stl;
+import file_system;
+import hnsw_common;
+
+namespace infinity {
+
+// A vector of the store is its codes, a query is the raw vector: the query is compared with the decoded codes.
+export template <typename DataType>
+struct SQStore {
+    const u8 *codes_;
+    const DataType *query_;
+};
+
+export template <typename DataType, u32 Bits>
+class SQVecStoreInner;
+
+// Scalar quantization: dimension j of a vector is encoded to a code of `Bits` bits, decoded as lower_[j] + code * step_[j].
+// The range of every dimension is trained on the raw vectors added, see Train.
+export template <typename DataType, u32 Bits>
+class SQVecStoreMeta {
+public:
+    static_assert(Bits == 4 || Bits == 8);
+    constexpr static u32 max_code_ = (1u << Bits) - 1;
+
+    using This = SQVecStoreMeta<DataType, Bits>;
+    using Inner = SQVecStoreInner<DataType, Bits>;
+    using StoreType = SQStore<DataType>;
+    using QueryType = SQStore<DataType>;
+
+private:
+    SQVecStoreMeta(SizeT dim) : dim_(dim), code_size_((dim * Bits + 7) / 8) {
+        lower_ = MakeUnique<DataType[]>(dim);
+        step_ = MakeUnique<DataType[]>(dim);
+        std::fill(lower_.get(), lower_.get() + dim, 0);
+        std::fill(step_.get(), step_.get() + dim, 0);
+    }
+
+public:
+    SQVecStoreMeta() : dim_(0), code_size_(0) {}
+    SQVecStoreMeta(This &&other)
+        : dim_(std::exchange(other.dim_, 0)), code_size_(std::exchange(other.code_size_, 0)), trained_(std::exchange(other.trained_, false)),
+          lower_(std::move(other.lower_)), step_(std::move(other.step_)) {}
+    This &operator=(This &&other) {
+        if (this != &other) {
+            dim_ = std::exchange(other.dim_, 0);
+            code_size_ = std::exchange(other.code_size_, 0);
+            trained_ = std::exchange(other.trained_, false);
+            lower_ = std::move(other.lower_);
+            step_ = std::move(other.step_);
+        }
+        return *this;
+    }
+    ~SQVecStoreMeta() = default;
+
+    static This Make(SizeT dim) { return This(dim); }
+
+    void Save(FileHandler &file_handler) const {
+        file_handler.Write(&dim_, sizeof(dim_));
+        file_handler.Write(&trained_, sizeof(trained_));
+        file_handler.Write(lower_.get(), sizeof(DataType) * dim_);
+        file_handler.Write(step_.get(), sizeof(DataType) * dim_);
+    }
+
+    static This Load(FileHandler &file_handler) {
+        SizeT dim;
+        file_handler.Read(&dim, sizeof(dim));
+        This meta(dim);
+        file_handler.Read(&meta.trained_, sizeof(meta.trained_));
+        file_handler.Read(meta.lower_.get(), sizeof(DataType) * dim);
+        file_handler.Read(meta.step_.get(), sizeof(DataType) * dim);
+        return meta;
+    }
+
+    static This Clone(const This &other) {
+        This meta(other.dim_);
+        meta.trained_ = other.trained_;
+        std::memcpy(meta.lower_.get(), other.lower_.get(), sizeof(DataType) * other.dim_);
+        std::memcpy(meta.step_.get(), other.step_.get(), sizeof(DataType) * other.dim_);
+        return meta;
+    }
+
+    QueryType MakeQuery(const DataType *vec) const { return {nullptr, vec}; }
+
+    void CompressTo(const DataType *src, u8 *dest) const { Encode(src, lower_.get(), step_.get(), dest); }
+
+    void DecompressTo(const u8 *src, DataType *dest) const {
+        for (SizeT j = 0; j < dim_; ++j) {
+            dest[j] = lower_[j] + GetCode(src, j) * step_[j];
+        }
+    }
+
+    // Train the range of every dimension on the raw vectors of the iterator. The ranges are written in place, the caller encodes
+    // the vectors in the store again.
+    template <typename LabelType, DataIteratorConcept<const DataType *, LabelType> Iterator>
+    void Train(Iterator &&query_iter) {
+        auto new_lower = MakeUnique<DataType[]>(dim_);
+        auto new_upper = MakeUnique<DataType[]>(dim_);
+        std::fill(new_lower.get(), new_lower.get() + dim_, std::numeric_limits<DataType>::max());
+        std::fill(new_upper.get(), new_upper.get() + dim_, std::numeric_limits<DataType>::lowest());
+        SizeT vec_num = 0;
+        while (true) {
+            if (auto ret = query_iter.Next(); ret) {
+                const DataType *vec = ret->first;
+                for (SizeT j = 0; j < dim_; ++j) {
+                    new_lower[j] = std::min(new_lower[j], vec[j]);
+                    new_upper[j] = std::max(new_upper[j], vec[j]);
+                }
+                ++vec_num;
+            } else {
+                break;
+            }
+        }
+        if (vec_num == 0) {
+            return;
+        }
+        for (SizeT j = 0; j < dim_; ++j) {
+            lower_[j] = new_lower[j];
+            step_[j] = (new_upper[j] - new_lower[j]) / max_code_;
+        }
+        trained_ = true;
+    }
+
+    static u32 GetCode(const u8 *codes, SizeT j) {
+        if constexpr (Bits == 8) {
+            return codes[j];
+        } else {
+            return (codes[j >> 1] >> ((j & 1) << 2)) & 0xF;
+        }
+    }
+
+    SizeT dim() const { return dim_; }
+    SizeT code_size() const { return code_size_; }
+    bool trained() const { return trained_; }
+    const DataType *lower() const { return lower_.get(); }
+    const DataType *step() const { return step_.get(); }
+
+private:
+    void Encode(const DataType *src, const DataType *lower, const DataType *step, u8 *dest) const {
+        std::fill(dest, dest + code_size_, 0);
+        for (SizeT j = 0; j < dim_; ++j) {
+            u32 code = 0;
+            if (step[j] > 0) {
+                DataType c = std::floor((src[j] - lower[j]) / step[j] + 0.5);
+                code = std::clamp<DataType>(c, 0, max_code_);
+            }
+            if constexpr (Bits == 8) {
+                dest[j] = code;
+            } else {
+                dest[j >> 1] |= code << ((j & 1) << 2);
+            }
+        }
+    }
+
+private:
+    SizeT dim_;
+    SizeT code_size_;
+    bool trained_ = false;
+
+    UniquePtr<DataType[]> lower_;
+    UniquePtr<DataType[]> step_;
+
+public:
+    void Dump(std::ostream &os) const {
+        os << "[CONST] dim: " << dim_ << ", bits: " << Bits << ", code_size: " << code_size_ << ", trained: " << trained_ << std::endl;
+        os << "lower: ";
+        for (SizeT j = 0; j < dim_; ++j) {
+            os << lower_[j] << " ";
+        }
+        os << std::endl;
+        os << "step: ";
+        for (SizeT j = 0; j < dim_; ++j) {
+            os << step_[j] << " ";
+        }
+        os << std::endl;
+    }
+};
+
+export template <typename DataType, u32 Bits>
+class SQVecStoreInner {
+public:
+    using This = SQVecStoreInner<DataType, Bits>;
+    using Meta = SQVecStoreMeta<DataType, Bits>;
+    using StoreType = typename Meta::StoreType;
+
+private:
+    SQVecStoreInner(SizeT max_vec_num, const Meta &meta) : ptr_(MakeUnique<u8[]>(max_vec_num * meta.code_size())) {}
+
+public:
+    SQVecStoreInner() = default;
+
+    static This Make(SizeT max_vec_num, const Meta &meta) { return This(max_vec_num, meta); }
+
+    void Save(FileHandler &file_handler, SizeT cur_vec_num, const Meta &meta) const {
+        file_handler.Write(ptr_.get(), cur_vec_num * meta.code_size());
+    }
+
+    static This Load(FileHandler &file_handler, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        file_handler.Read(ret.ptr_.get(), cur_vec_num * meta.code_size());
+        return ret;
+    }
+
+    static This Clone(const This &other, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        std::memcpy(ret.ptr_.get(), other.ptr_.get(), cur_vec_num * meta.code_size());
+        return ret;
+    }
+
+    void SetVec(SizeT idx, const DataType *vec, const Meta &meta) { meta.CompressTo(vec, GetCodesMut(idx, meta)); }
+
+    StoreType GetVec(SizeT idx, const Meta &meta) const { return {GetCodes(idx, meta), nullptr}; }
+
+    const u8 *GetCodes(SizeT idx, const Meta &meta) const { return ptr_.get() + idx * meta.code_size(); }
+
+    void Prefetch(VertexType vec_i, const Meta &meta) const { _mm_prefetch(reinterpret_cast<const char *>(GetCodes(vec_i, meta)), _MM_HINT_T0); }
+
+private:
+    u8 *GetCodesMut(SizeT idx, const Meta &meta) { return ptr_.get() + idx * meta.code_size(); }
+
+private:
+    UniquePtr<u8[]> ptr_;
+
+public:
+    void Dump(std::ostream &os, SizeT offset, SizeT chunk_size, const Meta &meta) const {
+        for (int i = 0; i < (int)chunk_size; ++i) {
+            os << "vec " << i << "(" << offset + i << "): ";
+            const u8 *codes = GetCodes(i, meta);
+            for (SizeT j = 0; j < meta.dim(); ++j) {
+                os << Meta::GetCode(codes, j) << " ";
+            }
+            os << std::endl;
+        }
+    }
+};
+
+} // namespace infinity
@@ -19,6 +19,8 @@ export module vec_store_type;
 import stl;
 import plain_vec_store;
 import lvq_vec_store;
+import sq_vec_store;
+import pq_vec_store;
 import dist_func_l2;
 import dist_func_ip;
 
@@ -70,4 +72,48 @@ public:
     using Distance = LVQIPDist<DataType, CompressType>;
 };
 
+export template <typename DataT, u32 Bits>
+class SQL2VecStoreType {
+public:
+    using DataType = DataT;
+    using Meta = SQVecStoreMeta<DataType, Bits>;
+    using Inner = SQVecStoreInner<DataType, Bits>;
+    using StoreType = typename Meta::StoreType;
+    using QueryType = typename Meta::QueryType;
+    using Distance = SQL2Dist<DataType, Bits>;
+};
+
+export template <typename DataT, u32 Bits>
+class SQIPVecStoreType {
+public:
+    using DataType = DataT;
+    using Meta = SQVecStoreMeta<DataType, Bits>;
+    using Inner = SQVecStoreInner<DataType, Bits>;
+    using StoreType = typename Meta::StoreType;
+    using QueryType = typename Meta::QueryType;
+    using Distance = SQIPDist<DataType, Bits>;
+};
+
+export template <typename DataT>
+class PQL2VecStoreType {
+public:
+    using DataType = DataT;
+    using Meta = PQVecStoreMeta<DataType, PQL2Table<DataType>>;
+    using Inner = PQVecStoreInner<DataType, PQL2Table<DataType>>;
+    using StoreType = typename Meta::StoreType;
+    using QueryType = typename Meta::QueryType;
+    using Distance = PQL2Dist<DataType>;
+};
+
+export template <typename DataT>
+class PQIPVecStoreType {
+public:
+    using DataType = DataT;
+    using Meta = PQVecStoreMeta<DataType, PQIPTable<DataType>>;
+    using Inner = PQVecStoreInner<DataType, PQIPTable<DataType>>;
+    using StoreType = typename Meta::StoreType;
+    using QueryType = typename Meta::QueryType;
+    using Distance = PQIPDist<DataType>;
+};
+
 } // namespace infinity
@@ -22,6 +22,8 @@ import hnsw_common;
 import hnsw_simd_func;
 import plain_vec_store;
 import lvq_vec_store;
+import sq_vec_store;
+import pq_vec_store;
 
 export module dist_func_ip;
 
@@ -50,27 +52,7 @@ public:
     ~PlainIPDist() = default;
     PlainIPDist(SizeT dim) {
         if constexpr (std::is_same<DataType, float>()) {
-#if defined(USE_AVX512)
-            if (dim % 16 == 0) {
-                SIMDFunc = F32IPAVX512;
-            } else {
-                SIMDFunc = F32IPAVX512Residual;
-            }
-#elif defined(USE_AVX)
-            if (dim % 16 == 0) {
-                SIMDFunc = F32IPAVX;
-            } else {
-                SIMDFunc = F32IPAVXResidual;
-            }
-#elif defined(USE_SSE)
-            if (dim % 16 == 0) {
-                SIMDFunc = F32IPSSE;
-            } else {
-                SIMDFunc = F32IPSSEResidual;
-            }
-#else
-            SIMDFunc = F32IPBF;
-#endif
+            SIMDFunc = GetF32IPFunc(dim);
         }
     }
 
@@ -140,27 +122,7 @@ public:
     ~LVQIPDist() = default;
     LVQIPDist(SizeT dim) {
         if constexpr (std::is_same<CompressType, i8>()) {
-#if defined(USE_AVX512)
-            if (dim % 16 == 0) {
-                SIMDFunc = I8IPAVX512;
-            } else {
-                SIMDFunc = I8IPAVX512Residual;
-            }
-#elif defined(USE_AVX)
-            if (dim % 16 == 0) {
-                SIMDFunc = I8IPAVX;
-            } else {
-                SIMDFunc = I8IPAVXResidual;
-            }
-#elif defined(USE_SSE)
-            if (dim % 16 == 0) {
-                SIMDFunc = I8IPSSE;
-            } else {
-                SIMDFunc = I8IPSSEResidual;
-            }
-#else
-            SIMDFunc = I8IPBF;
-#endif
+            SIMDFunc = GetI8IPFunc(dim);
         }
     }
 
@@ -180,4 +142,65 @@ public:
     }
 };
 
+export template <typename DataType, u32 Bits>
+class SQIPDist {
+public:
+    using This = SQIPDist<DataType, Bits>;
+    using VecStoreMeta = SQVecStoreMeta<DataType, Bits>;
+    using StoreType = typename VecStoreMeta::StoreType;
+
+public:
+    SQIPDist() = default;
+    SQIPDist(SizeT) {}
+
+    // The first vector is the query of a search or a vector of the store, the second one is always a vector of the store.
+    DataType operator()(const StoreType &v1, const StoreType &v2, const VecStoreMeta &vec_store_meta) const {
+        SizeT dim = vec_store_meta.dim();
+        const DataType *lower = vec_store_meta.lower();
+        const DataType *step = vec_store_meta.step();
+        DataType dist = 0;
+        if (v1.query_ != nullptr) {
+            for (SizeT j = 0; j < dim; ++j) {
+                dist += v1.query_[j] * (lower[j] + VecStoreMeta::GetCode(v2.codes_, j) * step[j]);
+            }
+        } else {
+            for (SizeT j = 0; j < dim; ++j) {
+                dist += (lower[j] + VecStoreMeta::GetCode(v1.codes_, j) * step[j]) * (lower[j] + VecStoreMeta::GetCode(v2.codes_, j) * step[j]);
+            }
+        }
+        return -dist;
+    }
+};
+
+export template <typename DataType>
+class PQIPTable {
+public:
+    static DataType SubDist(const DataType *v1, const DataType *v2, SizeT sub_dim) {
+        DataType ip = 0;
+        for (SizeT j = 0; j < sub_dim; ++j) {
+            ip += v1[j] * v2[j];
+        }
+        return -ip;
+    }
+};
+
+export template <typename DataType>
+class PQIPDist {
+public:
+    using This = PQIPDist<DataType>;
+    using VecStoreMeta = PQVecStoreMeta<DataType, PQIPTable<DataType>>;
+    using StoreType = typename VecStoreMeta::StoreType;
+
+public:
+    PQIPDist() = default;
+    PQIPDist(SizeT) {}
+
+    DataType operator()(const StoreType &v1, const StoreType &v2, const VecStoreMeta &vec_store_meta) const {
+        if (v1.lut_ != nullptr) {
+            return vec_store_meta.QueryDist(v1.lut_, v2.codes_);
+        }
+        return vec_store_meta.CodesDist(v1.codes_, v2.codes_);
+    }
+};
+
 } // namespace infinity
\ No newline at end of file
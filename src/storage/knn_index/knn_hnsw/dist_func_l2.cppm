@@ -22,6 +22,8 @@ import hnsw_common;
 import hnsw_simd_func;
 import plain_vec_store;
 import lvq_vec_store;
+import sq_vec_store;
+import pq_vec_store;
 
 export module dist_func_l2;
 
@@ -51,27 +53,7 @@ public:
 
     PlainL2Dist(SizeT dim) {
         if constexpr (std::is_same<DataType, float>()) {
-#if defined(USE_AVX512)
-            if (dim % 16 == 0) {
-                SIMDFunc = F32L2AVX512;
-            } else {
-                SIMDFunc = F32L2AVX512Residual;
-            }
-#elif defined(USE_AVX)
-            if (dim % 16 == 0) {
-                SIMDFunc = F32L2AVX;
-            } else {
-                SIMDFunc = F32L2AVXResidual;
-            }
-#elif defined(USE_SSE)
-            if (dim % 16 == 0) {
-                SIMDFunc = F32L2SSE;
-            } else {
-                SIMDFunc = F32L2SSEResidual;
-            }
-#else
-            SIMDFunc = F32IPBF;
-#endif
+            SIMDFunc = GetF32L2Func(dim);
         }
     }
 
@@ -131,27 +113,7 @@ public:
     ~LVQL2Dist() = default;
     LVQL2Dist(SizeT dim) {
         if constexpr (std::is_same<CompressType, i8>()) {
-#if defined(USE_AVX512)
-            if (dim % 64 == 0) {
-                SIMDFunc = I8IPAVX512;
-            } else {
-                SIMDFunc = I8IPAVX512Residual;
-            }
-#elif defined(USE_AVX)
-            if (dim % 32 == 0) {
-                SIMDFunc = I8IPAVX;
-            } else {
-                SIMDFunc = I8IPAVXResidual;
-            }
-#elif defined(USE_SSE)
-            if (dim % 16 == 0) {
-                SIMDFunc = I8IPSSE;
-            } else {
-                SIMDFunc = I8IPSSEResidual;
-            }
-#else
-            SIMDFunc = I8IPBF;
-#endif
+            SIMDFunc = GetI8IPFunc(dim);
         }
     }
 
@@ -169,4 +131,68 @@ public:
     }
 };
 
+export template <typename DataType, u32 Bits>
+class SQL2Dist {
+public:
+    using This = SQL2Dist<DataType, Bits>;
+    using VecStoreMeta = SQVecStoreMeta<DataType, Bits>;
+    using StoreType = typename VecStoreMeta::StoreType;
+
+public:
+    SQL2Dist() = default;
+    SQL2Dist(SizeT) {}
+
+    // The first vector is the query of a search or a vector of the store, the second one is always a vector of the store.
+    DataType operator()(const StoreType &v1, const StoreType &v2, const VecStoreMeta &vec_store_meta) const {
+        SizeT dim = vec_store_meta.dim();
+        const DataType *lower = vec_store_meta.lower();
+        const DataType *step = vec_store_meta.step();
+        DataType dist = 0;
+        if (v1.query_ != nullptr) {
+            for (SizeT j = 0; j < dim; ++j) {
+                DataType diff = v1.query_[j] - (lower[j] + VecStoreMeta::GetCode(v2.codes_, j) * step[j]);
+                dist += diff * diff;
+            }
+        } else {
+            for (SizeT j = 0; j < dim; ++j) {
+                DataType diff = (DataType(VecStoreMeta::GetCode(v1.codes_, j)) - DataType(VecStoreMeta::GetCode(v2.codes_, j))) * step[j];
+                dist += diff * diff;
+            }
+        }
+        return dist;
+    }
+};
+
+export template <typename DataType>
+class PQL2Table {
+public:
+    static DataType SubDist(const DataType *v1, const DataType *v2, SizeT sub_dim) {
+        DataType dist = 0;
+        for (SizeT j = 0; j < sub_dim; ++j) {
+            DataType diff = v1[j] - v2[j];
+            dist += diff * diff;
+        }
+        return dist;
+    }
+};
+
+export template <typename DataType>
+class PQL2Dist {
+public:
+    using This = PQL2Dist<DataType>;
+    using VecStoreMeta = PQVecStoreMeta<DataType, PQL2Table<DataType>>;
+    using StoreType = typename VecStoreMeta::StoreType;
+
+public:
+    PQL2Dist() = default;
+    PQL2Dist(SizeT) {}
+
+    DataType operator()(const StoreType &v1, const StoreType &v2, const VecStoreMeta &vec_store_meta) const {
+        if (v1.lut_ != nullptr) {
+            return vec_store_meta.QueryDist(v1.lut_, v2.codes_);
+        }
+        return vec_store_meta.CodesDist(v1.codes_, v2.codes_);
+    }
+};
+
 } // namespace infinity
\ No newline at end of file
@@ -2,13 +2,19 @@
 #ifndef NO_MANUAL_VECTORIZATION
 #if (defined(__SSE2__) || _M_IX86_FP > 0 || defined(_M_AMD64) || defined(_M_X64))
 #define USE_SSE
-#ifdef __AVX2__
+// The avx2 and avx512 kernels are compiled for their own target whatever the compiler flags are,
+// the kernel is chosen at runtime by the cpu features, see simd_init.
 #define USE_AVX
-#ifdef __AVX512F__
 #define USE_AVX512
 #endif
 #endif
-#endif
+
+#if defined(__GNUC__) && defined(USE_SSE)
+#define IMPL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define IMPL_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define IMPL_TARGET_AVX2
+#define IMPL_TARGET_AVX512
 #endif
 
 #if defined(USE_AVX) || defined(USE_SSE)
@@ -35,7 +41,7 @@
 // }
 #endif
 
-#if defined(USE_AVX512)
+#if defined(USE_SSE)
 #include <immintrin.h>
 #endif
 
@@ -113,19 +113,32 @@ public:
         return This(M, ef_construction, std::move(data_store), std::move(distance), 0, 0);
     }
 
+    static This Clone(const This &other) {
+        auto data_store = DataStore::Clone(other.data_store_);
+        Distance distance(data_store.dim());
+        return This(other.M_, other.ef_construction_, std::move(data_store), std::move(distance), 0, 0);
+    }
+
 private:
     // >= 0
     i32 GenerateRandomLayer() {
         std::uniform_real_distribution<double> distribution(0.0, 1.0);
-        auto r1 = distribution(level_rng_);
+        double r1 = 0;
+        {
+            // Build may run on several threads
+            std::unique_lock lock(level_rng_mutex_);
+            r1 = distribution(level_rng_);
+        }
         double r = -std::log(r1) * mult_;
         return static_cast<i32>(r);
     }
 
     // return the nearest `ef_construction_` neighbors of `query` in layer `layer_idx`
+    // With `filter_two_hop`, the distance of a neighbor rejected by the filter is not computed. Its own neighbors passing the filter are
+    // visited instead, so that the search still reaches the accepted vertices when most of the graph is filtered out.
     template <bool WithLock, FilterConcept<LabelType> Filter = NoneType>
     Tuple<SizeT, UniquePtr<DataType[]>, UniquePtr<VertexType[]>>
-    SearchLayer(VertexType enter_point, const StoreType &query, i32 layer_idx, SizeT result_n, const Filter &filter) const {
+    SearchLayer(VertexType enter_point, const StoreType &query, i32 layer_idx, SizeT result_n, const Filter &filter, bool filter_two_hop = false) const {
         auto d_ptr = MakeUniqueForOverwrite<DataType[]>(result_n);
         auto i_ptr = MakeUniqueForOverwrite<VertexType[]>(result_n);
         HeapResultHandler<CompareMax<DataType, VertexType>> result_handler(1, result_n, d_ptr.get(), i_ptr.get());
@@ -148,6 +161,21 @@ private:
         Vector<bool> visited(cur_vec_num, false);
         visited[enter_point] = true;
 
+        auto add_candidate = [&](VertexType n_idx, bool check_filter) {
+            auto dist = distance_(query, data_store_.GetVec(n_idx), data_store_.vec_store_meta());
+            if (result_handler.GetSize(0) < result_n || dist < result_handler.GetDistance0(0)) {
+                candidate.emplace(-dist, n_idx);
+                if constexpr (!std::is_same_v<Filter, NoneType>) {
+                    if (!check_filter || filter(GetLabel(n_idx))) {
+                        result_handler.AddResult(0, dist, n_idx);
+                    }
+                } else {
+                    result_handler.AddResult(0, dist, n_idx);
+                }
+            }
+        };
+
+        Vector<VertexType> filtered_out;
         while (!candidate.empty()) {
             const auto [minus_c_dist, c_idx] = candidate.top();
             candidate.pop();
@@ -155,36 +183,55 @@ private:
                 break;
             }
 
-            std::shared_lock<std::shared_mutex> lock;
-            if constexpr (WithLock) {
-                lock = data_store_.SharedLock(c_idx);
-            }
-
-            const auto [neighbors_p, neighbor_size] = data_store_.GetNeighbors(c_idx, layer_idx);
-            int prefetch_start = neighbor_size - 1 - prefetch_offset_;
-            for (int i = neighbor_size - 1; i >= 0; --i) {
-                VertexType n_idx = neighbors_p[i];
-                if (n_idx >= (VertexType)cur_vec_num || visited[n_idx]) {
-                    continue;
+            filtered_out.clear();
+            {
+                std::shared_lock<std::shared_mutex> lock;
+                if constexpr (WithLock) {
+                    lock = data_store_.SharedLock(c_idx);
                 }
-                visited[n_idx] = true;
-                if (prefetch_start >= 0) {
-                    int lower = std::max(0, prefetch_start - prefetch_step_);
-                    for (int i = prefetch_start; i >= lower; --i) {
-                        VertexType prefetch_idx = neighbors_p[i];
-                        data_store_.PrefetchVec(prefetch_idx);
+
+                const auto [neighbors_p, neighbor_size] = data_store_.GetNeighbors(c_idx, layer_idx);
+                int prefetch_start = neighbor_size - 1 - prefetch_offset_;
+                for (int i = neighbor_size - 1; i >= 0; --i) {
+                    VertexType n_idx = neighbors_p[i];
+                    if (n_idx >= (VertexType)cur_vec_num || visited[n_idx]) {
+                        continue;
+                    }
+                    visited[n_idx] = true;
+                    if (prefetch_start >= 0) {
+                        int lower = std::max(0, prefetch_start - prefetch_step_);
+                        for (int i = prefetch_start; i >= lower; --i) {
+                            VertexType prefetch_idx = neighbors_p[i];
+                            data_store_.PrefetchVec(prefetch_idx);
+                        }
+                        prefetch_start -= prefetch_step_;
                     }
-                    prefetch_start -= prefetch_step_;
-                }
-                auto dist = distance_(query, data_store_.GetVec(n_idx), data_store_.vec_store_meta());
-                if (result_handler.GetSize(0) < result_n || dist < result_handler.GetDistance0(0)) {
-                    candidate.emplace(-dist, n_idx);
                     if constexpr (!std::is_same_v<Filter, NoneType>) {
-                        if (filter(GetLabel(n_idx))) {
-                            result_handler.AddResult(0, dist, n_idx);
+                        if (filter_two_hop && !filter(GetLabel(n_idx))) {
+                            filtered_out.push_back(n_idx);
+                            continue;
                         }
-                    } else {
-                        result_handler.AddResult(0, dist, n_idx);
+                    }
+                    add_candidate(n_idx, !filter_two_hop);
+                }
+            }
+            if constexpr (!std::is_same_v<Filter, NoneType>) {
+                // The lock of c_idx is released before locking the filtered out neighbors, a vertex being built holds its own lock while
+                // locking its neighbors.
+                for (VertexType f_idx : filtered_out) {
+                    std::shared_lock<std::shared_mutex> lock;
+                    if constexpr (WithLock) {
+                        lock = data_store_.SharedLock(f_idx);
+                    }
+
+                    const auto [neighbors_p, neighbor_size] = data_store_.GetNeighbors(f_idx, layer_idx);
+                    for (int i = neighbor_size - 1; i >= 0; --i) {
+                        VertexType n_idx = neighbors_p[i];
+                        if (n_idx >= (VertexType)cur_vec_num || visited[n_idx] || !filter(GetLabel(n_idx))) {
+                            continue;
+                        }
+                        visited[n_idx] = true;
+                        add_candidate(n_idx, false);
                     }
                 }
             }
@@ -284,7 +331,12 @@ private:
     LabelType GetLabel(VertexType vertex_i) const { return data_store_.GetLabel(vertex_i); }
 
     template <bool WithLock, FilterConcept<LabelType> Filter = NoneType>
-    Tuple<SizeT, UniquePtr<DataType[]>, UniquePtr<VertexType[]>> KnnSearchInner(const DataType *q, SizeT k, const Filter &filter) const {
+    Tuple<SizeT, UniquePtr<DataType[]>, UniquePtr<VertexType[]>>
+    KnnSearchInner(const DataType *q, SizeT k, const Filter &filter, bool filter_two_hop = false) const {
+        std::shared_lock<std::shared_mutex> quantizer_lock;
+        if constexpr (WithLock) {
+            quantizer_lock = data_store_.SharedQuantizerLock();
+        }
         auto query = data_store_.MakeQuery(q);
         auto [max_layer, ep] = data_store_.GetEnterPoint();
         if (ep == -1) {
@@ -293,7 +345,7 @@ private:
         for (i32 cur_layer = max_layer; cur_layer > 0; --cur_layer) {
             ep = SearchLayerNearest<WithLock>(ep, query, cur_layer);
         }
-        return SearchLayer<WithLock, Filter>(ep, query, 0, std::max(k, ef_), filter);
+        return SearchLayer<WithLock, Filter>(ep, query, 0, std::max(k, ef_), filter, filter_two_hop);
     }
 
 public:
@@ -327,6 +379,46 @@ public:
         return StoreData(DenseVectorIter<DataType, LabelType>(query, data_store_.dim(), insert_n, offset), config);
     }
 
+    // Build vertices [start_i, end_i) on thread_n threads, each thread claims the next vertex from a shared counter.
+    // progress(built_n) is called by one thread at a time whenever another report_interval vertices are built.
+    template <typename Progress>
+    void ParallelBuild(VertexType start_i, VertexType end_i, SizeT thread_n, SizeT report_interval, Progress &&progress) {
+        if (start_i >= end_i) {
+            return;
+        }
+        thread_n = std::max<SizeT>(1, std::min<SizeT>(thread_n, end_i - start_i));
+        report_interval = std::max<SizeT>(1, report_interval);
+        Atomic<VertexType> next_i = start_i;
+        Atomic<SizeT> built_n = 0;
+        std::mutex progress_mutex;
+        auto build_func = [&] {
+            while (true) {
+                VertexType vertex_i = next_i.fetch_add(1);
+                if (vertex_i >= end_i) {
+                    break;
+                }
+                Build(vertex_i);
+                if (SizeT n = built_n.fetch_add(1) + 1; n % report_interval == 0) {
+                    std::unique_lock lock(progress_mutex);
+                    progress(n);
+                }
+            }
+        };
+        if (thread_n == 1) {
+            build_func();
+            return;
+        }
+        Vector<Thread> threads;
+        threads.reserve(thread_n - 1);
+        for (SizeT i = 0; i + 1 < thread_n; ++i) {
+            threads.emplace_back(build_func);
+        }
+        build_func();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
     void Build(VertexType vertex_i) {
         i32 q_layer = GenerateRandomLayer();
 
@@ -355,8 +447,9 @@ public:
     }
 
     template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
-    Tuple<SizeT, UniquePtr<DataType[]>, UniquePtr<LabelType[]>> KnnSearch(const DataType *q, SizeT k, const Filter &filter) const {
-        auto [result_n, d_ptr, v_ptr] = KnnSearchInner<WithLock, Filter>(q, k, filter);
+    Tuple<SizeT, UniquePtr<DataType[]>, UniquePtr<LabelType[]>>
+    KnnSearch(const DataType *q, SizeT k, const Filter &filter, bool filter_two_hop = false) const {
+        auto [result_n, d_ptr, v_ptr] = KnnSearchInner<WithLock, Filter>(q, k, filter, filter_two_hop);
         auto labels = MakeUniqueForOverwrite<LabelType[]>(result_n);
         for (SizeT i = 0; i < result_n; ++i) {
             labels[i] = GetLabel(v_ptr[i]);
@@ -371,8 +464,8 @@ public:
 
     // function for test, add sort for convenience
     template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
-    Vector<Pair<DataType, LabelType>> KnnSearchSorted(const DataType *q, SizeT k, const Filter &filter) const {
-        auto [result_n, d_ptr, v_ptr] = KnnSearchInner<WithLock, Filter>(q, k, filter);
+    Vector<Pair<DataType, LabelType>> KnnSearchSorted(const DataType *q, SizeT k, const Filter &filter, bool filter_two_hop = false) const {
+        auto [result_n, d_ptr, v_ptr] = KnnSearchInner<WithLock, Filter>(q, k, filter, filter_two_hop);
         Vector<Pair<DataType, LabelType>> result(result_n);
         for (SizeT i = 0; i < result_n; ++i) {
             result[i] = {d_ptr[i], GetLabel(v_ptr[i])};
@@ -396,6 +489,7 @@ private:
     // 1 / log(1.0 * M_)
     double mult_;
     std::default_random_engine level_rng_{};
+    std::mutex level_rng_mutex_{};
 
     DataStore data_store_;
     Distance distance_;
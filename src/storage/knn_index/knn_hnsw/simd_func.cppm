@@ -17,6 +17,7 @@ module;
 #include "header.h"
 
 import stl;
+import simd_init;
 
 export module hnsw_simd_func;
 
@@ -24,7 +25,7 @@ namespace infinity {
 
 // for debug
 template <typename T>
-void log_m256(const __m256i &value) {
+IMPL_TARGET_AVX2 void log_m256(const __m256i &value) {
     const size_t n = sizeof(__m256i) / sizeof(T);
     T buffer[n];
     _mm256_storeu_si256((__m256i_u *)buffer, value);
@@ -47,7 +48,7 @@ export int32_t I8IPBF(const int8_t *pv1, const int8_t *pv2, size_t dim) {
 }
 
 #if defined(USE_AVX512)
-export int32_t I8IPAVX512(const int8_t *pv1, const int8_t *pv2, size_t dim) {
+export IMPL_TARGET_AVX512 int32_t I8IPAVX512(const int8_t *pv1, const int8_t *pv2, size_t dim) {
     size_t dim64 = dim >> 6;
     const int8_t *pend1 = pv1 + (dim64 << 6);
 
@@ -73,13 +74,13 @@ export int32_t I8IPAVX512(const int8_t *pv1, const int8_t *pv2, size_t dim) {
     return _mm512_reduce_add_epi32(sum);
 }
 
-export int32_t I8IPAVX512Residual(const int8_t *pv1, const int8_t *pv2, size_t dim) {
+export IMPL_TARGET_AVX512 int32_t I8IPAVX512Residual(const int8_t *pv1, const int8_t *pv2, size_t dim) {
     return I8IPAVX512(pv1, pv2, dim) + I8IPBF(pv1 + (dim & ~63), pv2 + (dim & ~63), dim & 63);
 }
 #endif
 
 #if defined(USE_AVX)
-export int32_t I8IPAVX(const int8_t *pv1, const int8_t *pv2, size_t dim) {
+export IMPL_TARGET_AVX2 int32_t I8IPAVX(const int8_t *pv1, const int8_t *pv2, size_t dim) {
     size_t dim32 = dim >> 5;
     const int8_t *pend1 = pv1 + (dim32 << 5);
 
@@ -109,7 +110,7 @@ export int32_t I8IPAVX(const int8_t *pv1, const int8_t *pv2, size_t dim) {
     return _mm256_extract_epi32(sum, 0) + _mm256_extract_epi32(sum, 4);
 }
 
-export int32_t I8IPAVXResidual(const int8_t *pv1, const int8_t *pv2, size_t dim) {
+export IMPL_TARGET_AVX2 int32_t I8IPAVXResidual(const int8_t *pv1, const int8_t *pv2, size_t dim) {
     return I8IPAVX(pv1, pv2, dim) + I8IPBF(pv1 + (dim & ~31), pv2 + (dim & ~31), dim & 31);
 }
 
@@ -165,7 +166,7 @@ export float F32L2BF(const float *pv1, const float *pv2, size_t dim) {
 
 #if defined(USE_AVX512)
 
-export float F32L2AVX512(const float *pv1, const float *pv2, size_t dim) {
+export IMPL_TARGET_AVX512 float F32L2AVX512(const float *pv1, const float *pv2, size_t dim) {
     float PORTABLE_ALIGN64 TmpRes[16];
     size_t dim16 = dim >> 4;
 
@@ -191,7 +192,7 @@ export float F32L2AVX512(const float *pv1, const float *pv2, size_t dim) {
     return (res);
 }
 
-export float F32L2AVX512Residual(const float *pv1, const float *pv2, size_t dim) {
+export IMPL_TARGET_AVX512 float F32L2AVX512Residual(const float *pv1, const float *pv2, size_t dim) {
     return F32L2AVX512(pv1, pv2, dim) + F32L2BF(pv1 + (dim & ~15), pv2 + (dim & ~15), dim & 15);
 }
 
@@ -199,7 +200,7 @@ export float F32L2AVX512Residual(const float *pv1, const float *pv2, size_t dim)
 
 #if defined(USE_AVX)
 
-export float F32L2AVX(const float *pv1, const float *pv2, size_t dim) {
+export IMPL_TARGET_AVX2 float F32L2AVX(const float *pv1, const float *pv2, size_t dim) {
     float PORTABLE_ALIGN32 TmpRes[8];
     size_t dim16 = dim >> 4;
 
@@ -228,7 +229,7 @@ export float F32L2AVX(const float *pv1, const float *pv2, size_t dim) {
     return TmpRes[0] + TmpRes[1] + TmpRes[2] + TmpRes[3] + TmpRes[4] + TmpRes[5] + TmpRes[6] + TmpRes[7];
 }
 
-export float F32L2AVXResidual(const float *pv1, const float *pv2, size_t dim) {
+export IMPL_TARGET_AVX2 float F32L2AVXResidual(const float *pv1, const float *pv2, size_t dim) {
     return F32L2AVX(pv1, pv2, dim) + F32L2BF(pv1 + (dim & ~15), pv2 + (dim & ~15), dim & 15);
 }
 
@@ -295,7 +296,7 @@ export float F32IPBF(const float *pv1, const float *pv2, size_t dim) {
 
 #if defined(USE_AVX512)
 
-export float F32IPAVX512(const float *pVect1, const float *pVect2, SizeT qty) {
+export IMPL_TARGET_AVX512 float F32IPAVX512(const float *pVect1, const float *pVect2, SizeT qty) {
     float PORTABLE_ALIGN64 TmpRes[16];
 
     size_t qty16 = qty / 16;
@@ -321,7 +322,7 @@ export float F32IPAVX512(const float *pVect1, const float *pVect2, SizeT qty) {
     return sum;
 }
 
-export float F32IPAVX512Residual(const float *pVect1, const float *pVect2, SizeT qty) {
+export IMPL_TARGET_AVX512 float F32IPAVX512Residual(const float *pVect1, const float *pVect2, SizeT qty) {
     return F32IPAVX512(pVect1, pVect2, qty) + F32IPBF(pVect1 + (qty & ~15), pVect2 + (qty & ~15), qty & 15);
 }
 
@@ -329,7 +330,7 @@ export float F32IPAVX512Residual(const float *pVect1, const float *pVect2, SizeT
 
 #if defined(USE_AVX)
 
-export float F32IPAVX(const float *pVect1, const float *pVect2, SizeT qty) {
+export IMPL_TARGET_AVX2 float F32IPAVX(const float *pVect1, const float *pVect2, SizeT qty) {
     float PORTABLE_ALIGN32 TmpRes[8];
 
     size_t qty16 = qty / 16;
@@ -360,7 +361,7 @@ export float F32IPAVX(const float *pVect1, const float *pVect2, SizeT qty) {
     return sum;
 }
 
-export float F32IPAVXResidual(const float *pVect1, const float *pVect2, SizeT qty) {
+export IMPL_TARGET_AVX2 float F32IPAVXResidual(const float *pVect1, const float *pVect2, SizeT qty) {
     return F32IPAVX(pVect1, pVect2, qty) + F32IPBF(pVect1 + (qty & ~15), pVect2 + (qty & ~15), qty & 15);
 }
 
@@ -416,4 +417,58 @@ export float F32IPSSEResidual(const float *pVect1, const float *pVect2, SizeT qt
 
 #endif
 
+//------------------------------//------------------------------//------------------------------
+
+export using F32DistanceFunc = float (*)(const float *, const float *, SizeT);
+export using I8DistanceFunc = int32_t (*)(const int8_t *, const int8_t *, SizeT);
+
+// The kernels of the widest instruction set the cpu supports, the residual version if dim is not a multiple of the vector width.
+export F32DistanceFunc GetF32L2Func(SizeT dim) {
+#if defined(USE_SSE)
+    switch (GetSupportedSIMDLevel()) {
+        case SIMDLevel::kAVX512:
+            return dim % 16 == 0 ? F32L2AVX512 : F32L2AVX512Residual;
+        case SIMDLevel::kAVX2:
+            return dim % 16 == 0 ? F32L2AVX : F32L2AVXResidual;
+        case SIMDLevel::kSSE:
+            return dim % 16 == 0 ? F32L2SSE : F32L2SSEResidual;
+        default:
+            break;
+    }
+#endif
+    return F32L2BF;
+}
+
+export F32DistanceFunc GetF32IPFunc(SizeT dim) {
+#if defined(USE_SSE)
+    switch (GetSupportedSIMDLevel()) {
+        case SIMDLevel::kAVX512:
+            return dim % 16 == 0 ? F32IPAVX512 : F32IPAVX512Residual;
+        case SIMDLevel::kAVX2:
+            return dim % 16 == 0 ? F32IPAVX : F32IPAVXResidual;
+        case SIMDLevel::kSSE:
+            return dim % 16 == 0 ? F32IPSSE : F32IPSSEResidual;
+        default:
+            break;
+    }
+#endif
+    return F32IPBF;
+}
+
+export I8DistanceFunc GetI8IPFunc(SizeT dim) {
+#if defined(USE_SSE)
+    switch (GetSupportedSIMDLevel()) {
+        case SIMDLevel::kAVX512:
+            return dim % 64 == 0 ? I8IPAVX512 : I8IPAVX512Residual;
+        case SIMDLevel::kAVX2:
+            return dim % 32 == 0 ? I8IPAVX : I8IPAVXResidual;
+        case SIMDLevel::kSSE:
+            return dim % 16 == 0 ? I8IPSSE : I8IPSSEResidual;
+        default:
+            break;
+    }
+#endif
+    return I8IPBF;
+}
+
 } // namespace infinity
\ No newline at end of file
@@ -24,6 +24,7 @@ import infinity_exception;
 import bitmask;
 import default_values;
 import internal_types;
+import query_memory_tracker;
 
 namespace infinity {
 
@@ -39,8 +40,11 @@ class MergeKnn final : public MergeKnnBase {
 
 public:
     explicit MergeKnn(u64 query_count, u64 topk)
-        : total_count_(0), query_count_(query_count), topk_(topk), idx_array_(MakeUniqueForOverwrite<RowID[]>(topk * query_count)),
-          distance_array_(MakeUniqueForOverwrite<DataType[]>(topk * query_count)) {
+        : reservation_(QueryMemoryTracker::Current()), total_count_(0), query_count_(query_count), topk_(topk) {
+        // the result arrays and the reservoir of 2 * topk candidates per query
+        reservation_.Resize(3 * topk * query_count * (sizeof(RowID) + sizeof(DataType)));
+        idx_array_ = MakeUniqueForOverwrite<RowID[]>(topk * query_count);
+        distance_array_ = MakeUniqueForOverwrite<DataType[]>(topk * query_count);
         result_handler_ = MakeUnique<ResultHandler>(query_count, topk, this->distance_array_.get(), this->idx_array_.get());
     }
 
@@ -72,6 +76,7 @@ public:
     i64 total_count() const { return total_count_; }
 
 private:
+    MemoryReservation reservation_{};
     i64 total_count_{};
     bool begin_{false};
     u64 query_count_{};
@@ -53,6 +53,8 @@ import block_entry;
 import block_column_entry;
 import segment_index_entry;
 import log_file;
+import mem_index_appender;
+import default_values;
 
 namespace infinity {
 
@@ -64,9 +66,12 @@ Catalog::Catalog(SharedPtr<String> data_dir)
         fs.CreateDirectory(*catalog_dir_);
     }
     mem_index_commit_thread_ = Thread([this] { MemIndexCommitLoop(); });
+    mem_index_appender_ = MakeUnique<MemIndexAppender>(MEM_INDEX_APPEND_THREAD_NUM);
+    mem_index_appender_->Start();
 }
 
 Catalog::~Catalog() {
+    mem_index_appender_->Stop();
     bool expected = true;
     bool changed = running_.compare_exchange_strong(expected, false);
     if (!changed) {
@@ -346,6 +351,10 @@ Status Catalog::RollbackDelete(TableEntry *table_entry, TransactionID txn_id, De
     return table_entry->RollbackDelete(txn_id, append_state, buffer_mgr);
 }
 
+Status Catalog::Update(TableEntry *table_entry, TransactionID txn_id, void *txn_store, TxnTimeStamp commit_ts, Vector<UpdateState> &update_states) {
+    return table_entry->Update(txn_id, txn_store, commit_ts, update_states);
+}
+
 Status Catalog::CommitCompact(TableEntry *table_entry, TransactionID txn_id, TxnTimeStamp commit_ts, TxnCompactStore &compact_store) {
     return table_entry->CommitCompact(txn_id, commit_ts, compact_store);
 }
@@ -1004,6 +1013,8 @@ void Catalog::MemIndexCommitLoop() {
 }
 
 void Catalog::MemIndexRecover(BufferManager *buffer_manager) {
+    // Finish the insertions of the appends replayed from the wal before recovering the memory indexes.
+    mem_index_appender_->WaitAll();
     auto db_meta_map_guard = db_meta_map_.GetMetaMap();
     for (auto &[_, db_meta] : *db_meta_map_guard) {
         auto [db_entry, status] = db_meta->GetEntryNolock(0UL, MAX_TIMESTAMP);
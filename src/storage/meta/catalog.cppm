@@ -43,6 +43,7 @@ import base_entry;
 import meta_entry_interface;
 import cleanup_scanner;
 import log_file;
+import mem_index_appender;
 
 namespace infinity {
 
@@ -206,6 +207,8 @@ public:
 
     static Status RollbackDelete(TableEntry *table_entry, TransactionID txn_id, DeleteState &append_state, BufferManager *buffer_mgr);
 
+    static Status Update(TableEntry *table_entry, TransactionID txn_id, void *txn_store, TxnTimeStamp commit_ts, Vector<UpdateState> &update_states);
+
     static Status CommitCompact(TableEntry *table_entry, TransactionID txn_id, TxnTimeStamp commit_ts, TxnCompactStore &compact_store);
 
     static Status RollbackCompact(TableEntry *table_entry, TransactionID txn_id, TxnTimeStamp commit_ts, const TxnCompactStore &compact_store);
@@ -297,6 +300,7 @@ private: // TODO: remove this
 
     Atomic<bool> running_{};
     Thread mem_index_commit_thread_{};
+    UniquePtr<MemIndexAppender> mem_index_appender_{};
 
     void MemIndexCommit();
 
@@ -305,6 +309,8 @@ private: // TODO: remove this
 public:
     void MemIndexRecover(BufferManager *buffer_manager);
 
+    MemIndexAppender *mem_index_appender() const { return mem_index_appender_.get(); }
+
     void PickCleanup(CleanupScanner *scanner);
 
     // delta checkpoint info
@@ -32,9 +32,12 @@ import infinity_exception;
 import varchar_layout;
 import logger;
 import data_file_worker;
+import file_worker;
 import catalog_delta_entry;
 import internal_types;
 import data_type;
+import block_codec;
+import block_entry;
 
 namespace infinity {
 
@@ -57,7 +60,10 @@ UniquePtr<BlockColumnEntry> BlockColumnEntry::NewBlockColumnEntry(const BlockEnt
         // TODO
         total_data_size = (row_capacity + 7) / 8;
     }
-    auto file_worker = MakeUnique<DataFileWorker>(block_column_entry->base_dir_, block_column_entry->file_name_, total_data_size);
+    auto file_worker = MakeUnique<DataFileWorker>(block_column_entry->base_dir_,
+                                                  block_column_entry->file_name_,
+                                                  total_data_size,
+                                                  BlockCodec::EncodableElemSize(column_type->type()));
 
     auto *buffer_mgr = txn->buffer_mgr();
     block_column_entry->buffer_ = buffer_mgr->Allocate(std::move(file_worker));
@@ -79,7 +85,10 @@ UniquePtr<BlockColumnEntry> BlockColumnEntry::NewReplayBlockColumnEntry(const Bl
     DataType *column_type = column_entry->column_type_.get();
     SizeT row_capacity = block_entry->row_capacity();
     SizeT total_data_size = (column_type->type() == kBoolean) ? ((row_capacity + 7) / 8) : (row_capacity * column_type->Size());
-    auto file_worker = MakeUnique<DataFileWorker>(column_entry->base_dir_, column_entry->file_name_, total_data_size);
+    auto file_worker = MakeUnique<DataFileWorker>(column_entry->base_dir_,
+                                                  column_entry->file_name_,
+                                                  total_data_size,
+                                                  BlockCodec::EncodableElemSize(column_type->type()));
 
     column_entry->buffer_ = buffer_manager->Get(std::move(file_worker));
 
@@ -94,7 +103,9 @@ UniquePtr<BlockColumnEntry> BlockColumnEntry::NewReplayBlockColumnEntry(const Bl
     return column_entry;
 }
 
-ColumnVector BlockColumnEntry::GetColumnVector(BufferManager *buffer_mgr) {
+ColumnVector BlockColumnEntry::GetColumnVector(BufferManager *buffer_mgr) { return GetColumnVector(buffer_mgr, block_entry_->row_count()); }
+
+ColumnVector BlockColumnEntry::GetColumnVector(BufferManager *buffer_mgr, SizeT row_count) {
     if (this->buffer_ == nullptr) {
         // Get buffer handle from buffer manager
         auto file_worker = MakeUnique<DataFileWorker>(this->base_dir_, this->file_name_, 0);
@@ -102,10 +113,40 @@ ColumnVector BlockColumnEntry::GetColumnVector(BufferManager *buffer_mgr) {
     }
 
     ColumnVector column_vector(column_type_);
-    column_vector.Initialize(buffer_mgr, this, block_entry_->row_count());
+    column_vector.Initialize(buffer_mgr, this, row_count);
     return column_vector;
 }
 
+ColumnVector BlockColumnEntry::GetColumnVector(BufferManager *buffer_mgr, SizeT row_count, TxnTimeStamp check_ts) {
+    ColumnVector column_vector = GetColumnVector(buffer_mgr, row_count);
+    if (!block_entry_->HasColumnDelta(column_id_, check_ts)) {
+        return column_vector;
+    }
+    ColumnVector updated_vector(column_type_);
+    updated_vector.Initialize(ColumnVectorType::kFlat, column_vector.capacity());
+    updated_vector.AppendWith(column_vector, 0, row_count);
+    block_entry_->ApplyColumnDelta(column_id_, check_ts, 0, row_count, updated_vector.data());
+    return updated_vector;
+}
+
+void BlockColumnEntry::Prefetch(BufferManager *buffer_mgr) const {
+    buffer_mgr->Prefetch(buffer_);
+    std::shared_lock lock(mutex_);
+    for (BufferObj *outline_buffer : outline_buffers_) {
+        buffer_mgr->Prefetch(outline_buffer);
+    }
+}
+
+void BlockColumnEntry::AppendTo(BufferManager *buffer_mgr, TxnTimeStamp check_ts, BlockOffset block_offset, SizeT row_count, ColumnVector &output) {
+    ColumnVector column_vector = GetColumnVector(buffer_mgr);
+    SizeT output_offset = output.Size();
+    output.AppendWith(column_vector, block_offset, row_count);
+    if (block_entry_->HasColumnDelta(column_id_, check_ts)) {
+        SizeT elem_size = column_type_->Size();
+        block_entry_->ApplyColumnDelta(column_id_, check_ts, block_offset, block_offset + row_count, output.data() + output_offset * elem_size);
+    }
+}
+
 void BlockColumnEntry::Append(const ColumnVector *input_column_vector, u16 input_column_vector_offset, SizeT append_rows, BufferManager *buffer_mgr) {
     if (buffer_ == nullptr) {
         UnrecoverableError("Not initialize buffer handle");
@@ -229,6 +270,12 @@ void BlockColumnEntry::CommitColumn(TransactionID txn_id, TxnTimeStamp commit_ts
     }
 }
 
+void BlockColumnEntry::Seal() {
+    if (buffer_ != nullptr) {
+        static_cast<DataFileWorker *>(buffer_->file_worker())->Seal();
+    }
+}
+
 Vector<String> BlockColumnEntry::OutlinePaths() const {
     Vector<String> outline_paths;
     SizeT outline_file_count = 0;
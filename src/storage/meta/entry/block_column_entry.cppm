@@ -55,6 +55,9 @@ public:
 
     void CommitColumn(TransactionID txn_id, TxnTimeStamp commit_ts);
 
+    // Called when the segment is sealed, the following writes of the column data may be encoded.
+    void Seal();
+
 public:
     // Getter
     inline const BlockEntry *GetBlockEntry() const { return block_entry_; }
@@ -71,6 +74,19 @@ public:
 
     ColumnVector GetColumnVector(BufferManager *buffer_mgr);
 
+    // The column vector references the block memory directly and exposes the first row_count rows.
+    ColumnVector GetColumnVector(BufferManager *buffer_mgr, SizeT row_count);
+
+    // Same as above with the in place updates visible at check_ts applied.
+    // The updated rows are written to a copy of the column data, the block memory is referenced only if there is no such update.
+    ColumnVector GetColumnVector(BufferManager *buffer_mgr, SizeT row_count, TxnTimeStamp check_ts);
+
+    // Append the values of rows [block_offset, block_offset + row_count) visible at check_ts to output.
+    void AppendTo(BufferManager *buffer_mgr, TxnTimeStamp check_ts, BlockOffset block_offset, SizeT row_count, ColumnVector &output);
+
+    // Read the column data and its outline buffers in the background ahead of a scan.
+    void Prefetch(BufferManager *buffer_mgr) const;
+
     void AppendOutlineBuffer(BufferObj *buffer) {
         std::unique_lock lock(mutex_);
         outline_buffers_.emplace_back(buffer);
@@ -34,6 +34,8 @@ import segment_entry;
 import column_vector;
 import bitmask;
 import block_version;
+import column_delta_store;
+import data_block;
 import cleanup_scanner;
 
 namespace infinity {
@@ -89,45 +91,76 @@ Pair<BlockOffset, BlockOffset> BlockEntry::GetVisibleRange(TxnTimeStamp begin_ts
     std::shared_lock lock(rw_locker_);
     begin_ts = std::min(begin_ts, this->max_row_ts_);
     auto &block_version = this->block_version_;
-    auto &deleted = block_version->deleted_;
     BlockOffset block_offset_end = block_version->GetRowCount(begin_ts);
-    while (block_offset_begin < block_offset_end && deleted[block_offset_begin] != 0 && deleted[block_offset_begin] <= begin_ts) {
-        block_offset_begin++;
-    }
-    BlockOffset row_idx;
-    for (row_idx = block_offset_begin; row_idx < block_offset_end; ++row_idx) {
-        if (deleted[row_idx] != 0 && deleted[row_idx] <= begin_ts) {
-            break;
-        }
-    }
+    block_offset_begin = block_version->NextNotDeleted(block_offset_begin, block_offset_end, begin_ts);
+    BlockOffset row_idx = block_version->NextDeleted(block_offset_begin, block_offset_end, begin_ts);
     return {block_offset_begin, row_idx};
 }
 
 bool BlockEntry::CheckRowVisible(BlockOffset block_offset, TxnTimeStamp check_ts) const {
+    if (!CheckAnyDelete(check_ts)) {
+        return true;
+    }
     std::shared_lock lock(rw_locker_);
-    auto &block_version = this->block_version_;
-    auto &deleted = block_version->deleted_;
-    return deleted[block_offset] == 0 || deleted[block_offset] > check_ts;
+    return !block_version_->IsDeleted(block_offset, check_ts);
 }
 
 void BlockEntry::SetDeleteBitmask(TxnTimeStamp query_ts, Bitmask &bitmask) const {
-    BlockOffset read_offset = 0;
-    while (true) {
-        auto [row_begin, row_end] = GetVisibleRange(query_ts, read_offset);
-        if (row_begin == row_end) {
-            break;
-        }
-        for (BlockOffset offset = read_offset; offset < row_begin; ++offset) {
+    std::shared_lock lock(rw_locker_);
+    TxnTimeStamp check_ts = std::min(query_ts, this->max_row_ts_);
+    auto &block_version = this->block_version_;
+    BlockOffset visible_row_count = block_version->GetRowCount(check_ts);
+    if (CheckAnyDelete(check_ts)) {
+        for (BlockOffset offset = block_version->NextDeleted(0, visible_row_count, check_ts); offset < visible_row_count;
+             offset = block_version->NextDeleted(offset + 1, visible_row_count, check_ts)) {
             bitmask.SetFalse(offset);
         }
-        read_offset = row_end;
     }
-    // FIXME: read row_count_ is not thread safe
-    for (BlockOffset offset = read_offset; offset < row_count_; ++offset) {
+    for (BlockOffset offset = visible_row_count; offset < row_count_; ++offset) {
         bitmask.SetFalse(offset);
     }
 }
 
+bool BlockEntry::HasColumnDelta(ColumnID column_id, TxnTimeStamp check_ts) const {
+    if (!CheckAnyUpdate(check_ts)) {
+        return false;
+    }
+    std::shared_lock lock(rw_locker_);
+    return column_delta_store_.HasVisibleUpdate(column_id, check_ts);
+}
+
+void BlockEntry::ApplyColumnDelta(ColumnID column_id, TxnTimeStamp check_ts, BlockOffset begin, BlockOffset end, char *dest) const {
+    if (!CheckAnyUpdate(check_ts)) {
+        return;
+    }
+    std::shared_lock lock(rw_locker_);
+    column_delta_store_.Apply(column_id, check_ts, begin, end, dest);
+}
+
+void BlockEntry::PruneColumnDelta(TxnTimeStamp visible_ts) {
+    if (!CheckAnyUpdate(visible_ts)) {
+        return;
+    }
+    std::unique_lock lock(rw_locker_);
+    SizeT pruned_count = column_delta_store_.Prune(visible_ts);
+    if (pruned_count > 0) {
+        LOG_TRACE(fmt::format("Segment {} Block {} pruned {} update versions", this->segment_entry_->segment_id(), this->block_id_, pruned_count));
+    }
+}
+
+void BlockEntry::FoldDeletes(TxnTimeStamp visible_ts) {
+    std::unique_lock lock(rw_locker_);
+    // A checkpoint copies the folded deletes whatever their commit ts, only the deletes before the last one are folded.
+    TxnTimeStamp fold_ts = std::min(visible_ts, this->checkpoint_ts_);
+    if (!CheckAnyDelete(fold_ts)) {
+        return;
+    }
+    SizeT folded_count = block_version_->FoldDeletes(fold_ts);
+    if (folded_count > 0) {
+        LOG_TRACE(fmt::format("Segment {} Block {} folded {} deletes", this->segment_entry_->segment_id(), this->block_id_, folded_count));
+    }
+}
+
 u16 BlockEntry::AppendData(TransactionID txn_id,
                            TxnTimeStamp commit_ts,
                            DataBlock *input_data_block,
@@ -179,12 +212,46 @@ void BlockEntry::DeleteData(TransactionID txn_id, TxnTimeStamp commit_ts, const
 
     auto &block_version = this->block_version_;
     for (BlockOffset block_offset : rows) {
-        block_version->deleted_[block_offset] = commit_ts;
+        block_version->Delete(block_offset, commit_ts);
+    }
+    if (!rows.empty() && first_delete_ts_ == UNCOMMIT_TS) {
+        first_delete_ts_ = commit_ts;
     }
 
     LOG_TRACE(fmt::format("Segment {} Block {} has deleted {} rows", segment_id, block_id, rows.size()));
 }
 
+void BlockEntry::UpdateData(TransactionID txn_id,
+                            TxnTimeStamp commit_ts,
+                            const Vector<Pair<BlockOffset, u32>> &rows,
+                            const Vector<ColumnID> &column_ids,
+                            const DataBlock &values) {
+    std::unique_lock<std::shared_mutex> lck(this->rw_locker_);
+    if (this->using_txn_id_ != 0 && this->using_txn_id_ != txn_id) {
+        UnrecoverableError(
+            fmt::format("Multiple transactions are changing data of Segment: {}, Block: {}", this->segment_entry_->segment_id(), this->block_id_));
+    }
+
+    this->using_txn_id_ = txn_id;
+
+    for (SizeT i = 0; i < column_ids.size(); ++i) {
+        const ColumnVector &column_vector = *values.column_vectors[i];
+        SizeT elem_size = column_vector.data_type()->Size();
+        for (const auto &[block_offset, value_row] : rows) {
+            if (block_offset >= this->row_count_) {
+                UnrecoverableError(fmt::format("Update row {} exceed block row count {}", block_offset, this->row_count_));
+            }
+            column_delta_store_.Update(column_ids[i], block_offset, column_vector.data() + value_row * elem_size, elem_size, commit_ts);
+        }
+    }
+    if (!rows.empty() && first_update_ts_ == UNCOMMIT_TS) {
+        first_update_ts_ = commit_ts;
+    }
+    fast_rough_filter_.MarkUpdated(commit_ts);
+
+    LOG_TRACE(fmt::format("Segment {} Block {} has updated {} rows", this->segment_entry_->segment_id(), this->block_id_, rows.size()));
+}
+
 void BlockEntry::CommitBlock(TransactionID txn_id, TxnTimeStamp commit_ts) {
     std::unique_lock w_lock(this->rw_locker_);
 
@@ -234,7 +301,8 @@ void BlockEntry::Flush(TxnTimeStamp checkpoint_ts, bool check_commit) {
     }
     int checkpoint_row_count = 0;
 
-    BlockVersion checkpoint_version(this->block_version_->deleted_.size());
+    BlockVersion checkpoint_version(this->block_version_->capacity());
+    ColumnDeltaStore checkpoint_delta;
     {
         std::shared_lock<std::shared_mutex> lock(this->rw_locker_);
 
@@ -250,29 +318,26 @@ void BlockEntry::Flush(TxnTimeStamp checkpoint_ts, bool check_commit) {
             LOG_TRACE(fmt::format("Block entry {} is empty at checkpoint_ts {}", this->block_id_, checkpoint_ts));
             return;
         }
-        const Vector<TxnTimeStamp> &deleted = this->block_version_->deleted_;
         if (checkpoint_row_count <= this->checkpoint_row_count_) {
             // BlockEntry doesn't append rows between the previous checkpoint and checkpoint_ts.
-            bool deleted_between = false;
-            for (int i = 0; i < checkpoint_row_count; i++) {
-                if (deleted[i] > this->checkpoint_ts_ && deleted[i] <= checkpoint_ts) {
-                    deleted_between = true;
-                    break;
-                }
-            }
-            if (!deleted_between) // BlockEntry doesn't change between the previous checkpoint and checkpoint_ts.
+            if (!this->block_version_->HasDeleteBetween(this->checkpoint_ts_, checkpoint_ts) &&
+                !this->column_delta_store_.HasUpdateBetween(this->checkpoint_ts_, checkpoint_ts)) {
+                // BlockEntry doesn't change between the previous checkpoint and checkpoint_ts.
                 return;
+            }
         }
         checkpoint_version.created_ = this->block_version_->created_;
-        checkpoint_version.deleted_ = deleted;
-    }
-    for (int i = 0; i < checkpoint_row_count; i++) {
-        if (checkpoint_version.deleted_[i] > checkpoint_ts) {
-            checkpoint_version.deleted_[i] = 0;
-        }
+        checkpoint_version.CopyDeletes(*this->block_version_, checkpoint_ts);
+        checkpoint_delta.CopyUpdates(this->column_delta_store_, checkpoint_ts);
+        // Readers after a restart begin later than checkpoint_ts, only the newest version of each row is persisted, and no delete ts.
+        checkpoint_delta.Prune(checkpoint_ts);
+        checkpoint_version.FoldDeletes(checkpoint_ts);
     }
     LOG_TRACE("Block entry flush before flush version");
     FlushVersion(checkpoint_version);
+    if (!checkpoint_delta.Empty()) {
+        checkpoint_delta.SaveToFile(this->ColumnDeltaFilePath());
+    }
     LOG_TRACE("Block entry flush before flush data");
     FlushData(checkpoint_row_count);
     this->checkpoint_ts_ = checkpoint_ts;
@@ -291,6 +356,7 @@ void BlockEntry::Cleanup() {
         block_column_entry->Cleanup();
     }
     block_version_->Cleanup(this->VersionFilePath());
+    column_delta_store_.Cleanup(this->ColumnDeltaFilePath());
 
     CleanupScanner::CleanupDir(*block_dir_);
 }
@@ -349,6 +415,13 @@ UniquePtr<BlockEntry> BlockEntry::Deserialize(const nlohmann::json &block_entry_
     block_entry->txn_id_ = block_entry_json["txn_id"];
 
     block_entry->block_version_->LoadFromFile(block_entry->VersionFilePath());
+    block_entry->first_delete_ts_ = block_entry->block_version_->min_delete_ts();
+    block_entry->column_delta_store_.LoadFromFile(block_entry->ColumnDeltaFilePath());
+    if (!block_entry->column_delta_store_.Empty()) {
+        block_entry->first_update_ts_ = block_entry->column_delta_store_.min_update_ts();
+        block_entry->fast_rough_filter_.MarkUpdated(block_entry->first_update_ts_);
+        segment_entry->GetFastRoughFilter()->MarkUpdated(block_entry->first_update_ts_);
+    }
     if (block_entry->block_version_->created_.empty()) {
         block_entry->block_version_->created_.emplace_back(block_entry->max_row_ts_, block_entry->row_count_);
     }
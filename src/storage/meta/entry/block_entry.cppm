@@ -27,6 +27,7 @@ import internal_types;
 import base_entry;
 import block_column_entry;
 import block_version;
+import column_delta_store;
 import fast_rough_filter;
 import value;
 
@@ -88,6 +89,12 @@ protected:
 
     void DeleteData(TransactionID txn_id, TxnTimeStamp commit_ts, const Vector<BlockOffset> &rows);
 
+    void UpdateData(TransactionID txn_id,
+                    TxnTimeStamp commit_ts,
+                    const Vector<Pair<BlockOffset, u32>> &rows,
+                    const Vector<ColumnID> &column_ids,
+                    const DataBlock &values);
+
     void CommitBlock(TransactionID txn_id, TxnTimeStamp commit_ts);
 
     static SharedPtr<String> DetermineDir(const String &parent_dir, BlockID block_id);
@@ -127,12 +134,31 @@ public:
 
     bool CheckRowVisible(BlockOffset block_offset, TxnTimeStamp check_ts) const;
 
+    // Summary of the deletes, false if every row of the block is visible at check_ts regarding deletes.
+    bool CheckAnyDelete(TxnTimeStamp check_ts) const { return first_delete_ts_ <= check_ts; }
+
     void SetDeleteBitmask(TxnTimeStamp query_ts, Bitmask &bitmask) const;
 
+    // Summary of the in place updates, false if no column value of the block is updated at check_ts.
+    bool CheckAnyUpdate(TxnTimeStamp check_ts) const { return first_update_ts_ <= check_ts; }
+
+    bool HasColumnDelta(ColumnID column_id, TxnTimeStamp check_ts) const;
+
+    // Overwrite the values of rows [begin, end) in dest with the updates visible at check_ts, dest[0] holds the value of row `begin`.
+    void ApplyColumnDelta(ColumnID column_id, TxnTimeStamp check_ts, BlockOffset begin, BlockOffset end, char *dest) const;
+
+    // Drop the in place update versions hidden from every reader at or after visible_ts.
+    void PruneColumnDelta(TxnTimeStamp visible_ts);
+
+    // Drop the commit ts of the deletes seen by every reader at or after visible_ts and already persisted by a checkpoint.
+    void FoldDeletes(TxnTimeStamp visible_ts);
+
     i32 GetAvailableCapacity();
 
     String VersionFilePath() { return LocalFileSystem::ConcatenateFilePath(*block_dir_, String(BlockVersion::PATH)); }
 
+    String ColumnDeltaFilePath() { return LocalFileSystem::ConcatenateFilePath(*block_dir_, String(ColumnDeltaStore::PATH)); }
+
     const SharedPtr<DataType> GetColumnType(u64 column_id) const;
 
     Vector<UniquePtr<BlockColumnEntry>> &columns() { return columns_; }
@@ -167,6 +193,11 @@ protected:
 
     TransactionID using_txn_id_{0}; // Temporarily used to lock the modification to block entry.
 
+    Atomic<TxnTimeStamp> first_delete_ts_{UNCOMMIT_TS}; // Indicate the first delete commit ts. If not delete, it is UNCOMMIT_TS
+
+    ColumnDeltaStore column_delta_store_{};
+    Atomic<TxnTimeStamp> first_update_ts_{UNCOMMIT_TS}; // Indicate the first in place update commit ts. If not update, it is UNCOMMIT_TS
+
     // checkpoint state
     u16 checkpoint_row_count_{0};
 
@@ -14,6 +14,7 @@
 
 module;
 
+#include <bit>
 #include <fstream>
 
 module block_version;
@@ -25,21 +26,22 @@ import third_party;
 
 import serialize;
 import local_file_system;
+import default_values;
 
 namespace infinity {
 
+namespace {
+enum class DeleteContainer : u8 { kArray = 0, kBitmap = 1 };
+} // namespace
+
 bool BlockVersion::operator==(const BlockVersion &rhs) const {
-    if (this->created_.size() != rhs.created_.size() || this->deleted_.size() != rhs.deleted_.size())
+    if (this->created_.size() != rhs.created_.size() || this->capacity_ != rhs.capacity_)
         return false;
     for (SizeT i = 0; i < this->created_.size(); i++) {
         if (this->created_[i] != rhs.created_[i])
             return false;
     }
-    for (SizeT i = 0; i < this->deleted_.size(); i++) {
-        if (this->deleted_[i] != rhs.deleted_[i])
-            return false;
-    }
-    return true;
+    return this->deleted_bitmap_ == rhs.deleted_bitmap_ && this->delete_ts_ == rhs.delete_ts_ && this->folded_ts_ == rhs.folded_ts_;
 }
 
 i32 BlockVersion::GetRowCount(TxnTimeStamp begin_ts) {
@@ -55,6 +57,142 @@ i32 BlockVersion::GetRowCount(TxnTimeStamp begin_ts) {
     return created_[idx].row_count_;
 }
 
+void BlockVersion::SetBit(BlockOffset block_offset, TxnTimeStamp commit_ts) {
+    u64 &word = deleted_bitmap_[block_offset / 64];
+    u64 mask = u64(1) << (block_offset % 64);
+    if (word & mask) {
+        // e.g. the delete is replayed from wal after being loaded from the version file
+        return;
+    }
+    word |= mask;
+    if (commit_ts > folded_ts_) {
+        delete_ts_.emplace(block_offset, commit_ts);
+    }
+    ++delete_count_;
+    min_delete_ts_ = std::min(min_delete_ts_, commit_ts);
+    max_delete_ts_ = std::max(max_delete_ts_, commit_ts);
+}
+
+void BlockVersion::Delete(BlockOffset block_offset, TxnTimeStamp commit_ts) {
+    if (block_offset >= capacity_) {
+        UnrecoverableError(fmt::format("Delete row {} out of block capacity {}.", block_offset, capacity_));
+    }
+    SetBit(block_offset, commit_ts);
+}
+
+TxnTimeStamp BlockVersion::DeleteTS(BlockOffset block_offset) const {
+    if (!TestBit(block_offset)) {
+        return 0;
+    }
+    return RowDeleteTS(block_offset);
+}
+
+bool BlockVersion::IsDeleted(BlockOffset block_offset, TxnTimeStamp check_ts) const {
+    if (NoDeleteVisible(check_ts) || !TestBit(block_offset)) {
+        return false;
+    }
+    return check_ts >= max_delete_ts_ || RowDeleteTS(block_offset) <= check_ts;
+}
+
+BlockOffset BlockVersion::NextDeleted(BlockOffset begin, BlockOffset end, TxnTimeStamp check_ts) const {
+    if (begin >= end || NoDeleteVisible(check_ts)) {
+        return end;
+    }
+    bool all_visible = check_ts >= max_delete_ts_;
+    for (SizeT word_idx = begin / 64; word_idx * 64 < end; ++word_idx) {
+        u64 word = deleted_bitmap_[word_idx];
+        if (word_idx == begin / 64) {
+            word &= ~u64(0) << (begin % 64);
+        }
+        while (word != 0) {
+            SizeT offset = word_idx * 64 + std::countr_zero(word);
+            if (offset >= end) {
+                return end;
+            }
+            if (all_visible || RowDeleteTS(offset) <= check_ts) {
+                return offset;
+            }
+            word &= word - 1;
+        }
+    }
+    return end;
+}
+
+BlockOffset BlockVersion::NextNotDeleted(BlockOffset begin, BlockOffset end, TxnTimeStamp check_ts) const {
+    if (begin >= end || NoDeleteVisible(check_ts)) {
+        return begin;
+    }
+    bool all_visible = check_ts >= max_delete_ts_;
+    for (SizeT word_idx = begin / 64; word_idx * 64 < end; ++word_idx) {
+        // bits set for the rows which are not deleted
+        u64 word = ~deleted_bitmap_[word_idx];
+        if (!all_visible) {
+            for (u64 deleted = deleted_bitmap_[word_idx]; deleted != 0; deleted &= deleted - 1) {
+                SizeT offset = word_idx * 64 + std::countr_zero(deleted);
+                if (RowDeleteTS(offset) > check_ts) {
+                    word |= u64(1) << (offset % 64);
+                }
+            }
+        }
+        if (word_idx == begin / 64) {
+            word &= ~u64(0) << (begin % 64);
+        }
+        if (word != 0) {
+            SizeT offset = word_idx * 64 + std::countr_zero(word);
+            return std::min(offset, SizeT(end));
+        }
+    }
+    return end;
+}
+
+bool BlockVersion::HasDeleteBetween(TxnTimeStamp begin_ts, TxnTimeStamp end_ts) const {
+    if (delete_count_ == 0 || max_delete_ts_ <= begin_ts || min_delete_ts_ > end_ts) {
+        return false;
+    }
+    if (delete_ts_.size() < delete_count_ && folded_ts_ > begin_ts) {
+        // some folded delete may be committed after begin_ts
+        return true;
+    }
+    for (const auto &[block_offset, delete_ts] : delete_ts_) {
+        if (delete_ts > begin_ts && delete_ts <= end_ts) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BlockVersion::CopyDeletes(const BlockVersion &other, TxnTimeStamp check_ts) {
+    // The commit ts of a folded delete is lost, it is copied whatever check_ts. The block folds deletes up to its last checkpoint only,
+    // so they are all committed no later than check_ts at the next checkpoint.
+    folded_ts_ = std::max(folded_ts_, other.folded_ts_);
+    for (SizeT word_idx = 0; word_idx < other.deleted_bitmap_.size(); ++word_idx) {
+        for (u64 word = other.deleted_bitmap_[word_idx]; word != 0; word &= word - 1) {
+            BlockOffset block_offset = word_idx * 64 + std::countr_zero(word);
+            TxnTimeStamp delete_ts = other.RowDeleteTS(block_offset);
+            if (delete_ts <= check_ts || delete_ts <= other.folded_ts_) {
+                SetBit(block_offset, delete_ts);
+            }
+        }
+    }
+}
+
+SizeT BlockVersion::FoldDeletes(TxnTimeStamp visible_ts) {
+    if (visible_ts <= folded_ts_ || visible_ts < min_delete_ts_) {
+        return 0;
+    }
+    folded_ts_ = visible_ts;
+    SizeT folded_count = 0;
+    for (auto iter = delete_ts_.begin(); iter != delete_ts_.end();) {
+        if (iter->second <= visible_ts) {
+            iter = delete_ts_.erase(iter);
+            ++folded_count;
+        } else {
+            ++iter;
+        }
+    }
+    return folded_count;
+}
+
 void BlockVersion::LoadFromFile(const String &version_path) {
     std::ifstream ifs(version_path);
     if (!ifs.is_open()) {
@@ -70,27 +208,110 @@ void BlockVersion::LoadFromFile(const String &version_path) {
     i32 created_size = ReadBufAdv<i32>(ptr);
     i32 deleted_size = ReadBufAdv<i32>(ptr);
     created_.resize(created_size);
-    deleted_.resize(deleted_size);
     std::memcpy(created_.data(), ptr, created_size * sizeof(CreateField));
     ptr += created_size * sizeof(CreateField);
-    std::memcpy(deleted_.data(), ptr, deleted_size * sizeof(TxnTimeStamp));
-    ptr += deleted_.size() * sizeof(TxnTimeStamp);
+
+    delete_ts_.clear();
+    folded_ts_ = 0;
+    delete_count_ = 0;
+    min_delete_ts_ = UNCOMMIT_TS;
+    max_delete_ts_ = 0;
+    if (deleted_size >= 0) {
+        // Legacy format: a commit ts for each row, 0 if the row isn't deleted.
+        capacity_ = deleted_size;
+        deleted_bitmap_.assign((capacity_ + 63) / 64, 0);
+        for (i32 i = 0; i < deleted_size; ++i) {
+            TxnTimeStamp delete_ts = ReadBufAdv<TxnTimeStamp>(ptr);
+            if (delete_ts != 0) {
+                SetBit(i, delete_ts);
+            }
+        }
+    } else {
+        capacity_ = -deleted_size;
+        deleted_bitmap_.assign((capacity_ + 63) / 64, 0);
+        i32 delete_count = ReadBufAdv<i32>(ptr);
+        auto container = static_cast<DeleteContainer>(ReadBufAdv<u8>(ptr));
+        Vector<BlockOffset> deleted_rows;
+        deleted_rows.reserve(delete_count);
+        if (container == DeleteContainer::kArray) {
+            for (i32 i = 0; i < delete_count; ++i) {
+                deleted_rows.push_back(ReadBufAdv<BlockOffset>(ptr));
+            }
+        } else {
+            for (SizeT word_idx = 0; word_idx < deleted_bitmap_.size(); ++word_idx) {
+                for (u64 word = ReadBufAdv<u64>(ptr); word != 0; word &= word - 1) {
+                    deleted_rows.push_back(word_idx * 64 + std::countr_zero(word));
+                }
+            }
+        }
+        if ((i32)deleted_rows.size() != delete_count) {
+            UnrecoverableError(fmt::format("Failed to load block_version file: {}, delete count mismatch", version_path));
+        }
+        folded_ts_ = ReadBufAdv<TxnTimeStamp>(ptr);
+        HashMap<BlockOffset, TxnTimeStamp> delete_ts;
+        i32 delete_ts_count = ReadBufAdv<i32>(ptr);
+        for (i32 i = 0; i < delete_ts_count; ++i) {
+            BlockOffset block_offset = ReadBufAdv<BlockOffset>(ptr);
+            delete_ts.emplace(block_offset, ReadBufAdv<TxnTimeStamp>(ptr));
+        }
+        for (BlockOffset block_offset : deleted_rows) {
+            auto iter = delete_ts.find(block_offset);
+            SetBit(block_offset, iter == delete_ts.end() ? folded_ts_ : iter->second);
+        }
+        if (delete_ts_.size() != delete_ts.size()) {
+            UnrecoverableError(fmt::format("Failed to load block_version file: {}, delete ts mismatch", version_path));
+        }
+    }
     if (ptr - buf.data() != buf_len) {
         UnrecoverableError(fmt::format("Failed to load block_version file: {}", version_path));
     }
 }
 
 void BlockVersion::SaveToFile(const String &version_path) {
+    // File structure:
+    // - created size, negative capacity (the legacy format stores the count of per row ts here)
+    // - created fields
+    // - delete count, container type and deleted rows, as an array of row offsets or as the bitmap, whichever is smaller
+    // - folded ts, count of the deletes which aren't folded, and (row offset, commit ts) of each of them
+    Vector<BlockOffset> deleted_rows;
+    deleted_rows.reserve(delete_count_);
+    for (SizeT word_idx = 0; word_idx < deleted_bitmap_.size(); ++word_idx) {
+        for (u64 word = deleted_bitmap_[word_idx]; word != 0; word &= word - 1) {
+            deleted_rows.push_back(word_idx * 64 + std::countr_zero(word));
+        }
+    }
+    DeleteContainer container = deleted_rows.size() * sizeof(BlockOffset) < deleted_bitmap_.size() * sizeof(u64) ? DeleteContainer::kArray
+                                                                                                                  : DeleteContainer::kBitmap;
     i32 exp_size = sizeof(i32) + created_.size() * sizeof(CreateField);
-    exp_size += sizeof(i32) + deleted_.size() * sizeof(TxnTimeStamp);
+    exp_size += sizeof(i32) + sizeof(i32) + sizeof(u8);
+    exp_size += container == DeleteContainer::kArray ? deleted_rows.size() * sizeof(BlockOffset) : deleted_bitmap_.size() * sizeof(u64);
+    exp_size += sizeof(TxnTimeStamp) + sizeof(i32) + delete_ts_.size() * (sizeof(BlockOffset) + sizeof(TxnTimeStamp));
     Vector<char> buf(exp_size, 0);
     char *ptr = buf.data();
     WriteBufAdv<i32>(ptr, i32(created_.size()));
-    WriteBufAdv<i32>(ptr, i32(deleted_.size()));
+    WriteBufAdv<i32>(ptr, -i32(capacity_));
     std::memcpy(ptr, created_.data(), created_.size() * sizeof(CreateField));
     ptr += created_.size() * sizeof(CreateField);
-    std::memcpy(ptr, deleted_.data(), deleted_.size() * sizeof(TxnTimeStamp));
-    ptr += deleted_.size() * sizeof(TxnTimeStamp);
+    WriteBufAdv<i32>(ptr, i32(deleted_rows.size()));
+    WriteBufAdv<u8>(ptr, static_cast<u8>(container));
+    if (container == DeleteContainer::kArray) {
+        for (BlockOffset block_offset : deleted_rows) {
+            WriteBufAdv<BlockOffset>(ptr, block_offset);
+        }
+    } else {
+        for (u64 word : deleted_bitmap_) {
+            WriteBufAdv<u64>(ptr, word);
+        }
+    }
+    WriteBufAdv<TxnTimeStamp>(ptr, folded_ts_);
+    WriteBufAdv<i32>(ptr, i32(delete_ts_.size()));
+    for (BlockOffset block_offset : deleted_rows) {
+        auto iter = delete_ts_.find(block_offset);
+        if (iter != delete_ts_.end()) {
+            WriteBufAdv<BlockOffset>(ptr, block_offset);
+            WriteBufAdv<TxnTimeStamp>(ptr, iter->second);
+        }
+    }
     if (ptr - buf.data() != exp_size) {
         UnrecoverableError(fmt::format("Failed to save block_version file: {}", version_path));
     }
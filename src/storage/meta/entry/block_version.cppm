@@ -17,6 +17,7 @@ module;
 export module block_version;
 
 import stl;
+import default_values;
 
 namespace infinity {
 
@@ -31,10 +32,13 @@ struct CreateField {
     bool operator!=(const CreateField &rhs) const { return !(*this == rhs); }
 };
 
+// Deleted rows are kept in a bitmap, the commit ts of the deletes in a side table keyed by the deleted rows.
+// A row deleted after the begin ts of a reader is still visible to it.
+// Deletes committed no later than folded_ts_ are deleted for every reader, they are only kept in the bitmap.
 export struct BlockVersion {
     constexpr static std::string_view PATH = "version";
 
-    explicit BlockVersion(SizeT capacity) : deleted_(capacity, 0) {}
+    explicit BlockVersion(SizeT capacity) : capacity_(capacity), deleted_bitmap_((capacity + 63) / 64, 0) {}
     bool operator==(const BlockVersion &rhs) const;
     bool operator!=(const BlockVersion &rhs) const { return !(*this == rhs); };
     i32 GetRowCount(TxnTimeStamp begin_ts);
@@ -43,9 +47,62 @@ export struct BlockVersion {
 
     void Cleanup(const String &version_path);
 
+    void Delete(BlockOffset block_offset, TxnTimeStamp commit_ts);
+
+    // Commit ts of the delete, 0 if the row isn't deleted, folded_ts if the delete is folded.
+    TxnTimeStamp DeleteTS(BlockOffset block_offset) const;
+
+    bool IsDeleted(BlockOffset block_offset, TxnTimeStamp check_ts) const;
+
+    // No delete is visible at check_ts, visibility check of each row can be skipped.
+    bool NoDeleteVisible(TxnTimeStamp check_ts) const { return delete_count_ == 0 || check_ts < min_delete_ts_; }
+
+    // First row in [begin, end) which is deleted at check_ts, end if there isn't.
+    BlockOffset NextDeleted(BlockOffset begin, BlockOffset end, TxnTimeStamp check_ts) const;
+
+    // First row in [begin, end) which is not deleted at check_ts, end if there isn't.
+    BlockOffset NextNotDeleted(BlockOffset begin, BlockOffset end, TxnTimeStamp check_ts) const;
+
+    // Any delete committed in (begin_ts, end_ts].
+    bool HasDeleteBetween(TxnTimeStamp begin_ts, TxnTimeStamp end_ts) const;
+
+    // Copy the deletes of other which are committed no later than check_ts, and all of its folded deletes.
+    void CopyDeletes(const BlockVersion &other, TxnTimeStamp check_ts);
+
+    // Drop the commit ts of the deletes committed no later than visible_ts, no reader at or after visible_ts can tell them apart.
+    // Return the count of the dropped commit ts.
+    SizeT FoldDeletes(TxnTimeStamp visible_ts);
+
+    SizeT capacity() const { return capacity_; }
+
+    SizeT delete_count() const { return delete_count_; }
+
+    TxnTimeStamp min_delete_ts() const { return min_delete_ts_; }
+
+    TxnTimeStamp folded_ts() const { return folded_ts_; }
+
     Vector<CreateField> created_{}; // second field width is same as timestamp, otherwise Valgrind will issue BlockVersion::SaveToFile has
                                     // risk to write uninitialized buffer. (ts, rows)
-    Vector<TxnTimeStamp> deleted_{};
+
+private:
+    bool TestBit(BlockOffset block_offset) const { return (deleted_bitmap_[block_offset / 64] >> (block_offset % 64)) & 1; }
+
+    void SetBit(BlockOffset block_offset, TxnTimeStamp commit_ts);
+
+    // Commit ts of a deleted row.
+    TxnTimeStamp RowDeleteTS(BlockOffset block_offset) const {
+        auto iter = delete_ts_.find(block_offset);
+        return iter == delete_ts_.end() ? folded_ts_ : iter->second;
+    }
+
+private:
+    SizeT capacity_{};
+    Vector<u64> deleted_bitmap_{};
+    HashMap<BlockOffset, TxnTimeStamp> delete_ts_{};
+    SizeT delete_count_{};
+    TxnTimeStamp min_delete_ts_{UNCOMMIT_TS};
+    TxnTimeStamp max_delete_ts_{0};
+    TxnTimeStamp folded_ts_{0};
 };
 
 } // namespace infinity
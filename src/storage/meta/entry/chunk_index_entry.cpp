@@ -37,6 +37,7 @@ import buffer_obj;
 import buffer_handle;
 import infinity_exception;
 import index_defines;
+import norm_quantizer;
 
 namespace infinity {
 
@@ -122,6 +123,19 @@ SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewReplayChunkIndexEntry(ChunkID chu
 
 BufferHandle ChunkIndexEntry::GetIndex() { return buffer_obj_->Load(); }
 
+const u8 *ChunkIndexEntry::GetNorms() {
+    std::scoped_lock lock(norms_mutex_);
+    if (norms_.size() != row_count_) {
+        BufferHandle handle = GetIndex();
+        const u32 *column_lengths = (const u32 *)handle.GetData();
+        norms_.resize(row_count_);
+        for (u32 i = 0; i < row_count_; ++i) {
+            norms_[i] = EncodeNorm(column_lengths[i]);
+        }
+    }
+    return norms_.data();
+}
+
 nlohmann::json ChunkIndexEntry::Serialize() {
     nlohmann::json index_entry_json;
     index_entry_json["chunk_id"] = this->chunk_id_;
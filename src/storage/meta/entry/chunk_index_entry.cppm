@@ -85,6 +85,10 @@ public:
 
     BufferObj *GetBufferObj() { return buffer_obj_; }
 
+    // The 1-byte quantized column lengths of a full-text chunk, see norm_quantizer.
+    // Built from the column length file on first use and kept in memory since the chunk is immutable.
+    const u8 *GetNorms();
+
     void DeprecateChunk(TxnTimeStamp commit_ts) { deprecate_ts_.store(commit_ts); }
 
     bool CheckVisible(TxnTimeStamp ts) {
@@ -109,6 +113,9 @@ public:
 
 private:
     BufferObj *buffer_obj_{};
+
+    std::mutex norms_mutex_{};
+    Vector<u8> norms_{};
 };
 
 } // namespace infinity
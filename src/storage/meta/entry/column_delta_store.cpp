@@ -0,0 +1,276 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <fstream>
+
+module column_delta_store;
+
+import stl;
+import infinity_exception;
+import logger;
+import third_party;
+
+import serialize;
+import local_file_system;
+import default_values;
+import data_type;
+import logical_type;
+
+namespace infinity {
+
+bool ColumnDeltaStore::Supported(const DataType &data_type) {
+    switch (data_type.type()) {
+        case LogicalType::kTinyInt:
+        case LogicalType::kSmallInt:
+        case LogicalType::kInteger:
+        case LogicalType::kBigInt:
+        case LogicalType::kFloat:
+        case LogicalType::kDouble:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+        case LogicalType::kDateTime:
+        case LogicalType::kTimestamp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool ColumnDeltaStore::operator==(const ColumnDeltaStore &rhs) const {
+    if (columns_.size() != rhs.columns_.size()) {
+        return false;
+    }
+    for (const auto &[column_id, column_delta] : columns_) {
+        auto iter = rhs.columns_.find(column_id);
+        if (iter == rhs.columns_.end()) {
+            return false;
+        }
+        const ColumnDelta &rhs_delta = iter->second;
+        if (column_delta.elem_size_ != rhs_delta.elem_size_ || column_delta.rows_.size() != rhs_delta.rows_.size()) {
+            return false;
+        }
+        for (const auto &[block_offset, versions] : column_delta.rows_) {
+            auto row_iter = rhs_delta.rows_.find(block_offset);
+            if (row_iter == rhs_delta.rows_.end() || row_iter->second.size() != versions.size()) {
+                return false;
+            }
+            for (SizeT i = 0; i < versions.size(); ++i) {
+                const RowVersion &rhs_version = row_iter->second[i];
+                if (versions[i].commit_ts_ != rhs_version.commit_ts_ ||
+                    std::memcmp(column_delta.Value(versions[i]), rhs_delta.Value(rhs_version), column_delta.elem_size_) != 0) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void ColumnDeltaStore::Update(ColumnID column_id, BlockOffset block_offset, const char *value, SizeT elem_size, TxnTimeStamp commit_ts) {
+    ColumnDelta &column_delta = columns_[column_id];
+    if (column_delta.elem_size_ == 0) {
+        column_delta.elem_size_ = elem_size;
+    } else if (column_delta.elem_size_ != elem_size) {
+        UnrecoverableError(fmt::format("Column {} is updated with element size {}, expect {}", column_id, elem_size, column_delta.elem_size_));
+    }
+    Vector<RowVersion> &versions = column_delta.rows_[block_offset];
+    if (!versions.empty() && versions.back().commit_ts_ > commit_ts) {
+        UnrecoverableError(fmt::format("Update of column {} row {} is committed out of order", column_id, block_offset));
+    }
+    if (!versions.empty() && versions.back().commit_ts_ == commit_ts) {
+        // Updated twice in one transaction or replayed, the last value wins.
+        std::memcpy(column_delta.values_.data() + versions.back().value_idx_ * elem_size, value, elem_size);
+        return;
+    }
+    u32 value_idx = column_delta.values_.size() / elem_size;
+    column_delta.values_.insert(column_delta.values_.end(), value, value + elem_size);
+    versions.push_back(RowVersion{commit_ts, value_idx});
+
+    column_delta.min_update_ts_ = std::min(column_delta.min_update_ts_, commit_ts);
+    min_update_ts_ = std::min(min_update_ts_, commit_ts);
+    max_update_ts_ = std::max(max_update_ts_, commit_ts);
+}
+
+bool ColumnDeltaStore::HasVisibleUpdate(ColumnID column_id, TxnTimeStamp check_ts) const {
+    if (check_ts < min_update_ts_) {
+        return false;
+    }
+    auto iter = columns_.find(column_id);
+    return iter != columns_.end() && iter->second.min_update_ts_ <= check_ts;
+}
+
+void ColumnDeltaStore::Apply(ColumnID column_id, TxnTimeStamp check_ts, BlockOffset begin, BlockOffset end, char *dest) const {
+    auto iter = columns_.find(column_id);
+    if (iter == columns_.end() || check_ts < iter->second.min_update_ts_) {
+        return;
+    }
+    const ColumnDelta &column_delta = iter->second;
+    for (auto row_iter = column_delta.rows_.lower_bound(begin); row_iter != column_delta.rows_.end() && row_iter->first < end; ++row_iter) {
+        const Vector<RowVersion> &versions = row_iter->second;
+        // newest version visible at check_ts
+        for (auto version = versions.rbegin(); version != versions.rend(); ++version) {
+            if (version->commit_ts_ <= check_ts) {
+                std::memcpy(dest + (row_iter->first - begin) * column_delta.elem_size_, column_delta.Value(*version), column_delta.elem_size_);
+                break;
+            }
+        }
+    }
+}
+
+bool ColumnDeltaStore::HasUpdateBetween(TxnTimeStamp begin_ts, TxnTimeStamp end_ts) const {
+    if (columns_.empty() || max_update_ts_ <= begin_ts || min_update_ts_ > end_ts) {
+        return false;
+    }
+    for (const auto &[column_id, column_delta] : columns_) {
+        for (const auto &[block_offset, versions] : column_delta.rows_) {
+            for (const RowVersion &version : versions) {
+                if (version.commit_ts_ > begin_ts && version.commit_ts_ <= end_ts) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void ColumnDeltaStore::CopyUpdates(const ColumnDeltaStore &other, TxnTimeStamp check_ts) {
+    for (const auto &[column_id, column_delta] : other.columns_) {
+        for (const auto &[block_offset, versions] : column_delta.rows_) {
+            for (const RowVersion &version : versions) {
+                if (version.commit_ts_ <= check_ts) {
+                    Update(column_id, block_offset, column_delta.Value(version), column_delta.elem_size_, version.commit_ts_);
+                }
+            }
+        }
+    }
+}
+
+SizeT ColumnDeltaStore::Prune(TxnTimeStamp visible_ts) {
+    if (columns_.empty() || visible_ts < min_update_ts_) {
+        return 0;
+    }
+    SizeT pruned_count = 0;
+    min_update_ts_ = UNCOMMIT_TS;
+    for (auto &[column_id, column_delta] : columns_) {
+        SizeT elem_size = column_delta.elem_size_;
+        Vector<char> values;
+        column_delta.min_update_ts_ = UNCOMMIT_TS;
+        for (auto &[block_offset, versions] : column_delta.rows_) {
+            // versions[first_kept] is the newest version visible at visible_ts
+            SizeT first_kept = 0;
+            while (first_kept + 1 < versions.size() && versions[first_kept + 1].commit_ts_ <= visible_ts) {
+                ++first_kept;
+            }
+            pruned_count += first_kept;
+            versions.erase(versions.begin(), versions.begin() + first_kept);
+            for (RowVersion &version : versions) {
+                const char *value = column_delta.Value(version);
+                version.value_idx_ = values.size() / elem_size;
+                values.insert(values.end(), value, value + elem_size);
+            }
+            column_delta.min_update_ts_ = std::min(column_delta.min_update_ts_, versions.front().commit_ts_);
+        }
+        column_delta.values_ = std::move(values);
+        min_update_ts_ = std::min(min_update_ts_, column_delta.min_update_ts_);
+    }
+    return pruned_count;
+}
+
+void ColumnDeltaStore::SaveToFile(const String &delta_path) const {
+    // File structure:
+    // - column count
+    // - for each column: column id, element size, updated row count
+    // - for each updated row: row offset, version count, (commit ts, value) of the versions in commit order
+    i32 exp_size = sizeof(i32);
+    for (const auto &[column_id, column_delta] : columns_) {
+        exp_size += sizeof(u32) + sizeof(u32) + sizeof(i32);
+        for (const auto &[block_offset, versions] : column_delta.rows_) {
+            exp_size += sizeof(BlockOffset) + sizeof(i32) + versions.size() * (sizeof(TxnTimeStamp) + column_delta.elem_size_);
+        }
+    }
+    Vector<char> buf(exp_size, 0);
+    char *ptr = buf.data();
+    WriteBufAdv<i32>(ptr, i32(columns_.size()));
+    for (const auto &[column_id, column_delta] : columns_) {
+        WriteBufAdv<u32>(ptr, u32(column_id));
+        WriteBufAdv<u32>(ptr, u32(column_delta.elem_size_));
+        WriteBufAdv<i32>(ptr, i32(column_delta.rows_.size()));
+        for (const auto &[block_offset, versions] : column_delta.rows_) {
+            WriteBufAdv<BlockOffset>(ptr, block_offset);
+            WriteBufAdv<i32>(ptr, i32(versions.size()));
+            for (const RowVersion &version : versions) {
+                WriteBufAdv<TxnTimeStamp>(ptr, version.commit_ts_);
+                std::memcpy(ptr, column_delta.Value(version), column_delta.elem_size_);
+                ptr += column_delta.elem_size_;
+            }
+        }
+    }
+    if (ptr - buf.data() != exp_size) {
+        UnrecoverableError(fmt::format("Failed to save column delta file: {}", delta_path));
+    }
+    std::ofstream ofs = std::ofstream(delta_path, std::ios::trunc | std::ios::binary);
+    if (!ofs.is_open()) {
+        UnrecoverableError(fmt::format("Failed to open column delta file: {}, {}", delta_path, ofs.rdstate()));
+    }
+    ofs.write(buf.data(), ptr - buf.data());
+    ofs.flush();
+    ofs.close();
+}
+
+void ColumnDeltaStore::LoadFromFile(const String &delta_path) {
+    std::ifstream ifs(delta_path);
+    if (!ifs.is_open()) {
+        // No column of the block has been updated in place.
+        return;
+    }
+    int buf_len = std::filesystem::file_size(delta_path);
+    Vector<char> buf(buf_len);
+    ifs.read(buf.data(), buf_len);
+    ifs.close();
+
+    columns_.clear();
+    min_update_ts_ = UNCOMMIT_TS;
+    max_update_ts_ = 0;
+    char *ptr = buf.data();
+    i32 column_count = ReadBufAdv<i32>(ptr);
+    for (i32 i = 0; i < column_count; ++i) {
+        ColumnID column_id = ReadBufAdv<u32>(ptr);
+        SizeT elem_size = ReadBufAdv<u32>(ptr);
+        i32 row_count = ReadBufAdv<i32>(ptr);
+        for (i32 j = 0; j < row_count; ++j) {
+            BlockOffset block_offset = ReadBufAdv<BlockOffset>(ptr);
+            i32 version_count = ReadBufAdv<i32>(ptr);
+            for (i32 k = 0; k < version_count; ++k) {
+                TxnTimeStamp commit_ts = ReadBufAdv<TxnTimeStamp>(ptr);
+                Update(column_id, block_offset, ptr, elem_size, commit_ts);
+                ptr += elem_size;
+            }
+        }
+    }
+    if (ptr - buf.data() != buf_len) {
+        UnrecoverableError(fmt::format("Failed to load column delta file: {}", delta_path));
+    }
+}
+
+void ColumnDeltaStore::Cleanup(const String &delta_path) {
+    LocalFileSystem fs;
+
+    if (fs.Exists(delta_path)) {
+        fs.DeleteFile(delta_path);
+    }
+}
+
+} // namespace infinity
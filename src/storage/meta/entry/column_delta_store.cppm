@@ -0,0 +1,86 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module column_delta_store;
+
+import stl;
+import default_values;
+import data_type;
+
+namespace infinity {
+
+// Values of fixed width columns updated in place, kept beside the column data of a block.
+// The column data itself is never overwritten: a reader overlays the newest value committed no later than its begin ts.
+// The updates are merged into the column data when the segment is compacted.
+export class ColumnDeltaStore {
+public:
+    constexpr static std::string_view PATH = "column_delta";
+
+    // Column types which can be updated through the delta store.
+    static bool Supported(const DataType &data_type);
+
+    bool operator==(const ColumnDeltaStore &rhs) const;
+    bool operator!=(const ColumnDeltaStore &rhs) const { return !(*this == rhs); }
+
+    void Update(ColumnID column_id, BlockOffset block_offset, const char *value, SizeT elem_size, TxnTimeStamp commit_ts);
+
+    // Any update of the column committed no later than check_ts.
+    bool HasVisibleUpdate(ColumnID column_id, TxnTimeStamp check_ts) const;
+
+    // Overwrite the values of rows [begin, end) in dest, which holds the value of row `begin` at dest[0].
+    void Apply(ColumnID column_id, TxnTimeStamp check_ts, BlockOffset begin, BlockOffset end, char *dest) const;
+
+    // Any update committed in (begin_ts, end_ts].
+    bool HasUpdateBetween(TxnTimeStamp begin_ts, TxnTimeStamp end_ts) const;
+
+    // Copy the updates of other which are committed no later than check_ts.
+    void CopyUpdates(const ColumnDeltaStore &other, TxnTimeStamp check_ts);
+
+    // Drop the versions which no reader at or after visible_ts can see, keeping the newest one committed no later than visible_ts.
+    // Return the number of dropped versions.
+    SizeT Prune(TxnTimeStamp visible_ts);
+
+    void SaveToFile(const String &delta_path) const;
+
+    void LoadFromFile(const String &delta_path);
+
+    void Cleanup(const String &delta_path);
+
+    bool Empty() const { return columns_.empty(); }
+
+    TxnTimeStamp min_update_ts() const { return min_update_ts_; }
+
+private:
+    struct RowVersion {
+        TxnTimeStamp commit_ts_{};
+        u32 value_idx_{};
+    };
+
+    struct ColumnDelta {
+        SizeT elem_size_{};
+        Map<BlockOffset, Vector<RowVersion>> rows_{}; // versions of a row in commit order
+        Vector<char> values_{};
+        TxnTimeStamp min_update_ts_{UNCOMMIT_TS};
+
+        const char *Value(const RowVersion &version) const { return values_.data() + version.value_idx_ * elem_size_; }
+    };
+
+    HashMap<ColumnID, ColumnDelta> columns_{};
+    TxnTimeStamp min_update_ts_{UNCOMMIT_TS};
+    TxnTimeStamp max_update_ts_{0};
+};
+
+} // namespace infinity
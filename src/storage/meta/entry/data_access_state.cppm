@@ -67,6 +67,13 @@ export struct DeleteState {
     HashMap<SegmentID, HashMap<BlockID, Vector<BlockOffset>>> rows_; // use segment id, as the first level key, block id as the second level key
 };
 
+export struct UpdateState {
+    Vector<ColumnID> column_ids_{};
+    SharedPtr<DataBlock> values_{}; // column i holds the new values of column_ids_[i]
+    // segment id -> block id -> (block offset, row of the new value in values_)
+    HashMap<SegmentID, HashMap<BlockID, Vector<Pair<BlockOffset, u32>>>> rows_;
+};
+
 export struct GetState {};
 
 export enum class ScanStateType {
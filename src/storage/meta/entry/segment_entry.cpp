@@ -43,6 +43,7 @@ import compact_segments_task;
 import cleanup_scanner;
 import background_process;
 import wal_entry;
+import block_column_entry;
 
 namespace infinity {
 
@@ -98,6 +99,11 @@ bool SegmentEntry::SetSealed() {
         return false;
     }
     status_ = SegmentStatus::kSealed;
+    for (auto &block_entry : block_entries_) {
+        for (auto &column : block_entry->columns()) {
+            column->Seal();
+        }
+    }
     return true;
 }
 
@@ -322,6 +328,54 @@ void SegmentEntry::DeleteData(TransactionID txn_id,
     }
 }
 
+// One writer
+void SegmentEntry::UpdateData(TransactionID txn_id,
+                              TxnTimeStamp commit_ts,
+                              const HashMap<BlockID, Vector<Pair<BlockOffset, u32>>> &block_row_hashmap,
+                              const Vector<ColumnID> &column_ids,
+                              const SharedPtr<DataBlock> &values,
+                              Txn *txn,
+                              bool keep_registered) {
+    TxnTableStore *txn_store = txn->GetTxnTableStore(table_entry_);
+
+    for (const auto &[block_id, update_rows] : block_row_hashmap) {
+        BlockEntry *block_entry = nullptr;
+        {
+            std::shared_lock lck(this->rw_locker_);
+            block_entry = block_entries_.at(block_id).get();
+        }
+
+        block_entry->UpdateData(txn_id, commit_ts, update_rows, column_ids, *values);
+        txn_store->AddBlockStore(this, block_entry);
+    }
+    fast_rough_filter_.MarkUpdated(commit_ts);
+    {
+        std::unique_lock w_lock(rw_locker_);
+        if (status_ == SegmentStatus::kDeprecated) {
+            UnrecoverableError("Assert: Should not commit update to deprecated segment.");
+        }
+        if (compact_task_ != nullptr) {
+            if (status_ != SegmentStatus::kCompacting && status_ != SegmentStatus::kNoDelete) {
+                UnrecoverableError("Assert: compact_task is not nullptr means segment is being compacted");
+            }
+            // The compacted segment is copied at the begin ts of the compact txn, forward the update to it.
+            Vector<Pair<SegmentOffset, u32>> update_rows;
+            for (const auto &[block_id, rows] : block_row_hashmap) {
+                for (const auto &[block_offset, value_row] : rows) {
+                    update_rows.emplace_back(block_id * DEFAULT_BLOCK_CAPACITY + block_offset, value_row);
+                }
+            }
+            compact_task_->AddToUpdate(segment_id_, std::move(update_rows), column_ids, values);
+        }
+        if (!keep_registered) {
+            delete_txns_.erase(txn_id);
+            if (delete_txns_.empty()) { // == 0 when replay
+                no_delete_complete_cv_.notify_one();
+            }
+        }
+    }
+}
+
 void SegmentEntry::CommitSegment(TransactionID txn_id, TxnTimeStamp commit_ts) {
     std::unique_lock w_lock(rw_locker_);
     min_row_ts_ = std::min(min_row_ts_, commit_ts);
@@ -451,7 +505,14 @@ void SegmentEntry::Cleanup() {
     CleanupScanner::CleanupDir(*segment_dir_);
 }
 
-void SegmentEntry::PickCleanup(CleanupScanner *scanner) {}
+void SegmentEntry::PickCleanup(CleanupScanner *scanner) {
+    TxnTimeStamp visible_ts = scanner->visible_ts();
+    std::shared_lock lock(rw_locker_);
+    for (auto &block_entry : block_entries_) {
+        block_entry->PruneColumnDelta(visible_ts);
+        block_entry->FoldDeletes(visible_ts);
+    }
+}
 
 // used in:
 // 1. record minmax filter and optional bloom filter created for sealed segment created by append, import and compact
@@ -37,6 +37,7 @@ class TxnTableStore;
 struct TableEntry;
 class CompactSegmentsTask;
 class BlockEntryIter;
+class DataBlock;
 
 export enum class SegmentStatus : u8 {
     kUnsealed,
@@ -164,6 +165,15 @@ public:
 
     void DeleteData(TransactionID txn_id, TxnTimeStamp commit_ts, const HashMap<BlockID, Vector<BlockOffset>> &block_row_hashmap, Txn *txn);
 
+    // keep_registered: the txn writes the segment again later in its commit, stay in delete_txns_ until then
+    void UpdateData(TransactionID txn_id,
+                    TxnTimeStamp commit_ts,
+                    const HashMap<BlockID, Vector<Pair<BlockOffset, u32>>> &block_row_hashmap,
+                    const Vector<ColumnID> &column_ids,
+                    const SharedPtr<DataBlock> &values,
+                    Txn *txn,
+                    bool keep_registered);
+
     void CommitSegment(TransactionID txn_id, TxnTimeStamp commit_ts);
 
     void RollbackBlocks(TxnTimeStamp commit_ts, const Vector<BlockEntry *> &block_entry);
@@ -212,7 +222,7 @@ private:
     SegmentStatus status_;
 
     std::condition_variable_any no_delete_complete_cv_{};
-    HashSet<TransactionID> delete_txns_; // current number of delete txn that write this segment
+    HashSet<TransactionID> delete_txns_; // current number of delete and update txn that write this segment
 
 public:
     void Cleanup() override;
@@ -38,7 +38,9 @@ import hnsw_alg;
 import catalog_delta_entry;
 import column_vector;
 import annivfflat_index_data;
+import kmeans_partition;
 import secondary_index_data;
+import secondary_index_in_mem;
 import type_info;
 import embedding_info;
 import create_index_info;
@@ -58,6 +60,8 @@ import chunk_index_entry;
 import abstract_hnsw;
 import block_column_iter;
 import txn_store;
+import txn;
+import txn_manager;
 
 namespace infinity {
 
@@ -112,11 +116,7 @@ SharedPtr<SegmentIndexEntry> SegmentIndexEntry::NewReplaySegmentIndexEntry(Table
     String column_name = table_index_entry->index_base()->column_name();
     auto create_index_param =
         SegmentIndexEntry::GetCreateIndexParam(table_index_entry->table_index_def(), segment_row_count, table_entry->GetColumnDefByName(column_name));
-    auto vector_file_worker = SegmentIndexEntry::CreateFileWorkers(table_index_entry->index_dir(), create_index_param.get(), segment_id);
-    Vector<BufferObj *> vector_buffer(vector_file_worker.size());
-    for (u32 i = 0; i < vector_file_worker.size(); ++i) {
-        vector_buffer[i] = buffer_manager->Get(std::move(vector_file_worker[i]));
-    };
+    auto vector_buffer = SegmentIndexEntry::GetIndexBuffers(table_index_entry, segment_id, buffer_manager, create_index_param.get());
     auto segment_index_entry = SharedPtr<SegmentIndexEntry>(new SegmentIndexEntry(table_index_entry, segment_id, std::move(vector_buffer)));
     if (segment_index_entry.get() == nullptr) {
         UnrecoverableError("Failed to load index entry");
@@ -205,13 +205,42 @@ Vector<UniquePtr<IndexFileWorker>> SegmentIndexEntry::CreateFileWorkers(SharedPt
 
 String SegmentIndexEntry::IndexFileName(SegmentID segment_id) { return fmt::format("seg{}.idx", segment_id); }
 
-UniquePtr<SegmentIndexEntry>
-SegmentIndexEntry::LoadIndexEntry(TableIndexEntry *table_index_entry, u32 segment_id, BufferManager *buffer_manager, CreateIndexParam *param) {
+Vector<BufferObj *>
+SegmentIndexEntry::GetIndexBuffers(TableIndexEntry *table_index_entry, SegmentID segment_id, BufferManager *buffer_manager, CreateIndexParam *param) {
     auto vector_file_worker = SegmentIndexEntry::CreateFileWorkers(table_index_entry->index_dir(), param, segment_id);
-    Vector<BufferObj *> vector_buffer(vector_file_worker.size());
-    for (u32 i = 0; i < vector_file_worker.size(); ++i) {
-        vector_buffer[i] = buffer_manager->Get(std::move(vector_file_worker[i]));
+    if (param->index_base_->index_type_ != IndexType::kSecondary) {
+        Vector<BufferObj *> vector_buffer(vector_file_worker.size());
+        for (u32 i = 0; i < vector_file_worker.size(); ++i) {
+            vector_buffer[i] = buffer_manager->Get(std::move(vector_file_worker[i]));
+        }
+        return vector_buffer;
     }
+    // The parts of a secondary index are added when its segment is sealed, an unsealed segment may have more rows than its saved
+    // index covers. The part number is the one of the saved head.
+    Vector<BufferObj *> vector_buffer{buffer_manager->Get(std::move(vector_file_worker[0]))};
+    u32 part_num = 0;
+    {
+        BufferHandle buffer_handle_head = vector_buffer[0]->Load();
+        part_num = static_cast<const SecondaryIndexDataHead *>(buffer_handle_head.GetData())->GetPartNum();
+    }
+    auto create_secondary_param = static_cast<CreateSecondaryIndexParam *>(param);
+    for (u32 i = 1; i <= part_num; ++i) {
+        auto part_file_name = MakeShared<String>(fmt::format("{}_part{}", IndexFileName(segment_id), i));
+        auto file_worker = MakeUnique<SecondaryIndexFileWorker>(table_index_entry->index_dir(),
+                                                                part_file_name,
+                                                                param->index_base_,
+                                                                param->column_def_,
+                                                                i,
+                                                                create_secondary_param->row_count_,
+                                                                create_secondary_param->part_capacity_);
+        vector_buffer.push_back(buffer_manager->Get(std::move(file_worker)));
+    }
+    return vector_buffer;
+}
+
+UniquePtr<SegmentIndexEntry>
+SegmentIndexEntry::LoadIndexEntry(TableIndexEntry *table_index_entry, u32 segment_id, BufferManager *buffer_manager, CreateIndexParam *param) {
+    auto vector_buffer = SegmentIndexEntry::GetIndexBuffers(table_index_entry, segment_id, buffer_manager, param);
     return UniquePtr<SegmentIndexEntry>(new SegmentIndexEntry(table_index_entry, segment_id, std::move(vector_buffer)));
 }
 
@@ -252,7 +281,8 @@ void SegmentIndexEntry::MemIndexInsert(SharedPtr<BlockEntry> block_entry,
                 assert(begin_row_id == memory_indexer_->GetBaseRowId() + memory_indexer_->GetDocCount());
             }
             BlockColumnEntry *block_column_entry = block_entry->GetColumnBlockEntry(column_id);
-            SharedPtr<ColumnVector> column_vector = MakeShared<ColumnVector>(block_column_entry->GetColumnVector(buffer_manager));
+            SharedPtr<ColumnVector> column_vector =
+                MakeShared<ColumnVector>(block_column_entry->GetColumnVector(buffer_manager, row_offset + row_count, commit_ts));
             memory_indexer_->Insert(column_vector, row_offset, row_count, false);
             break;
         }
@@ -277,7 +307,7 @@ void SegmentIndexEntry::MemIndexInsert(SharedPtr<BlockEntry> block_entry,
             switch (embedding_info->Type()) {
                 case kElemFloat: {
                     AbstractHnsw<f32, SegmentOffset> abstract_hnsw(buffer_handle.GetDataMut(), index_hnsw);
-                    MemIndexInserterIter<f32> iter(0, block_column_entry, buffer_manager, row_offset, row_count);
+                    MemIndexInserterIter<f32> iter(0, block_column_entry, buffer_manager, row_offset, row_count, commit_ts);
                     auto [start_i, end_i] = abstract_hnsw.InsertVecs(std::move(iter));
                     row_cnt = end_i;
                     break;
@@ -289,8 +319,24 @@ void SegmentIndexEntry::MemIndexInsert(SharedPtr<BlockEntry> block_entry,
             memory_hnsw_indexer_->SetRowCount(row_cnt);
             break;
         }
-        case IndexType::kIVFFlat:
         case IndexType::kSecondary: {
+            SharedPtr<SecondaryIndexInMem> memory_secondary_index;
+            {
+                std::unique_lock<std::shared_mutex> lck(rw_locker_);
+                if (memory_secondary_index_.get() == nullptr) {
+                    // The rows before full_data_num are in the PGM index.
+                    BufferHandle index_handle_head = GetIndex();
+                    auto index_head = static_cast<const SecondaryIndexDataHead *>(index_handle_head.GetData());
+                    memory_secondary_index_ = GetSecondaryIndexInMem(column_def->type(), index_head->GetFullDataNum());
+                }
+                memory_secondary_index = memory_secondary_index_;
+            }
+            BlockColumnEntry *block_column_entry = block_entry->GetColumnBlockEntry(column_id);
+            ColumnVector column_vector = block_column_entry->GetColumnVector(buffer_manager, row_offset + row_count, commit_ts);
+            memory_secondary_index->Insert(column_vector, row_offset, row_count, begin_row_id.segment_offset_);
+            break;
+        }
+        case IndexType::kIVFFlat: {
             UniquePtr<String> err_msg =
                 MakeUnique<String>(fmt::format("{} realtime index is not supported yet", IndexInfo::IndexTypeToString(index_base->index_type_)));
             LOG_WARN(*err_msg);
@@ -304,7 +350,6 @@ void SegmentIndexEntry::MemIndexInsert(SharedPtr<BlockEntry> block_entry,
         }
     }
     assert(commit_ts >= min_ts_);
-    max_ts_ = commit_ts;
 }
 
 void SegmentIndexEntry::MemIndexCommit() {
@@ -390,7 +435,8 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
             auto block_entry_iter = BlockEntryIter(segment_entry);
             for (const auto *block_entry = block_entry_iter.Next(); block_entry != nullptr; block_entry = block_entry_iter.Next()) {
                 BlockColumnEntry *block_column_entry = block_entry->GetColumnBlockEntry(column_id);
-                SharedPtr<ColumnVector> column_vector = MakeShared<ColumnVector>(block_column_entry->GetColumnVector(buffer_mgr));
+                SharedPtr<ColumnVector> column_vector =
+                    MakeShared<ColumnVector>(block_column_entry->GetColumnVector(buffer_mgr, block_entry->row_count(), begin_ts));
                 memory_indexer_->Insert(column_vector, 0, block_entry->row_count(), true);
                 memory_indexer_->Commit(true);
             }
@@ -421,8 +467,17 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
                         insert_config.optimize_ = true;
                         SegmentOffset start_i, end_i;
                         if (!config.prepare_) {
-                            // Single thread insert
-                            std::tie(start_i, end_i) = abstract_hnsw.InsertVecs(std::move(iter), insert_config);
+                            // Insert data, then build the graph on the index build threads.
+                            std::tie(start_i, end_i) = abstract_hnsw.StoreData(std::move(iter), insert_config);
+                            SizeT build_thread_n = txn->txn_mgr()->index_build_thread_num();
+                            SizeT report_interval = std::max<SizeT>((end_i - start_i) / 10, DEFAULT_BLOCK_CAPACITY);
+                            abstract_hnsw.ParallelBuild(start_i, end_i, build_thread_n, report_interval, [&](SizeT built_n) {
+                                LOG_INFO(fmt::format("Build hnsw index {} of segment {}: {}/{} vertices",
+                                                     *table_index_entry_->GetIndexName(),
+                                                     segment_entry->segment_id(),
+                                                     built_n,
+                                                     end_i - start_i));
+                            });
                         } else {
                             // Multi thread insert data, write file in the physical create index finish stage.
                             std::tie(start_i, end_i) = abstract_hnsw.StoreData(std::move(iter), insert_config);
@@ -488,14 +543,16 @@ Status SegmentIndexEntry::CreateIndexPrepare(const SegmentEntry *segment_entry,
             switch (embedding_info->Type()) {
                 case kElemFloat: {
                     auto annivfflat_index = reinterpret_cast<AnnIVFFlatIndexData<f32> *>(buffer_handle.GetDataMut());
+                    // The centroids are trained on the index build threads.
+                    KMeansOption kmeans_option{.thread_num_ = u32(std::max<SizeT>(1, txn->txn_mgr()->index_build_thread_num()))};
                     // TODO: How to select training data?
                     if (check_ts) {
                         OneColumnIterator<float> iter(segment_entry, buffer_mgr, column_def->id(), begin_ts);
-                        annivfflat_index->BuildIndex(iter, dimension, full_row_count);
+                        annivfflat_index->BuildIndex(iter, dimension, full_row_count, 32, 256, kmeans_option);
                     } else {
                         // Not check ts in uncommitted segment when compact segment
                         OneColumnIterator<float, false> iter(segment_entry, buffer_mgr, column_def->id(), begin_ts);
-                        annivfflat_index->BuildIndex(iter, dimension, full_row_count);
+                        annivfflat_index->BuildIndex(iter, dimension, full_row_count, 32, 256, kmeans_option);
                     }
                     break;
                 }
@@ -514,32 +571,7 @@ Status SegmentIndexEntry::CreateIndexPrepare(const SegmentEntry *segment_entry,
             break;
         }
         case IndexType::kSecondary: {
-            auto &data_type = column_def->type();
-            if (!(data_type->CanBuildSecondaryIndex())) {
-                UnrecoverableError(fmt::format("Cannot build secondary index on data type: {}", data_type->ToString()));
-            }
-            // 1. build secondary index by merge sort
-            u32 part_capacity = DEFAULT_BLOCK_CAPACITY;
-            // fetch the row_count from segment_entry
-            auto secondary_index_builder = GetSecondaryIndexDataBuilder(data_type, segment_entry->row_count(), part_capacity);
-            secondary_index_builder->LoadSegmentData(segment_entry, buffer_mgr, column_def->id(), begin_ts, check_ts);
-            secondary_index_builder->StartOutput();
-            // 2. output into SecondaryIndexDataPart
-            {
-                u32 part_num = GetIndexPartNum();
-                for (u32 part_id = 0; part_id < part_num; ++part_id) {
-                    BufferHandle buffer_handle_part = GetIndexPartAt(part_id);
-                    auto secondary_index_part = static_cast<SecondaryIndexDataPart *>(buffer_handle_part.GetDataMut());
-                    secondary_index_builder->OutputToPart(secondary_index_part);
-                }
-            }
-            // 3. output into SecondaryIndexDataHead
-            {
-                BufferHandle buffer_handle_head = GetIndex();
-                auto secondary_index_head = static_cast<SecondaryIndexDataHead *>(buffer_handle_head.GetDataMut());
-                secondary_index_builder->OutputToHeader(secondary_index_head);
-            }
-            secondary_index_builder->EndOutput();
+            BuildSecondaryIndex(segment_entry, buffer_mgr, begin_ts, check_ts);
             break;
         }
         default: {
@@ -552,6 +584,51 @@ Status SegmentIndexEntry::CreateIndexPrepare(const SegmentEntry *segment_entry,
     return Status::OK();
 }
 
+void SegmentIndexEntry::BuildSecondaryIndex(const SegmentEntry *segment_entry, BufferManager *buffer_mgr, TxnTimeStamp begin_ts, bool check_ts) {
+    const SharedPtr<ColumnDef> &column_def = table_index_entry_->column_def();
+    auto &data_type = column_def->type();
+    if (!(data_type->CanBuildSecondaryIndex())) {
+        UnrecoverableError(fmt::format("Cannot build secondary index on data type: {}", data_type->ToString()));
+    }
+    u32 part_capacity = DEFAULT_BLOCK_CAPACITY;
+    // fetch the row_count from segment_entry
+    u32 row_count = segment_entry->row_count();
+    u32 part_num = (row_count + part_capacity - 1) / part_capacity;
+    std::unique_lock lock(rw_locker_);
+    // 1. add the parts of the rows appended since the index was created
+    for (u32 part_id = GetIndexPartNum(); part_id < part_num; ++part_id) {
+        auto part_file_name = MakeShared<String>(fmt::format("{}_part{}", IndexFileName(segment_id_), part_id + 1));
+        auto file_worker = MakeUnique<SecondaryIndexFileWorker>(table_index_entry_->index_dir(),
+                                                                part_file_name,
+                                                                table_index_entry_->table_index_def(),
+                                                                column_def,
+                                                                part_id + 1,
+                                                                row_count,
+                                                                part_capacity);
+        vector_buffer_.push_back(buffer_mgr->Allocate(std::move(file_worker)));
+    }
+    // 2. build secondary index by merge sort
+    auto secondary_index_builder = GetSecondaryIndexDataBuilder(data_type, row_count, part_capacity);
+    secondary_index_builder->LoadSegmentData(segment_entry, buffer_mgr, column_def->id(), begin_ts, check_ts);
+    secondary_index_builder->StartOutput();
+    // 3. output into SecondaryIndexDataPart
+    for (u32 part_id = 0; part_id < part_num; ++part_id) {
+        BufferHandle buffer_handle_part = GetIndexPartAt(part_id);
+        auto secondary_index_part = static_cast<SecondaryIndexDataPart *>(buffer_handle_part.GetDataMut());
+        *secondary_index_part = SecondaryIndexDataPart(part_id, std::min(part_capacity, row_count - part_id * part_capacity));
+        secondary_index_builder->OutputToPart(secondary_index_part);
+    }
+    // 4. output into SecondaryIndexDataHead
+    {
+        BufferHandle buffer_handle_head = GetIndex();
+        auto secondary_index_head = static_cast<SecondaryIndexDataHead *>(buffer_handle_head.GetDataMut());
+        *secondary_index_head = SecondaryIndexDataHead(part_capacity, row_count, data_type);
+        secondary_index_builder->OutputToHeader(secondary_index_head);
+    }
+    secondary_index_builder->EndOutput();
+    memory_secondary_index_.reset();
+}
+
 Status SegmentIndexEntry::CreateIndexDo(atomic_u64 &create_index_idx) {
     const IndexBase *index_base = table_index_entry_->index_base();
     const ColumnDef *column_def = table_index_entry_->column_def().get();
@@ -705,7 +782,7 @@ SegmentIndexEntry::GetCreateIndexParam(SharedPtr<IndexBase> index_base, SizeT se
 }
 
 void SegmentIndexEntry::ReplaceFtChunkIndexEntries(SharedPtr<ChunkIndexEntry> merged_chunk_index_entry) {
-    std::shared_lock lock(rw_locker_);
+    std::unique_lock lock(rw_locker_);
     SizeT num_entries = chunk_index_entries_.size();
     SizeT idx_first = num_entries;
     for (SizeT i = 0; i < num_entries; i++) {
@@ -733,12 +810,38 @@ void SegmentIndexEntry::ReplaceChunkIndexEntries(TxnTableStore *txn_table_store,
                                                  SharedPtr<ChunkIndexEntry> merged_chunk_index_entry,
                                                  Vector<ChunkIndexEntry *> &&old_chunks) {
     TxnIndexStore *txn_index_store = txn_table_store->GetIndexStore(table_index_entry_);
-    chunk_index_entries_.push_back(merged_chunk_index_entry);
+    {
+        std::unique_lock lock(rw_locker_);
+        chunk_index_entries_.push_back(merged_chunk_index_entry);
+    }
     txn_index_store->optimize_data_.emplace_back(this, merged_chunk_index_entry.get(), std::move(old_chunks));
 }
 
-ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_table_store, SegmentEntry *segment_entry) {
-    Txn *txn = txn_table_store->txn_;
+// Yields the rows of the column except the ones in [skip_begin, skip_end).
+template <typename DataType, typename Iterator>
+class SkipRangeIterator {
+public:
+    SkipRangeIterator(Iterator iter, SegmentOffset skip_begin, SegmentOffset skip_end)
+        : iter_(std::move(iter)), skip_begin_(skip_begin), skip_end_(skip_end) {}
+
+    Optional<Pair<const DataType *, SegmentOffset>> Next() {
+        while (true) {
+            auto ret = iter_.Next();
+            if (!ret || ret->second < skip_begin_ || ret->second >= skip_end_) {
+                return ret;
+            }
+        }
+    }
+
+private:
+    Iterator iter_;
+    SegmentOffset skip_begin_;
+    SegmentOffset skip_end_;
+};
+
+// The graph can only be copied through its file format.
+SharedPtr<ChunkIndexEntry>
+SegmentIndexEntry::RebuildChunkIndexEntries(Txn *txn, SegmentEntry *segment_entry, SizeT build_thread_n, Vector<ChunkIndexEntry *> &old_chunks) {
     TxnTimeStamp begin_ts = txn->BeginTS();
     const IndexBase *index_base = table_index_entry_->index_base();
     SharedPtr<ColumnDef> column_def = table_index_entry_->column_def();
@@ -746,8 +849,8 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
     switch (index_base->index_type_) {
         case IndexType::kHnsw: {
             BufferManager *buffer_mgr = txn->buffer_mgr();
-            Vector<ChunkIndexEntry *> old_chunks;
             u32 row_count = 0;
+            SharedPtr<ChunkIndexEntry> largest_chunk;
             {
                 std::shared_lock lock(rw_locker_);
                 if (chunk_index_entries_.size() <= 1) { // TODO
@@ -757,9 +860,16 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
                     if (chunk_index_entry->CheckVisible(begin_ts)) {
                         row_count += chunk_index_entry->row_count_;
                         old_chunks.push_back(chunk_index_entry.get());
+                        if (largest_chunk.get() == nullptr || chunk_index_entry->row_count_ > largest_chunk->row_count_) {
+                            largest_chunk = chunk_index_entry;
+                        }
                     }
                 }
             }
+            if (old_chunks.size() <= 1) {
+                old_chunks.clear();
+                return nullptr;
+            }
 
             auto index_hnsw = static_cast<const IndexHnsw *>(index_base);
             if (column_def->type()->type() != LogicalType::kEmbedding) {
@@ -775,13 +885,34 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
             switch (embedding_info->Type()) {
                 case kElemFloat: {
                     AbstractHnsw<f32, SegmentOffset> abstract_hnsw(buffer_handle.GetDataMut(), index_hnsw);
-                    OneColumnIterator<float, true /*check ts*/> iter(segment_entry, buffer_mgr, column_def->id(), begin_ts);
+                    // 1. start from the graph of the largest chunk, its vectors are not inserted again. A quantized index starts from
+                    // scratch instead, so that its quantizer is trained on the raw vectors of the whole segment.
+                    const bool from_scratch = index_hnsw->NeedRerank();
+                    if (!from_scratch) {
+                        BufferHandle largest_handle = largest_chunk->GetIndex();
+                        AbstractHnsw<f32, SegmentOffset> largest_hnsw(const_cast<void *>(largest_handle.GetData()), index_hnsw);
+                        abstract_hnsw.CopyInPlace(largest_hnsw);
+                    }
+                    // 2. insert the vectors of the other chunks
+                    SegmentOffset skip_begin = from_scratch ? 0 : largest_chunk->base_rowid_.segment_offset_;
+                    SegmentOffset skip_end = from_scratch ? 0 : skip_begin + largest_chunk->row_count_;
+                    SizeT copied_n = from_scratch ? 0 : largest_chunk->row_count_;
+                    OneColumnIterator<float, true /*check ts*/> column_iter(segment_entry, buffer_mgr, column_def->id(), begin_ts);
+                    SkipRangeIterator<float, OneColumnIterator<float, true>> iter(std::move(column_iter), skip_begin, skip_end);
                     HnswInsertConfig insert_config;
                     insert_config.optimize_ = true;
-                    auto [start_i, end_i] = abstract_hnsw.InsertVecs(std::move(iter), insert_config);
-                    if (end_i - start_i != row_count) {
+                    auto [start_i, end_i] = abstract_hnsw.StoreData(std::move(iter), insert_config);
+                    if (copied_n + (end_i - start_i) != row_count) {
                         UnrecoverableError("Rebuild HNSW index failed.");
                     }
+                    SizeT report_interval = std::max<SizeT>((end_i - start_i) / 10, DEFAULT_BLOCK_CAPACITY);
+                    abstract_hnsw.ParallelBuild(start_i, end_i, build_thread_n, report_interval, [&](SizeT built_n) {
+                        LOG_INFO(fmt::format("Rebuild hnsw index {} of segment {}: {}/{} vertices",
+                                             *table_index_entry_->GetIndexName(),
+                                             segment_id_,
+                                             built_n,
+                                             end_i - start_i));
+                    });
                     break;
                 }
                 default: {
@@ -789,9 +920,8 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
                 }
             }
             merged_chunk_index_entry->SetRowCount(row_count);
-            ReplaceChunkIndexEntries(txn_table_store, merged_chunk_index_entry, std::move(old_chunks));
-            txn_table_store->AddChunkIndexStore(table_index_entry_, merged_chunk_index_entry.get());
-            return merged_chunk_index_entry.get();
+            merged_chunk_index_entry->SaveIndexFile();
+            return merged_chunk_index_entry;
         }
         default: {
             UnrecoverableError("RebuildChunkIndexEntries is not supported for this index type.");
@@ -804,6 +934,8 @@ void SegmentIndexEntry::SaveIndexFile() {
     String &index_name = *table_index_entry_->index_dir();
     u64 segment_id = this->segment_id_;
     LOG_TRACE(fmt::format("Segment: {}, Index: {} is being flushing", segment_id, index_name));
+    // the PGM index of a sealed segment may be rebuilt in the background meanwhile
+    std::shared_lock lock(rw_locker_);
     for (auto &buffer_ptr : vector_buffer_) {
         buffer_ptr->Save();
     }
@@ -32,6 +32,7 @@ import meta_entry_interface;
 import cleanup_scanner;
 import chunk_index_entry;
 import memory_indexer;
+import secondary_index_in_mem;
 
 namespace infinity {
 
@@ -68,6 +69,10 @@ public:
 
     static Vector<UniquePtr<IndexFileWorker>> CreateFileWorkers(SharedPtr<String> index_dir, CreateIndexParam *param, SegmentID segment_id);
 
+    // Get the buffers of the saved index files.
+    static Vector<BufferObj *>
+    GetIndexBuffers(TableIndexEntry *table_index_entry, SegmentID segment_id, BufferManager *buffer_manager, CreateIndexParam *param);
+
     static String IndexFileName(SegmentID segment_id);
 
     [[nodiscard]] BufferHandle GetIndex();
@@ -104,6 +109,9 @@ public:
     inline ChunkID next_chunk_id() const { return next_chunk_id_; }
     SharedPtr<String> index_dir() const { return index_dir_; }
 
+    // The rows committed at commit_ts are inserted into the memory index later, see MemIndexAppender.
+    void UpdateMaxTs(TxnTimeStamp commit_ts) { max_ts_ = std::max(max_ts_, commit_ts); }
+
     // MemIndexInsert is non-blocking. Caller must ensure there's no RowID gap between each call.
     void MemIndexInsert(SharedPtr<BlockEntry> block_entry, u32 row_offset, u32 row_count, TxnTimeStamp commit_ts, BufferManager *buffer_manager);
 
@@ -123,6 +131,10 @@ public:
 
     Status CreateIndexPrepare(const SegmentEntry *segment_entry, Txn *txn, bool prepare, bool check_ts);
 
+    // Build the secondary index of all the rows of the segment in place, adding the index parts the segment has grown by.
+    // The rows of the memory secondary index are in the PGM index afterwards, so it is dropped.
+    void BuildSecondaryIndex(const SegmentEntry *segment_entry, BufferManager *buffer_mgr, TxnTimeStamp begin_ts, bool check_ts);
+
     Status CreateIndexDo(atomic_u64 &create_index_idx);
 
     static UniquePtr<CreateIndexParam> GetCreateIndexParam(SharedPtr<IndexBase> index_base, SizeT seg_row_count, SharedPtr<ColumnDef> column_def);
@@ -148,7 +160,10 @@ public:
                                   SharedPtr<ChunkIndexEntry> merged_chunk_index_entry,
                                   Vector<ChunkIndexEntry *> &&old_chunks);
 
-    ChunkIndexEntry *RebuildChunkIndexEntries(TxnTableStore *txn_table_store, SegmentEntry *segment_entry);
+    // Merge the visible chunks into one: the vectors of the other chunks are inserted into a copy of the largest chunk's graph on
+    // build_thread_n threads, then the index file is written. The merged chunk is registered by ReplaceChunkIndexEntries.
+    SharedPtr<ChunkIndexEntry>
+    RebuildChunkIndexEntries(Txn *txn, SegmentEntry *segment_entry, SizeT build_thread_n, Vector<ChunkIndexEntry *> &old_chunks);
 
     Tuple<Vector<SharedPtr<ChunkIndexEntry>>, SharedPtr<MemoryIndexer>> GetFullTextIndexSnapshot() {
         std::shared_lock lock(rw_locker_);
@@ -160,6 +175,13 @@ public:
         return {chunk_index_entries_, memory_hnsw_indexer_};
     }
 
+    // The PGM index parts are rebuilt in place when the segment is sealed, the returned lock keeps them unchanged while searched.
+    Pair<std::shared_lock<std::shared_mutex>, SharedPtr<SecondaryIndexInMem>> GetSecondaryIndexSnapshot() {
+        std::shared_lock lock(rw_locker_);
+        SharedPtr<SecondaryIndexInMem> memory_secondary_index = memory_secondary_index_;
+        return {std::move(lock), std::move(memory_secondary_index)};
+    }
+
     Pair<u64, u32> GetFulltextColumnLenInfo() {
         std::shared_lock lock(rw_locker_);
         if (ft_column_len_sum_ == 0 && memory_indexer_.get() != nullptr) {
@@ -218,6 +240,7 @@ private:
     Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries_{};
     SharedPtr<ChunkIndexEntry> memory_hnsw_indexer_{};
     SharedPtr<MemoryIndexer> memory_indexer_{};
+    SharedPtr<SecondaryIndexInMem> memory_secondary_index_{};
 
     u64 ft_column_len_sum_{}; // increase only
     u32 ft_column_len_cnt_{}; // increase only
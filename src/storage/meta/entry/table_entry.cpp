@@ -52,6 +52,11 @@ import segment_index_entry;
 import chunk_index_entry;
 import cleanup_scanner;
 import column_index_merger;
+import catalog;
+import mem_index_appender;
+import chunk_merge_policy;
+import memory_pool;
+import build_secondary_index_task;
 
 namespace infinity {
 
@@ -393,6 +398,32 @@ Status TableEntry::Delete(TransactionID txn_id, void *txn_store, TxnTimeStamp co
     return Status::OK();
 }
 
+Status TableEntry::Update(TransactionID txn_id, void *txn_store, TxnTimeStamp commit_ts, Vector<UpdateState> &update_states) {
+    TxnTableStore *txn_store_ptr = (TxnTableStore *)txn_store;
+    Txn *txn = txn_store_ptr->txn_;
+    // The txn is registered to the segments it writes until its last write of the segment is committed.
+    // Deletes are committed after updates.
+    HashMap<SegmentID, SizeT> last_update_idx;
+    for (SizeT idx = 0; idx < update_states.size(); ++idx) {
+        for (const auto &[segment_id, block_row_hashmap] : update_states[idx].rows_) {
+            last_update_idx[segment_id] = idx;
+        }
+    }
+    for (SizeT idx = 0; idx < update_states.size(); ++idx) {
+        const auto &update_state = update_states[idx];
+        for (const auto &[segment_id, block_row_hashmap] : update_state.rows_) {
+            SharedPtr<SegmentEntry> segment_entry = GetSegmentByID(segment_id, commit_ts);
+            if (!segment_entry) {
+                UniquePtr<String> err_msg = MakeUnique<String>(fmt::format("Going to update data in non-exist segment: {}", segment_id));
+                return Status(ErrorCode::kTableNotExist, std::move(err_msg));
+            }
+            bool keep_registered = last_update_idx[segment_id] != idx || txn_store_ptr->delete_state_.rows_.contains(segment_id);
+            segment_entry->UpdateData(txn_id, commit_ts, block_row_hashmap, update_state.column_ids_, update_state.values_, txn, keep_registered);
+        }
+    }
+    return Status::OK();
+}
+
 void TableEntry::RollbackAppend(TransactionID txn_id, TxnTimeStamp commit_ts, void *txn_store) {
     //    auto *txn_store_ptr = (TxnTableStore *)txn_store;
     //    AppendState *append_state_ptr = txn_store_ptr->append_state_.get();
@@ -578,7 +609,8 @@ void TableEntry::MemIndexInsert(Txn *txn, Vector<AppendRange> &append_ranges) {
         const IndexBase *index_base = table_index_entry->index_base();
         switch (index_base->index_type_) {
             case IndexType::kHnsw:
-            case IndexType::kFullText: {
+            case IndexType::kFullText:
+            case IndexType::kSecondary: {
                 for (auto &[seg_id, ranges] : seg_append_ranges) {
                     MemIndexInsertInner(table_index_entry, txn, seg_id, ranges);
                 }
@@ -620,11 +652,32 @@ void TableEntry::MemIndexInsertInner(TableIndexEntry *table_index_entry, Txn *tx
         if (block_entry->GetAvailableCapacity() <= 0)
             dump_idx = i;
     }
+    if (index_base->index_type_ == IndexType::kSecondary) {
+        // The secondary index is inserted at commit rather than in the background: a row costs a tree insertion, and the index scan
+        // relies on the committed rows being indexed.
+        // The PGM index of a new segment is empty, its rows are in the memory index until the segment is sealed.
+        segment_index_entry->UpdateMaxTs(txn->CommitTS());
+        for (SizeT i = 0; i < num_ranges; i++) {
+            AppendRange &range = append_ranges[i];
+            segment_index_entry->MemIndexInsert(block_entries[i], range.start_offset_, range.row_count_, txn->CommitTS(), txn->buffer_mgr());
+        }
+        if (segment_entry->Room() <= 0) {
+            // The PGM index of a sealed segment is rebuilt off the commit path, the memory index serves its rows until then.
+            BuildSecondaryIndexTask::CreateAndSubmitTask(segment_index_entry, segment_entry, txn->buffer_mgr(), txn->CommitTS(), txn->txn_mgr());
+        }
+        return;
+    }
+    MemIndexAppender *mem_index_appender = txn->GetCatalog()->mem_index_appender();
+    segment_index_entry->UpdateMaxTs(txn->CommitTS());
     for (SizeT i = 0; i < num_ranges; i++) {
         AppendRange &range = append_ranges[i];
         SharedPtr<BlockEntry> block_entry = block_entries[i];
-        segment_index_entry->MemIndexInsert(block_entry, range.start_offset_, range.row_count_, txn->CommitTS(), txn->buffer_mgr());
-        if (i == dump_idx && segment_index_entry->MemIndexRowCount() >= 1000000) {
+        // The rows are inserted into the index in the background, the commit doesn't wait for them.
+        mem_index_appender->Submit(segment_index_entry, block_entry, range.start_offset_, range.row_count_, txn->CommitTS(), txn->buffer_mgr());
+        // the memory index lags the submitted rows, count the pending ones too
+        if (i == dump_idx && segment_index_entry->MemIndexRowCount() + mem_index_appender->pending_rows(segment_index_entry.get()) >= 1000000) {
+            // Rare: the memory index is dumped when full, after its pending rows are inserted.
+            mem_index_appender->WaitSegmentIndex(segment_index_entry.get());
             SharedPtr<ChunkIndexEntry> chunk_index_entry = segment_index_entry->MemIndexDump();
             if (chunk_index_entry.get() != nullptr) {
                 txn_table_store->AddChunkIndexStore(table_index_entry, chunk_index_entry.get());
@@ -639,6 +692,7 @@ void TableEntry::MemIndexInsertInner(TableIndexEntry *table_index_entry, Txn *tx
 
 void TableEntry::MemIndexDump(Txn *txn, bool spill) {
     TxnTableStore *txn_table_store = txn->GetTxnTableStore(this);
+    txn->GetCatalog()->mem_index_appender()->WaitAll();
     auto index_meta_map_guard = index_meta_map_.GetMetaMap();
     for (auto &[_, table_index_meta] : *index_meta_map_guard) {
         auto [table_index_entry, status] = table_index_meta->GetEntryNolock(txn->TxnID(), txn->BeginTS());
@@ -725,6 +779,7 @@ void TableEntry::MemIndexRecover(BufferManager *buffer_manager) {
 
 void TableEntry::OptimizeIndex(Txn *txn) {
     TxnTableStore *txn_table_store = txn->GetTxnTableStore(this);
+    txn->GetCatalog()->mem_index_appender()->WaitAll();
     auto index_meta_map_guard = index_meta_map_.GetMetaMap();
     for (auto &[_, table_index_meta] : *index_meta_map_guard) {
         auto [table_index_entry, status] = table_index_meta->GetEntryNolock(txn->TxnID(), txn->BeginTS());
@@ -735,57 +790,180 @@ void TableEntry::OptimizeIndex(Txn *txn) {
         switch (index_base->index_type_) {
             case IndexType::kFullText: {
                 const IndexFullText *index_fulltext = static_cast<const IndexFullText *>(index_base);
+                TieredChunkMergePolicy merge_policy;
+                struct ChunkMerge {
+                    SegmentIndexEntry *segment_index_entry_{};
+                    Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries_{};
+                    String dst_base_name_{};
+                    RowID base_rowid_{};
+                    u32 row_count_{};
+                };
+                Vector<ChunkMerge> chunk_merges;
                 for (auto &[segment_id, segment_index_entry] : table_index_entry->index_by_segment()) {
                     Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries;
                     segment_index_entry->GetChunkIndexEntries(chunk_index_entries);
-                    if (chunk_index_entries.size() <= 1) {
-                        continue;
+                    Vector<u32> chunk_row_counts;
+                    for (const auto &chunk_index_entry : chunk_index_entries) {
+                        chunk_row_counts.push_back(chunk_index_entry->row_count_);
+                    }
+                    for (const auto &[begin, end] : merge_policy.PickMerges(chunk_row_counts)) {
+                        ChunkMerge &chunk_merge = chunk_merges.emplace_back();
+                        chunk_merge.segment_index_entry_ = segment_index_entry.get();
+                        chunk_merge.chunk_index_entries_.assign(chunk_index_entries.begin() + begin, chunk_index_entries.begin() + end);
+                        chunk_merge.base_rowid_ = chunk_index_entries[begin]->base_rowid_;
+                        for (SizeT i = begin; i < end; i++) {
+                            chunk_merge.row_count_ += chunk_index_entries[i]->row_count_;
+                        }
+                        chunk_merge.dst_base_name_ = fmt::format("ft_{:016x}_{:x}", chunk_merge.base_rowid_.ToUint64(), chunk_merge.row_count_);
                     }
+                }
+                if (chunk_merges.empty()) {
+                    break;
+                }
 
-                    Vector<String> base_names;
-                    Vector<RowID> base_rowids;
-                    RowID base_rowid = chunk_index_entries[0]->base_rowid_;
-                    u32 total_row_count = 0;
-                    for (SizeT i = 0; i < chunk_index_entries.size(); i++) {
-                        auto &chunk_index_entry = chunk_index_entries[i];
-                        base_names.push_back(chunk_index_entry->base_name_);
-                        base_rowids.push_back(chunk_index_entry->base_rowid_);
-                        total_row_count += chunk_index_entry->row_count_;
+                // The merges write disjoint chunks, run them in parallel across and within the segments.
+                Atomic<SizeT> next_merge_idx = 0;
+                std::mutex merge_error_mutex;
+                std::exception_ptr merge_error;
+                auto merge_worker = [&] {
+                    try {
+                        while (true) {
+                            SizeT merge_idx = next_merge_idx.fetch_add(1);
+                            if (merge_idx >= chunk_merges.size()) {
+                                break;
+                            }
+                            const ChunkMerge &chunk_merge = chunk_merges[merge_idx];
+                            Vector<String> base_names;
+                            Vector<RowID> base_rowids;
+                            for (const auto &chunk_index_entry : chunk_merge.chunk_index_entries_) {
+                                base_names.push_back(chunk_index_entry->base_name_);
+                                base_rowids.push_back(chunk_index_entry->base_rowid_);
+                            }
+                            // A merger releases its pools when done, so the merges running in parallel can't share them.
+                            MemoryPool byte_slice_pool;
+                            RecyclePool buffer_pool;
+                            ColumnIndexMerger column_index_merger(*table_index_entry->index_dir_, index_fulltext->flag_, &byte_slice_pool, &buffer_pool);
+                            column_index_merger.Merge(base_names, base_rowids, chunk_merge.dst_base_name_);
+                        }
+                    } catch (...) {
+                        // The other workers stop at their next merge, the error is rethrown once they are joined.
+                        next_merge_idx = chunk_merges.size();
+                        std::lock_guard lock(merge_error_mutex);
+                        if (!merge_error) {
+                            merge_error = std::current_exception();
+                        }
                     }
-                    String dst_base_name = fmt::format("ft_{:016x}_{:x}", base_rowid.ToUint64(), total_row_count);
-                    ColumnIndexMerger column_index_merger(*table_index_entry->index_dir_,
-                                                          index_fulltext->flag_,
-                                                          &table_index_entry->GetFulltextByteSlicePool(),
-                                                          &table_index_entry->GetFulltextBufferPool());
-                    column_index_merger.Merge(base_names, base_rowids, dst_base_name);
-
-                    for (SizeT i = 0; i < chunk_index_entries.size(); i++) {
-                        auto &chunk_index_entry = chunk_index_entries[i];
+                };
+                SizeT thread_n = std::min(FULLTEXT_MERGE_THREAD_NUM, chunk_merges.size());
+                Vector<Thread> merge_threads;
+                for (SizeT i = 1; i < thread_n; i++) {
+                    merge_threads.emplace_back(merge_worker);
+                }
+                merge_worker();
+                for (auto &merge_thread : merge_threads) {
+                    merge_thread.join();
+                }
+                if (merge_error) {
+                    std::rethrow_exception(merge_error);
+                }
+
+                for (const ChunkMerge &chunk_merge : chunk_merges) {
+                    for (const auto &chunk_index_entry : chunk_merge.chunk_index_entries_) {
                         // TODO yzc: txn_store.cpp:87
                         // chunk_index_entry->deleted_ = true;
                         txn_table_store->AddChunkIndexStore(table_index_entry, chunk_index_entry.get());
                     }
-                    SharedPtr<ChunkIndexEntry> chunk_index_entry =
-                        ChunkIndexEntry::NewFtChunkIndexEntry(segment_index_entry.get(), dst_base_name, base_rowid, total_row_count, txn->buffer_mgr());
+                    SharedPtr<ChunkIndexEntry> chunk_index_entry = ChunkIndexEntry::NewFtChunkIndexEntry(chunk_merge.segment_index_entry_,
+                                                                                                         chunk_merge.dst_base_name_,
+                                                                                                         chunk_merge.base_rowid_,
+                                                                                                         chunk_merge.row_count_,
+                                                                                                         txn->buffer_mgr());
                     txn_table_store->AddChunkIndexStore(table_index_entry, chunk_index_entry.get());
-                    segment_index_entry->ReplaceFtChunkIndexEntries(chunk_index_entry);
-                    // OPTIMIZE invoke this func at which the txn hasn't been commited yet.
-                    TxnTimeStamp ts = std::max(txn->BeginTS(), txn->CommitTS());
-                    assert(ts >= table_index_entry->GetFulltexSegmentUpdateTs());
-                    table_index_entry->UpdateFulltextSegmentTs(ts);
+                    chunk_merge.segment_index_entry_->ReplaceFtChunkIndexEntries(chunk_index_entry);
+                    LOG_INFO(fmt::format("Merged {} full-text index chunks of {} rows into {}",
+                                         chunk_merge.chunk_index_entries_.size(),
+                                         chunk_merge.row_count_,
+                                         chunk_merge.dst_base_name_));
                 }
+                // OPTIMIZE invoke this func at which the txn hasn't been commited yet.
+                TxnTimeStamp ts = std::max(txn->BeginTS(), txn->CommitTS());
+                assert(ts >= table_index_entry->GetFulltexSegmentUpdateTs());
+                table_index_entry->UpdateFulltextSegmentTs(ts);
                 break;
             }
             case IndexType::kHnsw: {
                 TxnTimeStamp begin_ts = txn->BeginTS();
+                struct ChunkRebuild {
+                    SegmentIndexEntry *segment_index_entry_{};
+                    SharedPtr<SegmentEntry> segment_entry_{};
+                    SharedPtr<ChunkIndexEntry> merged_chunk_index_entry_{};
+                    Vector<ChunkIndexEntry *> old_chunks_{};
+                };
+                Vector<ChunkRebuild> chunk_rebuilds;
                 for (auto &[segment_id, segment_index_entry] : table_index_entry->index_by_segment()) {
-                    SegmentEntry *segment_entry = GetSegmentByID(segment_id, begin_ts).get();
-                    if (segment_entry != nullptr) {
-                        auto *merged_chunk_entry = segment_index_entry->RebuildChunkIndexEntries(txn_table_store, segment_entry);
-                        if (merged_chunk_entry != nullptr) {
-                            merged_chunk_entry->SaveIndexFile();
+                    SharedPtr<SegmentEntry> segment_entry = GetSegmentByID(segment_id, begin_ts);
+                    if (segment_entry.get() != nullptr) {
+                        ChunkRebuild &chunk_rebuild = chunk_rebuilds.emplace_back();
+                        chunk_rebuild.segment_index_entry_ = segment_index_entry.get();
+                        chunk_rebuild.segment_entry_ = std::move(segment_entry);
+                    }
+                }
+                if (chunk_rebuilds.empty()) {
+                    break;
+                }
+
+                // The segments are rebuilt in parallel, each with its share of the index build threads. The index files are written by
+                // the rebuilding threads as well.
+                SizeT thread_budget = std::max<SizeT>(1, txn->txn_mgr()->index_build_thread_num());
+                SizeT thread_n = std::min(thread_budget, chunk_rebuilds.size());
+                SizeT build_thread_n = thread_budget / thread_n;
+                Atomic<SizeT> next_rebuild_idx = 0;
+                std::mutex rebuild_error_mutex;
+                std::exception_ptr rebuild_error;
+                auto rebuild_worker = [&] {
+                    try {
+                        while (true) {
+                            SizeT rebuild_idx = next_rebuild_idx.fetch_add(1);
+                            if (rebuild_idx >= chunk_rebuilds.size()) {
+                                break;
+                            }
+                            ChunkRebuild &chunk_rebuild = chunk_rebuilds[rebuild_idx];
+                            chunk_rebuild.merged_chunk_index_entry_ =
+                                chunk_rebuild.segment_index_entry_->RebuildChunkIndexEntries(txn,
+                                                                                             chunk_rebuild.segment_entry_.get(),
+                                                                                             build_thread_n,
+                                                                                             chunk_rebuild.old_chunks_);
+                        }
+                    } catch (...) {
+                        // The other workers stop at their next segment, the error is rethrown once they are joined.
+                        next_rebuild_idx = chunk_rebuilds.size();
+                        std::lock_guard lock(rebuild_error_mutex);
+                        if (!rebuild_error) {
+                            rebuild_error = std::current_exception();
                         }
                     }
+                };
+                Vector<Thread> rebuild_threads;
+                for (SizeT i = 1; i < thread_n; i++) {
+                    rebuild_threads.emplace_back(rebuild_worker);
+                }
+                rebuild_worker();
+                for (auto &rebuild_thread : rebuild_threads) {
+                    rebuild_thread.join();
+                }
+                if (rebuild_error) {
+                    std::rethrow_exception(rebuild_error);
+                }
+
+                // The txn store isn't thread safe, the merged chunks are registered here.
+                for (auto &chunk_rebuild : chunk_rebuilds) {
+                    if (chunk_rebuild.merged_chunk_index_entry_.get() == nullptr) {
+                        continue;
+                    }
+                    txn_table_store->AddChunkIndexStore(table_index_entry, chunk_rebuild.merged_chunk_index_entry_.get());
+                    chunk_rebuild.segment_index_entry_->ReplaceChunkIndexEntries(txn_table_store,
+                                                                                 chunk_rebuild.merged_chunk_index_entry_,
+                                                                                 std::move(chunk_rebuild.old_chunks_));
                 }
                 break;
             }
@@ -1067,6 +1245,7 @@ void TableEntry::PickCleanup(CleanupScanner *scanner) {
                 scanner->AddEntry(std::move(iter->second));
                 iter = segment_map_.erase(iter);
             } else {
+                segment->PickCleanup(scanner);
                 ++iter;
             }
         }
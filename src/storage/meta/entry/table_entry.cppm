@@ -150,6 +150,8 @@ public:
 
     Status RollbackDelete(TransactionID txn_id, DeleteState &append_state, BufferManager *buffer_mgr);
 
+    Status Update(TransactionID txn_id, void *txn_store, TxnTimeStamp commit_ts, Vector<UpdateState> &update_states);
+
     Status CommitCompact(TransactionID txn_id, TxnTimeStamp commit_ts, TxnCompactStore &compact_state);
 
     Status RollbackCompact(TransactionID txn_id, TxnTimeStamp commit_ts, const TxnCompactStore &compact_state);
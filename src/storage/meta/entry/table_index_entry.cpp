@@ -118,7 +118,9 @@ bool TableIndexEntry::GetOrCreateSegment(SegmentID segment_id, Txn *txn, SharedP
     std::unique_lock w_lock(rw_locker_);
     auto iter = index_by_segment_.find(segment_id);
     if (iter == index_by_segment_.end()) {
-        auto create_index_param = SegmentIndexEntry::GetCreateIndexParam(index_base_, DEFAULT_SEGMENT_CAPACITY, column_def_);
+        // The parts of a secondary index are added as the segment grows, see SegmentIndexEntry::BuildSecondaryIndex.
+        SizeT seg_row_count = index_base_->index_type_ == IndexType::kSecondary ? 0 : DEFAULT_SEGMENT_CAPACITY;
+        auto create_index_param = SegmentIndexEntry::GetCreateIndexParam(index_base_, seg_row_count, column_def_);
         segment_index_entry = SegmentIndexEntry::NewIndexEntry(this, segment_id, txn, create_index_param.get());
         index_by_segment_.emplace(segment_id, segment_index_entry);
         created = true;
@@ -239,7 +241,9 @@ SharedPtr<ChunkIndexEntry> TableIndexEntry::MemIndexDump(TxnIndexStore *txn_inde
     SharedPtr<ChunkIndexEntry> chunk_index_entry = nullptr;
     if (last_segment_.get() != nullptr) {
         chunk_index_entry = last_segment_->MemIndexDump();
-        txn_index_store->chunk_index_entries_.push_back(chunk_index_entry.get());
+        if (chunk_index_entry.get() != nullptr) {
+            txn_index_store->chunk_index_entries_.push_back(chunk_index_entry.get());
+        }
     }
     return chunk_index_entry;
 }
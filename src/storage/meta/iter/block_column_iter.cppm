@@ -32,7 +32,8 @@ export template <bool CheckTS = true>
 class BlockColumnIter {
 public:
     BlockColumnIter(BlockColumnEntry *entry, BufferManager *buffer_mgr, TxnTimeStamp iterate_ts)
-        : block_entry_(entry->GetBlockEntry()), column_vector_(MakeShared<ColumnVector>(entry->GetColumnVector(buffer_mgr))),
+        : block_entry_(entry->GetBlockEntry()),
+          column_vector_(MakeShared<ColumnVector>(entry->GetColumnVector(buffer_mgr, entry->GetBlockEntry()->row_count(), iterate_ts))),
           ele_size_(entry->column_type()->Size()), iterate_ts_(iterate_ts), offset_(0), read_end_(0) {}
     // TODO: Does `ColumnVector` implements the move constructor?
 
@@ -67,8 +68,9 @@ private:
 export template <>
 class BlockColumnIter<false> {
 public:
-    BlockColumnIter(BlockColumnEntry *entry, BufferManager *buffer_mgr, TxnTimeStamp)
-        : block_entry_(entry->GetBlockEntry()), column_vector_(MakeShared<ColumnVector>(entry->GetColumnVector(buffer_mgr))),
+    BlockColumnIter(BlockColumnEntry *entry, BufferManager *buffer_mgr, TxnTimeStamp iterate_ts)
+        : block_entry_(entry->GetBlockEntry()),
+          column_vector_(MakeShared<ColumnVector>(entry->GetColumnVector(buffer_mgr, entry->GetBlockEntry()->row_count(), iterate_ts))),
           ele_size_(entry->column_type()->Size()), size_(block_entry_->row_count()), offset_(0) {}
 
     Optional<Pair<const void *, BlockOffset>> Next() {
@@ -95,8 +97,14 @@ private:
 export template <typename DataType>
 class MemIndexInserterIter {
 public:
-    MemIndexInserterIter(SegmentOffset block_offset, BlockColumnEntry *entry, BufferManager *buffer_mgr, SizeT offset, SizeT size)
-        : block_offset_(block_offset), column_vector_(MakeShared<ColumnVector>(entry->GetColumnVector(buffer_mgr))),
+    MemIndexInserterIter(SegmentOffset block_offset,
+                         BlockColumnEntry *entry,
+                         BufferManager *buffer_mgr,
+                         SizeT offset,
+                         SizeT size,
+                         TxnTimeStamp iterate_ts)
+        : block_offset_(block_offset),
+          column_vector_(MakeShared<ColumnVector>(entry->GetColumnVector(buffer_mgr, offset + size, iterate_ts))),
           ele_size_(entry->column_type()->Size()), cur_(offset), end_(offset + size) {}
 
     Optional<Pair<const DataType *, SegmentOffset>> Next() {
@@ -0,0 +1,159 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <thread>
+
+module mem_index_appender;
+
+import stl;
+import buffer_manager;
+import block_entry;
+import segment_index_entry;
+import logger;
+import third_party;
+import infinity_exception;
+
+namespace infinity {
+
+MemIndexAppender::MemIndexAppender(SizeT worker_num) : worker_num_(std::max<SizeT>(worker_num, 1)) {}
+
+MemIndexAppender::~MemIndexAppender() { Stop(); }
+
+void MemIndexAppender::Start() {
+    std::lock_guard lock(mutex_);
+    stop_ = false;
+    for (SizeT i = workers_.size(); i < worker_num_; ++i) {
+        workers_.emplace_back([this] { Process(); });
+    }
+    LOG_INFO(fmt::format("Realtime index appender is started with {} workers.", worker_num_));
+}
+
+void MemIndexAppender::Stop() {
+    {
+        std::lock_guard lock(mutex_);
+        if (workers_.empty()) {
+            return;
+        }
+        stop_ = true;
+    }
+    task_cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    LOG_INFO("Realtime index appender is stopped.");
+}
+
+void MemIndexAppender::Submit(SharedPtr<SegmentIndexEntry> segment_index_entry,
+                              SharedPtr<BlockEntry> block_entry,
+                              u32 row_offset,
+                              u32 row_count,
+                              TxnTimeStamp commit_ts,
+                              BufferManager *buffer_mgr) {
+    SegmentIndexEntry *key = segment_index_entry.get();
+    {
+        std::lock_guard lock(mutex_);
+        auto &queue = queues_[key];
+        bool idle = queue.empty();
+        queue.push_back(AppendTask{std::move(segment_index_entry),
+                                   std::move(block_entry),
+                                   row_offset,
+                                   row_count,
+                                   commit_ts,
+                                   buffer_mgr,
+                                   std::chrono::steady_clock::now()});
+        pending_rows_ += row_count;
+        if (!idle) {
+            // a worker is inserting the queue, or the queue is ready already
+            return;
+        }
+        ready_.push_back(key);
+    }
+    task_cv_.notify_one();
+}
+
+void MemIndexAppender::WaitSegmentIndex(SegmentIndexEntry *segment_index_entry) {
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [&] { return !queues_.contains(segment_index_entry); });
+}
+
+void MemIndexAppender::WaitAll() {
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [&] { return queues_.empty(); });
+}
+
+SizeT MemIndexAppender::pending_rows() const {
+    std::lock_guard lock(mutex_);
+    return pending_rows_;
+}
+
+SizeT MemIndexAppender::pending_rows(SegmentIndexEntry *segment_index_entry) const {
+    std::lock_guard lock(mutex_);
+    auto iter = queues_.find(segment_index_entry);
+    if (iter == queues_.end()) {
+        return 0;
+    }
+    SizeT row_count = 0;
+    for (const auto &task : iter->second) {
+        row_count += task.row_count_;
+    }
+    return row_count;
+}
+
+i64 MemIndexAppender::lag_ms() const {
+    std::lock_guard lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    i64 lag = 0;
+    for (const auto &[_, queue] : queues_) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - queue.front().submit_time_).count();
+        lag = std::max<i64>(lag, elapsed);
+    }
+    return lag;
+}
+
+void MemIndexAppender::Process() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        task_cv_.wait(lock, [this] { return stop_ || !ready_.empty(); });
+        if (ready_.empty()) {
+            // stopped and no row is pending
+            break;
+        }
+        SegmentIndexEntry *key = ready_.front();
+        ready_.pop_front();
+        auto &queue = queues_[key];
+        while (!queue.empty()) {
+            AppendTask task = queue.front();
+            lock.unlock();
+            try {
+                task.segment_index_entry_->MemIndexInsert(task.block_entry_, task.row_offset_, task.row_count_, task.commit_ts_, task.buffer_mgr_);
+            } catch (const std::exception &e) {
+                // Skipping the rows would leave them out of the index for good, crash and rebuild the index from the wal instead.
+                String error_message =
+                    fmt::format("Realtime index insertion of segment {} failed: {}", task.segment_index_entry_->segment_id(), e.what());
+                LOG_CRITICAL(error_message);
+                UnrecoverableError(error_message);
+            }
+            lock.lock();
+            queue.pop_front();
+            pending_rows_ -= task.row_count_;
+        }
+        queues_.erase(key);
+        done_cv_.notify_all();
+    }
+}
+
+} // namespace infinity
@@ -0,0 +1,89 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module mem_index_appender;
+
+import stl;
+import buffer_manager;
+import block_entry;
+import segment_index_entry;
+
+namespace infinity {
+
+// Inserts the rows of committed appends into the realtime indexes (memory HNSW and full-text indexer) in the background, so that a
+// commit doesn't wait for the index. The appended rows are visible at once: until inserted, the knn scan searches them by brute force
+// after the indexed rows of the segment.
+// The rows of a segment index are inserted in RowID order, by one worker at a time. Different segment indexes are inserted in parallel.
+export class MemIndexAppender {
+public:
+    explicit MemIndexAppender(SizeT worker_num);
+
+    ~MemIndexAppender();
+
+    void Start();
+
+    // Insert the pending rows and join the workers.
+    void Stop();
+
+    void Submit(SharedPtr<SegmentIndexEntry> segment_index_entry,
+                SharedPtr<BlockEntry> block_entry,
+                u32 row_offset,
+                u32 row_count,
+                TxnTimeStamp commit_ts,
+                BufferManager *buffer_mgr);
+
+    // Block until the rows submitted for the segment index are inserted.
+    void WaitSegmentIndex(SegmentIndexEntry *segment_index_entry);
+
+    // Block until all the submitted rows are inserted.
+    void WaitAll();
+
+    SizeT pending_rows() const;
+
+    // The rows submitted for the segment index and not inserted yet.
+    SizeT pending_rows(SegmentIndexEntry *segment_index_entry) const;
+
+    // Milliseconds since the oldest pending rows were submitted, 0 if no row is pending.
+    i64 lag_ms() const;
+
+private:
+    struct AppendTask {
+        SharedPtr<SegmentIndexEntry> segment_index_entry_{};
+        SharedPtr<BlockEntry> block_entry_{};
+        u32 row_offset_{};
+        u32 row_count_{};
+        TxnTimeStamp commit_ts_{};
+        BufferManager *buffer_mgr_{};
+        std::chrono::steady_clock::time_point submit_time_{};
+    };
+
+    void Process();
+
+    const SizeT worker_num_{};
+    Vector<Thread> workers_{};
+
+    mutable std::mutex mutex_{};
+    std::condition_variable task_cv_{};
+    std::condition_variable done_cv_{};
+    // The tasks of a segment index stay in its queue until inserted, an empty queue is removed.
+    HashMap<SegmentIndexEntry *, Deque<AppendTask>> queues_{};
+    // The segment indexes with tasks and no worker.
+    Deque<SegmentIndexEntry *> ready_{};
+    SizeT pending_rows_{};
+    bool stop_{false};
+};
+
+} // namespace infinity
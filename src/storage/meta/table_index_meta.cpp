@@ -33,6 +33,9 @@ import extra_ddl_info;
 import local_file_system;
 import txn;
 import create_index_info;
+import segment_index_entry;
+import chunk_index_entry;
+import chunk_merge_policy;
 
 namespace infinity {
 
@@ -127,6 +130,19 @@ TableIndexMeta::GetTableIndexInfo(std::shared_lock<std::shared_mutex> &&r_lock,
     table_index_info->segment_index_count_ = table_index_entry->index_by_segment().size();
 
     auto index_base = table_index_entry->index_base();
+    TieredChunkMergePolicy merge_policy;
+    for (const auto &[segment_id, segment_index_entry] : table_index_entry->index_by_segment()) {
+        Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries;
+        segment_index_entry->GetChunkIndexEntries(chunk_index_entries);
+        table_index_info->chunk_index_count_ += chunk_index_entries.size();
+        if (index_base->index_type_ == IndexType::kFullText) {
+            Vector<u32> chunk_row_counts;
+            for (const auto &chunk_index_entry : chunk_index_entries) {
+                chunk_row_counts.push_back(chunk_index_entry->row_count_);
+            }
+            table_index_info->merge_debt_rows_ += merge_policy.MergeDebt(std::move(chunk_row_counts));
+        }
+    }
     table_index_info->index_type_ = MakeShared<String>(IndexInfo::IndexTypeToString(index_base->index_type_));
     table_index_info->index_other_params_ = MakeShared<String>(index_base->BuildOtherParamsString());
 
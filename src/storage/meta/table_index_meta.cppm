@@ -74,6 +74,16 @@ public:
         return index_entry_list_.GetEntryNolock(txn_id, begin_ts);
     }
 
+    // The newest entry whatever its txn, committed or not, nullptr if the index is dropped.
+    TableIndexEntry *GetLatestEntryNolock() {
+        std::shared_lock r_lock(index_entry_list_.rw_locker_);
+        if (index_entry_list_.entry_list_.empty()) {
+            return nullptr;
+        }
+        TableIndexEntry *entry = index_entry_list_.entry_list_.front().get();
+        return entry->Deleted() ? nullptr : entry;
+    }
+
     void DeleteEntry(TransactionID txn_id);
 
     // replay
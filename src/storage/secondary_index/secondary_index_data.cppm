@@ -171,8 +171,12 @@ public:
 
     ~SecondaryIndexDataHead() = default;
 
+    // used when the index of a sealed segment is rebuilt in place
+    SecondaryIndexDataHead &operator=(SecondaryIndexDataHead &&other) = default;
+
     [[nodiscard]] u32 GetPartCapacity() const { return part_capacity_; }
     [[nodiscard]] u32 GetPartNum() const { return part_num_; }
+    [[nodiscard]] u32 GetFullDataNum() const { return full_data_num_; }
     [[nodiscard]] u32 GetDataNum() const { return data_num_; }
 
     [[nodiscard]] auto SearchPGM(const void *val_ptr) const {
@@ -216,6 +220,9 @@ public:
 
     ~SecondaryIndexDataPart() = default;
 
+    // used when the index of a sealed segment is rebuilt in place
+    SecondaryIndexDataPart &operator=(SecondaryIndexDataPart &&other) = default;
+
     [[nodiscard]] u32 GetPartId() const { return part_id_; }
 
     [[nodiscard]] u32 GetPartSize() const { return part_size_; }
@@ -0,0 +1,118 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <vector>
+
+module secondary_index_in_mem;
+
+import stl;
+import column_vector;
+import data_type;
+import logical_type;
+import internal_types;
+import secondary_index_data;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+template <typename RawValueType>
+class SecondaryIndexInMemT final : public SecondaryIndexInMem {
+public:
+    using KeyType = ConvertToOrderedType<RawValueType>;
+
+    explicit SecondaryIndexInMemT(SegmentOffset begin_offset) : SecondaryIndexInMem(begin_offset) {}
+
+    u32 GetRowCount() const final {
+        std::shared_lock lock(rw_mutex_);
+        return in_mem_index_.size();
+    }
+
+    void Insert(const ColumnVector &column_vector, u32 row_offset, u32 row_count, SegmentOffset segment_offset) final {
+        auto column_data = reinterpret_cast<const RawValueType *>(column_vector.data());
+        std::unique_lock lock(rw_mutex_);
+        for (u32 i = 0; i < row_count; ++i) {
+            if (segment_offset + i < begin_offset_) {
+                continue;
+            }
+            in_mem_index_.emplace(ConvertToOrderedKeyValue<RawValueType>(column_data[row_offset + i]), segment_offset + i);
+        }
+    }
+
+    void RangeQuery(const void *begin_val, const void *end_val, u32 row_limit, Vector<u32> &offsets) const final {
+        const KeyType begin_key = *static_cast<const KeyType *>(begin_val);
+        const KeyType end_key = *static_cast<const KeyType *>(end_val);
+        const SizeT old_size = offsets.size();
+        {
+            std::shared_lock lock(rw_mutex_);
+            for (auto iter = in_mem_index_.lower_bound(begin_key); iter != in_mem_index_.end() and iter->first <= end_key; ++iter) {
+                if (iter->second < row_limit) {
+                    offsets.push_back(iter->second);
+                }
+            }
+        }
+        std::sort(offsets.begin() + old_size, offsets.end());
+    }
+
+private:
+    mutable std::shared_mutex rw_mutex_{};
+    MultiMap<KeyType, SegmentOffset> in_mem_index_{};
+};
+
+SharedPtr<SecondaryIndexInMem> GetSecondaryIndexInMem(const SharedPtr<DataType> &data_type, SegmentOffset begin_offset) {
+    if (!(data_type->CanBuildSecondaryIndex())) {
+        UnrecoverableError(fmt::format("Cannot build secondary index on data type: {}", data_type->ToString()));
+        return nullptr;
+    }
+    switch (data_type->type()) {
+        case LogicalType::kTinyInt: {
+            return MakeShared<SecondaryIndexInMemT<TinyIntT>>(begin_offset);
+        }
+        case LogicalType::kSmallInt: {
+            return MakeShared<SecondaryIndexInMemT<SmallIntT>>(begin_offset);
+        }
+        case LogicalType::kInteger: {
+            return MakeShared<SecondaryIndexInMemT<IntegerT>>(begin_offset);
+        }
+        case LogicalType::kBigInt: {
+            return MakeShared<SecondaryIndexInMemT<BigIntT>>(begin_offset);
+        }
+        case LogicalType::kFloat: {
+            return MakeShared<SecondaryIndexInMemT<FloatT>>(begin_offset);
+        }
+        case LogicalType::kDouble: {
+            return MakeShared<SecondaryIndexInMemT<DoubleT>>(begin_offset);
+        }
+        case LogicalType::kDate: {
+            return MakeShared<SecondaryIndexInMemT<DateT>>(begin_offset);
+        }
+        case LogicalType::kTime: {
+            return MakeShared<SecondaryIndexInMemT<TimeT>>(begin_offset);
+        }
+        case LogicalType::kDateTime: {
+            return MakeShared<SecondaryIndexInMemT<DateTimeT>>(begin_offset);
+        }
+        case LogicalType::kTimestamp: {
+            return MakeShared<SecondaryIndexInMemT<TimestampT>>(begin_offset);
+        }
+        default: {
+            UnrecoverableError(fmt::format("Need to add secondary index support for data type: {}", data_type->ToString()));
+            return nullptr;
+        }
+    }
+}
+
+} // namespace infinity
@@ -0,0 +1,53 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module secondary_index_in_mem;
+
+import stl;
+import column_vector;
+import data_type;
+
+namespace infinity {
+
+// The secondary index of the rows appended to a segment after its PGM index was built.
+// The (key, segment offset) pairs are kept in an ordered tree, so a range of keys is found without sorting the rows on each query.
+// The rows are moved into the PGM index when the segment is sealed, see SegmentIndexEntry::BuildSecondaryIndex.
+export class SecondaryIndexInMem {
+public:
+    explicit SecondaryIndexInMem(SegmentOffset begin_offset) : begin_offset_(begin_offset) {}
+
+    virtual ~SecondaryIndexInMem() = default;
+
+    // The rows before begin_offset are in the PGM index.
+    SegmentOffset begin_offset() const { return begin_offset_; }
+
+    virtual u32 GetRowCount() const = 0;
+
+    // Insert the rows [row_offset, row_offset + row_count) of the column vector, the first one at segment_offset in the segment.
+    // The rows before begin_offset are skipped.
+    virtual void Insert(const ColumnVector &column_vector, u32 row_offset, u32 row_count, SegmentOffset segment_offset) = 0;
+
+    // Append the sorted segment offsets of the rows whose key is in [begin_val, end_val] and offset is below row_limit.
+    // begin_val and end_val point to the ordered key type, see ConvertToOrderedType.
+    virtual void RangeQuery(const void *begin_val, const void *end_val, u32 row_limit, Vector<u32> &offsets) const = 0;
+
+protected:
+    const SegmentOffset begin_offset_{};
+};
+
+export SharedPtr<SecondaryIndexInMem> GetSecondaryIndexInMem(const SharedPtr<DataType> &data_type, SegmentOffset begin_offset);
+
+} // namespace infinity
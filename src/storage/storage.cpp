@@ -67,7 +67,13 @@ void Storage::Init() {
     builtin_functions.Init();
     // Catalog finish init here.
 
-    bg_processor_ = MakeUnique<BGTaskProcessor>(wal_mgr_.get(), new_catalog_.get());
+    BGTaskProcessorOptions bg_processor_options;
+    bg_processor_options.index_build_thread_num_ = config_ptr_->background_index_build_thread_num();
+    bg_processor_options.checkpoint_nice_ = config_ptr_->background_checkpoint_nice();
+    bg_processor_options.index_build_nice_ = config_ptr_->background_index_build_nice();
+    bg_processor_options.cleanup_nice_ = config_ptr_->background_cleanup_nice();
+    bg_processor_options.io_rate_limit_ = config_ptr_->background_io_rate_limit();
+    bg_processor_ = MakeUnique<BGTaskProcessor>(wal_mgr_.get(), new_catalog_.get(), bg_processor_options);
     // Construct txn manager
     std::chrono::seconds compact_interval = config_ptr_->compact_interval();
     bool enable_compaction = compact_interval.count() > 0;
@@ -77,13 +83,14 @@ void Storage::Init() {
                                       wal_mgr_.get(),
                                       new_catalog_->next_txn_id_,
                                       system_start_ts,
-                                      enable_compaction);
+                                      enable_compaction,
+                                      config_ptr_->index_build_thread_num());
 
     std::chrono::seconds optimize_interval = config_ptr_->optimize_interval();
     bool enable_optimize = optimize_interval.count() > 0;
 
     if (enable_compaction || enable_optimize) {
-        compact_processor_ = MakeUnique<CompactionProcessor>(new_catalog_.get(), txn_mgr_.get());
+        compact_processor_ = MakeUnique<CompactionProcessor>(new_catalog_.get(), txn_mgr_.get(), config_ptr_->background_io_rate_limit());
     } else {
         LOG_WARN("Compact interval is not set, auto compact is disable");
     }
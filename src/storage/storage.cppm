@@ -43,6 +43,9 @@ public:
 
     [[nodiscard]] inline BGTaskProcessor *bg_processor() const noexcept { return bg_processor_.get(); }
 
+    // nullptr if neither compaction nor optimize is enabled
+    [[nodiscard]] inline CompactionProcessor *compaction_processor() const noexcept { return compact_processor_.get(); }
+
     void Init();
 
     void UnInit();
@@ -113,6 +113,31 @@ Status Txn::Delete(const String &db_name, const String &table_name, const Vector
     return delete_status;
 }
 
+Status Txn::Update(const String &db_name,
+                  const String &table_name,
+                  const Vector<RowID> &row_ids,
+                  const Vector<ColumnID> &column_ids,
+                  const SharedPtr<DataBlock> &values,
+                  bool check_conflict) {
+    this->CheckTxn(db_name);
+
+    auto [table_entry, status] = GetTableByName(db_name, table_name);
+    if (!status.ok()) {
+        return status;
+    }
+    // An update conflicts with compaction the same way as a delete.
+    if (check_conflict && table_entry->CheckDeleteConflict(row_ids, txn_id_)) {
+        LOG_WARN(fmt::format("Rollback update in table {} due to conflict.", table_name));
+        RecoverableError(Status::TxnRollback(TxnID()));
+    }
+
+    TxnTableStore *table_store = this->GetTxnTableStore(table_name);
+
+    wal_entry_->cmds_.push_back(MakeShared<WalCmdUpdate>(db_name, table_name, row_ids, column_ids, values));
+    auto [err_msg, update_status] = table_store->Update(row_ids, column_ids, values);
+    return update_status;
+}
+
 Status
 Txn::Compact(TableEntry *table_entry, Vector<Pair<SharedPtr<SegmentEntry>, Vector<SegmentEntry *>>> &&segment_data, CompactSegmentsTaskType type) {
     const String &table_name = *table_entry->GetTableName();
@@ -462,7 +487,13 @@ void Txn::CommitBottom() {
         txn_store_.CommitBottom(txn_id_, commit_ts);
 
         txn_store_.AddDeltaOp(local_catalog_delta_ops_entry_.get(), txn_mgr_);
+    }
+    LOG_TRACE(fmt::format("Txn bottom: {} is applied.", txn_id_));
+}
 
+// The commits may be applied concurrently, the sequences of the delta entries are taken here in the commit_ts order.
+void Txn::PostCommitBottom() {
+    if (txn_context_.GetTxnState() != TxnState::kToRollback) {
         // Don't need to write empty CatalogDeltaEntry (read-only transactions).
         if (!local_catalog_delta_ops_entry_->operations().empty()) {
             local_catalog_delta_ops_entry_->SaveState(txn_id_, txn_context_.GetCommitTS(), txn_mgr_->NextSequence());
@@ -91,8 +91,12 @@ public:
 
     bool CheckConflict();
 
+    bool GetCommitTables(Vector<TableEntry *> &table_entries) const { return txn_store_.GetCommitTables(table_entries); }
+
     void CommitBottom();
 
+    void PostCommitBottom();
+
     void CancelCommitBottom();
 
     void Rollback();
@@ -160,6 +164,14 @@ public:
 
     Status Delete(const String &db_name, const String &table_name, const Vector<RowID> &row_ids, bool check_conflict = true);
 
+    // Update the columns of the rows in place, row i of values holds the new values of row_ids[i].
+    Status Update(const String &db_name,
+                  const String &table_name,
+                  const Vector<RowID> &row_ids,
+                  const Vector<ColumnID> &column_ids,
+                  const SharedPtr<DataBlock> &values,
+                  bool check_conflict = true);
+
     Status
     Compact(TableEntry *table_entry, Vector<Pair<SharedPtr<SegmentEntry>, Vector<SegmentEntry *>>> &&segment_data, CompactSegmentsTaskType type);
 
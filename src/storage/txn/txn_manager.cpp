@@ -41,9 +41,10 @@ TxnManager::TxnManager(Catalog *catalog,
                        WalManager *wal_mgr,
                        TransactionID start_txn_id,
                        TxnTimeStamp start_ts,
-                       bool enable_compaction)
+                       bool enable_compaction,
+                       SizeT index_build_thread_num)
     : catalog_(catalog), buffer_mgr_(buffer_mgr), bg_task_processor_(bg_task_processor), wal_mgr_(wal_mgr), start_txn_id_(start_txn_id),
-      start_ts_(start_ts), is_running_(false), enable_compaction_(enable_compaction) {
+      start_ts_(start_ts), is_running_(false), enable_compaction_(enable_compaction), index_build_thread_num_(index_build_thread_num) {
     catalog_->SetTxnMgr(this);
 }
 
@@ -37,7 +37,8 @@ public:
                         WalManager *wal_mgr,
                         TransactionID start_txn_id,
                         TxnTimeStamp start_ts,
-                        bool enable_compaction);
+                        bool enable_compaction,
+                        SizeT index_build_thread_num);
 
     ~TxnManager() { Stop(); }
 
@@ -89,6 +90,8 @@ public:
 
     bool enable_compaction() const { return enable_compaction_; }
 
+    SizeT index_build_thread_num() const { return index_build_thread_num_; }
+
     u64 NextSequence() { return ++sequence_; }
 
 private:
@@ -114,8 +117,9 @@ private:
     // For stop the txn manager
     atomic_bool is_running_{false};
     bool enable_compaction_{};
+    SizeT index_build_thread_num_{};
 
-    u64 sequence_{};
+    Atomic<u64> sequence_{};
 };
 
 } // namespace infinity
@@ -37,6 +37,9 @@ import background_process;
 import bg_task;
 import compact_segments_task;
 import build_fast_rough_filter_task;
+import table_index_meta;
+import table_index_entry;
+import index_base;
 
 namespace infinity {
 
@@ -214,6 +217,24 @@ Tuple<UniquePtr<String>, Status> TxnTableStore::Delete(const Vector<RowID> &row_
     return {nullptr, Status::OK()};
 }
 
+Tuple<UniquePtr<String>, Status>
+TxnTableStore::Update(const Vector<RowID> &row_ids, const Vector<ColumnID> &column_ids, const SharedPtr<DataBlock> &values) {
+    if (values->column_count() != column_ids.size() || values->row_count() != row_ids.size()) {
+        UnrecoverableError("Update values mismatch the updated rows and columns");
+    }
+    UpdateState &update_state = update_states_.emplace_back();
+    update_state.column_ids_ = column_ids;
+    update_state.values_ = values;
+    for (SizeT idx = 0; idx < row_ids.size(); ++idx) {
+        const RowID &row_id = row_ids[idx];
+        BlockID block_id = row_id.segment_offset_ / DEFAULT_BLOCK_CAPACITY;
+        BlockOffset block_offset = row_id.segment_offset_ % DEFAULT_BLOCK_CAPACITY;
+        update_state.rows_[row_id.segment_id_][block_id].emplace_back(block_offset, u32(idx));
+    }
+
+    return {nullptr, Status::OK()};
+}
+
 Tuple<UniquePtr<String>, Status> TxnTableStore::Compact(Vector<Pair<SharedPtr<SegmentEntry>, Vector<SegmentEntry *>>> &&segment_data,
                                                         CompactSegmentsTaskType type) {
     if (compact_state_.task_type_ != CompactSegmentsTaskType::kInvalid) {
@@ -242,6 +263,7 @@ void TxnTableStore::Rollback(TransactionID txn_id, TxnTimeStamp abort_ts) {
     // }
     Catalog::RollbackCompact(table_entry_, txn_id, abort_ts, compact_state_);
     blocks_.clear();
+    update_states_.clear();
 
     for (auto &[table_index_entry, ptr_seq_n] : txn_indexes_) {
         table_index_entry->Cleanup();
@@ -262,6 +284,27 @@ bool TxnTableStore::CheckConflict(Catalog *catalog) const {
     if (latest_table_entry != table_entry_) {
         UnrecoverableError(fmt::format("Table entry should conflict, table name: {}", table_name));
     }
+    // The updates in place skipped the indexes visible at begin_ts, an index created since then on an updated column
+    // would not see the new values.
+    if (!update_states_.empty()) {
+        auto map_guard = table_entry_->IndexMetaMap();
+        for (auto &[index_name, table_index_meta] : *map_guard) {
+            TableIndexEntry *table_index_entry = table_index_meta->GetLatestEntryNolock();
+            if (table_index_entry == nullptr) {
+                continue;
+            }
+            for (const String &column_name : table_index_entry->index_base()->column_names_) {
+                ColumnID column_id = table_entry_->GetColumnIdByName(column_name);
+                for (const auto &update_state : update_states_) {
+                    if (std::find(update_state.column_ids_.begin(), update_state.column_ids_.end(), column_id) !=
+                        update_state.column_ids_.end()) {
+                        LOG_TRACE(fmt::format("Index {} was created on an updated column of table {}", index_name, table_name));
+                        return true;
+                    }
+                }
+            }
+        }
+    }
     return false;
 }
 
@@ -280,6 +323,9 @@ void TxnTableStore::PrepareCommit(TransactionID txn_id, TxnTimeStamp commit_ts,
         Catalog::CommitCompact(table_entry_, txn_id, commit_ts, compact_state_);
     }
 
+    // "update" needs to be ahead of "delete", see TableEntry::Update
+    Catalog::Update(table_entry_, txn_id, this, commit_ts, update_states_);
+
     Catalog::Delete(table_entry_, txn_id, this, commit_ts, delete_state_);
 
     for (const auto &[index_name, txn_index_store] : txn_indexes_store_) {
@@ -440,6 +486,16 @@ bool TxnStore::CheckConflict() const {
     return false;
 }
 
+bool TxnStore::GetCommitTables(Vector<TableEntry *> &table_entries) const {
+    if (!txn_dbs_.empty() || !txn_tables_.empty() || txn_tables_store_.empty()) {
+        return false;
+    }
+    for (const auto &[table_name, table_store] : txn_tables_store_) {
+        table_entries.push_back(table_store->table_entry_);
+    }
+    return true;
+}
+
 void TxnStore::PrepareCommit(TransactionID txn_id, TxnTimeStamp commit_ts, BufferManager *buffer_mgr) {
     for (const auto &[table_name, table_store] : txn_tables_store_) {
         table_store->PrepareCommit(txn_id, commit_ts, buffer_mgr);
@@ -108,6 +108,9 @@ public:
 
     Tuple<UniquePtr<String>, Status> Delete(const Vector<RowID> &row_ids);
 
+    // Row i of values holds the new values of row_ids[i].
+    Tuple<UniquePtr<String>, Status> Update(const Vector<RowID> &row_ids, const Vector<ColumnID> &column_ids, const SharedPtr<DataBlock> &values);
+
     Tuple<UniquePtr<String>, Status> Compact(Vector<Pair<SharedPtr<SegmentEntry>, Vector<SegmentEntry *>>> &&segment_data,
                                              CompactSegmentsTaskType type);
 
@@ -150,6 +153,7 @@ public:
 
     UniquePtr<AppendState> append_state_{};
     DeleteState delete_state_{};
+    Vector<UpdateState> update_states_{};
 
     SizeT current_block_id_{0};
 
@@ -178,6 +182,10 @@ public:
 
     bool CheckConflict() const;
 
+    // The tables whose data is committed. Return false if databases or tables are created or dropped or no table data is committed,
+    // e.g. a checkpoint, the commit is then applied alone, after the commits before it.
+    bool GetCommitTables(Vector<TableEntry *> &table_entries) const;
+
     void PrepareCommit(TransactionID txn_id, TxnTimeStamp commit_ts, BufferManager *buffer_mgr);
 
     void CommitBottom(TransactionID txn_id, TxnTimeStamp commit_ts);
@@ -213,6 +213,23 @@ SharedPtr<WalCmd> WalCmd::ReadAdv(char *&ptr, i32 max_bytes) {
             cmd = MakeShared<WalCmdDelete>(db_name, table_name, row_ids);
             break;
         }
+        case WalCommandType::UPDATE: {
+            String db_name = ReadBufAdv<String>(ptr);
+            String table_name = ReadBufAdv<String>(ptr);
+            i32 row_cnt = ReadBufAdv<i32>(ptr);
+            Vector<RowID> row_ids;
+            for (i32 i = 0; i < row_cnt; ++i) {
+                row_ids.push_back(ReadBufAdv<RowID>(ptr));
+            }
+            i32 column_cnt = ReadBufAdv<i32>(ptr);
+            Vector<ColumnID> column_ids;
+            for (i32 i = 0; i < column_cnt; ++i) {
+                column_ids.push_back(ReadBufAdv<ColumnID>(ptr));
+            }
+            SharedPtr<DataBlock> block = DataBlock::ReadAdv(ptr, ptr_end - ptr);
+            cmd = MakeShared<WalCmdUpdate>(db_name, table_name, row_ids, column_ids, block);
+            break;
+        }
         case WalCommandType::SET_SEGMENT_STATUS_SEALED: {
             String db_name = ReadBufAdv<String>(ptr);
             String table_name = ReadBufAdv<String>(ptr);
@@ -347,6 +364,15 @@ bool WalCmdDelete::operator==(const WalCmd &other) const {
     return true;
 }
 
+bool WalCmdUpdate::operator==(const WalCmd &other) const {
+    auto other_cmd = dynamic_cast<const WalCmdUpdate *>(&other);
+    if (other_cmd == nullptr || !IsEqual(db_name_, other_cmd->db_name_) || !IsEqual(table_name_, other_cmd->table_name_) ||
+        row_ids_ != other_cmd->row_ids_ || column_ids_ != other_cmd->column_ids_) {
+        return false;
+    }
+    return true;
+}
+
 bool WalCmdSetSegmentStatusSealed::operator==(const WalCmd &other) const {
     auto other_cmd = dynamic_cast<const WalCmdSetSegmentStatusSealed *>(&other);
     if (other_cmd == nullptr || !IsEqual(db_name_, other_cmd->db_name_) || !IsEqual(table_name_, other_cmd->table_name_) ||
@@ -428,6 +454,11 @@ i32 WalCmdDelete::GetSizeInBytes() const {
            row_ids_.size() * sizeof(RowID);
 }
 
+i32 WalCmdUpdate::GetSizeInBytes() const {
+    return sizeof(WalCommandType) + sizeof(i32) + this->db_name_.size() + sizeof(i32) + this->table_name_.size() + sizeof(i32) +
+           row_ids_.size() * sizeof(RowID) + sizeof(i32) + column_ids_.size() * sizeof(ColumnID) + block_->GetSizeInBytes();
+}
+
 i32 WalCmdSetSegmentStatusSealed::GetSizeInBytes() const {
     i32 sz = sizeof(WalCommandType) + ::infinity::GetSizeInBytes(db_name_) + ::infinity::GetSizeInBytes(table_name_) +
              ::infinity::GetSizeInBytes(segment_id_) + ::infinity::GetSizeInBytes(segment_filter_binary_data_);
@@ -523,6 +554,21 @@ void WalCmdDelete::WriteAdv(char *&buf) const {
     }
 }
 
+void WalCmdUpdate::WriteAdv(char *&buf) const {
+    WriteBufAdv(buf, WalCommandType::UPDATE);
+    WriteBufAdv(buf, this->db_name_);
+    WriteBufAdv(buf, this->table_name_);
+    WriteBufAdv(buf, static_cast<i32>(this->row_ids_.size()));
+    for (const auto &row_id : this->row_ids_) {
+        WriteBufAdv(buf, row_id);
+    }
+    WriteBufAdv(buf, static_cast<i32>(this->column_ids_.size()));
+    for (const auto column_id : this->column_ids_) {
+        WriteBufAdv(buf, column_id);
+    }
+    block_->WriteAdv(buf);
+}
+
 void WalCmdSetSegmentStatusSealed::WriteAdv(char *&buf) const {
     WriteBufAdv(buf, WalCommandType::SET_SEGMENT_STATUS_SEALED);
     WriteBufAdv(buf, this->db_name_);
@@ -729,6 +775,21 @@ String WalEntry::ToString() const {
                 ss << row_id.ToString() << " ";
             }
             ss << std::endl;
+        } else if (cmd->GetType() == WalCommandType::UPDATE) {
+            auto update_cmd = dynamic_cast<const WalCmdUpdate *>(cmd.get());
+            ss << "db name: " << update_cmd->db_name_ << std::endl;
+            ss << "table name: " << update_cmd->table_name_ << std::endl;
+            ss << "row ids: ";
+            for (const auto &row_id : update_cmd->row_ids_) {
+                ss << row_id.ToString() << " ";
+            }
+            ss << std::endl;
+            ss << "column ids: ";
+            for (const auto column_id : update_cmd->column_ids_) {
+                ss << column_id << " ";
+            }
+            ss << std::endl;
+            ss << update_cmd->block_->ToString();
         } else if (cmd->GetType() == WalCommandType::CREATE_INDEX) {
             auto create_index_cmd = dynamic_cast<const WalCmdCreateIndex *>(cmd.get());
             ss << "db name: " << create_index_cmd->db_name_ << std::endl;
@@ -780,6 +841,9 @@ String WalCmd::WalCommandTypeToString(WalCommandType type) {
         case WalCommandType::DELETE:
             command = "DELETE";
             break;
+        case WalCommandType::UPDATE:
+            command = "UPDATE";
+            break;
         case WalCommandType::SET_SEGMENT_STATUS_SEALED:
             command = "SET_SEGMENT_STATUS_SEALED";
             break;
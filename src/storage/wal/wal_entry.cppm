@@ -51,6 +51,7 @@ export enum class WalCommandType : i8 {
     IMPORT = 20,
     APPEND = 21,
     DELETE = 22,
+    UPDATE = 23,
 
     // -----------------------------
     // SEGMENT STATUS
@@ -263,6 +264,27 @@ export struct WalCmdDelete : public WalCmd {
     Vector<RowID> row_ids_{};
 };
 
+// in place update of fixed width columns, row i of block_ holds the new values of row_ids_[i]
+export struct WalCmdUpdate : public WalCmd {
+    WalCmdUpdate(String db_name,
+                 String table_name,
+                 const Vector<RowID> &row_ids,
+                 const Vector<ColumnID> &column_ids,
+                 const SharedPtr<DataBlock> &block)
+        : db_name_(std::move(db_name)), table_name_(std::move(table_name)), row_ids_(row_ids), column_ids_(column_ids), block_(block) {}
+
+    WalCommandType GetType() override { return WalCommandType::UPDATE; }
+    bool operator==(const WalCmd &other) const override;
+    [[nodiscard]] i32 GetSizeInBytes() const override;
+    void WriteAdv(char *&buf) const override;
+
+    String db_name_{};
+    String table_name_{};
+    Vector<RowID> row_ids_{};
+    Vector<ColumnID> column_ids_{};
+    SharedPtr<DataBlock> block_{};
+};
+
 // used when append op turn an old unsealed segment full and sealed
 // will always have necessary minmax filter
 // may have user-defined bloom filter
@@ -52,6 +52,7 @@ import table_index_entry;
 import log_file;
 import default_values;
 import defer_op;
+import txn_state;
 
 module wal_manager;
 
@@ -60,7 +61,7 @@ namespace infinity {
 WalManager::WalManager(Storage *storage, String wal_dir, u64 wal_size_threshold, u64 delta_checkpoint_interval_wal_bytes, FlushOption flush_option)
     : cfg_wal_size_threshold_(wal_size_threshold), cfg_delta_checkpoint_interval_wal_bytes_(delta_checkpoint_interval_wal_bytes), wal_dir_(wal_dir),
       wal_path_(wal_dir + "/" + WalFile::TempWalFilename()), storage_(storage), running_(false), flush_option_(flush_option), last_ckp_wal_size_(0),
-      checkpoint_in_progress_(false), last_ckp_ts_(UNCOMMIT_TS), last_full_ckp_ts_(UNCOMMIT_TS) {}
+      commit_thread_pool_(WAL_COMMIT_THREAD_NUM), checkpoint_in_progress_(false), last_ckp_ts_(UNCOMMIT_TS), last_full_ckp_ts_(UNCOMMIT_TS) {}
 
 WalManager::~WalManager() {
     if (running_.load()) {
@@ -157,6 +158,7 @@ void WalManager::Flush() {
         TxnManager *txn_mgr = storage_->txn_manager();
 
         Vector<SharedPtr<Txn>> txns;
+        Vector<WalEntry *> entries;
         for (const auto &entry : log_batch) {
             // Empty WalEntry (read-only transactions) shouldn't go into WalManager.
             if (entry == nullptr) {
@@ -164,34 +166,37 @@ void WalManager::Flush() {
                 running_ = false;
                 break;
             }
-            SharedPtr<Txn> txn = txn_mgr->GetTxnPtr(entry->txn_id_);
-            // Commit sequentially so they get visible in the same order with wal.
-            bool conflict = txn->CheckConflict();
-            txns.push_back(txn);
-            if (conflict) {
-                txn->SetTxnToRollback();
-                continue;
-            }
+            txns.push_back(txn_mgr->GetTxnPtr(entry->txn_id_));
+            entries.push_back(entry);
+        }
 
-            if (entry->cmds_.empty()) {
-                continue;
-                // UnrecoverableError(fmt::format("WalEntry of txn_id {} commands is empty", entry->txn_id_));
+        // Check the conflicts and serialize the wal entries in parallel. The conflicts are checked against the catalog committed before
+        // the batch, so the result doesn't depend on the order of the checks.
+        Vector<Vector<char>> bufs(txns.size());
+        if (txns.size() == 1) {
+            PrepareWalEntry(txns[0].get(), entries[0], bufs[0]);
+        } else {
+            Vector<future<void>> prepare_futures;
+            for (SizeT i = 0; i < txns.size(); ++i) {
+                prepare_futures.push_back(
+                    commit_thread_pool_.push([this, &txns, &entries, &bufs, i](int) { PrepareWalEntry(txns[i].get(), entries[i], bufs[i]); }));
+            }
+            for (auto &prepare_future : prepare_futures) {
+                prepare_future.get();
             }
+        }
 
-            i32 exp_size = entry->GetSizeInBytes();
-            Vector<char> buf(exp_size);
-            char *ptr = buf.data();
-            entry->WriteAdv(ptr);
-            i32 act_size = ptr - buf.data();
-            if (exp_size != act_size) {
-                UnrecoverableError(fmt::format("WalManager::Flush WalEntry estimated size {} differ with the actual one {}", exp_size, act_size));
+        // Write the wal in the commit_ts order.
+        for (SizeT i = 0; i < txns.size(); ++i) {
+            if (bufs[i].empty()) {
+                continue;
             }
-            ofs_.write(buf.data(), ptr - buf.data());
-            LOG_TRACE(fmt::format("WalManager::Flush done writing wal for txn_id {}, commit_ts {}", entry->txn_id_, entry->commit_ts_));
+            ofs_.write(bufs[i].data(), bufs[i].size());
+            LOG_TRACE(fmt::format("WalManager::Flush done writing wal for txn_id {}, commit_ts {}", entries[i]->txn_id_, entries[i]->commit_ts_));
 
             // update
-            max_commit_ts_ = entry->commit_ts_;
-            wal_size_ += act_size;
+            max_commit_ts_ = entries[i]->commit_ts_;
+            wal_size_ += bufs[i].size();
         }
 
         if (!running_.load()) {
@@ -215,9 +220,7 @@ void WalManager::Flush() {
 
         log_batch.clear();
 
-        for (auto txn : txns) {
-            txn->CommitBottom();
-        }
+        CommitBottoms(txns);
 
         // Check if the wal file is too large, swap to a new one.
         try {
@@ -247,6 +250,104 @@ void WalManager::Flush() {
     LOG_TRACE("WalManager::Flush mainloop end");
 }
 
+void WalManager::PrepareWalEntry(Txn *txn, WalEntry *entry, Vector<char> &buf) {
+    if (txn->CheckConflict()) {
+        txn->SetTxnToRollback();
+        return;
+    }
+    if (entry->cmds_.empty()) {
+        return;
+        // UnrecoverableError(fmt::format("WalEntry of txn_id {} commands is empty", entry->txn_id_));
+    }
+
+    i32 exp_size = entry->GetSizeInBytes();
+    buf.resize(exp_size);
+    char *ptr = buf.data();
+    entry->WriteAdv(ptr);
+    i32 act_size = ptr - buf.data();
+    if (exp_size != act_size) {
+        UnrecoverableError(fmt::format("WalManager::Flush WalEntry estimated size {} differ with the actual one {}", exp_size, act_size));
+    }
+}
+
+void WalManager::CommitBottoms(const Vector<SharedPtr<Txn>> &txns) {
+    // Apply the commits to the catalog, the commits of disjoint tables in parallel. The commits of a same table are applied in the
+    // commit_ts order by one thread, a commit changing the catalog itself is applied alone after all the commits before it. The
+    // delta entry sequences are then taken here in the commit_ts order, the global delta entry requires them to follow it.
+    SizeT begin = 0;
+    while (begin < txns.size()) {
+        Vector<Vector<Txn *>> groups;
+        HashMap<TableEntry *, SizeT> table_groups;
+        SizeT end = begin;
+        for (; end < txns.size(); ++end) {
+            Txn *txn = txns[end].get();
+            if (txn->GetTxnState() == TxnState::kToRollback) {
+                // nothing to apply
+                groups.push_back({txn});
+                continue;
+            }
+            Vector<TableEntry *> table_entries;
+            if (!txn->GetCommitTables(table_entries)) {
+                break;
+            }
+            // The commit joins the groups of its tables, the groups are independent so their commits may be concatenated in any order.
+            SizeT group_id = groups.size();
+            for (TableEntry *table_entry : table_entries) {
+                if (auto iter = table_groups.find(table_entry); iter != table_groups.end()) {
+                    group_id = std::min(group_id, iter->second);
+                }
+            }
+            if (group_id == groups.size()) {
+                groups.emplace_back();
+            }
+            for (TableEntry *table_entry : table_entries) {
+                auto [iter, inserted] = table_groups.emplace(table_entry, group_id);
+                if (!inserted && iter->second != group_id) {
+                    SizeT merged_group_id = iter->second;
+                    groups[group_id].insert(groups[group_id].end(), groups[merged_group_id].begin(), groups[merged_group_id].end());
+                    groups[merged_group_id].clear();
+                    for (auto &[merged_table_entry, table_group_id] : table_groups) {
+                        if (table_group_id == merged_group_id) {
+                            table_group_id = group_id;
+                        }
+                    }
+                }
+            }
+            groups[group_id].push_back(txn);
+        }
+
+        if (groups.size() == 1) {
+            for (Txn *txn : groups[0]) {
+                txn->CommitBottom();
+            }
+        } else if (!groups.empty()) {
+            Vector<future<void>> commit_futures;
+            for (const auto &group : groups) {
+                if (group.empty()) {
+                    continue;
+                }
+                commit_futures.push_back(commit_thread_pool_.push([&group](int) {
+                    for (Txn *txn : group) {
+                        txn->CommitBottom();
+                    }
+                }));
+            }
+            for (auto &commit_future : commit_futures) {
+                commit_future.get();
+            }
+        }
+
+        if (end < txns.size()) {
+            txns[end]->CommitBottom();
+            ++end;
+        }
+        for (SizeT i = begin; i < end; ++i) {
+            txns[i]->PostCommitBottom();
+        }
+        begin = end;
+    }
+}
+
 bool WalManager::TrySubmitCheckpointTask(SharedPtr<CheckpointTaskBase> ckp_task) {
     bool expect = false;
     if (checkpoint_in_progress_.compare_exchange_strong(expect, true)) {
@@ -542,6 +643,9 @@ void WalManager::ReplayWalEntry(const WalEntry &entry) {
             case WalCommandType::DELETE:
                 WalCmdDeleteReplay(*dynamic_cast<const WalCmdDelete *>(cmd.get()), entry.txn_id_, entry.commit_ts_);
                 break;
+            case WalCommandType::UPDATE:
+                WalCmdUpdateReplay(*dynamic_cast<const WalCmdUpdate *>(cmd.get()), entry.txn_id_, entry.commit_ts_);
+                break;
             // case WalCommandType::SET_SEGMENT_STATUS_SEALED:
             //     WalCmdSetSegmentStatusSealedReplay(*dynamic_cast<const WalCmdSetSegmentStatusSealed *>(cmd.get()), entry.txn_id_,
             //     entry.commit_ts_); break;
@@ -737,6 +841,20 @@ void WalManager::WalCmdDeleteReplay(const WalCmdDelete &cmd, TransactionID txn_i
     Catalog::CommitWrite(table_store->table_entry_, fake_txn->TxnID(), commit_ts, table_store->txn_segments());
 }
 
+void WalManager::WalCmdUpdateReplay(const WalCmdUpdate &cmd, TransactionID txn_id, TxnTimeStamp commit_ts) {
+    auto [table_entry, table_status] = storage_->catalog()->GetTableByName(cmd.db_name_, cmd.table_name_, txn_id, commit_ts);
+    if (!table_status.ok()) {
+        UnrecoverableError(fmt::format("Wal Replay: Get table failed {}", table_status.message()));
+    }
+
+    auto fake_txn = Txn::NewReplayTxn(storage_->buffer_manager(), storage_->txn_manager(), storage_->catalog(), txn_id);
+    auto table_store = fake_txn->GetTxnTableStore(table_entry);
+    table_store->Update(cmd.row_ids_, cmd.column_ids_, cmd.block_);
+    fake_txn->FakeCommit(commit_ts);
+    Catalog::Update(table_store->table_entry_, fake_txn->TxnID(), (void *)table_store, fake_txn->CommitTS(), table_store->update_states_);
+    Catalog::CommitWrite(table_store->table_entry_, fake_txn->TxnID(), commit_ts, table_store->txn_segments());
+}
+
 void WalManager::WalCmdCompactReplay(const WalCmdCompact &cmd, TransactionID txn_id, TxnTimeStamp commit_ts) {
     auto [table_entry, table_status] = storage_->catalog()->GetTableByName(cmd.db_name_, cmd.table_name_, txn_id, commit_ts);
     if (!table_status.ok()) {
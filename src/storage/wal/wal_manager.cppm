@@ -69,6 +69,10 @@ public:
     i64 WalSize() const { return wal_size_; }
 
 private:
+    // Commit pipeline helpers, see Flush.
+    void PrepareWalEntry(Txn *txn, WalEntry *entry, Vector<char> &buf);
+    void CommitBottoms(const Vector<SharedPtr<Txn>> &txns);
+
     // Checkpoint Helper
     void CheckpointInner(bool is_full_checkpoint, Txn *txn, TxnTimeStamp max_commit_ts, i64 wal_size);
 
@@ -88,6 +92,7 @@ private:
 
     void WalCmdImportReplay(const WalCmdImport &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
     void WalCmdDeleteReplay(const WalCmdDelete &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
+    void WalCmdUpdateReplay(const WalCmdUpdate &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
     // void WalCmdSetSegmentStatusSealedReplay(const WalCmdSetSegmentStatusSealed &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
     // void WalCmdUpdateSegmentBloomFilterDataReplay(const WalCmdUpdateSegmentBloomFilterData &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
     void WalCmdCompactReplay(const WalCmdCompact &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
@@ -111,6 +116,9 @@ private:
     // TxnManager and Flush thread access following members
     WALEntryBlockingQueue blocking_queue_{};
 
+    // Only Flush thread submits to it
+    ThreadPool commit_thread_pool_;
+
     // Only Flush thread access following members
     std::ofstream ofs_{};
     TxnTimeStamp max_commit_ts_{};
@@ -0,0 +1,58 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+#include <thread>
+
+import stl;
+import analyzer;
+import analyzer_pool;
+
+using namespace infinity;
+
+class AnalyzerPoolTest : public BaseTest {};
+
+TEST_F(AnalyzerPoolTest, test1) {
+    AnalyzerPool &pool = AnalyzerPool::instance();
+    ASSERT_EQ(pool.Get("unknown").get(), nullptr);
+    ASSERT_EQ(pool.Get("ngram").get(), nullptr);
+
+    Analyzer *standard = nullptr;
+    {
+        PooledAnalyzer analyzer = pool.Get("standard");
+        ASSERT_NE(analyzer.get(), nullptr);
+        standard = analyzer.get();
+    }
+    {
+        // the released analyzer is reused by the same thread
+        PooledAnalyzer analyzer = pool.Get("standard");
+        ASSERT_EQ(analyzer.get(), standard);
+        // while it is in use another one is created
+        PooledAnalyzer other = pool.Get("standard");
+        ASSERT_NE(other.get(), nullptr);
+        ASSERT_NE(other.get(), standard);
+        // analyzers of another name or config are never mixed up
+        PooledAnalyzer ngram2 = pool.Get("ngram-2");
+        PooledAnalyzer ngram3 = pool.Get("ngram-3");
+        ASSERT_NE(ngram2.get(), nullptr);
+        ASSERT_NE(ngram3.get(), nullptr);
+        ASSERT_NE(ngram2.get(), ngram3.get());
+    }
+    std::thread thread([&] {
+        PooledAnalyzer analyzer = pool.Get("standard");
+        ASSERT_NE(analyzer.get(), nullptr);
+        ASSERT_NE(analyzer.get(), standard);
+    });
+    thread.join();
+}
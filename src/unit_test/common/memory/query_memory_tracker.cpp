@@ -0,0 +1,65 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "unit_test/base_test.h"
+
+import stl;
+import query_memory_tracker;
+import infinity_exception;
+import vector_buffer;
+
+using namespace infinity;
+
+class QueryMemoryTrackerTest : public BaseTest {};
+
+TEST_F(QueryMemoryTrackerTest, charge_and_release) {
+    auto tracker = MakeShared<QueryMemoryTracker>(1000);
+    {
+        MemoryReservation reservation(tracker);
+        reservation.Resize(600);
+        EXPECT_EQ(tracker->used(), 600u);
+        reservation.Resize(200);
+        EXPECT_EQ(tracker->used(), 200u);
+
+        MemoryReservation other(tracker);
+        EXPECT_THROW(other.Resize(900), RecoverableException);
+        EXPECT_EQ(other.bytes(), 0u);
+        EXPECT_EQ(tracker->used(), 200u);
+
+        MemoryReservation moved = std::move(reservation);
+        EXPECT_EQ(moved.bytes(), 200u);
+        EXPECT_EQ(tracker->used(), 200u);
+    }
+    EXPECT_EQ(tracker->used(), 0u);
+    EXPECT_EQ(tracker->peak(), 600u);
+
+    // Nothing is charged without a tracker.
+    MemoryReservation reservation;
+    reservation.Resize(1 << 20);
+    EXPECT_EQ(reservation.bytes(), 0u);
+}
+
+TEST_F(QueryMemoryTrackerTest, vector_buffer) {
+    EXPECT_EQ(QueryMemoryTracker::Current().get(), nullptr);
+    auto tracker = MakeShared<QueryMemoryTracker>(4096);
+    {
+        QueryMemoryTracker::ScopedCurrent guard(tracker);
+        EXPECT_EQ(QueryMemoryTracker::Current(), tracker);
+        auto buffer = VectorBuffer::Make(sizeof(i64), 256, VectorBufferType::kStandard);
+        EXPECT_EQ(tracker->used(), 256 * sizeof(i64));
+        EXPECT_THROW(VectorBuffer::Make(sizeof(i64), 512, VectorBufferType::kStandard), RecoverableException);
+    }
+    EXPECT_EQ(QueryMemoryTracker::Current().get(), nullptr);
+    EXPECT_EQ(tracker->used(), 0u);
+    EXPECT_EQ(tracker->peak(), 256 * sizeof(i64));
+}
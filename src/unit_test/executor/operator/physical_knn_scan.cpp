@@ -0,0 +1,67 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import stl;
+import default_values;
+import physical_knn_scan;
+
+using namespace infinity;
+
+class FilteredHnswStrategyTest : public BaseTest {};
+
+TEST_F(FilteredHnswStrategyTest, selectivity) {
+    constexpr SizeT segment_row_count = 1'000'000;
+    constexpr SizeT ef = 200;
+    constexpr SizeT M = 16;
+
+    EXPECT_EQ(ChooseFilteredHnswStrategy(segment_row_count, segment_row_count, ef, M), FilteredHnswStrategy::kGraph);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(600'000, segment_row_count, ef, M), FilteredHnswStrategy::kGraph);
+
+    // the two hop search starts below HNSW_FILTER_TWO_HOP_SELECTIVITY
+    SizeT two_hop_row_count = SizeT(segment_row_count * HNSW_FILTER_TWO_HOP_SELECTIVITY);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(two_hop_row_count, segment_row_count, ef, M), FilteredHnswStrategy::kGraph);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(two_hop_row_count - 1, segment_row_count, ef, M), FilteredHnswStrategy::kTwoHop);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(100'000, segment_row_count, ef, M), FilteredHnswStrategy::kTwoHop);
+
+    // 50000 rows at selectivity 0.05 cost less than the 200 * 2 * 16 distances of the graph search
+    EXPECT_EQ(ChooseFilteredHnswStrategy(50'000, segment_row_count, ef, M), FilteredHnswStrategy::kBruteForce);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(1, segment_row_count, ef, M), FilteredHnswStrategy::kBruteForce);
+}
+
+TEST_F(FilteredHnswStrategyTest, brute_force_threshold) {
+    constexpr SizeT ef = 200;
+    constexpr SizeT M = 16;
+
+    // filtered_row_count * selectivity == ef * 2 * M
+    EXPECT_EQ(ChooseFilteredHnswStrategy(12800, 25600, ef, M), FilteredHnswStrategy::kBruteForce);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(12801, 25600, ef, M), FilteredHnswStrategy::kGraph);
+
+    // a larger ef makes the graph search more expensive
+    EXPECT_EQ(ChooseFilteredHnswStrategy(100'000, 1'000'000, ef, M), FilteredHnswStrategy::kTwoHop);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(100'000, 1'000'000, 2 * ef, M), FilteredHnswStrategy::kBruteForce);
+
+    // a small segment is always scanned
+    EXPECT_EQ(ChooseFilteredHnswStrategy(1000, 1000, ef, M), FilteredHnswStrategy::kBruteForce);
+}
+
+TEST_F(FilteredHnswStrategyTest, empty) {
+    // no row passes the filter, nothing is searched
+    EXPECT_EQ(ChooseFilteredHnswStrategy(0, 1000, 200, 16), FilteredHnswStrategy::kBruteForce);
+    EXPECT_EQ(ChooseFilteredHnswStrategy(0, 0, 200, 16), FilteredHnswStrategy::kGraph);
+
+    EXPECT_EQ(FilteredHnswStrategyToString(FilteredHnswStrategy::kBruteForce), "brute force");
+    EXPECT_EQ(FilteredHnswStrategyToString(FilteredHnswStrategy::kTwoHop), "two hop");
+}
@@ -35,6 +35,7 @@ import data_block;
 import internal_types;
 import logical_type;
 import data_type;
+import column_vector;
 
 class SumFunctionTest : public BaseTest {};
 
@@ -242,3 +243,49 @@ TEST_F(SumFunctionTest, avg_func) {
         EXPECT_THROW(aggregate_function_set->GetMostMatchFunction(col_expr_ptr), UnrecoverableException);
     }
 }
+
+TEST_F(SumFunctionTest, sum_nulls) {
+    using namespace infinity;
+
+    UniquePtr<Catalog> catalog_ptr = MakeUnique<Catalog>(MakeShared<String>(GetDataDir()));
+
+    RegisterSumFunction(catalog_ptr);
+
+    SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog_ptr.get(), "sum");
+    SharedPtr<AggregateFunctionSet> aggregate_function_set = std::static_pointer_cast<AggregateFunctionSet>(function_set);
+
+    SharedPtr<DataType> data_type = MakeShared<DataType>(LogicalType::kInteger);
+    SharedPtr<ColumnExpression> col_expr_ptr = MakeShared<ColumnExpression>(*data_type, "t1", 1, "c1", 0, 0);
+    AggregateFunction func = aggregate_function_set->GetMostMatchFunction(col_expr_ptr);
+
+    Vector<SharedPtr<DataType>> column_types;
+    column_types.emplace_back(data_type);
+    SizeT row_count = DEFAULT_VECTOR_SIZE;
+    DataBlock data_block;
+    data_block.Init(column_types);
+    for (SizeT i = 0; i < row_count; ++i) {
+        data_block.AppendValue(0, Value::MakeInt(static_cast<IntegerT>(i)));
+    }
+    data_block.Finalize();
+
+    // The whole batch, reduced by UpdateBatch.
+    auto full_state = func.InitState();
+    func.init_func_(full_state.get());
+    func.update_func_(full_state.get(), data_block.column_vectors[0]);
+    EXPECT_EQ(*(BigIntT *)func.finalize_func_(full_state.get()), i64((row_count - 1) * row_count / 2));
+
+    // Odd rows are null, only the even rows are summed.
+    SharedPtr<ColumnVector> &column = data_block.column_vectors[0];
+    i64 even_sum = 0;
+    for (SizeT i = 0; i < row_count; ++i) {
+        if (i % 2 == 1) {
+            column->nulls_ptr_->SetFalse(i);
+        } else {
+            even_sum += i;
+        }
+    }
+    auto null_state = func.InitState();
+    func.init_func_(null_state.get());
+    func.update_func_(null_state.get(), column);
+    EXPECT_EQ(*(BigIntT *)func.finalize_func_(null_state.get()), even_sum);
+}
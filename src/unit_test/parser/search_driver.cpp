@@ -99,3 +99,34 @@ _exists_:"author" AND page_count:zzz^1.3 AND (name:star^0.1 OR name:duna^1.2)^1.
     int rc = ParseStream(driver, iss);
     EXPECT_EQ(rc, 0);
 }
+
+TEST_F(SearchDriverTest, multi_term_test) {
+    using namespace infinity;
+
+    Map<String, String> column2analyzer;
+    String default_field("body");
+    SearchDriver driver(column2analyzer, default_field);
+
+    auto check_multi_term = [&](const String &query, QueryNodeType type, const String &column, const String &pattern, u32 max_edits) {
+        std::unique_ptr<QueryNode> result = driver.ParseSingle(query);
+        ASSERT_NE(result, nullptr) << query;
+        ASSERT_EQ(result->GetType(), type) << query;
+        auto *multi_term = static_cast<MultiTermQueryNode *>(result.get());
+        EXPECT_EQ(multi_term->column_, column);
+        EXPECT_EQ(multi_term->pattern_, pattern);
+        EXPECT_EQ(multi_term->max_edits_, max_edits);
+    };
+    check_multi_term("dun*", QueryNodeType::PREFIX_TERM, "body", "dun", 0);
+    check_multi_term("name:dun*", QueryNodeType::PREFIX_TERM, "name", "dun", 0);
+    check_multi_term("d?n*", QueryNodeType::WILDCARD_TERM, "body", "d?n*", 0);
+    check_multi_term("name:*une", QueryNodeType::WILDCARD_TERM, "name", "*une", 0);
+    check_multi_term("dune~", QueryNodeType::FUZZY_TERM, "body", "dune", 2);
+    check_multi_term("name:dune~1^1.2", QueryNodeType::FUZZY_TERM, "name", "dune", 1);
+
+    // quoted texts are literal
+    for (const String query : {"'dun*'", "'dune~1'", "\"dun*\"", "\"dune god\"~2"}) {
+        std::unique_ptr<QueryNode> result = driver.ParseSingle(query);
+        ASSERT_NE(result, nullptr) << query;
+        EXPECT_EQ(result->GetType(), QueryNodeType::TERM) << query;
+    }
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "unit_test/base_test.h"
+#include <thread>
 
 import infinity_context;
 import infinity_exception;
@@ -31,6 +32,9 @@ import txn;
 import status;
 import background_process;
 import bg_task;
+import storage;
+import catalog;
+import extra_ddl_info;
 
 class BGProcessTest : public BaseTest {
     void SetUp() override {
@@ -62,3 +66,71 @@ TEST_F(BGProcessTest, test1) {
 
     processor.Stop();
 }
+
+TEST_F(BGProcessTest, lane_routing) {
+    using namespace infinity;
+
+    EXPECT_EQ(BGTaskProcessor::GetLane(BGTaskType::kAddDeltaEntry), BGTaskLane::kCheckpoint);
+    EXPECT_EQ(BGTaskProcessor::GetLane(BGTaskType::kCheckpoint), BGTaskLane::kCheckpoint);
+    EXPECT_EQ(BGTaskProcessor::GetLane(BGTaskType::kForceCheckpoint), BGTaskLane::kCheckpoint);
+    EXPECT_EQ(BGTaskProcessor::GetLane(BGTaskType::kUpdateSegmentBloomFilterData), BGTaskLane::kIndexBuild);
+    EXPECT_EQ(BGTaskProcessor::GetLane(BGTaskType::kCleanup), BGTaskLane::kCleanup);
+
+    BGTaskProcessorOptions options;
+    options.index_build_thread_num_ = 3;
+    BGTaskProcessor processor(infinity::InfinityContext::instance().storage()->wal_manager(), nullptr, options);
+    Vector<BGTaskLaneInfo> lane_infos = processor.GetLaneInfos();
+    ASSERT_EQ(lane_infos.size(), SizeT(BGTaskLane::kInvalid));
+    EXPECT_EQ(lane_infos[SizeT(BGTaskLane::kCheckpoint)].thread_num_, 1u);
+    EXPECT_EQ(lane_infos[SizeT(BGTaskLane::kIndexBuild)].thread_num_, 3u);
+    EXPECT_EQ(lane_infos[SizeT(BGTaskLane::kCleanup)].thread_num_, 1u);
+}
+
+// Checkpoints and cleanups run on different lanes and are serialized with each other, the cleanups remove the dropped databases while the
+// checkpoints save the catalog.
+TEST_F(BGProcessTest, concurrent_checkpoint_cleanup) {
+    using namespace infinity;
+
+    Storage *storage = infinity::InfinityContext::instance().storage();
+    TxnManager *txn_mgr = storage->txn_manager();
+    Catalog *catalog = storage->catalog();
+    BGTaskProcessor *processor = storage->bg_processor();
+    auto GetTaskCount = [&](BGTaskLane lane) { return processor->GetLaneInfos()[SizeT(lane)].task_count_; };
+    u64 cleanup_count = GetTaskCount(BGTaskLane::kCleanup);
+
+    constexpr SizeT round_num = 10;
+    for (SizeT i = 0; i < round_num; ++i) {
+        // a dropped database for the cleanup to remove while the checkpoint saves the catalog
+        String db_name = fmt::format("db{}", i);
+        {
+            auto *txn = txn_mgr->BeginTxn();
+            EXPECT_TRUE(txn->CreateDatabase(db_name, ConflictType::kError).ok());
+            txn_mgr->CommitTxn(txn);
+        }
+        {
+            auto *txn = txn_mgr->BeginTxn();
+            EXPECT_TRUE(txn->DropDatabase(db_name, ConflictType::kError).ok());
+            txn_mgr->CommitTxn(txn);
+        }
+        auto *txn_ckp = txn_mgr->BeginTxn();
+        auto force_ckp_task = MakeShared<ForceCheckpointTask>(txn_ckp, i % 2 == 0);
+        processor->Submit(MakeShared<CleanupTask>(catalog, txn_mgr->GetMinUnflushedTS(), txn_mgr->GetBufferMgr()));
+        processor->Submit(force_ckp_task);
+        force_ckp_task->Wait();
+        txn_mgr->CommitTxn(txn_ckp);
+    }
+
+    // cleanup tasks are async, wait for the lane to finish them
+    auto begin_time = std::chrono::steady_clock::now();
+    while (GetTaskCount(BGTaskLane::kCleanup) < cleanup_count + round_num) {
+        ASSERT_LT(std::chrono::steady_clock::now() - begin_time, std::chrono::seconds(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    for (SizeT i = 0; i < round_num; ++i) {
+        auto *txn = txn_mgr->BeginTxn();
+        auto [db_entry, status] = txn->GetDatabase(fmt::format("db{}", i));
+        EXPECT_EQ(db_entry, nullptr);
+        txn_mgr->CommitTxn(txn);
+    }
+}
@@ -79,8 +79,8 @@ TEST_F(BufferHandleTest, test1) {
 
         auto buf_handle2 = buf2->Load();
 
-        // out of memory exception
-        EXPECT_THROW({ auto buf_handle3 = buf3->Load(); }, UnrecoverableException);
+        // out of memory exception after waiting for memory to be unloaded
+        EXPECT_THROW({ auto buf_handle3 = buf3->Load(); }, RecoverableException);
         EXPECT_EQ(buf3->rc(), 0u);
         EXPECT_EQ(buf3->status(), BufferStatus::kNew);
         EXPECT_EQ(buf3->type(), BufferType::kEphemeral);
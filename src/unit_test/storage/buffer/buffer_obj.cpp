@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "unit_test/base_test.h"
+#include <filesystem>
 
 import infinity;
 import infinity_exception;
@@ -281,6 +282,206 @@ TEST_F(BufferObjTest, test1) {
     buf1->CheckState();
 }
 
+// A prefetched buffer is read into memory and left unloaded, the next Load doesn't read the file.
+TEST_F(BufferObjTest, test_prefetch) {
+    SizeT memory_limit = 1024;
+    String data_dir(GetDataDir());
+    auto temp_dir = MakeShared<String>(data_dir + "/spill");
+    auto base_dir = MakeShared<String>(GetDataDir());
+
+    BufferManager buffer_manager(memory_limit, base_dir, temp_dir);
+    auto wait_prefetch = [&] {
+        while (buffer_manager.prefetch_pending() > 0) {
+            usleep(1000);
+        }
+    };
+
+    SizeT test_size1 = 1024;
+    auto file_dir1 = MakeShared<String>(data_dir + "/dir1");
+    auto test_fname1 = MakeShared<String>("test1");
+    auto file_worker1 = MakeUnique<DataFileWorker>(file_dir1, test_fname1, test_size1);
+    auto buf1 = buffer_manager.Allocate(std::move(file_worker1));
+
+    SizeT test_size2 = 1024;
+    auto file_dir2 = MakeShared<String>(data_dir + "/dir2");
+    auto test_fname2 = MakeShared<String>("test2");
+    auto file_worker2 = MakeUnique<DataFileWorker>(file_dir2, test_fname2, test_size2);
+    auto buf2 = buffer_manager.Allocate(std::move(file_worker2));
+
+    { auto handle1 = buf1->Load(); }
+    SaveBufferObj(buf1);
+    { auto handle2 = buf2->Load(); }
+    // kUnloaded, kPersistent -> kFreed, kPersistent
+    EXPECT_EQ(buf1->status(), BufferStatus::kFreed);
+    EXPECT_EQ(buf1->type(), BufferType::kPersistent);
+
+    buffer_manager.Prefetch(buf1);
+    wait_prefetch();
+    // kFreed, kPersistent -> kUnloaded, kPersistent
+    EXPECT_EQ(buf1->status(), BufferStatus::kUnloaded);
+    EXPECT_EQ(buffer_manager.prefetch_count(), 1u);
+    buf1->CheckState();
+
+    {
+        auto handle1 = buf1->Load();
+        EXPECT_EQ(buf1->status(), BufferStatus::kLoaded);
+        buf1->CheckState();
+
+        // in memory already, nothing is read
+        buffer_manager.Prefetch(buf1);
+        wait_prefetch();
+        EXPECT_EQ(buf1->status(), BufferStatus::kLoaded);
+        EXPECT_EQ(buffer_manager.prefetch_count(), 1u);
+    }
+}
+
+// A prefetch failing to read the file gives back the space it reserved and leaves the buffer freed.
+TEST_F(BufferObjTest, test_prefetch_fail) {
+    SizeT memory_limit = 1024;
+    String data_dir(GetDataDir());
+    auto temp_dir = MakeShared<String>(data_dir + "/spill");
+    auto base_dir = MakeShared<String>(GetDataDir());
+
+    BufferManager buffer_manager(memory_limit, base_dir, temp_dir);
+
+    SizeT test_size1 = 1024;
+    auto file_dir1 = MakeShared<String>(data_dir + "/dir1");
+    auto test_fname1 = MakeShared<String>("test1");
+    auto file_worker1 = MakeUnique<DataFileWorker>(file_dir1, test_fname1, test_size1);
+    auto buf1 = buffer_manager.Allocate(std::move(file_worker1));
+
+    SizeT test_size2 = 1024;
+    auto file_dir2 = MakeShared<String>(data_dir + "/dir2");
+    auto test_fname2 = MakeShared<String>("test2");
+    auto file_worker2 = MakeUnique<DataFileWorker>(file_dir2, test_fname2, test_size2);
+    auto buf2 = buffer_manager.Allocate(std::move(file_worker2));
+
+    { auto handle1 = buf1->Load(); }
+    SaveBufferObj(buf1);
+    { auto handle2 = buf2->Load(); }
+    EXPECT_EQ(buf1->status(), BufferStatus::kFreed);
+    // buf2 is evicted by the prefetch, the read of buf1 fails after it
+    std::filesystem::resize_file(buf1->GetFilename(), 16);
+
+    buffer_manager.Prefetch(buf1);
+    while (buffer_manager.prefetch_pending() > 0) {
+        usleep(1000);
+    }
+    EXPECT_EQ(buf1->status(), BufferStatus::kFreed);
+    EXPECT_EQ(buffer_manager.prefetch_count(), 0u);
+    EXPECT_EQ(buffer_manager.memory_usage(), 0u);
+    buf1->CheckState();
+
+    { auto handle2 = buf2->Load(); }
+    EXPECT_EQ(buffer_manager.memory_usage(), test_size2);
+}
+
+// The flusher writes an unloaded dirty buffer to the spill file, its eviction then only releases the memory.
+TEST_F(BufferObjTest, test_write_back) {
+    SizeT memory_limit = 1024;
+    String data_dir(GetDataDir());
+    auto temp_dir = MakeShared<String>(data_dir + "/spill");
+    auto base_dir = MakeShared<String>(GetDataDir());
+
+    BufferManager buffer_manager(memory_limit, base_dir, temp_dir);
+
+    SizeT test_size1 = 1024;
+    auto file_dir1 = MakeShared<String>(data_dir + "/dir1");
+    auto test_fname1 = MakeShared<String>("test1");
+    auto file_worker1 = MakeUnique<DataFileWorker>(file_dir1, test_fname1, test_size1);
+    auto buf1 = buffer_manager.Allocate(std::move(file_worker1));
+
+    SizeT test_size2 = 1024;
+    auto file_dir2 = MakeShared<String>(data_dir + "/dir2");
+    auto test_fname2 = MakeShared<String>("test2");
+    auto file_worker2 = MakeUnique<DataFileWorker>(file_dir2, test_fname2, test_size2);
+    auto buf2 = buffer_manager.Allocate(std::move(file_worker2));
+
+    {
+        auto handle1 = buf1->Load();
+        auto data1 = static_cast<i32 *>(handle1.GetDataMut());
+        for (i32 i = 0; i < 256; ++i) {
+            data1[i] = i;
+        }
+    }
+    // kUnloaded, kEphemeral -> kUnloaded, kEphemeral, spilled
+    for (SizeT i = 0; i < 1000 && !buf1->spilled(); ++i) {
+        usleep(10 * 1000);
+    }
+    EXPECT_EQ(buf1->status(), BufferStatus::kUnloaded);
+    EXPECT_EQ(buf1->type(), BufferType::kEphemeral);
+    EXPECT_TRUE(buf1->spilled());
+    EXPECT_EQ(buffer_manager.write_back_count(), 1u);
+
+    { auto handle2 = buf2->Load(); }
+    // kUnloaded, kEphemeral, spilled -> kFreed, kEphemeral
+    EXPECT_EQ(buf1->status(), BufferStatus::kFreed);
+    EXPECT_EQ(buffer_manager.evict_count(), 1u);
+
+    {
+        auto handle1 = buf1->Load();
+        auto data1 = static_cast<const i32 *>(handle1.GetData());
+        for (i32 i = 0; i < 256; ++i) {
+            EXPECT_EQ(data1[i], i);
+        }
+    }
+}
+
+// A buffer loaded again after its write back is changed: the eviction writes the spill file again, the change is not lost.
+TEST_F(BufferObjTest, test_write_back_then_change) {
+    SizeT memory_limit = 1024;
+    String data_dir(GetDataDir());
+    auto temp_dir = MakeShared<String>(data_dir + "/spill");
+    auto base_dir = MakeShared<String>(GetDataDir());
+
+    BufferManager buffer_manager(memory_limit, base_dir, temp_dir);
+
+    SizeT test_size1 = 1024;
+    auto file_dir1 = MakeShared<String>(data_dir + "/dir1");
+    auto test_fname1 = MakeShared<String>("test1");
+    auto file_worker1 = MakeUnique<DataFileWorker>(file_dir1, test_fname1, test_size1);
+    auto buf1 = buffer_manager.Allocate(std::move(file_worker1));
+
+    SizeT test_size2 = 1024;
+    auto file_dir2 = MakeShared<String>(data_dir + "/dir2");
+    auto test_fname2 = MakeShared<String>("test2");
+    auto file_worker2 = MakeUnique<DataFileWorker>(file_dir2, test_fname2, test_size2);
+    auto buf2 = buffer_manager.Allocate(std::move(file_worker2));
+
+    {
+        auto handle1 = buf1->Load();
+        auto data1 = static_cast<i32 *>(handle1.GetDataMut());
+        for (i32 i = 0; i < 256; ++i) {
+            data1[i] = i;
+        }
+    }
+    for (SizeT i = 0; i < 1000 && !buf1->spilled(); ++i) {
+        usleep(10 * 1000);
+    }
+    EXPECT_TRUE(buf1->spilled());
+
+    // kUnloaded, spilled -> kLoaded, not spilled
+    {
+        auto handle1 = buf1->Load();
+        EXPECT_FALSE(buf1->spilled());
+        auto data1 = static_cast<i32 *>(handle1.GetDataMut());
+        for (i32 i = 0; i < 256; ++i) {
+            data1[i] = 2 * i;
+        }
+    }
+    // the eviction writes the changed data
+    { auto handle2 = buf2->Load(); }
+    EXPECT_EQ(buf1->status(), BufferStatus::kFreed);
+
+    {
+        auto handle1 = buf1->Load();
+        auto data1 = static_cast<const i32 *>(handle1.GetData());
+        for (i32 i = 0; i < 256; ++i) {
+            EXPECT_EQ(data1[i], 2 * i);
+        }
+    }
+}
+
 // unit test for BufferStatus::kClean transformation
 // TEST_F(BufferObjTest, test_status_clean) {
 //     SizeT memory_limit = 1024;
@@ -0,0 +1,116 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import stl;
+import block_codec;
+import logical_type;
+import infinity_exception;
+
+using namespace infinity;
+
+class BlockCodecTest : public BaseTest {
+protected:
+    template <typename T>
+    void CheckEncoding(const Vector<T> &values, BlockEncodingType encoding) {
+        Vector<u8> encoded;
+        BlockCodec::Encode(encoding, values.data(), values.size(), sizeof(T), encoded);
+        EXPECT_EQ(BlockCodec::ReadHeader(encoded.data(), encoded.size()).encoding_, static_cast<u8>(encoding));
+
+        Vector<T> decoded(values.size());
+        BlockCodec::Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size() * sizeof(T));
+        EXPECT_EQ(decoded, values);
+    }
+};
+
+TEST_F(BlockCodecTest, elem_size) {
+    EXPECT_EQ(BlockCodec::EncodableElemSize(LogicalType::kTinyInt), 1u);
+    EXPECT_EQ(BlockCodec::EncodableElemSize(LogicalType::kSmallInt), 2u);
+    EXPECT_EQ(BlockCodec::EncodableElemSize(LogicalType::kInteger), 4u);
+    EXPECT_EQ(BlockCodec::EncodableElemSize(LogicalType::kDate), 4u);
+    EXPECT_EQ(BlockCodec::EncodableElemSize(LogicalType::kBigInt), 8u);
+    EXPECT_EQ(BlockCodec::EncodableElemSize(LogicalType::kFloat), 0u);
+    EXPECT_EQ(BlockCodec::EncodableElemSize(LogicalType::kVarchar), 0u);
+}
+
+TEST_F(BlockCodecTest, round_trip) {
+    constexpr SizeT row_count = 8192;
+    Vector<i32> narrow(row_count);
+    Vector<i64> wide(row_count);
+    Vector<i16> runs(row_count);
+    Vector<i64> sorted(row_count);
+    for (SizeT i = 0; i < row_count; ++i) {
+        narrow[i] = 10 + rand() % 200;
+        wide[i] = (i64(rand() % 16) << 40) - 3;
+        runs[i] = i / 1000;
+        sorted[i] = i64(1) << 50 | (i * 3);
+    }
+    for (auto encoding : {BlockEncodingType::kPlain,
+                          BlockEncodingType::kFrameOfReference,
+                          BlockEncodingType::kDictionary,
+                          BlockEncodingType::kRunLength,
+                          BlockEncodingType::kDelta}) {
+        CheckEncoding(narrow, encoding);
+        CheckEncoding(runs, encoding);
+        CheckEncoding(sorted, encoding);
+    }
+    CheckEncoding(wide, BlockEncodingType::kDictionary);
+    CheckEncoding(wide, BlockEncodingType::kRunLength);
+    CheckEncoding(Vector<i8>{}, BlockEncodingType::kFrameOfReference);
+    CheckEncoding(Vector<i8>{-1, 5, 7}, BlockEncodingType::kDelta);
+}
+
+TEST_F(BlockCodecTest, choose_encoding) {
+    constexpr SizeT row_count = 8192;
+    Vector<i64> values(row_count);
+    EXPECT_EQ(BlockCodec::ChooseEncoding(values.data(), row_count, sizeof(i64)), BlockEncodingType::kRunLength);
+
+    for (SizeT i = 0; i < row_count; ++i) {
+        values[i] = rand() % 100;
+    }
+    EXPECT_EQ(BlockCodec::ChooseEncoding(values.data(), row_count, sizeof(i64)), BlockEncodingType::kFrameOfReference);
+
+    for (SizeT i = 0; i < row_count; ++i) {
+        values[i] = (i64(rand() % 8) << 40);
+    }
+    EXPECT_EQ(BlockCodec::ChooseEncoding(values.data(), row_count, sizeof(i64)), BlockEncodingType::kDictionary);
+
+    for (SizeT i = 0; i < row_count; ++i) {
+        values[i] = (i64(1) << 40) + i * 7;
+    }
+    EXPECT_EQ(BlockCodec::ChooseEncoding(values.data(), row_count, sizeof(i64)), BlockEncodingType::kDelta);
+
+    Vector<i8> random_bytes(row_count);
+    for (SizeT i = 0; i < row_count; ++i) {
+        random_bytes[i] = rand();
+    }
+    EXPECT_EQ(BlockCodec::ChooseEncoding(random_bytes.data(), row_count, sizeof(i8)), BlockEncodingType::kPlain);
+}
+
+TEST_F(BlockCodecTest, corrupt_run_length) {
+    Vector<i32> values{1, 1, 2, 2, 2, 3};
+    Vector<u8> encoded;
+    BlockCodec::Encode(BlockEncodingType::kRunLength, values.data(), values.size(), sizeof(i32), encoded);
+    Vector<i32> decoded(values.size());
+
+    // the last run end is the last field of the block
+    u8 *last_run_end = encoded.data() + encoded.size() - sizeof(u32);
+    u32 run_end = values.size() + 1;
+    std::memcpy(last_run_end, &run_end, sizeof(run_end));
+    EXPECT_THROW(BlockCodec::Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size() * sizeof(i32)), UnrecoverableException);
+    run_end = values.size() - 1;
+    std::memcpy(last_run_end, &run_end, sizeof(run_end));
+    EXPECT_THROW(BlockCodec::Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size() * sizeof(i32)), UnrecoverableException);
+}
@@ -0,0 +1,48 @@
+#include "unit_test/base_test.h"
+
+import stl;
+import chunk_merge_policy;
+
+using namespace infinity;
+
+class ChunkMergePolicyTest : public BaseTest {};
+
+TEST_F(ChunkMergePolicyTest, test_tier) {
+    TieredChunkMergePolicy policy(4, 100, 100000);
+    EXPECT_EQ(policy.Tier(1), 0u);
+    EXPECT_EQ(policy.Tier(99), 0u);
+    EXPECT_EQ(policy.Tier(100), 1u);
+    EXPECT_EQ(policy.Tier(399), 1u);
+    EXPECT_EQ(policy.Tier(400), 2u);
+}
+
+TEST_F(ChunkMergePolicyTest, test_pick_merges) {
+    TieredChunkMergePolicy policy(4, 100, 100000);
+    // fewer than merge_factor chunks in every tier
+    EXPECT_TRUE(policy.PickMerges({500, 50, 50, 50}).empty());
+
+    // the big chunk is left alone, only the adjacent small chunks are merged
+    Vector<Pair<SizeT, SizeT>> merges = policy.PickMerges({500, 10, 20, 30, 40, 50, 60, 70, 80, 90});
+    ASSERT_EQ(merges.size(), 2u);
+    EXPECT_EQ(merges[0], (Pair<SizeT, SizeT>(1, 5)));
+    EXPECT_EQ(merges[1], (Pair<SizeT, SizeT>(5, 9)));
+
+    // chunks of another tier in between break the run
+    EXPECT_TRUE(policy.PickMerges({10, 10, 500, 10, 10}).empty());
+}
+
+TEST_F(ChunkMergePolicyTest, test_max_chunk_rows) {
+    TieredChunkMergePolicy policy(4, 100, 1000);
+    Vector<Pair<SizeT, SizeT>> merges = policy.PickMerges({300, 300, 300, 300, 300});
+    ASSERT_EQ(merges.size(), 1u);
+    EXPECT_EQ(merges[0], (Pair<SizeT, SizeT>(0, 3)));
+    EXPECT_TRUE(policy.PickMerges({1000, 1000, 1000, 1000}).empty());
+}
+
+TEST_F(ChunkMergePolicyTest, test_merge_debt) {
+    TieredChunkMergePolicy policy(4, 100, 100000);
+    EXPECT_EQ(policy.MergeDebt({50, 50, 50}), 0u);
+    // 16 chunks of 10 rows: 4 merges into 40 rows, then 1 merge into 160 rows
+    Vector<u32> chunk_row_counts(16, 10);
+    EXPECT_EQ(policy.MergeDebt(chunk_row_counts), 160u + 160u);
+}
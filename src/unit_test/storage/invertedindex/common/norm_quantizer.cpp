@@ -0,0 +1,38 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import stl;
+import norm_quantizer;
+
+using namespace infinity;
+
+class NormQuantizerTest : public BaseTest {};
+
+TEST_F(NormQuantizerTest, test1) {
+    for (u32 column_len = 0; column_len < 32; ++column_len) {
+        ASSERT_EQ(DecodeNorm(EncodeNorm(column_len)), column_len);
+    }
+    u8 prev_norm = 0;
+    for (u64 column_len = 1; column_len <= std::numeric_limits<u32>::max(); column_len = column_len * 9 / 8 + 1) {
+        const u8 norm = EncodeNorm(u32(column_len));
+        const u32 decoded_len = DecodeNorm(norm);
+        ASSERT_GE(norm, prev_norm);
+        // rounded up, by at most 1/8
+        ASSERT_GE(decoded_len, column_len);
+        ASSERT_LE(decoded_len, column_len + column_len / 8);
+        prev_norm = norm;
+    }
+}
@@ -22,6 +22,8 @@ public:
     void DoTest1() {
         SharedPtr<FileWriter> file_writer = MakeShared<FileWriter>(fs_, file_name_, 128);
         TermMeta term_meta(1, 2, 3);
+        term_meta.max_tf_ = 4;
+        term_meta.max_percentage_ = 5;
         optionflag_t option_flag = OPTION_FLAG_ALL;
         PostingFormatOption format_option(option_flag);
         TermMetaDumper term_dumper(format_option);
@@ -36,6 +38,8 @@ public:
         ASSERT_EQ(term_meta.doc_freq_, new_term_meta.doc_freq_);
         ASSERT_EQ(term_meta.total_tf_, new_term_meta.total_tf_);
         ASSERT_EQ(term_meta.payload_, new_term_meta.payload_);
+        ASSERT_EQ(term_meta.max_tf_, new_term_meta.max_tf_);
+        ASSERT_EQ(term_meta.max_percentage_, new_term_meta.max_percentage_);
 
         fs_.DeleteFile(file_name_);
     }
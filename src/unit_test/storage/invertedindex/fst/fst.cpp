@@ -120,3 +120,50 @@ TEST_F(FstTest, Iterate) {
     }
     EXPECT_EQ(i, b2_num);
 }
+
+TEST_F(FstTest, Automaton) {
+    Vector<u8> buffer;
+    BufferWriter wtr(buffer);
+    FstBuilder builder(wtr);
+    for (auto &month : months) {
+        builder.Insert((u8 *)month.first.c_str(), month.first.length(), month.second);
+    }
+    builder.Finish();
+    Fst f(buffer.data(), buffer.size());
+
+    auto search = [&](Automaton &automaton) {
+        Vector<String> names;
+        FstAutomatonStream s(f, automaton);
+        Vector<u8> key;
+        u64 val;
+        while (s.Next(key, val)) {
+            String name((char *)key.data(), key.size());
+            u64 expected_val;
+            EXPECT_TRUE(f.Get(key.data(), key.size(), expected_val));
+            EXPECT_EQ(val, expected_val);
+            names.push_back(std::move(name));
+        }
+        return names;
+    };
+
+    PrefixAutomaton prefix("Ju");
+    EXPECT_EQ(search(prefix), (Vector<String>{"July", "June"}));
+    PrefixAutomaton empty_prefix("");
+    EXPECT_EQ(search(empty_prefix).size(), months.size());
+
+    WildcardAutomaton suffix("*ber");
+    EXPECT_EQ(search(suffix), (Vector<String>{"December", "November", "October", "September"}));
+    WildcardAutomaton wildcard("?a*");
+    EXPECT_EQ(search(wildcard), (Vector<String>{"January", "March", "May"}));
+    WildcardAutomaton substring("*u*y");
+    EXPECT_EQ(search(substring), (Vector<String>{"February", "January", "July"}));
+
+    LevenshteinAutomaton exact("June", 0);
+    EXPECT_EQ(search(exact), (Vector<String>{"June"}));
+    LevenshteinAutomaton one_edit("Jane", 1);
+    EXPECT_EQ(search(one_edit), (Vector<String>{"June"}));
+    LevenshteinAutomaton two_edits("Mar", 2);
+    EXPECT_EQ(search(two_edits), (Vector<String>{"March", "May"}));
+    EXPECT_TRUE(two_edits.Matches((const u8 *)"Marc", 4));
+    EXPECT_FALSE(two_edits.Matches((const u8 *)"Maybe", 5));
+}
@@ -0,0 +1,77 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import stl;
+import index_defines;
+import phrase_doc_iterator;
+
+using namespace infinity;
+
+class PhraseMatcherTest : public BaseTest {
+protected:
+    // positions of a term in one doc, sought forward only like InDocPositionIterator
+    struct MockTermIterator {
+        explicit MockTermIterator(Vector<pos_t> positions) : positions_(std::move(positions)) {}
+
+        void SeekPosition(pos_t pos, pos_t &result) {
+            while (cursor_ < positions_.size() && (positions_[cursor_] < pos || (last_ != INVALID_POSITION && positions_[cursor_] <= last_))) {
+                ++cursor_;
+            }
+            result = cursor_ < positions_.size() ? positions_[cursor_] : INVALID_POSITION;
+            last_ = result;
+        }
+
+        Vector<pos_t> positions_;
+        SizeT cursor_ = 0;
+        pos_t last_ = INVALID_POSITION;
+    };
+
+    static bool Match(Vector<Vector<pos_t>> term_positions, Vector<u32> offsets, u32 slop) {
+        Vector<MockTermIterator> term_iters;
+        for (auto &positions : term_positions) {
+            term_iters.emplace_back(std::move(positions));
+        }
+        Vector<MockTermIterator *> terms;
+        for (auto &term_iter : term_iters) {
+            terms.push_back(&term_iter);
+        }
+        PhraseMatcher matcher(std::move(offsets), slop);
+        return matcher.Match(terms);
+    }
+};
+
+TEST_F(PhraseMatcherTest, exact) {
+    // "a b c"
+    EXPECT_TRUE(Match({{0}, {1}, {2}}, {0, 1, 2}, 0));
+    EXPECT_TRUE(Match({{3, 10}, {5, 11}, {12}}, {0, 1, 2}, 0));
+    EXPECT_FALSE(Match({{0}, {2}, {3}}, {0, 1, 2}, 0));
+    // out of order
+    EXPECT_FALSE(Match({{2}, {1}, {0}}, {0, 1, 2}, 0));
+    // a stop word removed between the terms
+    EXPECT_TRUE(Match({{4}, {6}}, {0, 2}, 0));
+    EXPECT_FALSE(Match({{4}, {5}}, {0, 2}, 0));
+}
+
+TEST_F(PhraseMatcherTest, slop) {
+    EXPECT_FALSE(Match({{0}, {2}, {4}}, {0, 1, 2}, 1));
+    EXPECT_TRUE(Match({{0}, {2}, {4}}, {0, 1, 2}, 2));
+    // the first occurrence of "a" is too far, the second one matches
+    EXPECT_TRUE(Match({{0, 7}, {8}, {10}}, {0, 1, 2}, 1));
+    EXPECT_FALSE(Match({{0, 7}, {9}, {11}}, {0, 1, 2}, 1));
+    // the same term twice
+    EXPECT_TRUE(Match({{1, 3}, {2}, {1, 3}}, {0, 1, 2}, 0));
+    EXPECT_FALSE(Match({{1}, {2}, {1}}, {0, 1, 2}, 5));
+}
@@ -0,0 +1,71 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "unit_test/base_test.h"
+#include <thread>
+
+import stl;
+import io_rate_limiter;
+
+using namespace infinity;
+
+class IoRateLimiterTest : public BaseTest {};
+
+TEST_F(IoRateLimiterTest, unlimited) {
+    IoRateLimiter limiter(0);
+    auto begin_time = std::chrono::steady_clock::now();
+    for (SizeT i = 0; i < 100; ++i) {
+        limiter.Acquire(1 << 20);
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - begin_time, std::chrono::milliseconds(100));
+    EXPECT_EQ(limiter.acquired_bytes(), 100u << 20);
+}
+
+TEST_F(IoRateLimiterTest, token_bucket) {
+    constexpr u64 bytes_per_sec = 1 << 20;
+    IoRateLimiter limiter(bytes_per_sec);
+
+    // the bucket starts full: one second of tokens is a burst
+    auto begin_time = std::chrono::steady_clock::now();
+    limiter.Acquire(bytes_per_sec);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin_time, std::chrono::milliseconds(100));
+
+    // then the bytes are paid at the rate: half a second for half of the rate
+    begin_time = std::chrono::steady_clock::now();
+    limiter.Acquire(bytes_per_sec / 4);
+    limiter.Acquire(bytes_per_sec / 4);
+    auto elapsed = std::chrono::steady_clock::now() - begin_time;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(400));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(1000));
+
+    // a read larger than the bucket borrows the tokens and waits until the debt is refilled
+    begin_time = std::chrono::steady_clock::now();
+    limiter.Acquire(bytes_per_sec * 2);
+    limiter.Acquire(1);
+    EXPECT_GE(std::chrono::steady_clock::now() - begin_time, std::chrono::milliseconds(1800));
+
+    EXPECT_EQ(limiter.acquired_bytes(), bytes_per_sec * 7 / 2 + 1);
+}
+
+TEST_F(IoRateLimiterTest, current) {
+    IoRateLimiter limiter(0);
+    EXPECT_EQ(IoRateLimiter::Current(), nullptr);
+    IoRateLimiter::SetCurrent(&limiter);
+    EXPECT_EQ(IoRateLimiter::Current(), &limiter);
+    // the limiter is per thread
+    std::thread([] { EXPECT_EQ(IoRateLimiter::Current(), nullptr); }).join();
+    IoRateLimiter::SetCurrent(nullptr);
+    EXPECT_EQ(IoRateLimiter::Current(), nullptr);
+}
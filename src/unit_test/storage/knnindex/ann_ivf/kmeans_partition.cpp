@@ -0,0 +1,109 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+#include <random>
+
+import stl;
+import kmeans_partition;
+import index_base;
+
+using namespace infinity;
+
+class KMeansPartitionTest : public BaseTest {};
+
+// The centroids are the same whatever the thread count, for every initialization and with mini batches.
+TEST_F(KMeansPartitionTest, test_thread_num) {
+    u32 dimension = 16;
+    u32 cluster_num = 16;
+    u32 cluster_size = 256;
+    u32 vector_count = cluster_num * cluster_size;
+
+    // well separated clusters: no vector is at the same distance of two centroids, whatever the rounding
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<f32> center_distrib(0, 10);
+    std::uniform_real_distribution<f32> noise_distrib(-0.1, 0.1);
+    Vector<f32> centers(cluster_num * dimension);
+    for (auto &x : centers) {
+        x = center_distrib(rng);
+    }
+    Vector<f32> vectors(vector_count * dimension);
+    for (u32 i = 0; i < vector_count; ++i) {
+        const f32 *center = centers.data() + (i % cluster_num) * dimension;
+        for (u32 j = 0; j < dimension; ++j) {
+            vectors[i * dimension + j] = center[j] + noise_distrib(rng);
+        }
+    }
+
+    auto train = [&](KMeansOption option) {
+        Vector<f32> centroids;
+        u32 partition_num =
+            GetKMeansCentroids<f32, f32, f32>(MetricType::kMetricL2, dimension, vector_count, vectors.data(), centroids, cluster_num, 0, 32, 256, option);
+        EXPECT_EQ(partition_num, cluster_num);
+        EXPECT_EQ(centroids.size(), cluster_num * dimension);
+        return centroids;
+    };
+
+    for (KMeansInit init : {KMeansInit::kRandom, KMeansInit::kPlusPlus}) {
+        for (u32 mini_batch_size : {0u, 512u}) {
+            KMeansOption option{.init_ = init, .mini_batch_size_ = mini_batch_size, .seed_ = 1};
+            option.thread_num_ = 1;
+            Vector<f32> centroids1 = train(option);
+            EXPECT_EQ(train(option), centroids1);
+            option.thread_num_ = 4;
+            EXPECT_EQ(train(option), centroids1);
+        }
+    }
+}
+
+// There are fewer distinct vectors than partitions: the partitions left without vectors are split from the largest ones instead of
+// being kept as zero centroids.
+TEST_F(KMeansPartitionTest, test_split_empty_partition) {
+    u32 dimension = 8;
+    u32 duplicate_num = 60;
+    u32 distinct_num = 4;
+    u32 vector_count = duplicate_num + distinct_num;
+    u32 partition_num = 8;
+
+    // every component of a vector is at least 1
+    Vector<f32> vectors(vector_count * dimension);
+    for (u32 i = 0; i < vector_count; ++i) {
+        f32 offset = i < duplicate_num ? 0 : 10.0f * (i - duplicate_num + 1);
+        for (u32 j = 0; j < dimension; ++j) {
+            vectors[i * dimension + j] = 1 + 0.1f * j + offset;
+        }
+    }
+
+    for (KMeansInit init : {KMeansInit::kRandom, KMeansInit::kPlusPlus}) {
+        for (u32 thread_num : {1u, 4u}) {
+            KMeansOption option{.thread_num_ = thread_num, .init_ = init};
+            Vector<f32> centroids;
+            u32 ret = GetKMeansCentroids<f32, f32, f32>(MetricType::kMetricL2,
+                                                        dimension,
+                                                        vector_count,
+                                                        vectors.data(),
+                                                        centroids,
+                                                        partition_num,
+                                                        0,
+                                                        1 /*min_points_per_centroid*/,
+                                                        256,
+                                                        option);
+            EXPECT_EQ(ret, partition_num);
+            // the update clears the centroid of an empty partition, it is not zero only if the partition is split
+            for (u32 i = 0; i < partition_num * dimension; ++i) {
+                EXPECT_GE(centroids[i], 0.9f);
+            }
+        }
+    }
+}
@@ -42,7 +42,7 @@ public:
     const std::string save_dir_ = GetTmpDir();
 
     template <typename Hnsw>
-    void TestSimple() {
+    void TestSimple(SizeT build_thread_n = 0) {
 
         int dim = 16;
         int M = 8;
@@ -61,10 +61,22 @@ public:
         }
 
         LocalFileSystem fs;
+        Hnsw cloned_index;
         {
             Hnsw hnsw_index = Hnsw::Make(chunk_size, max_chunk_n, dim, M, ef_construction);
 
-            hnsw_index.InsertVecsRaw(data.get(), element_size);
+            if (build_thread_n == 0) {
+                hnsw_index.InsertVecsRaw(data.get(), element_size);
+            } else {
+                auto [start_i, end_i] = hnsw_index.StoreDataRaw(data.get(), element_size);
+                SizeT report_n = 0, max_built_n = 0;
+                hnsw_index.ParallelBuild(start_i, end_i, build_thread_n, chunk_size, [&](SizeT built_n) {
+                    ++report_n;
+                    max_built_n = std::max(max_built_n, built_n);
+                });
+                EXPECT_EQ(report_n, SizeT(max_chunk_n));
+                EXPECT_EQ(max_built_n, SizeT(element_size));
+            }
             // std::ofstream os("tmp/dump.txt");
             // hnsw_index.Dump(os);
             // os.flush();
@@ -113,7 +125,67 @@ public:
             EXPECT_GE(correct_rate, 0.95);
 
             file_handler->Close();
+            cloned_index = Hnsw::Clone(hnsw_index);
+        }
+
+        {
+            // the copy doesn't share any memory with the loaded index, which is freed
+            cloned_index.SetEf(10);
+            cloned_index.Check();
+            int correct = 0;
+            for (int i = 0; i < element_size; ++i) {
+                const float *query = data.get() + i * dim;
+                auto result = cloned_index.KnnSearchSorted(query, 1);
+                if (result[0].second == (LabelT)i) {
+                    ++correct;
+                }
+            }
+            float correct_rate = float(correct) / element_size;
+            EXPECT_GE(correct_rate, 0.95);
+        }
+    }
+
+    // The realtime index inserts the vectors one by one, the quantizer must not be trained on the first one only.
+    template <typename Hnsw>
+    void TestOneByOne() {
+        int dim = 16;
+        int M = 8;
+        int ef_construction = 200;
+        int chunk_size = 128;
+        int max_chunk_n = 48;
+        int element_size = max_chunk_n * chunk_size;
+        int topk = 10;
+
+        std::mt19937 rng;
+        rng.seed(0);
+        std::uniform_real_distribution<float> distrib_real;
+
+        auto data = MakeUnique<float[]>(dim * element_size);
+        for (int i = 0; i < dim * element_size; ++i) {
+            data[i] = distrib_real(rng);
         }
+
+        Hnsw hnsw_index = Hnsw::Make(chunk_size, max_chunk_n, dim, M, ef_construction);
+        for (int i = 0; i < element_size; ++i) {
+            hnsw_index.InsertVecsRaw(data.get() + i * dim, 1, i);
+        }
+        hnsw_index.Check();
+
+        hnsw_index.SetEf(topk);
+        int correct = 0;
+        for (int i = 0; i < element_size; ++i) {
+            const float *query = data.get() + i * dim;
+            auto result = hnsw_index.KnnSearchSorted(query, topk);
+            for (const auto &[dist, label] : result) {
+                if (label == (LabelT)i) {
+                    ++correct;
+                    break;
+                }
+            }
+        }
+        float correct_rate = float(correct) / element_size;
+        // std::printf("correct rage: %f\n", correct_rate);
+        EXPECT_GE(correct_rate, 0.95);
     }
 
     template <typename Hnsw>
@@ -241,3 +313,28 @@ TEST_F(HnswAlgTest, test4) {
     using Hnsw = KnnHnsw<LVQL2VecStoreType<float, int8_t>, LabelT>;
     TestParallel<Hnsw>();
 }
+
+TEST_F(HnswAlgTest, test5) {
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    TestSimple<Hnsw>(4);
+}
+
+TEST_F(HnswAlgTest, test6) {
+    using Hnsw = KnnHnsw<SQL2VecStoreType<float, 8>, LabelT>;
+    TestSimple<Hnsw>();
+}
+
+TEST_F(HnswAlgTest, test7) {
+    using Hnsw = KnnHnsw<PQL2VecStoreType<float>, LabelT>;
+    TestSimple<Hnsw>();
+}
+
+TEST_F(HnswAlgTest, test8) {
+    using Hnsw = KnnHnsw<SQL2VecStoreType<float, 8>, LabelT>;
+    TestOneByOne<Hnsw>();
+}
+
+TEST_F(HnswAlgTest, test9) {
+    using Hnsw = KnnHnsw<PQL2VecStoreType<float>, LabelT>;
+    TestOneByOne<Hnsw>();
+}
@@ -139,4 +139,63 @@ TEST_F(HnswAlgBitmaskTest, test1) {
         EXPECT_NEAR(result[0].first, 0.2, error);
         EXPECT_NEAR(result[0].second, 3, error);
     }
-}
\ No newline at end of file
+}
+TEST_F(HnswAlgBitmaskTest, test_two_hop) {
+    SizeT dim = 16;
+    SizeT element_size = 2000;
+    SizeT top_k = 10;
+    SizeT M = 8;
+    SizeT ef_construction = 100;
+
+    auto data = MakeUnique<f32[]>(dim * element_size);
+    std::mt19937 rng;
+    rng.seed(0);
+    std::uniform_real_distribution<float> distrib_real;
+    for (SizeT i = 0; i < dim * element_size; ++i) {
+        data[i] = distrib_real(rng);
+    }
+
+    using LabelT = u64;
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<f32>, LabelT>;
+    auto hnsw_index = Hnsw::Make(element_size, 1, dim, M, ef_construction);
+    hnsw_index.InsertVecsRaw(data.get(), element_size);
+
+    // only one row in 20 passes the filter
+    auto p_bitmask = Bitmask::Make(std::bit_ceil(element_size));
+    for (SizeT i = 0; i < element_size; ++i) {
+        if (i % 20 != 0) {
+            p_bitmask->SetFalse(i);
+        }
+    }
+    BitmaskFilter<LabelT> filter(*p_bitmask);
+
+    SizeT query_n = 20;
+    SizeT correct = 0;
+    for (SizeT query_i = 0; query_i < query_n; ++query_i) {
+        const f32 *query = data.get() + query_i * 37 * dim;
+        Vector<Pair<f32, LabelT>> expect;
+        for (SizeT i = 0; i < element_size; i += 20) {
+            f32 dist = 0;
+            for (SizeT j = 0; j < dim; ++j) {
+                f32 diff = query[j] - data[i * dim + j];
+                dist += diff * diff;
+            }
+            expect.emplace_back(dist, i);
+        }
+        std::sort(expect.begin(), expect.end());
+        expect.resize(top_k);
+
+        auto result = hnsw_index.KnnSearchSorted(query, top_k, filter, true);
+        EXPECT_EQ(result.size(), top_k);
+        for (const auto &[dist, label] : result) {
+            EXPECT_EQ(label % 20, 0u);
+            for (const auto &[expect_dist, expect_label] : expect) {
+                if (expect_label == label) {
+                    ++correct;
+                    break;
+                }
+            }
+        }
+    }
+    EXPECT_GE(correct, query_n * top_k * 9 / 10);
+}
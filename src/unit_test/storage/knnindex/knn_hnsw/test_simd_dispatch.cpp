@@ -0,0 +1,49 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "unit_test/base_test.h"
+#include <random>
+
+import stl;
+import hnsw_simd_func;
+import simd_init;
+
+using namespace infinity;
+
+class SIMDDispatchTest : public BaseTest {};
+
+TEST_F(SIMDDispatchTest, level) {
+    SIMDLevel level = GetSupportedSIMDLevel();
+    EXPECT_EQ(level, GetSupportedSIMDLevel());
+    EXPECT_NE(SIMDLevelToString(level), "");
+}
+
+TEST_F(SIMDDispatchTest, selected_kernels) {
+    std::default_random_engine rng;
+    std::uniform_real_distribution<float> float_dist(-1, 1);
+    std::uniform_int_distribution<int> int_dist(-128, 127);
+
+    for (SizeT dim : {1, 15, 16, 33, 64, 128, 200}) {
+        Vector<float> v1(dim), v2(dim);
+        Vector<int8_t> c1(dim), c2(dim);
+        for (SizeT i = 0; i < dim; ++i) {
+            v1[i] = float_dist(rng);
+            v2[i] = float_dist(rng);
+            c1[i] = int_dist(rng);
+            c2[i] = int_dist(rng);
+        }
+        EXPECT_NEAR(GetF32L2Func(dim)(v1.data(), v2.data(), dim), F32L2BF(v1.data(), v2.data(), dim), 1e-4);
+        EXPECT_NEAR(GetF32IPFunc(dim)(v1.data(), v2.data(), dim), F32IPBF(v1.data(), v2.data(), dim), 1e-4);
+        EXPECT_EQ(GetI8IPFunc(dim)(c1.data(), c2.data(), dim), I8IPBF(c1.data(), c2.data(), dim));
+    }
+}
@@ -33,6 +33,7 @@ import statement_common;
 import embedding_info;
 import knn_expr;
 import catalog;
+import mem_index_appender;
 import infinity_exception;
 import bg_task;
 import txn_store;
@@ -171,6 +172,7 @@ TEST_F(OptimizeKnnTest, test1) {
 
             TxnTableStore *txn_table_store = txn->GetTxnTableStore(table_entry);
             TxnIndexStore *txn_index_store = txn_table_store->GetIndexStore(table_index_entry);
+            catalog->mem_index_appender()->WaitAll();
             table_index_entry->MemIndexDump(txn_index_store, true);
 
             txn_mgr->CommitTxn(txn);
@@ -34,8 +34,8 @@ TEST_F(BlockVersionTest, SaveAndLoad) {
     BlockVersion block_version(8192);
     block_version.created_.emplace_back(10, 3);
     block_version.created_.emplace_back(20, 6);
-    block_version.deleted_[2] = 30;
-    block_version.deleted_[5] = 40;
+    block_version.Delete(2, 30);
+    block_version.Delete(5, 40);
     String version_path = String(GetTmpDir()) + "/block_version_test";
     block_version.SaveToFile(version_path);
 
@@ -43,3 +43,101 @@ TEST_F(BlockVersionTest, SaveAndLoad) {
     block_verson2.LoadFromFile(version_path);
     ASSERT_EQ(block_version, block_verson2);
 }
+
+TEST_F(BlockVersionTest, SaveAndLoadDense) {
+    using namespace infinity;
+    BlockVersion block_version(8192);
+    block_version.created_.emplace_back(10, 8192);
+    for (BlockOffset offset = 0; offset < 8192; offset += 3) {
+        block_version.Delete(offset, 20 + offset % 7);
+    }
+    String version_path = String(GetTmpDir()) + "/block_version_test";
+    block_version.SaveToFile(version_path);
+
+    BlockVersion block_verson2(8192);
+    block_verson2.LoadFromFile(version_path);
+    ASSERT_EQ(block_version, block_verson2);
+}
+
+TEST_F(BlockVersionTest, Visibility) {
+    using namespace infinity;
+    BlockVersion block_version(8192);
+    block_version.created_.emplace_back(10, 200);
+    EXPECT_TRUE(block_version.NoDeleteVisible(100));
+    EXPECT_EQ(block_version.NextNotDeleted(0, 200, 100), 0);
+    EXPECT_EQ(block_version.NextDeleted(0, 200, 100), 200);
+
+    block_version.Delete(0, 30);
+    block_version.Delete(1, 30);
+    block_version.Delete(70, 40);
+    block_version.Delete(130, 50);
+
+    EXPECT_TRUE(block_version.NoDeleteVisible(29));
+    EXPECT_FALSE(block_version.NoDeleteVisible(30));
+    EXPECT_EQ(block_version.DeleteTS(70), 40u);
+    EXPECT_EQ(block_version.DeleteTS(71), 0u);
+
+    EXPECT_EQ(block_version.NextNotDeleted(0, 200, 29), 0);
+    EXPECT_EQ(block_version.NextNotDeleted(0, 200, 30), 2);
+    EXPECT_EQ(block_version.NextDeleted(2, 200, 30), 200);
+    EXPECT_EQ(block_version.NextDeleted(2, 200, 45), 70);
+    EXPECT_EQ(block_version.NextDeleted(71, 200, 45), 200);
+    EXPECT_EQ(block_version.NextDeleted(71, 200, 50), 130);
+    EXPECT_EQ(block_version.NextDeleted(71, 100, 50), 100);
+    EXPECT_EQ(block_version.NextNotDeleted(70, 200, 50), 71);
+
+    EXPECT_TRUE(block_version.IsDeleted(70, 40));
+    EXPECT_FALSE(block_version.IsDeleted(70, 39));
+    EXPECT_FALSE(block_version.IsDeleted(69, 100));
+
+    EXPECT_TRUE(block_version.HasDeleteBetween(35, 40));
+    EXPECT_FALSE(block_version.HasDeleteBetween(40, 49));
+
+    BlockVersion checkpoint_version(8192);
+    checkpoint_version.CopyDeletes(block_version, 40);
+    EXPECT_EQ(checkpoint_version.delete_count(), 3u);
+    EXPECT_EQ(checkpoint_version.DeleteTS(130), 0u);
+}
+
+TEST_F(BlockVersionTest, FoldDeletes) {
+    using namespace infinity;
+    BlockVersion block_version(8192);
+    block_version.created_.emplace_back(10, 200);
+    block_version.Delete(0, 30);
+    block_version.Delete(1, 30);
+    block_version.Delete(70, 40);
+    block_version.Delete(130, 50);
+
+    EXPECT_EQ(block_version.FoldDeletes(20), 0u);
+    EXPECT_EQ(block_version.FoldDeletes(45), 3u);
+    EXPECT_EQ(block_version.FoldDeletes(40), 0u);
+    EXPECT_EQ(block_version.folded_ts(), 45u);
+    EXPECT_EQ(block_version.delete_count(), 4u);
+    EXPECT_EQ(block_version.DeleteTS(70), 45u);
+    EXPECT_EQ(block_version.DeleteTS(130), 50u);
+    EXPECT_EQ(block_version.DeleteTS(71), 0u);
+
+    EXPECT_TRUE(block_version.IsDeleted(1, 45));
+    EXPECT_FALSE(block_version.IsDeleted(130, 49));
+    EXPECT_EQ(block_version.NextNotDeleted(0, 200, 45), 2);
+    EXPECT_EQ(block_version.NextDeleted(71, 200, 49), 200);
+    EXPECT_EQ(block_version.NextDeleted(71, 200, 50), 130);
+    EXPECT_FALSE(block_version.HasDeleteBetween(45, 49));
+    EXPECT_TRUE(block_version.HasDeleteBetween(40, 49));
+    EXPECT_TRUE(block_version.HasDeleteBetween(49, 50));
+
+    // The folded deletes are copied, and only the commit ts of the others is saved.
+    BlockVersion checkpoint_version(8192);
+    checkpoint_version.CopyDeletes(block_version, 49);
+    EXPECT_EQ(checkpoint_version.delete_count(), 3u);
+    EXPECT_EQ(checkpoint_version.DeleteTS(0), 45u);
+    EXPECT_EQ(checkpoint_version.DeleteTS(130), 0u);
+
+    String version_path = String(GetTmpDir()) + "/block_version_test";
+    block_version.SaveToFile(version_path);
+    BlockVersion block_verson2(8192);
+    block_verson2.LoadFromFile(version_path);
+    ASSERT_EQ(block_version, block_verson2);
+    EXPECT_EQ(block_verson2.DeleteTS(1), 45u);
+    EXPECT_EQ(block_verson2.DeleteTS(130), 50u);
+}
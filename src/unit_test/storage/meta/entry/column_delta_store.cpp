@@ -0,0 +1,145 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import stl;
+import column_delta_store;
+import data_type;
+import logical_type;
+
+using namespace infinity;
+
+class ColumnDeltaStoreTest : public BaseTest {
+protected:
+    static void UpdateInt(ColumnDeltaStore &store, ColumnID column_id, BlockOffset block_offset, i32 value, TxnTimeStamp commit_ts) {
+        store.Update(column_id, block_offset, reinterpret_cast<const char *>(&value), sizeof(value), commit_ts);
+    }
+
+    static Vector<i32> Read(const ColumnDeltaStore &store, ColumnID column_id, TxnTimeStamp check_ts, BlockOffset begin, BlockOffset end) {
+        Vector<i32> values(end - begin);
+        for (SizeT i = 0; i < values.size(); ++i) {
+            values[i] = -1 - i32(begin + i);
+        }
+        store.Apply(column_id, check_ts, begin, end, reinterpret_cast<char *>(values.data()));
+        return values;
+    }
+};
+
+TEST_F(ColumnDeltaStoreTest, supported) {
+    EXPECT_TRUE(ColumnDeltaStore::Supported(DataType(LogicalType::kInteger)));
+    EXPECT_TRUE(ColumnDeltaStore::Supported(DataType(LogicalType::kDouble)));
+    EXPECT_TRUE(ColumnDeltaStore::Supported(DataType(LogicalType::kTimestamp)));
+    EXPECT_FALSE(ColumnDeltaStore::Supported(DataType(LogicalType::kBoolean)));
+    EXPECT_FALSE(ColumnDeltaStore::Supported(DataType(LogicalType::kVarchar)));
+}
+
+TEST_F(ColumnDeltaStoreTest, visibility) {
+    ColumnDeltaStore store;
+    EXPECT_TRUE(store.Empty());
+    UpdateInt(store, 1, 3, 30, 10);
+    UpdateInt(store, 1, 5, 50, 10);
+    UpdateInt(store, 1, 3, 31, 20);
+    UpdateInt(store, 2, 4, 40, 15);
+    EXPECT_FALSE(store.Empty());
+    EXPECT_EQ(store.min_update_ts(), 10u);
+
+    EXPECT_FALSE(store.HasVisibleUpdate(1, 9));
+    EXPECT_TRUE(store.HasVisibleUpdate(1, 10));
+    EXPECT_FALSE(store.HasVisibleUpdate(2, 14));
+    EXPECT_FALSE(store.HasVisibleUpdate(0, 100));
+
+    EXPECT_EQ(Read(store, 1, 9, 2, 6), (Vector<i32>{-3, -4, -5, -6}));
+    EXPECT_EQ(Read(store, 1, 10, 2, 6), (Vector<i32>{-3, 30, -5, 50}));
+    EXPECT_EQ(Read(store, 1, 25, 2, 6), (Vector<i32>{-3, 31, -5, 50}));
+    EXPECT_EQ(Read(store, 1, 25, 4, 5), (Vector<i32>{-5}));
+    EXPECT_EQ(Read(store, 2, 15, 4, 5), (Vector<i32>{40}));
+
+    // updated twice with the same commit ts, the last value wins
+    UpdateInt(store, 1, 5, 51, 20);
+    UpdateInt(store, 1, 5, 52, 20);
+    EXPECT_EQ(Read(store, 1, 20, 5, 6), (Vector<i32>{52}));
+    EXPECT_EQ(Read(store, 1, 19, 5, 6), (Vector<i32>{50}));
+}
+
+TEST_F(ColumnDeltaStoreTest, copy_updates) {
+    ColumnDeltaStore store;
+    UpdateInt(store, 0, 0, 1, 10);
+    UpdateInt(store, 0, 0, 2, 20);
+    UpdateInt(store, 0, 7, 3, 30);
+
+    EXPECT_TRUE(store.HasUpdateBetween(0, 10));
+    EXPECT_TRUE(store.HasUpdateBetween(15, 20));
+    EXPECT_FALSE(store.HasUpdateBetween(20, 29));
+    EXPECT_FALSE(store.HasUpdateBetween(30, 100));
+
+    ColumnDeltaStore checkpoint_store;
+    checkpoint_store.CopyUpdates(store, 20);
+    EXPECT_NE(checkpoint_store, store);
+    EXPECT_EQ(Read(checkpoint_store, 0, 100, 0, 8), (Vector<i32>{2, -2, -3, -4, -5, -6, -7, -8}));
+
+    ColumnDeltaStore full_store;
+    full_store.CopyUpdates(store, 30);
+    EXPECT_EQ(full_store, store);
+}
+
+TEST_F(ColumnDeltaStoreTest, prune) {
+    ColumnDeltaStore store;
+    UpdateInt(store, 0, 0, 1, 10);
+    UpdateInt(store, 0, 0, 2, 20);
+    UpdateInt(store, 0, 0, 3, 30);
+    UpdateInt(store, 0, 4, 4, 15);
+    UpdateInt(store, 1, 2, 5, 40);
+
+    EXPECT_EQ(store.Prune(5), 0u);
+    EXPECT_EQ(store.min_update_ts(), 10u);
+
+    EXPECT_EQ(store.Prune(25), 1u);
+    EXPECT_EQ(store.min_update_ts(), 15u);
+    EXPECT_EQ(Read(store, 0, 25, 0, 5), (Vector<i32>{2, -2, -3, -4, 4}));
+    EXPECT_EQ(Read(store, 0, 35, 0, 1), (Vector<i32>{3}));
+    EXPECT_EQ(Read(store, 1, 45, 2, 3), (Vector<i32>{5}));
+
+    EXPECT_EQ(store.Prune(100), 1u);
+    EXPECT_EQ(store.Prune(100), 0u);
+    EXPECT_EQ(Read(store, 0, 100, 0, 5), (Vector<i32>{3, -2, -3, -4, 4}));
+    EXPECT_EQ(Read(store, 1, 100, 2, 3), (Vector<i32>{5}));
+
+    // updates committed after pruning are kept in commit order
+    UpdateInt(store, 0, 0, 6, 110);
+    EXPECT_EQ(Read(store, 0, 105, 0, 1), (Vector<i32>{3}));
+    EXPECT_EQ(Read(store, 0, 110, 0, 1), (Vector<i32>{6}));
+}
+
+TEST_F(ColumnDeltaStoreTest, save_load) {
+    String delta_path = String(GetTmpDir()) + "/column_delta_store_test";
+
+    ColumnDeltaStore store;
+    for (BlockOffset i = 0; i < 100; ++i) {
+        UpdateInt(store, i % 3, i * 7, i, 10 + i);
+        UpdateInt(store, i % 3, i * 7, i * 2, 200 + i);
+    }
+    store.SaveToFile(delta_path);
+
+    ColumnDeltaStore loaded_store;
+    loaded_store.LoadFromFile(delta_path);
+    EXPECT_EQ(loaded_store, store);
+    EXPECT_EQ(Read(loaded_store, 1, 250, 7, 8), (Vector<i32>{2}));
+    EXPECT_EQ(Read(loaded_store, 1, 100, 7, 8), (Vector<i32>{1}));
+
+    loaded_store.Cleanup(delta_path);
+    ColumnDeltaStore empty_store;
+    empty_store.LoadFromFile(delta_path);
+    EXPECT_TRUE(empty_store.Empty());
+}
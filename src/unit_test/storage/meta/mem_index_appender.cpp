@@ -0,0 +1,76 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "unit_test/base_test.h"
+
+import stl;
+import infinity;
+import infinity_context;
+import storage;
+import query_result;
+import data_block;
+import value;
+import internal_types;
+import catalog;
+import mem_index_appender;
+
+using namespace infinity;
+
+class MemIndexAppenderTest : public BaseTest {};
+
+// Rows committed while the appender workers are stopped stay pending. The knn scan brute forces them after the indexed rows, and finds the
+// same neighbors once they are inserted.
+TEST_F(MemIndexAppenderTest, knn_tail_scan) {
+    String path = GetHomeDir();
+    RemoveDbDirs();
+    Infinity::LocalInit(path);
+    SharedPtr<Infinity> infinity = Infinity::LocalConnect();
+    MemIndexAppender *appender = InfinityContext::instance().storage()->catalog()->mem_index_appender();
+
+    EXPECT_TRUE(infinity->Query("CREATE TABLE t1 (c1 INT, c2 EMBEDDING(FLOAT, 4))").IsOk());
+    EXPECT_TRUE(infinity->Query("CREATE INDEX idx1 ON t1 (c2) USING Hnsw WITH (M = 16, ef_construction = 50, metric = l2)").IsOk());
+
+    EXPECT_TRUE(infinity->Query("INSERT INTO t1 VALUES (5, [5.0, 5.0, 5.0, 5.0]), (6, [6.0, 6.0, 6.0, 6.0]), (7, [7.0, 7.0, 7.0, 7.0])").IsOk());
+    appender->WaitAll();
+    EXPECT_EQ(appender->pending_rows(), 0u);
+
+    appender->Stop();
+    EXPECT_TRUE(infinity->Query("INSERT INTO t1 VALUES (1, [1.0, 1.0, 1.0, 1.0]), (3, [3.0, 3.0, 3.0, 3.0])").IsOk());
+    EXPECT_TRUE(infinity->Query("INSERT INTO t1 VALUES (2, [2.0, 2.0, 2.0, 2.0])").IsOk());
+    EXPECT_EQ(appender->pending_rows(), 3u);
+
+    auto check_knn = [&] {
+        QueryResult result = infinity->Query("SELECT c1 FROM t1 SEARCH KNN(c2, [0.0, 0.0, 0.0, 0.0], 'float', 'l2', 4)");
+        ASSERT_TRUE(result.IsOk());
+        Vector<IntegerT> c1;
+        for (SizeT block_idx = 0; block_idx < result.result_table_->DataBlockCount(); ++block_idx) {
+            SharedPtr<DataBlock> data_block = result.result_table_->GetDataBlockById(block_idx);
+            for (SizeT row_idx = 0; row_idx < data_block->row_count(); ++row_idx) {
+                c1.push_back(data_block->GetValue(0, row_idx).GetValue<IntegerT>());
+            }
+        }
+        EXPECT_EQ(c1, (Vector<IntegerT>{1, 2, 3, 5}));
+    };
+    check_knn();
+
+    appender->Start();
+    appender->WaitAll();
+    EXPECT_EQ(appender->pending_rows(), 0u);
+    EXPECT_EQ(appender->lag_ms(), 0);
+    check_knn();
+
+    infinity->LocalDisconnect();
+    Infinity::LocalUnInit();
+}
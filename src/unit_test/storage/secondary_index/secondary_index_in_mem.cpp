@@ -0,0 +1,47 @@
+#include "unit_test/base_test.h"
+
+import stl;
+import secondary_index_in_mem;
+import column_vector;
+import value;
+import internal_types;
+import logical_type;
+import data_type;
+
+using namespace infinity;
+
+class SecondaryIndexInMemTest : public BaseTest {};
+
+TEST_F(SecondaryIndexInMemTest, test_range_query) {
+    auto data_type = MakeShared<DataType>(LogicalType::kInteger);
+    SharedPtr<ColumnVector> column = ColumnVector::Make(data_type);
+    column->Initialize();
+    // keys: 9, 8, ..., 0, 9, 8, ..., 0
+    for (i32 i = 0; i < 20; ++i) {
+        column->AppendValue(Value::MakeInt(9 - i % 10));
+    }
+    // the rows before segment offset 100 are in the PGM index
+    auto memory_index = GetSecondaryIndexInMem(data_type, 100);
+    memory_index->Insert(*column, 0, 5, 95);
+    EXPECT_EQ(memory_index->GetRowCount(), 0u);
+    memory_index->Insert(*column, 5, 15, 100);
+    EXPECT_EQ(memory_index->GetRowCount(), 15u);
+
+    // segment offset 100 + j is row 5 + j of the column, whose key is 9 - (5 + j) % 10
+    i32 begin_val = 2;
+    i32 end_val = 3;
+    Vector<u32> offsets;
+    memory_index->RangeQuery(&begin_val, &end_val, 200, offsets);
+    EXPECT_EQ(offsets, (Vector<u32>{101, 102, 111, 112}));
+
+    // the rows at or after the row limit are appended after the scan started
+    offsets.clear();
+    memory_index->RangeQuery(&begin_val, &end_val, 111, offsets);
+    EXPECT_EQ(offsets, (Vector<u32>{101, 102}));
+
+    begin_val = 10;
+    end_val = 20;
+    offsets.clear();
+    memory_index->RangeQuery(&begin_val, &end_val, 200, offsets);
+    EXPECT_TRUE(offsets.empty());
+}
@@ -52,6 +52,10 @@ import default_values;
 import global_resource_usage;
 import infinity;
 import background_process;
+import table_index_entry;
+import segment_index_entry;
+import secondary_index_data;
+import buffer_handle;
 
 using namespace infinity;
 
@@ -442,4 +446,130 @@ TEST_F(CheckpointTest, test_index_replay_with_full_and_delta_checkpoint2) {
     EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
     infinity::GlobalResourceUsage::UnInit();
 #endif
-}
\ No newline at end of file
+}
+TEST_F(CheckpointTest, test_secondary_index_restart_then_seal) {
+#ifdef INFINITY_DEBUG
+    infinity::GlobalResourceUsage::Init();
+#endif
+    auto config_path = std::make_shared<std::string>(std::string(test_data_path()) + "/config/test_catalog_delta.toml");
+
+    auto db_name = std::make_shared<std::string>("default");
+    auto table_name = std::make_shared<std::string>("test_secondary_index_restart_then_seal");
+    auto column_name = std::make_shared<std::string>("col1");
+    auto index_name = std::make_shared<std::string>("idx1");
+
+    auto append_rows = [&](TxnManager *txn_mgr, SizeT row_count) {
+        while (row_count > 0) {
+            auto *txn = txn_mgr->BeginTxn();
+            // at most 128 blocks per txn
+            for (SizeT i = 0; i < 128 && row_count > 0; ++i) {
+                SizeT block_row_count = std::min(SizeT(DEFAULT_BLOCK_CAPACITY), row_count);
+                row_count -= block_row_count;
+                auto input_block = MakeShared<DataBlock>();
+                input_block->Init(Vector<SharedPtr<DataType>>{MakeShared<DataType>(LogicalType::kInteger)}, block_row_count);
+                for (SizeT j = 0; j < block_row_count; ++j) {
+                    input_block->AppendValue(0, Value::MakeInt(static_cast<IntegerT>(j)));
+                }
+                input_block->Finalize();
+                Status status = txn->Append(*db_name, *table_name, input_block);
+                EXPECT_TRUE(status.ok());
+            }
+            txn_mgr->CommitTxn(txn);
+        }
+    };
+    auto get_segment_index_entry = [&](TxnManager *txn_mgr) {
+        auto *txn = txn_mgr->BeginTxn();
+        auto [table_index_entry, status] = txn->GetIndexByName(*db_name, *table_name, *index_name);
+        EXPECT_TRUE(status.ok());
+        SharedPtr<SegmentIndexEntry> segment_index_entry = table_index_entry->index_by_segment().at(0);
+        txn_mgr->CommitTxn(txn);
+        return segment_index_entry;
+    };
+
+    // create the index, then append the rows of one part and a few more, they are in the memory index
+    {
+        infinity::InfinityContext::instance().Init(config_path);
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+        {
+            Vector<SharedPtr<ColumnDef>> columns;
+            columns.emplace_back(MakeShared<ColumnDef>(0, MakeShared<DataType>(LogicalType::kInteger), *column_name, HashSet<ConstraintType>()));
+            auto *txn = txn_mgr->BeginTxn();
+            Status status = txn->CreateTable(*db_name, MakeUnique<TableDef>(db_name, table_name, columns), ConflictType::kError);
+            EXPECT_TRUE(status.ok());
+            txn_mgr->CommitTxn(txn);
+        }
+        {
+            auto *txn = txn_mgr->BeginTxn();
+            SharedPtr<IndexBase> index_base = IndexSecondary::Make(index_name, fmt::format("{}_{}", *table_name, *index_name), {*column_name});
+            auto [table_entry, status1] = txn->GetTableByName(*db_name, *table_name);
+            EXPECT_TRUE(status1.ok());
+            auto table_ref = BaseTableRef::FakeTableRef(table_entry, txn->BeginTS());
+            auto [table_index_entry, status2] = txn->CreateIndexDef(table_entry, index_base, ConflictType::kError);
+            EXPECT_TRUE(status2.ok());
+            auto status3 = txn->CreateIndexPrepare(table_index_entry, table_ref.get(), false);
+            EXPECT_TRUE(status3.ok());
+            txn->CreateIndexFinish(table_entry, table_index_entry);
+            txn_mgr->CommitTxn(txn);
+        }
+        append_rows(txn_mgr, DEFAULT_BLOCK_CAPACITY);
+        append_rows(txn_mgr, 100);
+        EXPECT_EQ(get_segment_index_entry(txn_mgr)->GetIndexPartNum(), 0u);
+        {
+            auto *txn = txn_mgr->BeginTxn();
+            auto force_ckp_task = MakeShared<ForceCheckpointTask>(txn, true);
+            storage->bg_processor()->Submit(force_ckp_task);
+            force_ckp_task->Wait();
+            txn_mgr->CommitTxn(txn);
+        }
+
+        infinity::InfinityContext::instance().UnInit();
+    }
+    // the checkpointed index has no part although the segment has rows, fill and seal the segment after the restart
+    {
+        infinity::InfinityContext::instance().Init(config_path);
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+
+        SharedPtr<SegmentIndexEntry> segment_index_entry = get_segment_index_entry(txn_mgr);
+        EXPECT_EQ(segment_index_entry->GetIndexPartNum(), 0u);
+        EXPECT_EQ(segment_index_entry->GetSecondaryIndexSnapshot().second->GetRowCount(), DEFAULT_BLOCK_CAPACITY + 100);
+
+        append_rows(txn_mgr, DEFAULT_SEGMENT_CAPACITY - DEFAULT_BLOCK_CAPACITY - 100);
+        // the PGM index of the sealed segment is built in the background, then the memory index is dropped
+        time_t start = time(nullptr);
+        while (segment_index_entry->GetSecondaryIndexSnapshot().second.get() != nullptr) {
+            if (time(nullptr) - start > 60) {
+                UnrecoverableException("Build secondary index timeout");
+            }
+            usleep(100 * 1000);
+        }
+        EXPECT_EQ(segment_index_entry->GetIndexPartNum(), DEFAULT_SEGMENT_CAPACITY / DEFAULT_BLOCK_CAPACITY);
+        {
+            BufferHandle buffer_handle_head = segment_index_entry->GetIndex();
+            auto secondary_index_head = static_cast<const SecondaryIndexDataHead *>(buffer_handle_head.GetData());
+            EXPECT_EQ(secondary_index_head->GetDataNum(), DEFAULT_SEGMENT_CAPACITY);
+        }
+        segment_index_entry.reset();
+
+        infinity::InfinityContext::instance().UnInit();
+    }
+    // the saved index of the sealed segment covers all its rows
+    {
+        infinity::InfinityContext::instance().Init(config_path);
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+
+        SharedPtr<SegmentIndexEntry> segment_index_entry = get_segment_index_entry(txn_mgr);
+        EXPECT_EQ(segment_index_entry->GetIndexPartNum(), DEFAULT_SEGMENT_CAPACITY / DEFAULT_BLOCK_CAPACITY);
+        EXPECT_EQ(segment_index_entry->GetSecondaryIndexSnapshot().second.get(), nullptr);
+        segment_index_entry.reset();
+
+        infinity::InfinityContext::instance().UnInit();
+    }
+#ifdef INFINITY_DEBUG
+    EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+    EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+    infinity::GlobalResourceUsage::UnInit();
+#endif
+}
@@ -15,8 +15,10 @@
 #include "type/complex/embedding_type.h"
 #include "unit_test/base_test.h"
 #include <memory>
+#include <thread>
 
 import stl;
+import third_party;
 import global_resource_usage;
 import storage;
 import infinity_context;
@@ -464,6 +466,109 @@ TEST_F(WalReplayTest, wal_replay_append) {
     }
 }
 
+TEST_F(WalReplayTest, wal_replay_parallel_commit) {
+    constexpr SizeT table_n = 8;
+    constexpr SizeT txn_n = 32;
+    {
+#ifdef INFINITY_DEBUG
+        infinity::GlobalResourceUsage::Init();
+#endif
+        std::shared_ptr<std::string> config_path = WalReplayTest::config_path();
+        infinity::InfinityContext::instance().Init(config_path);
+
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+        BGTaskProcessor *bg_processor = storage->bg_processor();
+
+        Vector<SharedPtr<ColumnDef>> columns;
+        columns.emplace_back(MakeShared<ColumnDef>(0, MakeShared<DataType>(LogicalType::kBigInt), "c1", HashSet<ConstraintType>()));
+        for (SizeT i = 0; i < table_n; ++i) {
+            auto tbl_def = MakeUnique<TableDef>(MakeShared<String>("default"), MakeShared<String>(fmt::format("tbl{}", i)), columns);
+            auto *txn = txn_mgr->BeginTxn();
+            Status status = txn->CreateTable("default", std::move(tbl_def), ConflictType::kIgnore);
+            EXPECT_TRUE(status.ok());
+            txn_mgr->CommitTxn(txn);
+        }
+
+        // The appends of different tables are committed concurrently by the WAL flush, their delta entries must still reach the
+        // catalog in the commit_ts order.
+        Vector<TxnTimeStamp> max_commit_ts(table_n);
+        Vector<std::thread> threads;
+        for (SizeT i = 0; i < table_n; ++i) {
+            threads.emplace_back([&, i] {
+                String table_name = fmt::format("tbl{}", i);
+                for (SizeT j = 0; j < txn_n; ++j) {
+                    auto *txn = txn_mgr->BeginTxn();
+                    SharedPtr<DataBlock> input_block = MakeShared<DataBlock>();
+                    input_block->Init(Vector<SharedPtr<DataType>>{MakeShared<DataType>(LogicalType::kBigInt)}, 1);
+                    input_block->AppendValue(0, Value::MakeBigInt(static_cast<i64>(j)));
+                    input_block->Finalize();
+                    txn->Append("default", table_name, input_block);
+                    max_commit_ts[i] = std::max(max_commit_ts[i], txn_mgr->CommitTxn(txn));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        TxnTimeStamp last_commit_ts = *std::max_element(max_commit_ts.begin(), max_commit_ts.end());
+        TxnTimeStamp delta_commit_ts = 0;
+        for (SizeT i = 0; i < 1000; ++i) {
+            delta_commit_ts = std::get<0>(storage->catalog()->GetCheckpointState());
+            if (delta_commit_ts == last_commit_ts) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        EXPECT_EQ(delta_commit_ts, last_commit_ts);
+
+        {
+            auto *txn = txn_mgr->BeginTxn();
+            SharedPtr<ForceCheckpointTask> force_ckp_task = MakeShared<ForceCheckpointTask>(txn, false);
+            bg_processor->Submit(force_ckp_task);
+            force_ckp_task->Wait();
+            txn_mgr->CommitTxn(txn);
+        }
+        infinity::InfinityContext::instance().UnInit();
+#ifdef INFINITY_DEBUG
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+        infinity::GlobalResourceUsage::UnInit();
+#endif
+    }
+    // Restart the db instance
+    {
+#ifdef INFINITY_DEBUG
+        infinity::GlobalResourceUsage::Init();
+#endif
+        std::shared_ptr<std::string> config_path = WalReplayTest::config_path();
+        infinity::InfinityContext::instance().Init(config_path);
+
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+        {
+            auto *txn = txn_mgr->BeginTxn();
+            TxnTimeStamp begin_ts = txn->BeginTS();
+            for (SizeT i = 0; i < table_n; ++i) {
+                auto [table_entry, status] = txn->GetTableByName("default", fmt::format("tbl{}", i));
+                EXPECT_NE(table_entry, nullptr);
+
+                auto segment_entry = table_entry->GetSegmentByID(0, begin_ts);
+                EXPECT_NE(segment_entry, nullptr);
+                EXPECT_EQ(segment_entry->row_count(), txn_n);
+            }
+            txn_mgr->CommitTxn(txn);
+        }
+        infinity::InfinityContext::instance().UnInit();
+#ifdef INFINITY_DEBUG
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+        infinity::GlobalResourceUsage::UnInit();
+#endif
+    }
+}
+
 TEST_F(WalReplayTest, wal_replay_import) {
     {
 #ifdef INFINITY_DEBUG